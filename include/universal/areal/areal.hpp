@@ -9,6 +9,7 @@
 #include <bitset>
 
 #include "universal/native/ieee-754.hpp"
+#include "universal/native/word_arithmetic.hpp"
 #include "universal/posit/exponent.hpp"
 #include "universal/posit/fraction.hpp"
 #include "universal/posit/value.hpp"
@@ -41,7 +42,7 @@ namespace sw {
 			// check special cases
 			_sign = raw_bits.test(nbits - 1);
 			if (_sign) {
-				std::bitset<nbits> tmp(raw_bits);
+				bitblock<nbits> tmp(raw_bits);
 				tmp.reset(nbits - 1);
 				if (tmp.none()) {
 					// setnan();   special case = NaR (Not a Real)
@@ -69,14 +70,29 @@ namespace sw {
 			// so no need to transform back via 2's complement of regime/exponent/fraction
 		}
 
-		// needed to avoid double rounding situations: TODO: does that mean the condensed version above should be removed?
+		// round to nearest even to the fraction of the areal from sign, scale, and a fraction without the hidden bit
+		// the fraction is rounded on 64-bit limbs: a carry out of the fraction moves the value to the next binade
 		template<size_t nbits, size_t es, size_t fbits>
 		inline areal<nbits, es>& convert_(bool _sign, int _scale, const bitblock<fbits>& fraction_in, areal<nbits, es>& r) {
 			if (_trace_conversion) std::cout << "------------------- CONVERT ------------------" << std::endl;
 			if (_trace_conversion) std::cout << "sign " << (_sign ? "-1 " : " 1 ") << "scale " << std::setw(3) << _scale << " fraction " << fraction_in << std::endl;
 
-			r.reset();
-
+			constexpr size_t afbits = nbits - es - 1;
+			// the fraction of the areal and its rounding bit, with a limb to spare
+			constexpr size_t N = (afbits + 1 + 63) / 64 + 1;
+			uint64_t fraction[N];
+			bool sticky = copy_msbs_to_limbs(fraction_in, fraction);
+			sticky = limbs_shift_right(fraction, unsigned(64 * N - afbits - 1)) || sticky;
+			bool round = bool(fraction[0] & 1);
+			limbs_shift_right(fraction, 1);
+			if (round && (sticky || (fraction[0] & 1))) {
+				limbs_increment(fraction);
+				if (fraction[afbits / 64] & (1ull << (afbits % 64))) {
+					for (size_t i = 0; i < N; ++i) fraction[i] = 0;
+					++_scale;
+				}
+			}
+			r = areal<nbits, es>(_sign, _scale, limbs_to_bitblock<afbits>(fraction), false, false);
 			return r;
 		}
 
@@ -110,7 +126,7 @@ namespace sw {
 
 			areal() : _sign(false), _scale(0), _nrOfBits(fbits), _inf(false), _zero(true), _nan(false) {}
 			areal(bool sign, int scale, const bitblock<fbits>& fraction_without_hidden_bit, bool zero = true, bool inf = false) 
-				: _sign(sign), _scale(scale), _nrOfBits(fbits), _fraction(fraction_without_hidden_bit), _inf(inf), _zero(zero), _nan(false) {}
+				: _sign(sign), _scale(scale), _fraction(fraction_without_hidden_bit), _nrOfBits(fbits), _inf(inf), _zero(zero), _nan(false) {}
 
 			explicit areal(signed char initial_value)        { *this = initial_value; }
 			explicit areal(short initial_value)              { *this = initial_value; }
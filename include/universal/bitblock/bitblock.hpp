@@ -8,36 +8,108 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
-// this should be removed when we have made the transition away from std::bitset to sw::unum::bitblock
 #include <cassert>
-#include <bitset>
+#include <cstdint>
+#include <string>
+#include <limits>
+#include <stdexcept>
+#include "../native/word_arithmetic.hpp"
 
 namespace sw {
 	namespace unum {
 
 		// bitblock is a template class implementing efficient multi-precision binary arithmetic and logic
+		// The bits are stored in 64-bit blocks, least significant block first, and the bits above nbits in the most
+		// significant block are always zero. bitblock has the interface of std::bitset<nbits>, and the arithmetic
+		// functions below process a block at a time.
 		template<size_t nbits>
-		class bitblock : public std::bitset<nbits> {
-                    using base= std::bitset<nbits>;
+		class bitblock {
 		public:
-			constexpr bitblock() : base(0ull) {}
+			static constexpr size_t bitsInBlock = 64;
+			static constexpr size_t nrBlocks = (nbits == 0) ? 1 : 1 + ((nbits - 1) / bitsInBlock);
+			static constexpr size_t MSU = nrBlocks - 1; // MSU == Most Significant Unit
+			static constexpr uint64_t MSU_MASK = (nbits % bitsInBlock) ? ((uint64_t(1) << (nbits % bitsInBlock)) - 1) : (nbits ? 0xFFFFFFFFFFFFFFFFull : 0);
+
+			// proxy of a single bit, as std::bitset<nbits>::reference
+			class reference {
+			public:
+				reference(bitblock& bits, size_t pos) : _block(bits._block[blockIndex(pos)]), _mask(uint64_t(1) << (pos % bitsInBlock)) {}
+				reference(const reference&) = default;
+				reference& operator=(bool value) {
+					if (value) _block |= _mask; else _block &= ~_mask;
+					return *this;
+				}
+				reference& operator=(const reference& rhs) { return *this = bool(rhs); }
+				operator bool() const { return (_block & _mask) != 0; }
+				bool operator~() const { return (_block & _mask) == 0; }
+				reference& flip() {
+					_block ^= _mask;
+					return *this;
+				}
+			private:
+				uint64_t& _block;
+				uint64_t  _mask;
+			};
+
+			constexpr bitblock() : _block{} {}
 
 			constexpr bitblock(const bitblock&) = default;
 			constexpr bitblock(bitblock&&) = default;
 
-			constexpr bitblock& operator=(const bitblock&) = default;
-			constexpr bitblock& operator=(bitblock&&) = default;
-
-			constexpr bitblock& operator=(unsigned long long rhs) {
-				return (bitblock&)std::bitset<nbits>::operator=(rhs);
-			}
-
-			constexpr base& reset() { *this= bitblock{}; return *this; }
-			using base::reset; // make unary reset visible
-			
-			
-			void setToZero() { std::bitset<nbits>::reset(); }
-			constexpr bool load_bits(const std::string& string_of_bits) {
+			bitblock& operator=(const bitblock&) = default;
+			bitblock& operator=(bitblock&&) = default;
+
+			explicit bitblock(unsigned long long rhs) : _block{} { *this = rhs; }
+			bitblock& operator=(unsigned long long rhs) {
+				_block[0] = uint64_t(rhs);
+				for (size_t i = 1; i < nrBlocks; ++i) _block[i] = 0;
+				_block[MSU] &= MSU_MASK;
+				return *this;
+			}
+
+			// block access
+			uint64_t block(size_t b) const { return _block[b]; }
+			void setblock(size_t b, uint64_t value) { _block[b] = (b == MSU) ? (value & MSU_MASK) : value; }
+
+			// bit access
+			constexpr size_t size() const { return nbits; }
+			bool operator[](size_t pos) const { return (_block[blockIndex(pos)] >> (pos % bitsInBlock)) & 1; }
+			reference operator[](size_t pos) { return reference(*this, pos); }
+			bool test(size_t pos) const {
+				if (pos >= nbits) throw std::out_of_range("bitblock::test: position out of range");
+				return (*this)[pos];
+			}
+			bitblock& set() {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] = 0xFFFFFFFFFFFFFFFFull;
+				_block[MSU] &= MSU_MASK;
+				return *this;
+			}
+			bitblock& set(size_t pos, bool value = true) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::set: position out of range");
+				(*this)[pos] = value;
+				return *this;
+			}
+			bitblock& reset() {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] = 0;
+				return *this;
+			}
+			bitblock& reset(size_t pos) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::reset: position out of range");
+				(*this)[pos] = false;
+				return *this;
+			}
+			bitblock& flip() {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] = ~_block[i];
+				_block[MSU] &= MSU_MASK;
+				return *this;
+			}
+			bitblock& flip(size_t pos) {
+				if (pos >= nbits) throw std::out_of_range("bitblock::flip: position out of range");
+				(*this)[pos].flip();
+				return *this;
+			}
+			void setToZero() { reset(); }
+			bool load_bits(const std::string& string_of_bits) {
 				if (string_of_bits.length() != nbits) return false;
 				setToZero();
 				int msb = nbits - 1;
@@ -54,10 +126,157 @@ namespace sw {
 				}
 				return true;
 			}
+
+			// queries
+			bool any() const {
+				for (size_t i = 0; i < nrBlocks; ++i) if (_block[i]) return true;
+				return false;
+			}
+			bool none() const { return !any(); }
+			bool all() const {
+				for (size_t i = 0; i < MSU; ++i) if (_block[i] != 0xFFFFFFFFFFFFFFFFull) return false;
+				return _block[MSU] == MSU_MASK;
+			}
+			size_t count() const {
+				size_t count = 0;
+				for (size_t i = 0; i < nrBlocks; ++i) count += size_t(countSetBits(_block[i]));
+				return count;
+			}
+
+			// conversions
+			unsigned long long to_ullong() const {
+				for (size_t i = 1; i < nrBlocks; ++i) {
+					if (_block[i]) throw std::overflow_error("bitblock::to_ullong: value does not fit");
+				}
+				return _block[0];
+			}
+			unsigned long to_ulong() const {
+				unsigned long long value = to_ullong();
+				if (value > std::numeric_limits<unsigned long>::max()) throw std::overflow_error("bitblock::to_ulong: value does not fit");
+				return static_cast<unsigned long>(value);
+			}
+			std::string to_string(char zero = '0', char one = '1') const {
+				std::string s(nbits, zero);
+				for (size_t i = 0; i < nbits; ++i) if ((*this)[i]) s[nbits - 1 - i] = one;
+				return s;
+			}
+
+			// logic and shifts
+			bitblock& operator&=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] &= rhs._block[i];
+				return *this;
+			}
+			bitblock& operator|=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] |= rhs._block[i];
+				return *this;
+			}
+			bitblock& operator^=(const bitblock& rhs) {
+				for (size_t i = 0; i < nrBlocks; ++i) _block[i] ^= rhs._block[i];
+				return *this;
+			}
+			bitblock operator~() const {
+				bitblock result(*this);
+				return result.flip();
+			}
+			bitblock& operator<<=(size_t shift) {
+				if (shift >= nbits) return reset();
+				size_t blockShift = shift / bitsInBlock, bitShift = shift % bitsInBlock;
+				for (size_t i = MSU + 1; i-- > blockShift; ) {
+					uint64_t b = _block[i - blockShift] << bitShift;
+					if (bitShift && i > blockShift) b |= _block[i - blockShift - 1] >> (bitsInBlock - bitShift);
+					_block[i] = b;
+				}
+				for (size_t i = 0; i < blockShift; ++i) _block[i] = 0;
+				_block[MSU] &= MSU_MASK;
+				return *this;
+			}
+			bitblock& operator>>=(size_t shift) {
+				if (shift >= nbits) return reset();
+				size_t blockShift = shift / bitsInBlock, bitShift = shift % bitsInBlock;
+				for (size_t i = 0; i + blockShift < nrBlocks; ++i) {
+					uint64_t b = _block[i + blockShift] >> bitShift;
+					if (bitShift && i + blockShift + 1 < nrBlocks) b |= _block[i + blockShift + 1] << (bitsInBlock - bitShift);
+					_block[i] = b;
+				}
+				for (size_t i = nrBlocks - blockShift; i < nrBlocks; ++i) _block[i] = 0;
+				return *this;
+			}
+			bitblock operator<<(size_t shift) const {
+				bitblock result(*this);
+				return result <<= shift;
+			}
+			bitblock operator>>(size_t shift) const {
+				bitblock result(*this);
+				return result >>= shift;
+			}
+
+		private:
+			uint64_t _block[nrBlocks];
+
+			// index of the block holding bit pos: a single-block bitblock folds to block 0, so that the unchecked
+			// accessors never form an out-of-bounds subscript, even on dead paths such as bits[nbits - 1] of bitblock<0>
+			static constexpr size_t blockIndex(size_t pos) { return (nrBlocks == 1) ? 0 : pos / bitsInBlock; }
 		};
 
+		template<size_t nbits>
+		inline bitblock<nbits> operator&(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result &= rhs;
+		}
+		template<size_t nbits>
+		inline bitblock<nbits> operator|(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result |= rhs;
+		}
+		template<size_t nbits>
+		inline bitblock<nbits> operator^(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			bitblock<nbits> result(lhs);
+			return result ^= rhs;
+		}
+
+		template<size_t nbits>
+		inline std::ostream& operator<<(std::ostream& ostr, const bitblock<nbits>& bits) {
+			return ostr << bits.to_string();
+		}
+		template<size_t nbits>
+		inline std::istream& operator>>(std::istream& istr, bitblock<nbits>& bits) {
+			std::string s;
+			istr >> s;
+			if (!bits.load_bits(s)) istr.setstate(std::ios_base::failbit);
+			return istr;
+		}
+
 		// logic operators
 
+		namespace internal {
+
+			// compare two unsigned bitblocks from the most significant block down: -1, 0, or 1
+			template<size_t nbits>
+			int compare_unsigned(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+				for (size_t i = bitblock<nbits>::nrBlocks; i-- > 0; ) {
+					if (lhs.block(i) != rhs.block(i)) return (lhs.block(i) < rhs.block(i)) ? -1 : 1;
+				}
+				return 0;
+			}
+
+			// add the addend shifted left by lsb bits to the number, and return true if there is a carry out of nbits
+			template<size_t nbits>
+			bool add_block(bitblock<nbits>& number, uint64_t addend, size_t lsb = 0) {
+				constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+				constexpr size_t msuBits = nbits - 64 * (nrBlocks - 1);
+				const uint64_t addends[2] = { addend << (lsb % 64), (lsb % 64) ? (addend >> (64 - lsb % 64)) : 0 };
+				bool carry = false;
+				for (size_t b = lsb / 64, k = 0; b < nrBlocks; ++b, ++k) {
+					if (k >= 2 && !carry) break;
+					uint64_t sum = add_words(number.block(b), (k < 2) ? addends[k] : 0, carry);
+					if (b == nrBlocks - 1 && msuBits < 64) carry = carry || (sum >> (msuBits % 64)) != 0;
+					number.setblock(b, sum);
+				}
+				return carry;
+			}
+
+		} // namespace internal
+
 		// this comparison is for a two's complement number only
 		template<size_t nbits>
 		bool twosComplementLessThan(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
@@ -65,73 +284,41 @@ namespace sw {
 			if (lhs[nbits - 1] == 0 && rhs[nbits - 1] == 1)	return false;
 			if (lhs[nbits - 1] == 1 && rhs[nbits - 1] == 0) return true;
 			// sign is equal, compare the remaining bits
-			if (nbits > 1) {
-				for (int i = static_cast<int>(nbits) - 2; i >= 0; --i) {
-					if (lhs[i] == 0 && rhs[i] == 1)	return true;
-					if (lhs[i] == 1 && rhs[i] == 0) return false;
-				}
-			}
-			// numbers are equal
-			return false;
+			return internal::compare_unsigned(lhs, rhs) < 0;
 		}
 
 		// this comparison works for any number
 		template<size_t nbits>
 		bool operator==(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-			// compare remaining bits
-			for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-				if (lhs[i] != rhs[i]) return false;
-			}
-			// numbers are equal
-			return true;
+			return internal::compare_unsigned(lhs, rhs) == 0;
+		}
+		template<size_t nbits>
+		bool operator!=(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+			return internal::compare_unsigned(lhs, rhs) != 0;
 		}
 
 		// this comparison is for unsigned numbers only
 		template<size_t nbits>
 		bool operator< (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-			// compare remaining bits
-			for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-				if (lhs[i] == 0 && rhs[i] == 1)	return true;
-				if (lhs[i] == 1 && rhs[i] == 0) return false;
-			}
-			// numbers are equal
-			return false;
+			return internal::compare_unsigned(lhs, rhs) < 0;
 		}
 
 		// this comparison is for unsigned numbers only
 		template<size_t nbits>
 		bool operator<= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-			// compare remaining bits
-			for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-				if (lhs[i] == 0 && rhs[i] == 1)	return true;
-				if (lhs[i] == 1 && rhs[i] == 0) return false;
-			}
-			// numbers are equal
-			return true;
+			return internal::compare_unsigned(lhs, rhs) <= 0;
 		}
 
 		// this comparison is for unsigned numbers only
 		template<size_t nbits>
 		bool operator> (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-			// compare remaining bits
-			for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-				if (lhs[i] == 0 && rhs[i] == 1)	return false;
-				if (lhs[i] == 1 && rhs[i] == 0) return true;
-			}
-			// numbers are equal
-			return false;
+			return internal::compare_unsigned(lhs, rhs) > 0;
 		}
 
 		// this comparison is for unsigned numbers only
 		template<size_t nbits>
 		bool operator>= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-			// compare remaining bits
-			for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-				if (lhs[i] == 0 && rhs[i] == 1)	return false;
-				if (lhs[i] == 1 && rhs[i] == 0) return true;
-			}
-			// numbers are equal
-			return true;
+			return internal::compare_unsigned(lhs, rhs) >= 0;
 		}
 
 		////////////////////////////// ARITHMETIC functions
@@ -143,13 +330,7 @@ namespace sw {
 		// increment the input bitset in place, and return true if there is a carry generated.
 		template<size_t nbits>
 		bool increment_bitset(bitblock<nbits>& number) {
-			bool carry = true;  // ripple carry
-			for (size_t i = 0; i < nbits; i++) {
-				bool _a = number[i];
-				number[i] = _a ^ carry;
-				carry = carry & (_a ^ false);
-			}
-			return carry;
+			return internal::add_block(number, 1);
 		}
 
 		// increment the input bitset in place, and return true if there is a carry generated.
@@ -161,24 +342,17 @@ namespace sw {
 		template<size_t nbits>
 		bool increment_unsigned(bitblock<nbits>& number, size_t nrBits = nbits - 1) {
 			if (nrBits > nbits - 1) nrBits = nbits - 1;  // check/fix argument
-			bool carry = 1;  // ripple carry
-			size_t lsb = nbits - nrBits;
-			for (size_t i = lsb; i < nbits; i++) {
-				bool _a = number[i];
-				number[i] = _a ^ carry;
-				carry = (_a & false) | (carry & (_a ^ false));
-			}
-			return carry;
+			if (nrBits == 0) return true;                // the carry in passes through the empty word
+			return internal::add_block(number, 1, nbits - nrBits);
 		}
 
 		// decrement the input bitset in place, and return true if there is a borrow generated.
 		template<size_t nbits>
 		bool decrement_bitset(bitblock<nbits>& number) {
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
 			bool borrow = true;
-			for (size_t i = 0; i < nbits; i++) {
-				bool _a = number[i];
-				number[i] = _a ^ borrow;
-				borrow = (!(!_a ^ true) & borrow);
+			for (size_t i = 0; i < nrBlocks && borrow; ++i) {
+				number.setblock(i, subtract_words(number.block(i), 0, borrow));
 			}
 			return borrow;
 		}
@@ -188,27 +362,31 @@ namespace sw {
 
 		// add bitsets a and b and return result in bitset sum. Return true if there is a carry generated.
 		template<size_t nbits>
-		bool add_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& sum) {
-			bool carry = false;  // ripple carry
-			for (size_t i = 0; i < nbits; i++) {
-				bool _a = a[i];
-				bool _b = b[i];
-				sum[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
+		bool add_unsigned(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits + 1>& sum) {
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			bool carry = false;
+			sum.reset();
+			for (size_t i = 0; i < nrBlocks; ++i) sum.setblock(i, add_words(a.block(i), b.block(i), carry));
+			// a partial most significant block keeps the carry at bit nbits of the sum
+			if (nbits % 64) carry = sum[nbits];
 			sum.set(nbits, carry);
 			return carry;
 		}
 
 		// subtract bitsets a and b and return result in bitset dif. Return true if there is a borrow generated.
 		template<size_t nbits>
-		bool subtract_unsigned(bitblock<nbits> a, bitblock<nbits> b, bitblock<nbits + 1>& dif) {
-			bool borrow = false;  // ripple borrow
-			for (size_t i = 0; i < nbits; i++) {
-				bool _a = a[i];
-				bool _b = b[i];
-				dif[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
+		bool subtract_unsigned(const bitblock<nbits>& a, const bitblock<nbits>& b, bitblock<nbits + 1>& dif) {
+			constexpr size_t nrBlocks = bitblock<nbits>::nrBlocks;
+			bool borrow = false;
+			dif.reset();
+			for (size_t i = 0; i < nrBlocks; ++i) {
+				uint64_t difference = subtract_words(a.block(i), b.block(i), borrow);
+				if (i == nrBlocks - 1 && (nbits % 64)) {
+					// a borrow out of a partial most significant block sets all the bits above it
+					borrow = ((difference >> (nbits % 64)) & 1) != 0;
+					difference &= bitblock<nbits>::MSU_MASK;
+				}
+				dif.setblock(i, difference);
 			}
 			dif.set(nbits, borrow);
 			return borrow;
@@ -335,10 +513,34 @@ namespace sw {
 		// copy a bitset into a bigger bitset starting at position indicated by the shift value
 		template<size_t src_size, size_t tgt_size>
 		void copy_into(const bitblock<src_size>& src, size_t shift, bitblock<tgt_size>& tgt) {
+			constexpr size_t srcBlocks = bitblock<src_size>::nrBlocks, tgtBlocks = bitblock<tgt_size>::nrBlocks;
 			tgt.reset();
-			for (size_t i = 0; i < src_size; i++)
-				tgt.set(i + shift, src[i]);
-		}
+			size_t blockShift = shift / 64, bitShift = shift % 64;
+			for (size_t i = 0; i < srcBlocks && i + blockShift < tgtBlocks; ++i) {
+				size_t t = i + blockShift;
+				tgt.setblock(t, tgt.block(t) | (src.block(i) << bitShift));
+				if (bitShift && t + 1 < tgtBlocks) tgt.setblock(t + 1, src.block(i) >> (64 - bitShift));
+			}
+		}
+
+		namespace internal {
+
+			// the tgt_size bits of src starting at bit lsb
+			template<size_t tgt_size, size_t src_size>
+			bitblock<tgt_size> extract_bits(const bitblock<src_size>& src, size_t lsb) {
+				constexpr size_t srcBlocks = bitblock<src_size>::nrBlocks, tgtBlocks = bitblock<tgt_size>::nrBlocks;
+				bitblock<tgt_size> result;
+				size_t blockShift = lsb / 64, bitShift = lsb % 64;
+				for (size_t i = 0; i < tgtBlocks && i + blockShift < srcBlocks; ++i) {
+					size_t b = i + blockShift;
+					uint64_t bits = src.block(b) >> bitShift;
+					if (bitShift && b + 1 < srcBlocks) bits |= src.block(b + 1) << (64 - bitShift);
+					result.setblock(i, bits);
+				}
+				return result;
+			}
+
+		} // namespace internal
 
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 		// copy a slice of a bitset into a bigger bitset starting at position indicated by the shift value
@@ -367,10 +569,7 @@ namespace sw {
 			static_assert(from <= to, "from cannot be larger than to");
 			static_assert(to <= src_size, "to is larger than src_size");
 
-			bitblock<to - from> result;
-			for (size_t i = 0, end = to - from; i < end; ++i)
-				result[i] = src[i + from];
-			return result;
+			return internal::extract_bits<to - from>(src, from);
 		}
 
 		//////////////////////////////////////////////////////////////////////////////////////
@@ -379,48 +578,57 @@ namespace sw {
 		// accumulate the addend to a running accumulator
 		template<size_t src_size, size_t tgt_size>
 		bool accumulate(const bitblock<src_size>& addend, bitblock<tgt_size>& accumulator) {
-			bool carry = 0;  // ripple carry
-			for (size_t i = 0; i < src_size; i++) {
-				bool _a = addend[i];
-				bool _b = accumulator[i];
-				accumulator[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
+			static_assert(src_size <= tgt_size, "accumulator is smaller than the addend");
+			constexpr size_t nrBlocks = bitblock<src_size>::nrBlocks;
+			bool carry = false;
+			for (size_t i = 0; i < nrBlocks; ++i) {
+				uint64_t a = addend.block(i), b = accumulator.block(i);
+				if (i == nrBlocks - 1 && (src_size % 64)) {
+					// only the src_size bits of the accumulator change: the carry is bit src_size of the block sum
+					constexpr uint64_t mask = bitblock<src_size>::MSU_MASK;
+					uint64_t sum = a + (b & mask) + (carry ? 1 : 0);
+					carry = ((sum >> (src_size % 64)) & 1) != 0;
+					accumulator.setblock(i, (b & ~mask) | (sum & mask));
+				}
+				else {
+					accumulator.setblock(i, add_words(a, b, carry));
+				}
 			}
 			return carry;
 		}
 
 		// multiply bitsets a and b and return result in bitset result.
+		// The blocks are 64-bit limbs, so this is a multi-word multiplication of 64x64->128-bit partial products.
 		template<size_t operand_size>
 		void multiply_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
-			constexpr size_t result_size = 2 * operand_size;
-			bitblock<result_size> addend;
-			result.reset();
-			if (a.test(0)) {
-				copy_into<operand_size, result_size>(b, 0, result);
-			}
-			for (size_t i = 1; i < operand_size; i++) {
-				if (a.test(i)) {
-					copy_into<operand_size, result_size>(b, i, addend);
-#ifdef DEBUG
-					bool carry = accumulate(addend, result);   // we should never have a carry
-					assert(carry == false);
-#else
-					accumulate(addend, result);   // we should never have a carry
-#endif
-				}
+			constexpr size_t N = bitblock<operand_size>::nrBlocks;
+			uint64_t x[N], y[N], product[2 * N];
+			for (size_t i = 0; i < N; ++i) {
+				x[i] = a.block(i);
+				y[i] = b.block(i);
 			}
+			limbs_multiply(x, y, product);
+			for (size_t i = 0; i < bitblock<2 * operand_size>::nrBlocks; ++i) result.setblock(i, product[i]);
 		}
 
-
 		// subtract a subtractand from a running accumulator
 		template<size_t src_size, size_t tgt_size>
 		bool subtract(bitblock<tgt_size>& accumulator, const bitblock<src_size>& subtractand) {
-			bool borrow = 0;  // ripple borrow
-			for (size_t i = 0; i < src_size; i++) {
-				bool _a = accumulator[i];
-				bool _b = subtractand[i];
-				accumulator[i] = _a ^ _b ^ borrow;
-				borrow = ((!_a) & _b) | (!((!_a) ^ (!_b)) & borrow);
+			static_assert(src_size <= tgt_size, "accumulator is smaller than the subtractand");
+			constexpr size_t nrBlocks = bitblock<src_size>::nrBlocks;
+			bool borrow = false;
+			for (size_t i = 0; i < nrBlocks; ++i) {
+				uint64_t a = accumulator.block(i), b = subtractand.block(i);
+				if (i == nrBlocks - 1 && (src_size % 64)) {
+					// only the src_size bits of the accumulator change: a borrow sets bit src_size of the block difference
+					constexpr uint64_t mask = bitblock<src_size>::MSU_MASK;
+					uint64_t difference = (a & mask) - b - (borrow ? 1 : 0);
+					borrow = ((difference >> (src_size % 64)) & 1) != 0;
+					accumulator.setblock(i, (a & ~mask) | (difference & mask));
+				}
+				else {
+					accumulator.setblock(i, subtract_words(a, b, borrow));
+				}
 			}
 			return borrow;
 		}
@@ -428,11 +636,9 @@ namespace sw {
 		// divide bitsets a and b and return result in bitset result.
 		template<size_t operand_size>
 		void integer_divide_unsigned(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
-			bitblock<operand_size> subtractand, accumulator;
+			constexpr size_t N = bitblock<operand_size>::nrBlocks;
 			result.reset();
-			accumulator = a;
-			int msb = findMostSignificantBit(b);
-			if (msb < 0) {
+			if (b.none()) {
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 				throw integer_divide_by_zero{};
 #else
@@ -440,25 +646,13 @@ namespace sw {
 #endif // POSIT_THROW_ARITHMETIC_EXCEPTION
 			}
 			else {
-				int shift = operand_size - msb - 1;
-				// prepare the subtractand
-				subtractand = b;
-				subtractand <<= shift;
-				for (int i = operand_size - msb - 1; i >= 0; --i) {
-					if (subtractand <= accumulator) {
-#ifdef DEBUG
-						bool borrow = subtract(accumulator, subtractand);
-						assert(borrow == true);
-#else
-						subtract(accumulator, subtractand);
-#endif
-						result.set(i);
-					}
-					else {
-						result.reset(i);
-					}
-					subtractand >>= 1;
+				uint64_t u[N], v[N], q[N], r[N];
+				for (size_t i = 0; i < N; ++i) {
+					u[i] = a.block(i);
+					v[i] = b.block(i);
 				}
+				limbs_divide_unsigned(u, v, q, r);
+				for (size_t i = 0; i < N; ++i) result.setblock(i, q[i]);
 			}
 		}
 
@@ -467,11 +661,9 @@ namespace sw {
 		// Radix point must be maintained by calling function.
 		template<size_t operand_size, size_t result_size>
 		void divide_with_fraction(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<result_size>& result) {
-			bitblock<result_size> subtractand, accumulator;
+			constexpr size_t K = bitblock<result_size>::nrBlocks;
 			result.reset();
-			copy_into<operand_size, result_size>(a, result_size - operand_size, accumulator);
-			int msb = findMostSignificantBit(b);
-			if (msb < 0) {
+			if (b.none()) {
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 				throw integer_divide_by_zero{};
 #else
@@ -479,28 +671,14 @@ namespace sw {
 #endif // POSIT_THROW_ARITHMETIC_EXCEPTION
 			}
 			else {
-				int shift = operand_size - msb - 1;
-				// prepare the subtractand
-				copy_into<operand_size, result_size>(b, result_size - operand_size, subtractand);
-				subtractand <<= shift;
-				for (int i = result_size - msb - 1; i >= 0; --i) {
-					//std::cout << "accumulator " << accumulator << std::endl;
-					//std::cout << "subtractand " << subtractand << std::endl;
-					if (subtractand <= accumulator) {
-#ifdef DEBUG
-						bool borrow = subtract(accumulator, subtractand);
-						assert(borrow == false);
-#else
-						subtract(accumulator, subtractand);
-#endif
-						result.set(i);
-					}
-					else {
-						result.reset(i);
-					}
-					//std::cout << "result      " << result << std::endl;
-					subtractand >>= 1;
-				}
+				// the dividend is a aligned to the most significant bits of the result
+				bitblock<result_size> dividend;
+				copy_into<operand_size, result_size>(a, result_size - operand_size, dividend);
+				uint64_t u[K], v[K] = { 0 }, q[K], r[K];
+				for (size_t i = 0; i < K; ++i) u[i] = dividend.block(i);
+				for (size_t i = 0; i < bitblock<operand_size>::nrBlocks; ++i) v[i] = b.block(i);
+				limbs_divide_unsigned(u, v, q, r);
+				for (size_t i = 0; i < K; ++i) result.setblock(i, q[i]);
 			}
 		}
 
@@ -510,9 +688,8 @@ namespace sw {
 		// truncate right-side
 		template<size_t src_size, size_t tgt_size>
 		void truncate(bitblock<src_size>& src, bitblock<tgt_size>& tgt) {
-			tgt.reset();
-			for (size_t i = 0; i < tgt_size; i++)
-				tgt.set(tgt_size - 1 - i, src[src_size - 1 - i]);
+			static_assert(tgt_size <= src_size, "target is larger than the source");
+			tgt = internal::extract_bits<tgt_size>(src, src_size - tgt_size);
 		}
 
 		// round
@@ -600,38 +777,24 @@ namespace sw {
 		// find the MSB, return position if found, return -1 if no bits are set
 		template<size_t nbits>
 		int findMostSignificantBit(const bitblock<nbits>& bits) {
-			int msb = -1; // indicative of no bits set
-			for (int i = nbits - 1; i >= 0; i--) {
-				if (bits.test(i)) {
-					msb = i;
-					break;
-				}
+			for (size_t i = bitblock<nbits>::nrBlocks; i-- > 0; ) {
+				if (bits.block(i)) return int(64 * i) + 63 - countLeadingZeros(bits.block(i));
 			}
-			return msb;
+			return -1; // indicative of no bits set
 		}
 
 		// calculate the 1's complement of a sign-magnitude encoded number
 		template<size_t nbits>
 		bitblock<nbits> ones_complement(bitblock<nbits> number) {
-			bitblock<nbits> complement;
-			for (size_t i = 0; i < nbits; i++) {
-				complement.set(i, !number[i]);
-			}
-			return complement;
+			return number.flip();
 		}
 
 		// calculate the 2's complement of a 2's complement encoded number
 		template<size_t nbits>
 		bitblock<nbits> twos_complement(bitblock<nbits> number) {
-			bitblock<nbits> complement;
-			uint8_t _slice = 0;
-			uint8_t carry = 1;
-			for (size_t i = 0; i < nbits; i++) {
-				_slice = uint8_t(!number[i]) + carry;
-				carry = _slice >> 1;
-				complement[i] = (0x1 & _slice);
-			}
-			return complement;
+			number.flip();
+			internal::add_block(number, 1);
+			return number;
 		}
 
 		// DANGER: this depends on the implicit type conversion of number to a uint64_t to sign extent a 2's complement number system
@@ -639,11 +802,7 @@ namespace sw {
 		template<size_t nbits, class Type>
 		bitblock<nbits> convert_to_bitblock(Type number) {
 			bitblock<nbits> _Bits;
-			uint64_t mask = uint64_t(1);
-			for (std::size_t i = 0; i < nbits; i++) {
-				_Bits[i] = mask & number;
-				mask <<= 1;
-			}
+			_Bits.setblock(0, uint64_t(number));
 			return _Bits;
 		}
 
@@ -711,11 +870,36 @@ namespace sw {
 		template<size_t nbits>
 		bool anyAfter(const bitblock<nbits>& bits, int msb) {
 			if (msb < 0) return false;	// bad input
-			bool running = false;
-			for (int i = msb; i >= 0; i--) {
-				running |= bits.test(i);
+			size_t last = size_t(msb) / 64;
+			for (size_t i = 0; i < last; ++i) if (bits.block(i)) return true;
+			uint64_t mask = (msb % 64 == 63) ? 0xFFFFFFFFFFFFFFFFull : ((uint64_t(1) << (msb % 64 + 1)) - 1);
+			return (bits.block(last) & mask) != 0;
+		}
+
+		// copy the most significant bits of a bitblock into an array of 64-bit limbs, least significant limb first,
+		// aligned to the most significant bit of the top limb: returns true when any of the bits did not fit
+		template<size_t nbits, size_t N>
+		bool copy_msbs_to_limbs(const bitblock<nbits>& bits, uint64_t (&limbs)[N]) {
+			constexpr size_t limbBits = 64 * N;
+			bitblock<limbBits> aligned;
+			bool inexact = false;
+			if (nbits <= limbBits) {
+				copy_into(bits, limbBits - nbits, aligned);
+			}
+			else {
+				aligned = internal::extract_bits<limbBits>(bits, nbits - limbBits);
+				inexact = anyAfter(bits, int(nbits - limbBits) - 1);
 			}
-			return running;
+			for (size_t i = 0; i < N; ++i) limbs[i] = aligned.block(i);
+			return inexact;
+		}
+
+		// assemble a bitblock from an array of 64-bit limbs, least significant limb first
+		template<size_t nbits, size_t N>
+		bitblock<nbits> limbs_to_bitblock(const uint64_t (&limbs)[N]) {
+			bitblock<nbits> bits;
+			for (size_t i = 0; i < N && i < bitblock<nbits>::nrBlocks; ++i) bits.setblock(i, limbs[i]);
+			return bits;
 		}
 
 	} // namespace unum
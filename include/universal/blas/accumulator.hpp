@@ -0,0 +1,114 @@
+#pragma once
+// accumulator.hpp: dot product accumulators for the BLAS kernels
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// capacity bits of the quires of the BLAS kernels
+constexpr size_t default_quire_capacity = 30;
+
+// accumulation of a sum of products:
+// rounded rounds every product and every partial sum in the number system of the operands,
+// fused collects the sum in a dot_accumulator, which for posits is a quire that rounds once
+enum class accumulation { rounded, fused };
+
+// dot_accumulator collects a sum of products and returns it in the number system of the operands.
+// Native types round every product and every sum: the accumulator is the sum itself.
+template<typename Scalar>
+class dot_accumulator {
+public:
+	dot_accumulator() : _sum(0) {}
+
+	void reset() { _sum = Scalar(0); }
+	void load(const Scalar& init) { _sum = init; }
+	void mac(const Scalar& a, const Scalar& b) { _sum += a * b; }
+	void msc(const Scalar& a, const Scalar& b) { _sum -= a * b; }
+	void add(const dot_accumulator& other) { _sum += other._sum; }
+	Scalar value() const { return _sum; }
+
+private:
+	Scalar _sum;
+};
+
+// Posits accumulate the exact products in a quire and round once when the value is read.
+// A NaR operand makes the value NaR.
+template<size_t nbits, size_t es>
+class dot_accumulator< posit<nbits, es> > {
+public:
+	dot_accumulator() : _nar(false) {}
+
+	void reset() { _q.reset(); _nar = false; }
+	void load(const posit<nbits, es>& init) {
+		reset();
+		if (init.isnar()) _nar = true; else _q = init;
+	}
+	void mac(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		if (a.isnar() || b.isnar()) _nar = true; else _q.mac(a, b);
+	}
+	void msc(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		if (a.isnar() || b.isnar()) _nar = true; else _q.msc(a, b);
+	}
+	// merge the sum of another accumulator: the quires add exactly
+	void add(const dot_accumulator& other) {
+		_nar = _nar || other._nar;
+		_q += other._q;
+	}
+	posit<nbits, es> value() const {
+		posit<nbits, es> p;
+		if (_nar) p.setnar(); else convert(_q.to_value(), p);   // one and only rounding step
+		return p;
+	}
+
+private:
+	quire<nbits, es, default_quire_capacity> _q;
+	bool _nar;
+};
+
+// Fixed-point products are exact in twice the bits, so a fixpnt accumulates the unrounded products in a
+// two's complement integer of 2 * nbits + capacity bits with 2 * rbits fraction bits, and rounds once.
+// Saturating fixpnts saturate the rounded sum, modulo fixpnts keep its lower nbits.
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
+class dot_accumulator< fixpnt<nbits, rbits, arithmetic, BlockType> > {
+public:
+	typedef fixpnt<nbits, rbits, arithmetic, BlockType> Fixpnt;
+	typedef blockbinary<2 * nbits + default_quire_capacity, BlockType> Accumulator;
+
+	void reset() { _sum.clear(); }
+	void load(const Fixpnt& init) {
+		_sum = Accumulator(init.getbb());    // sign extended
+		_sum <<= long(rbits);                // align to the 2 * rbits fraction bits of the products
+	}
+	void mac(const Fixpnt& a, const Fixpnt& b) { _sum += Accumulator(urmul2(a.getbb(), b.getbb())); }
+	void msc(const Fixpnt& a, const Fixpnt& b) { _sum -= Accumulator(urmul2(a.getbb(), b.getbb())); }
+	void add(const dot_accumulator& other) { _sum += other._sum; }
+	Fixpnt value() const {
+		Accumulator c(_sum);
+		bool roundUp = c.roundingMode(rbits);
+		c >>= long(rbits);
+		if (roundUp) ++c;
+		Fixpnt f;
+		if (arithmetic == Saturating) {
+			Accumulator largest(maxpos_fixpnt<nbits, rbits, arithmetic, BlockType>().getbb());
+			Accumulator smallest(maxneg_fixpnt<nbits, rbits, arithmetic, BlockType>().getbb());
+			if (largest < c) c = largest;
+			if (c < smallest) c = smallest;
+		}
+		f = c;   // the lower nbits
+		return f;
+	}
+
+private:
+	Accumulator _sum;
+};
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,115 @@
+#pragma once
+// cg.hpp: preconditioned conjugate gradient solver with fused inner products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include "dot.hpp"
+#include "gemv.hpp"
+#include "sparse.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// preconditioner of the conjugate gradient iteration: jacobi divides the residual by the diagonal of A
+enum class preconditioner { none, jacobi };
+
+struct cg_options {
+	preconditioner precond = preconditioner::jacobi;
+	double tolerance = 1.0e-6;                          // on the residual norm relative to the norm of b
+	size_t max_iterations = 1000;
+	accumulation inner_products = accumulation::fused;  // fused inner products round once, for posits in a quire
+	unsigned threads = 0;                               // 0 selects the hardware concurrency of the host
+};
+
+struct cg_result {
+	bool   converged;     // the relative residual reached the tolerance
+	size_t iterations;
+	double residual;      // the norm of the recursively updated residual relative to the norm of b
+};
+
+namespace internal {
+
+// conjugate gradients for the symmetric positive definite operator apply(p, Ap), with the diagonal of A for jacobi
+template<typename Scalar, typename Operator>
+cg_result pcg(Operator apply, const std::vector<Scalar>& diag, const std::vector<Scalar>& b, std::vector<Scalar>& x, const cg_options& options) {
+	size_t n = b.size();
+	cg_result result = { false, 0, 0.0 };
+	if (x.size() != n) x.assign(n, Scalar(0));
+	accumulation acc = options.inner_products;
+	unsigned nrThreads = options.threads;
+
+	auto precondition = [&](const std::vector<Scalar>& r, std::vector<Scalar>& z) {
+		for (size_t i = 0; i < n; ++i) {
+			z[i] = r[i];
+			if (options.precond == preconditioner::jacobi && diag[i] != Scalar(0)) z[i] /= diag[i];
+		}
+	};
+
+	std::vector<Scalar> r(n), z(n), p(n), Ap(n);
+	apply(x, Ap);
+	for (size_t i = 0; i < n; ++i) r[i] = b[i] - Ap[i];
+	double bnorm = double(norm(b, acc, nrThreads));
+	if (bnorm == 0.0) {
+		x.assign(n, Scalar(0));
+		result.converged = true;
+		return result;
+	}
+	result.residual = double(norm(r, acc, nrThreads)) / bnorm;
+	precondition(r, z);
+	p = z;
+	Scalar rz = dot(r, z, acc, nrThreads);
+	while (result.residual > options.tolerance && result.iterations < options.max_iterations) {
+		apply(p, Ap);
+		Scalar pAp = dot(p, Ap, acc, nrThreads);
+		if (pAp == Scalar(0)) break;   // breakdown: the operator is not positive definite in this precision
+		Scalar alpha = rz / pAp;
+		for (size_t i = 0; i < n; ++i) {
+			x[i] += alpha * p[i];
+			r[i] -= alpha * Ap[i];
+		}
+		++result.iterations;
+		result.residual = double(norm(r, acc, nrThreads)) / bnorm;
+		precondition(r, z);
+		Scalar rzNext = dot(r, z, acc, nrThreads);
+		Scalar beta = rzNext / rz;
+		rz = rzNext;
+		for (size_t i = 0; i < n; ++i) p[i] = z[i] + beta * p[i];
+	}
+	result.converged = (result.residual <= options.tolerance);
+	return result;
+}
+
+} // namespace internal
+
+// cg solves A * x = b for a symmetric positive definite sparse matrix A with the conjugate gradient method.
+// x holds the initial guess on entry, where an empty x starts from zero, and the solution on exit.
+// The inner products and norms go through dot, so for posits through the fused dot products of fdp.hpp.
+template<typename Scalar>
+cg_result cg(const sparse_matrix<Scalar>& A, const std::vector<Scalar>& b, std::vector<Scalar>& x, const cg_options& options = cg_options()) {
+	if (A.rows() != A.cols() || b.size() != A.rows()) throw std::invalid_argument("cg: A must be square and match b");
+	std::vector<Scalar> diag(A.rows(), Scalar(0));
+	for (size_t k = 0; k < A.major(); ++k) {
+		for (size_t e = A.ptr()[k]; e < A.ptr()[k + 1]; ++e) if (A.index()[e] == k) diag[k] = A.value()[e];
+	}
+	auto apply = [&](const std::vector<Scalar>& v, std::vector<Scalar>& Av) { spmv(A, v, Av, options.inner_products, options.threads); };
+	return internal::pcg(apply, diag, b, x, options);
+}
+
+// cg for a dense, symmetric positive definite, n x n row-major matrix A
+template<typename Scalar>
+cg_result cg(size_t n, const std::vector<Scalar>& A, const std::vector<Scalar>& b, std::vector<Scalar>& x, const cg_options& options = cg_options()) {
+	if (A.size() != n * n || b.size() != n) throw std::invalid_argument("cg: A must be n x n and match b");
+	std::vector<Scalar> diag(n);
+	for (size_t i = 0; i < n; ++i) diag[i] = A[i * n + i];
+	auto apply = [&](const std::vector<Scalar>& v, std::vector<Scalar>& Av) { gemv(matrix_layout::row_major, n, n, A, v, Av, options.inner_products, options.threads); };
+	return internal::pcg(apply, diag, b, x, options);
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
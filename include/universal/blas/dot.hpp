@@ -0,0 +1,49 @@
+#pragma once
+// dot.hpp: inner products and norms of vectors
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "accumulator.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// dot returns the inner product of x and y: fused accumulation collects the products in a dot_accumulator
+template<typename Scalar>
+Scalar dot(const std::vector<Scalar>& x, const std::vector<Scalar>& y, accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	size_t n = std::min(x.size(), y.size());
+	if (acc == accumulation::fused) {
+		dot_accumulator<Scalar> sum;
+		for (size_t i = 0; i < n; ++i) sum.mac(x[i], y[i]);
+		return sum.value();
+	}
+	Scalar sum(0);
+	for (size_t i = 0; i < n; ++i) sum += x[i] * y[i];
+	return sum;
+}
+
+// posit vectors take the fused dot product of fdp.hpp, split over nrThreads threads
+template<size_t nbits, size_t es>
+posit<nbits, es> dot(const std::vector< posit<nbits, es> >& x, const std::vector< posit<nbits, es> >& y, accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	if (acc == accumulation::fused) return fdp_parallel<std::vector< posit<nbits, es> >, default_quire_capacity>(x, y, nrThreads);
+	size_t n = std::min(x.size(), y.size());
+	posit<nbits, es> sum(0);
+	for (size_t i = 0; i < n; ++i) sum += x[i] * y[i];
+	return sum;
+}
+
+// norm returns the Euclidean norm of x, the square root of its inner product with itself
+template<typename Scalar>
+Scalar norm(const std::vector<Scalar>& x, accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	using std::sqrt;
+	return sqrt(dot(x, x, acc, nrThreads));
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,162 @@
+#pragma once
+// gemm.hpp: cache-blocked matrix-matrix multiplication of posit matrices with quire accumulation
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <universal/posit/posit>
+#include "accumulator.hpp"
+#include "parallel.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// gemm computes C = A * B for row-major posit matrices: A is m x k, B is k x n, and C is m x n,
+// with leading dimensions lda, ldb, and ldc. Each element of C is the fused dot product of a row of A
+// and a column of B: the products are accumulated exactly in a quire and rounded once.
+//
+// The kernel computes C in tiles of gemm_tile_rows x gemm_tile_cols elements, with one quire per element
+// of the tile. A block of gemm_block_cols columns of B, in panels of gemm_panel_depth elements, and the rows
+// of A of a tile are decoded into (sign, scale, significand) triples when they are packed, so that the inner
+// loop only multiplies integer significands and adds the products into the quire limbs. Each block of B is
+// packed once per thread and shared by all the row tiles of the thread. The row tiles are distributed
+// over nrThreads threads, where 0 selects the hardware concurrency of the host.
+// A row of A or a column of B that contains NaR makes the elements of C it contributes to NaR.
+// Posits wider than 64 bits accumulate with quire::mac on the posits themselves.
+
+constexpr size_t gemm_tile_rows   = 16;    // rows of C, and of A, in a tile
+constexpr size_t gemm_tile_cols   = 16;    // columns of C, and of B, in a tile
+constexpr size_t gemm_panel_depth = 256;   // elements of a column of B in a packed panel
+constexpr size_t gemm_block_cols  = 256;   // columns of B packed and decoded at once, and reused by all row tiles
+
+// a posit decoded for the quire: zero and NaR have a zero significand, which adds nothing to the quire
+struct decoded_posit {
+	uint64_t significand;   // hidden bit at bit 63
+	int32_t  scale;
+	uint32_t sign;
+};
+
+template<size_t nbits, size_t es>
+inline decoded_posit decode_posit(const posit<nbits, es>& p) {
+	decoded_posit d = { 0, 0, 0 };
+	if (p.iszero() || p.isnar()) return d;
+	bool sign;
+	int scale;
+	uint64_t significand;
+	word_decode<nbits, es>(uint64_t(p.encoding()), sign, scale, significand);
+	d.significand = significand;
+	d.scale = scale;
+	d.sign = sign ? 1 : 0;
+	return d;
+}
+
+namespace internal {
+
+// rows [first, last) of C, in the loop order of BLIS: a block of gemm_block_cols columns of B is packed and
+// decoded once, and then reused by all the row tiles of the thread
+template<size_t nbits, size_t es, size_t capacity>
+void gemm_rows(std::true_type, size_t first, size_t last, size_t n, size_t k,
+               const posit<nbits, es>* A, size_t lda, const posit<nbits, es>* B, size_t ldb, posit<nbits, es>* C, size_t ldc) {
+	using Quire = quire<nbits, es, capacity>;
+	std::vector<decoded_posit> a(gemm_tile_rows * k);                   // rows of the tile, row-major
+	std::vector<decoded_posit> b(gemm_block_cols * k);                  // columns of the block, panel by panel
+	std::vector<Quire> tile(gemm_tile_rows * gemm_tile_cols);
+	std::vector<char> rowNaR(gemm_tile_rows), colNaR(gemm_block_cols);
+	for (size_t jc = 0; jc < n; jc += gemm_block_cols) {
+		size_t nc = std::min(gemm_block_cols, n - jc);
+		// panel p0 of the block holds kr elements of each of its nc columns, column-major, at offset p0 * nc
+		for (size_t j = 0; j < nc; ++j) colNaR[j] = 0;
+		for (size_t p0 = 0; p0 < k; p0 += gemm_panel_depth) {
+			size_t kr = std::min(gemm_panel_depth, k - p0);
+			decoded_posit* panel = &b[p0 * nc];
+			for (size_t p = 0; p < kr; ++p) {
+				const posit<nbits, es>* row = B + (p0 + p) * ldb + jc;
+				for (size_t j = 0; j < nc; ++j) {
+					if (row[j].isnar()) colNaR[j] = 1;
+					panel[j * kr + p] = decode_posit(row[j]);
+				}
+			}
+		}
+		for (size_t i0 = first; i0 < last; i0 += gemm_tile_rows) {
+			size_t mr = std::min(gemm_tile_rows, last - i0);
+			for (size_t i = 0; i < mr; ++i) {
+				rowNaR[i] = 0;
+				for (size_t p = 0; p < k; ++p) {
+					const posit<nbits, es>& x = A[(i0 + i) * lda + p];
+					if (x.isnar()) rowNaR[i] = 1;
+					a[i * k + p] = decode_posit(x);
+				}
+			}
+			for (size_t j0 = 0; j0 < nc; j0 += gemm_tile_cols) {
+				size_t nr = std::min(gemm_tile_cols, nc - j0);
+				for (Quire& q : tile) q.reset();
+				for (size_t p0 = 0; p0 < k; p0 += gemm_panel_depth) {
+					size_t kr = std::min(gemm_panel_depth, k - p0);
+					const decoded_posit* panel = &b[p0 * nc];
+					for (size_t i = 0; i < mr; ++i) {
+						const decoded_posit* ai = &a[i * k + p0];
+						for (size_t j = 0; j < nr; ++j) {
+							const decoded_posit* bj = &panel[(j0 + j) * kr];
+							Quire& q = tile[i * gemm_tile_cols + j];
+							for (size_t p = 0; p < kr; ++p) {
+								q.mac(ai[p].sign != bj[p].sign, ai[p].scale + bj[p].scale, ai[p].significand, bj[p].significand);
+							}
+						}
+					}
+				}
+				for (size_t i = 0; i < mr; ++i) {
+					for (size_t j = 0; j < nr; ++j) {
+						posit<nbits, es>& c = C[(i0 + i) * ldc + jc + j0 + j];
+						if (rowNaR[i] || colNaR[j0 + j]) c.setnar(); else convert(tile[i * gemm_tile_cols + j].to_value(), c);
+					}
+				}
+			}
+		}
+	}
+}
+
+// rows [first, last) of C for posits that the word engine does not decode
+template<size_t nbits, size_t es, size_t capacity>
+void gemm_rows(std::false_type, size_t first, size_t last, size_t n, size_t k,
+               const posit<nbits, es>* A, size_t lda, const posit<nbits, es>* B, size_t ldb, posit<nbits, es>* C, size_t ldc) {
+	for (size_t i = first; i < last; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			quire<nbits, es, capacity> q;
+			bool nar = false;
+			for (size_t p = 0; p < k; ++p) {
+				const posit<nbits, es>& x = A[i * lda + p];
+				const posit<nbits, es>& y = B[p * ldb + j];
+				if (x.isnar() || y.isnar()) nar = true; else q.mac(x, y);
+			}
+			if (nar) C[i * ldc + j].setnar(); else convert(q.to_value(), C[i * ldc + j]);
+		}
+	}
+}
+
+} // namespace internal
+
+// C = A * B
+template<size_t nbits, size_t es, size_t capacity = default_quire_capacity>
+void gemm(size_t m, size_t n, size_t k, const posit<nbits, es>* A, size_t lda, const posit<nbits, es>* B, size_t ldb, posit<nbits, es>* C, size_t ldc, unsigned nrThreads = 0) {
+	using decodable = std::integral_constant<bool, (nbits <= 64)>;
+	// contiguous ranges of row tiles per thread
+	parallel_rows(m, gemm_tile_rows, gemm_tile_rows, nrThreads, [=](size_t first, size_t last) {
+		internal::gemm_rows<nbits, es, capacity>(decodable(), first, last, n, k, A, lda, B, ldb, C, ldc);
+	});
+}
+
+// convenience overload for dense row-major matrices held in vectors: C is resized to m x n
+template<size_t nbits, size_t es, size_t capacity = default_quire_capacity>
+void gemm(size_t m, size_t n, size_t k, const std::vector< posit<nbits, es> >& A, const std::vector< posit<nbits, es> >& B, std::vector< posit<nbits, es> >& C, unsigned nrThreads = 0) {
+	C.resize(m * n);
+	gemm<nbits, es, capacity>(m, n, k, A.data(), k, B.data(), n, C.data(), n, nrThreads);
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,139 @@
+#pragma once
+// gemv.hpp: matrix-vector product and rank-1 update with quire accumulation
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "accumulator.hpp"
+#include "parallel.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// storage order of a dense matrix with leading dimension ld:
+// row_major stores element (i,j) at A[i * ld + j], column_major at A[i + j * ld]
+enum class matrix_layout { row_major, column_major };
+
+// minimum number of matrix elements a thread is started for
+constexpr size_t level2_elements_per_thread = 16384;
+
+namespace internal {
+
+inline size_t level2_min_rows(size_t n) {
+	return std::max(size_t(1), level2_elements_per_thread / std::max(size_t(1), n));
+}
+
+// rows [first, last) of y = A * x
+template<typename Scalar>
+void gemv_rows(matrix_layout layout, accumulation acc, size_t first, size_t last, size_t n,
+               const Scalar* A, size_t lda, const Scalar* x, Scalar* y) {
+	if (layout == matrix_layout::row_major) {
+		// a dot product per row: for posits the fused dot product of fdp.hpp
+		for (size_t i = first; i < last; ++i) {
+			const Scalar* row = A + i * lda;
+			if (acc == accumulation::fused) {
+				dot_accumulator<Scalar> sum;
+				for (size_t j = 0; j < n; ++j) sum.mac(row[j], x[j]);
+				y[i] = sum.value();
+			}
+			else {
+				Scalar sum(0);
+				for (size_t j = 0; j < n; ++j) sum += row[j] * x[j];
+				y[i] = sum;
+			}
+		}
+	}
+	else {
+		// an axpy per column, restricted to the rows of this range
+		if (acc == accumulation::fused) {
+			std::vector< dot_accumulator<Scalar> > sum(last - first);
+			for (size_t j = 0; j < n; ++j) {
+				const Scalar* column = A + j * lda;
+				for (size_t i = first; i < last; ++i) sum[i - first].mac(column[i], x[j]);
+			}
+			for (size_t i = first; i < last; ++i) y[i] = sum[i - first].value();
+		}
+		else {
+			for (size_t i = first; i < last; ++i) y[i] = Scalar(0);
+			for (size_t j = 0; j < n; ++j) {
+				const Scalar* column = A + j * lda;
+				for (size_t i = first; i < last; ++i) y[i] += column[i] * x[j];
+			}
+		}
+	}
+}
+
+// rows [first, last) of A += x * y^T
+template<typename Scalar>
+void ger_rows(matrix_layout layout, accumulation acc, size_t first, size_t last, size_t n,
+              const Scalar* x, const Scalar* y, Scalar* A, size_t lda) {
+	auto update = [acc](Scalar& a, const Scalar& u, const Scalar& v) {
+		if (acc == accumulation::fused) {
+			dot_accumulator<Scalar> sum;   // fused multiply-add: a + u * v rounded once
+			sum.load(a);
+			sum.mac(u, v);
+			a = sum.value();
+		}
+		else {
+			a += u * v;
+		}
+	};
+	if (layout == matrix_layout::row_major) {
+		for (size_t i = first; i < last; ++i) {
+			Scalar* row = A + i * lda;
+			for (size_t j = 0; j < n; ++j) update(row[j], x[i], y[j]);
+		}
+	}
+	else {
+		for (size_t j = 0; j < n; ++j) {
+			Scalar* column = A + j * lda;
+			for (size_t i = first; i < last; ++i) update(column[i], x[i], y[j]);
+		}
+	}
+}
+
+} // namespace internal
+
+// gemv computes y = A * x for an m x n matrix A with leading dimension lda.
+// The rows of y are distributed over nrThreads threads, where 0 selects the hardware concurrency of the host.
+// With fused accumulation every element of y is rounded once, independent of the layout and the number of threads.
+template<typename Scalar>
+void gemv(matrix_layout layout, size_t m, size_t n, const Scalar* A, size_t lda, const Scalar* x, Scalar* y,
+          accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	parallel_rows(m, 1, internal::level2_min_rows(n), nrThreads, [=](size_t first, size_t last) {
+		internal::gemv_rows(layout, acc, first, last, n, A, lda, x, y);
+	});
+}
+
+// convenience overload for a dense matrix held in a vector: y is resized to m elements
+template<typename Scalar>
+void gemv(matrix_layout layout, size_t m, size_t n, const std::vector<Scalar>& A, const std::vector<Scalar>& x, std::vector<Scalar>& y,
+          accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	y.resize(m);
+	gemv(layout, m, n, A.data(), (layout == matrix_layout::row_major ? n : m), x.data(), y.data(), acc, nrThreads);
+}
+
+// ger computes the rank-1 update A += x * y^T for an m x n matrix A with leading dimension lda.
+// With fused accumulation every element of A is updated with a single rounding.
+template<typename Scalar>
+void ger(matrix_layout layout, size_t m, size_t n, const Scalar* x, const Scalar* y, Scalar* A, size_t lda,
+         accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	parallel_rows(m, 1, internal::level2_min_rows(n), nrThreads, [=](size_t first, size_t last) {
+		internal::ger_rows(layout, acc, first, last, n, x, y, A, lda);
+	});
+}
+
+// convenience overload for a dense matrix held in a vector
+template<typename Scalar>
+void ger(matrix_layout layout, size_t m, size_t n, const std::vector<Scalar>& x, const std::vector<Scalar>& y, std::vector<Scalar>& A,
+         accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	ger(layout, m, n, x.data(), y.data(), A.data(), (layout == matrix_layout::row_major ? n : m), acc, nrThreads);
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,178 @@
+#pragma once
+// lu.hpp: LU factorization with partial pivoting and mixed-precision iterative refinement
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include "accumulator.hpp"
+#include "parallel.hpp"
+#include "trsv.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// columns of the panels of the blocked factorization
+constexpr size_t lu_panel_width = 32;
+
+// lu factors the n x n row-major matrix A in place into P * A = L * U, with L unit lower triangular and
+// U upper triangular, and returns false when a pivot is zero.
+// At step j row j was swapped with row piv[j], the row of the largest candidate pivot.
+//
+// The factorization is left-looking and blocked by panels of lu_panel_width columns. Each element of
+// a panel keeps a dot_accumulator that starts at A_ij and collects the products of L and U to its left,
+// so for posits every element of L and U is computed from a residual that is exact and rounded once:
+// U_ij = A_ij - sum(L_ip * U_pj), and L_ij = (A_ij - sum(L_ip * U_pj)) / U_jj.
+// The products with the columns left of the panel are accumulated in parallel over the rows on nrThreads
+// threads, where 0 selects the hardware concurrency of the host.
+template<typename Scalar>
+bool lu(size_t n, std::vector<Scalar>& A, std::vector<size_t>& piv, unsigned nrThreads = 0) {
+	piv.resize(n);
+	bool nonsingular = true;
+	std::vector< dot_accumulator<Scalar> > panel(n * lu_panel_width);
+	Scalar* a = A.data();
+	dot_accumulator<Scalar>* acc = panel.data();
+	for (size_t j0 = 0; j0 < n; j0 += lu_panel_width) {
+		size_t j1 = std::min(n, j0 + lu_panel_width);
+		size_t w = j1 - j0;
+		// rows above the panel are rows of U: U_ic = A_ic - sum(L_ip * U_pc) for p < i, independent per column
+		parallel_rows(w, 1, 1, (j0 * j0 * w < 2 * level2_elements_per_thread) ? 1 : nrThreads, [=](size_t first, size_t last) {
+			for (size_t c = first; c < last; ++c) {
+				for (size_t i = 0; i < j0; ++i) {
+					dot_accumulator<Scalar>& u = acc[i * w + c];
+					u.load(a[i * n + j0 + c]);
+					for (size_t p = 0; p < i; ++p) u.msc(a[i * n + p], a[p * n + j0 + c]);
+					a[i * n + j0 + c] = u.value();
+				}
+			}
+		});
+		// products of the rows of L with the rows of U above the panel
+		parallel_rows(n - j0, 1, internal::level2_min_rows(j0 * w), nrThreads, [=](size_t first, size_t last) {
+			for (size_t i = j0 + first; i < j0 + last; ++i) {
+				dot_accumulator<Scalar>* row = acc + i * w;
+				for (size_t c = 0; c < w; ++c) row[c].load(a[i * n + j0 + c]);
+				for (size_t p = 0; p < j0; ++p) {
+					const Scalar& l = a[i * n + p];
+					for (size_t c = 0; c < w; ++c) row[c].msc(l, a[p * n + j0 + c]);
+				}
+			}
+		});
+		// factor the panel column by column
+		for (size_t j = j0; j < j1; ++j) {
+			size_t c = j - j0;
+			for (size_t i = j0; i < n; ++i) {
+				size_t depth = std::min(i, j);
+				for (size_t p = j0; p < depth; ++p) acc[i * w + c].msc(a[i * n + p], a[p * n + j]);
+				a[i * n + j] = acc[i * w + c].value();   // rows above j are U, the others pivot candidates
+			}
+			size_t pivot = j;
+			Scalar largest = (a[j * n + j] < Scalar(0)) ? -a[j * n + j] : a[j * n + j];
+			for (size_t i = j + 1; i < n; ++i) {
+				Scalar magnitude = (a[i * n + j] < Scalar(0)) ? -a[i * n + j] : a[i * n + j];
+				if (largest < magnitude) {
+					largest = magnitude;
+					pivot = i;
+				}
+			}
+			piv[j] = pivot;
+			if (pivot != j) {
+				std::swap_ranges(a + j * n, a + (j + 1) * n, a + pivot * n);
+				std::swap_ranges(acc + j * w, acc + (j + 1) * w, acc + pivot * w);
+			}
+			if (a[j * n + j] == Scalar(0)) {
+				nonsingular = false;
+				continue;
+			}
+			for (size_t i = j + 1; i < n; ++i) a[i * n + j] /= a[j * n + j];
+		}
+	}
+	return nonsingular;
+}
+
+// lu_solve solves A * x = b with the factorization of lu: x holds b on entry and the solution on exit
+template<typename Scalar>
+void lu_solve(size_t n, const std::vector<Scalar>& LU, const std::vector<size_t>& piv, std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	for (size_t j = 0; j < n; ++j) if (piv[j] != j) std::swap(x[j], x[piv[j]]);
+	trsv(matrix_layout::row_major, triangle::lower, diagonal::unit, n, LU.data(), n, x.data(), nrThreads);
+	trsv(matrix_layout::row_major, triangle::upper, diagonal::non_unit, n, LU.data(), n, x.data(), nrThreads);
+}
+
+// outcome of a refined solve
+struct refinement_result {
+	bool   converged;     // the last correction was within the tolerance
+	size_t iterations;    // refinement steps taken
+};
+
+// refined_solve solves A * x = b for an n x n row-major matrix A in the working precision High:
+// A is factored once in the lower precision Low, and the solution is refined with the residuals
+// r = b - A * x, which are accumulated in a dot_accumulator of High, so for posits in a quire, and rounded once.
+// Every step scales the residual by a power of 2 to the magnitude of one, where the tapered precision
+// of a posit is largest, solves for the correction with the factors of Low, and adds it to x in High.
+// The refinement stops when the largest correction is at most tolerance times the largest element of x,
+// when the correction no longer changes x, or after maxIterations steps.
+// The values move between the precisions through double, which represents the corrections of Low exactly.
+template<typename Low, typename High>
+refinement_result refined_solve(size_t n, const std::vector<High>& A, const std::vector<High>& b, std::vector<High>& x,
+                                double tolerance, size_t maxIterations = 20, unsigned nrThreads = 0) {
+	refinement_result result = { false, 0 };
+	std::vector<Low> LU(n * n), d(n);
+	std::vector<size_t> piv;
+	for (size_t i = 0; i < n * n; ++i) LU[i] = Low(double(A[i]));
+	if (!lu(n, LU, piv, nrThreads)) return result;
+	for (size_t i = 0; i < n; ++i) d[i] = Low(double(b[i]));
+	lu_solve(n, LU, piv, d, nrThreads);
+	x.resize(n);
+	for (size_t i = 0; i < n; ++i) x[i] = High(double(d[i]));
+
+	std::vector<double> residual(n);
+	const High* a = A.data();
+	const High* bb = b.data();
+	const High* xx = x.data();
+	double* rr = residual.data();
+	while (result.iterations < maxIterations) {
+		// the residual in the working precision, rounded once
+		parallel_rows(n, 1, internal::level2_min_rows(n), nrThreads, [=](size_t first, size_t last) {
+			for (size_t i = first; i < last; ++i) {
+				dot_accumulator<High> r;
+				r.load(bb[i]);
+				for (size_t j = 0; j < n; ++j) r.msc(a[i * n + j], xx[j]);
+				rr[i] = double(r.value());
+			}
+		});
+		double largestResidual = 0.0;
+		for (size_t i = 0; i < n; ++i) largestResidual = std::max(largestResidual, std::abs(rr[i]));
+		if (largestResidual == 0.0) {
+			result.converged = true;
+			break;
+		}
+		// scale the residual to the magnitude of one, where posits have the most precision, by a power of 2
+		double scale = std::ldexp(1.0, -std::ilogb(largestResidual));
+		for (size_t i = 0; i < n; ++i) d[i] = Low(rr[i] * scale);
+		lu_solve(n, LU, piv, d, nrThreads);
+		++result.iterations;
+		double largestCorrection = 0.0, largestElement = 0.0;
+		bool changed = false;
+		for (size_t i = 0; i < n; ++i) {
+			double correction = double(d[i]) / scale;
+			High updated = x[i] + High(correction);
+			if (updated != x[i]) changed = true;
+			x[i] = updated;
+			largestCorrection = std::max(largestCorrection, std::abs(correction));
+			largestElement = std::max(largestElement, std::abs(double(x[i])));
+		}
+		if (!changed || largestCorrection <= tolerance * largestElement) {
+			result.converged = true;
+			break;
+		}
+	}
+	return result;
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,70 @@
+#pragma once
+// matrix_market.hpp: reader of sparse matrices in the Matrix Market exchange format
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cctype>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "sparse.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// read_matrix_market reads a matrix in the coordinate format of the Matrix Market exchange format,
+// with real, integer, or pattern elements, and general, symmetric, or skew-symmetric symmetry.
+// The values are converted from double to Scalar, pattern elements are 1, and the lower triangle of
+// a symmetric matrix is mirrored into the upper triangle. Malformed input throws a std::runtime_error.
+template<typename Scalar>
+sparse_matrix<Scalar> read_matrix_market(std::istream& istr, sparse_format format = sparse_format::csr) {
+	std::string line;
+	if (!std::getline(istr, line)) throw std::runtime_error("matrix market: empty input");
+	std::transform(line.begin(), line.end(), line.begin(), [](char c) { return char(std::tolower(static_cast<unsigned char>(c))); });
+	std::istringstream header(line);
+	std::string banner, object, layout, field, symmetry;
+	header >> banner >> object >> layout >> field >> symmetry;
+	if (banner != "%%matrixmarket" || object != "matrix") throw std::runtime_error("matrix market: missing %%MatrixMarket matrix banner");
+	if (layout != "coordinate") throw std::runtime_error("matrix market: only the coordinate format is supported");
+	bool pattern = (field == "pattern");
+	if (!pattern && field != "real" && field != "integer") throw std::runtime_error("matrix market: unsupported field " + field);
+	bool symmetric = (symmetry == "symmetric");
+	bool skew = (symmetry == "skew-symmetric");
+	if (!symmetric && !skew && symmetry != "general") throw std::runtime_error("matrix market: unsupported symmetry " + symmetry);
+
+	// comment lines start with %
+	do {
+		if (!std::getline(istr, line)) throw std::runtime_error("matrix market: missing size line");
+	} while (line.empty() || line[0] == '%');
+	size_t rows, cols, entries;
+	std::istringstream size(line);
+	if (!(size >> rows >> cols >> entries)) throw std::runtime_error("matrix market: malformed size line");
+
+	std::vector< triplet<Scalar> > elements;
+	elements.reserve((symmetric || skew) ? 2 * entries : entries);
+	for (size_t e = 0; e < entries; ++e) {
+		size_t i, j;
+		double v = 1.0;
+		if (!(istr >> i >> j) || (!pattern && !(istr >> v))) throw std::runtime_error("matrix market: expected " + std::to_string(entries) + " entries");
+		if (i < 1 || i > rows || j < 1 || j > cols) throw std::runtime_error("matrix market: entry outside the matrix");
+		elements.push_back({ i - 1, j - 1, Scalar(v) });
+		if ((symmetric || skew) && i != j) elements.push_back({ j - 1, i - 1, Scalar(skew ? -v : v) });
+	}
+	return sparse_matrix<Scalar>(rows, cols, std::move(elements), format);
+}
+
+// read a Matrix Market file
+template<typename Scalar>
+sparse_matrix<Scalar> read_matrix_market(const std::string& filename, sparse_format format = sparse_format::csr) {
+	std::ifstream istr(filename);
+	if (!istr) throw std::runtime_error("matrix market: cannot open " + filename);
+	return read_matrix_market<Scalar>(istr, format);
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,40 @@
+#pragma once
+// parallel.hpp: distribution of the rows of a BLAS kernel over threads
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// parallel_rows calls kernel(first, last) on contiguous ranges of rows that cover [0, m), one range per thread.
+// The ranges are multiples of grain rows, and a thread is only started when each thread gets at least
+// minRows rows. nrThreads of 0 selects the hardware concurrency of the host.
+// The calling thread computes the first range.
+template<typename Kernel>
+void parallel_rows(size_t m, size_t grain, size_t minRows, unsigned nrThreads, Kernel kernel) {
+	if (m == 0) return;
+	if (grain == 0) grain = 1;
+	size_t nrGrains = (m + grain - 1) / grain;
+	if (nrThreads == 0) nrThreads = std::max(1u, std::thread::hardware_concurrency());
+	size_t maxThreads = std::max(size_t(1), std::min(nrGrains, m / std::max(size_t(1), minRows)));
+	if (nrThreads > maxThreads) nrThreads = unsigned(maxThreads);
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < nrThreads; ++t) {
+		size_t first = std::min(m, (nrGrains * t / nrThreads) * grain);
+		size_t last = std::min(m, (nrGrains * (t + 1) / nrThreads) * grain);
+		workers.emplace_back([=]() { kernel(first, last); });
+	}
+	kernel(0, std::min(m, (nrGrains / nrThreads) * grain));
+	for (std::thread& worker : workers) worker.join();
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,352 @@
+#pragma once
+// reductions.hpp: sums, means, variances, and 2-norms of vectors that do not depend on the number of threads
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <universal/posit/posit>
+#include <universal/float/quire.hpp>     // needs the value and bitblock types of the posit headers
+#include "accumulator.hpp"
+#include "parallel.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// The reductions split a vector over threads and return the same result for any number of threads.
+// Number systems with an exact accumulator, posits with their quire, fixpnts with an exact fixed-point sum,
+// and float and double with the IEEE quire of float/quire.hpp, collect the exact terms in one accumulator
+// per thread, merge the accumulators exactly, and round once. Other types use pairwise summation over blocks
+// of reduction_block_size elements, so the order of the additions only depends on the length of the vector.
+
+// minimum number of elements a thread is started for
+constexpr size_t reduction_elements_per_thread = 16384;
+// number of elements of the blocks of the pairwise summation
+constexpr size_t reduction_block_size = 1024;
+
+namespace internal {
+
+// the significand of a finite, nonzero double as an integer of 53 bits, x = significand 2^(exponent - 52):
+// std::frexp is exact for normal and subnormal values
+inline uint64_t ieee_significand(double x, int& exponent) {
+	double f = std::frexp(std::abs(x), &exponent);
+	--exponent;
+	return uint64_t(std::ldexp(f, 53));
+}
+
+// the value of a finite, nonzero double
+inline value<52> ieee_value(double x) {
+	int exponent;
+	uint64_t significand = ieee_significand(x, exponent);
+	bitblock<52> fraction;
+	fraction = significand & ((uint64_t(1) << 52) - 1);
+	value<52> v;
+	v.set(x < 0, exponent, fraction, false, false);
+	return v;
+}
+
+// the exact product of two finite, nonzero doubles: the 53-bit significands multiply into 106 bits in 32-bit limbs
+inline value<105> ieee_product(double a, double b) {
+	int ea, eb;
+	uint64_t sa = ieee_significand(a, ea), sb = ieee_significand(b, eb);
+	uint64_t a0 = sa & 0xFFFFFFFFu, a1 = sa >> 32, b0 = sb & 0xFFFFFFFFu, b1 = sb >> 32;
+	uint64_t low = a0 * b0, middle1 = a1 * b0, middle2 = a0 * b1, high = a1 * b1;
+	uint64_t carry = (low >> 32) + (middle1 & 0xFFFFFFFFu) + (middle2 & 0xFFFFFFFFu);
+	low = (low & 0xFFFFFFFFu) | (carry << 32);
+	high += (middle1 >> 32) + (middle2 >> 32) + (carry >> 32);
+	int msb = (high >> 41) ? 105 : 104;                  // the product of two significands in [2^52, 2^53)
+	bitblock<105> fraction;
+	for (int i = 0; i < msb; ++i) {
+		fraction[105 - msb + i] = ((i < 64) ? (low >> i) : (high >> (i - 64))) & 1;
+	}
+	value<105> v;
+	v.set((a < 0) != (b < 0), ea + eb + msb - 104, fraction, false, false);
+	return v;
+}
+
+// round a value to the nearest float or double, ties to even, with gradual underflow
+template<typename Real, size_t fbits>
+Real round_to_ieee(const value<fbits>& v) {
+	if (v.iszero()) return Real(0);
+	constexpr int digits = std::numeric_limits<Real>::digits;
+	constexpr int emin = std::numeric_limits<Real>::min_exponent - 1;
+	int scale = v.scale();
+	int unit = std::max(scale, emin) - digits + 1;   // exponent of the last bit of the rounded significand
+	int kept = scale - unit;                         // fraction bits that fit, negative far below the subnormals
+	bitblock<fbits> fraction = v.fraction();
+	uint64_t significand = 0;
+	bool round = false, sticky = false;
+	if (kept >= 0) {
+		significand = 1;
+		for (int i = 0; i < kept; ++i) {
+			int b = int(fbits) - 1 - i;
+			significand = (significand << 1) | ((b >= 0 && fraction[b]) ? 1 : 0);
+		}
+		int r = int(fbits) - 1 - kept;
+		if (r >= 0) {
+			round = fraction[r];
+			for (int i = r - 1; i >= 0 && !sticky; --i) sticky = fraction[i];
+		}
+	}
+	else {
+		round = (kept == -1);                        // the hidden bit is the round bit
+		sticky = (kept < -1) || fraction.any();
+	}
+	if (round && (sticky || (significand & 1))) ++significand;
+	Real r = std::ldexp(Real(significand), unit);   // overflows to infinity
+	return v.sign() ? -r : r;
+}
+
+} // namespace internal
+
+// ieee_accumulator collects exact sums of products of floats or doubles in IEEE quires with one more exponent bit
+// than the operands, which covers the products of all values, subnormals included. The positive and the negative
+// terms go to separate quires, which only add magnitudes: a quire whose sum changes sign borrows through its whole
+// width. Infinities and NaNs are tracked separately and give the IEEE result of the sum.
+template<typename Real>
+class ieee_accumulator {
+public:
+	ieee_accumulator() : _nan(false), _posinf(false), _neginf(false) {}
+
+	void reset() {
+		_positive.reset();
+		_negative.reset();
+		_nan = _posinf = _neginf = false;
+	}
+	void mac(const Real& a, const Real& b) { accumulate(a, b, false); }
+	void msc(const Real& a, const Real& b) { accumulate(a, b, true); }
+	// merge the sums of another accumulator: the quires add exactly
+	void add(const ieee_accumulator& other) {
+		_positive += other._positive;
+		_negative += other._negative;
+		_nan = _nan || other._nan;
+		_posinf = _posinf || other._posinf;
+		_neginf = _neginf || other._neginf;
+	}
+	Real value() const {
+		if (_nan || (_posinf && _neginf)) return std::numeric_limits<Real>::quiet_NaN();
+		if (_posinf) return std::numeric_limits<Real>::infinity();
+		if (_neginf) return -std::numeric_limits<Real>::infinity();
+		return internal::round_to_ieee<Real>(sum().to_value());
+	}
+	// square root of the sum: the exact sum is scaled by an even power of 2 into [1, 4) before it rounds,
+	// so the norms of vectors of tiny or huge values do not underflow or overflow in the sum of squares
+	Real root() const {
+		if (_nan || _neginf) return std::numeric_limits<Real>::quiet_NaN();
+		if (_posinf) return std::numeric_limits<Real>::infinity();
+		auto v = sum().to_value();
+		if (v.iszero()) return Real(0);
+		if (v.sign()) return std::numeric_limits<Real>::quiet_NaN();
+		int k = (v.scale() >= 0) ? v.scale() / 2 : -((1 - v.scale()) / 2);
+		v.set(false, v.scale() - 2 * k, v.fraction(), false, false);
+		return std::ldexp(std::sqrt(internal::round_to_ieee<Real>(v)), k);
+	}
+
+private:
+	using quire_type = sw::ieee::quire<8 * sizeof(Real), (std::numeric_limits<Real>::max_exponent == 128 ? 9 : 12), default_quire_capacity>;
+	quire_type _positive, _negative;
+	bool _nan, _posinf, _neginf;
+
+	quire_type sum() const {
+		quire_type q(_positive);
+		q -= _negative;
+		return q;
+	}
+	void accumulate(Real a, Real b, bool negate) {
+		if (!std::isfinite(a) || !std::isfinite(b)) {
+			Real p = negate ? -(a * b) : a * b;
+			if (std::isnan(p)) _nan = true; else if (p > 0) _posinf = true; else _neginf = true;
+			return;
+		}
+		if (a == Real(0) || b == Real(0)) return;
+		quire_type& q = ((a < 0) != (b < 0)) != negate ? _negative : _positive;
+		if (b == Real(1) || b == Real(-1)) {
+			q += internal::ieee_value(std::abs(double(a)));
+			return;
+		}
+		q += internal::ieee_product(std::abs(double(a)), std::abs(double(b)));
+	}
+};
+
+namespace internal {
+
+// the exact accumulator of a number system, void when it has none
+template<typename Scalar>
+struct exact_accumulator { using type = void; };
+template<size_t nbits, size_t es>
+struct exact_accumulator< posit<nbits, es> > { using type = dot_accumulator< posit<nbits, es> >; };
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
+struct exact_accumulator< fixpnt<nbits, rbits, arithmetic, BlockType> > { using type = dot_accumulator< fixpnt<nbits, rbits, arithmetic, BlockType> >; };
+template<>
+struct exact_accumulator<float> { using type = ieee_accumulator<float>; };
+template<>
+struct exact_accumulator<double> { using type = ieee_accumulator<double>; };
+
+template<typename Scalar>
+using has_exact_accumulator = std::integral_constant<bool, !std::is_void<typename exact_accumulator<Scalar>::type>::value>;
+
+// collect term(accumulator, i) for i in [0, n) in one accumulator per thread and merge the accumulators
+template<typename Accumulator, typename Term>
+Accumulator exact_reduce(size_t n, unsigned nrThreads, Term term) {
+	Accumulator total;
+	std::mutex merge;
+	parallel_rows(n, 1, reduction_elements_per_thread, nrThreads, [&](size_t first, size_t last) {
+		Accumulator partial;
+		for (size_t i = first; i < last; ++i) term(partial, i);
+		std::lock_guard<std::mutex> lock(merge);
+		total.add(partial);
+	});
+	return total;
+}
+
+// sum of term(i) for i in [first, last), split in halves down to eight terms
+template<typename Scalar, typename Term>
+Scalar pairwise_sum(size_t first, size_t last, Term term) {
+	if (last - first <= 8) {
+		Scalar sum(0);
+		for (size_t i = first; i < last; ++i) sum += term(i);
+		return sum;
+	}
+	size_t middle = first + (last - first) / 2;
+	return pairwise_sum<Scalar>(first, middle, term) + pairwise_sum<Scalar>(middle, last, term);
+}
+
+// pairwise sums of the blocks of reduction_block_size terms, spread over threads, and the pairwise sum of the blocks
+template<typename Scalar, typename Term>
+Scalar pairwise_reduce(size_t n, unsigned nrThreads, Term term) {
+	size_t nrBlocks = (n + reduction_block_size - 1) / reduction_block_size;
+	std::vector<Scalar> blocks(nrBlocks);
+	size_t minBlocks = std::max(size_t(1), reduction_elements_per_thread / reduction_block_size);
+	parallel_rows(nrBlocks, 1, minBlocks, nrThreads, [&](size_t first, size_t last) {
+		for (size_t b = first; b < last; ++b) {
+			blocks[b] = pairwise_sum<Scalar>(b * reduction_block_size, std::min(n, (b + 1) * reduction_block_size), term);
+		}
+	});
+	return pairwise_sum<Scalar>(0, nrBlocks, [&](size_t b) { return blocks[b]; });
+}
+
+template<typename Scalar>
+Scalar sum(const std::vector<Scalar>& x, unsigned nrThreads, std::true_type) {
+	using Accumulator = typename exact_accumulator<Scalar>::type;
+	Scalar one(1);
+	return exact_reduce<Accumulator>(x.size(), nrThreads, [&](Accumulator& acc, size_t i) { acc.mac(x[i], one); }).value();
+}
+template<typename Scalar>
+Scalar sum(const std::vector<Scalar>& x, unsigned nrThreads, std::false_type) {
+	return pairwise_reduce<Scalar>(x.size(), nrThreads, [&](size_t i) { return x[i]; });
+}
+
+// With an exact accumulator the mean is refined with the exact sum of the deviations from the first estimate:
+// the sum rounds in Scalar, and a posit keeps few fraction bits for the large sum of many elements.
+template<typename Scalar>
+Scalar mean(const std::vector<Scalar>& x, unsigned nrThreads, std::true_type) {
+	using Accumulator = typename exact_accumulator<Scalar>::type;
+	Scalar n(double(x.size())), one(1);
+	Scalar m = sum(x, nrThreads, std::true_type()) / n;
+	Scalar deviations = exact_reduce<Accumulator>(x.size(), nrThreads, [&](Accumulator& acc, size_t i) {
+		acc.mac(x[i], one);
+		acc.msc(m, one);
+	}).value();
+	return m + deviations / n;
+}
+template<typename Scalar>
+Scalar mean(const std::vector<Scalar>& x, unsigned nrThreads, std::false_type) {
+	return sum(x, nrThreads, std::false_type()) / Scalar(double(x.size()));
+}
+
+// square root of the sum of an accumulator
+template<typename Accumulator>
+auto root(const Accumulator& acc) -> decltype(acc.value()) {
+	using std::sqrt;
+	return sqrt(acc.value());
+}
+template<typename Real>
+Real root(const ieee_accumulator<Real>& acc) {
+	return acc.root();
+}
+
+template<typename Scalar>
+Scalar nrm2(const std::vector<Scalar>& x, unsigned nrThreads, std::true_type) {
+	using Accumulator = typename exact_accumulator<Scalar>::type;
+	return root(exact_reduce<Accumulator>(x.size(), nrThreads, [&](Accumulator& acc, size_t i) { acc.mac(x[i], x[i]); }));
+}
+template<typename Scalar>
+Scalar nrm2(const std::vector<Scalar>& x, unsigned nrThreads, std::false_type) {
+	using std::sqrt;
+	return sqrt(pairwise_reduce<Scalar>(x.size(), nrThreads, [&](size_t i) { return Scalar(x[i] * x[i]); }));
+}
+
+// the sum of squares and the sum of the deviations from m: (x - m)^2 = x x - x m - x m + m m is a sum of exact products
+template<typename Accumulator>
+struct deviation_accumulators {
+	Accumulator squares, deviations;
+	void add(const deviation_accumulators& other) {
+		squares.add(other.squares);
+		deviations.add(other.deviations);
+	}
+};
+template<typename Scalar>
+void deviations(const std::vector<Scalar>& x, const Scalar& m, unsigned nrThreads, Scalar& squares, Scalar& sum, std::true_type) {
+	using Accumulators = deviation_accumulators<typename exact_accumulator<Scalar>::type>;
+	Scalar one(1);
+	Accumulators acc = exact_reduce<Accumulators>(x.size(), nrThreads, [&](Accumulators& a, size_t i) {
+		a.squares.mac(x[i], x[i]);
+		a.squares.msc(x[i], m);
+		a.squares.msc(x[i], m);
+		a.squares.mac(m, m);
+		a.deviations.mac(x[i], one);
+		a.deviations.msc(m, one);
+	});
+	squares = acc.squares.value();
+	sum = acc.deviations.value();
+}
+template<typename Scalar>
+void deviations(const std::vector<Scalar>& x, const Scalar& m, unsigned nrThreads, Scalar& squares, Scalar& sum, std::false_type) {
+	squares = pairwise_reduce<Scalar>(x.size(), nrThreads, [&](size_t i) { Scalar d = x[i] - m; return Scalar(d * d); });
+	sum = pairwise_reduce<Scalar>(x.size(), nrThreads, [&](size_t i) { return Scalar(x[i] - m); });
+}
+
+} // namespace internal
+
+// sum of the elements of x
+template<typename Scalar>
+Scalar sum(const std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	return internal::sum(x, nrThreads, internal::has_exact_accumulator<Scalar>());
+}
+
+// mean of the elements of x: the sum divided by the number of elements
+template<typename Scalar>
+Scalar mean(const std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	if (x.empty()) throw std::invalid_argument("mean: empty vector");
+	return internal::mean(x, nrThreads, internal::has_exact_accumulator<Scalar>());
+}
+
+// sample variance of the elements of x, with the corrected two-pass algorithm: for the mean m of the first pass,
+// the variance is (sum (x - m)^2 - (sum (x - m))^2 / n) / (n - 1), where the correction removes the rounding error of m
+template<typename Scalar>
+Scalar variance(const std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	if (x.size() < 2) throw std::invalid_argument("variance: fewer than two elements");
+	Scalar m = mean(x, nrThreads), squares, deviations;
+	internal::deviations(x, m, nrThreads, squares, deviations, internal::has_exact_accumulator<Scalar>());
+	Scalar n(double(x.size()));
+	return (squares - deviations * deviations / n) / (n - Scalar(1));
+}
+
+// Euclidean norm of x, named after the BLAS routine: the square root of the sum of squares
+template<typename Scalar>
+Scalar nrm2(const std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	return internal::nrm2(x, nrThreads, internal::has_exact_accumulator<Scalar>());
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
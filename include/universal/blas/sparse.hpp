@@ -0,0 +1,244 @@
+#pragma once
+// sparse.hpp: compressed sparse row and column matrices and their matrix-vector products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include "accumulator.hpp"
+#include "gemv.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// compression of a sparse matrix: csr stores the nonzeros row by row, csc column by column
+enum class sparse_format { csr, csc };
+
+// a nonzero element in coordinate form
+template<typename Scalar>
+struct triplet {
+	size_t row;
+	size_t col;
+	Scalar value;
+};
+
+// sparse_matrix holds the nonzeros of a rows x cols matrix in compressed sparse row or column form:
+// the nonzeros of major line k, a row for csr and a column for csc, are value[ptr[k], ptr[k+1]),
+// with their minor indices, the columns for csr and the rows for csc, in ascending order in index.
+template<typename Scalar>
+class sparse_matrix {
+public:
+	typedef Scalar value_type;
+
+	sparse_matrix() : _rows(0), _cols(0), _format(sparse_format::csr), _ptr(1, 0) {}
+
+	// compress a list of nonzeros: duplicate coordinates are summed
+	sparse_matrix(size_t rows, size_t cols, std::vector< triplet<Scalar> > elements, sparse_format format = sparse_format::csr)
+		: _rows(rows), _cols(cols), _format(format) {
+		bool rowMajor = (format == sparse_format::csr);
+		for (const triplet<Scalar>& e : elements) {
+			if (e.row >= rows || e.col >= cols) throw std::out_of_range("sparse_matrix: element outside the matrix");
+		}
+		std::stable_sort(elements.begin(), elements.end(), [rowMajor](const triplet<Scalar>& a, const triplet<Scalar>& b) {
+			return rowMajor ? (a.row < b.row || (a.row == b.row && a.col < b.col)) : (a.col < b.col || (a.col == b.col && a.row < b.row));
+		});
+		_ptr.assign(major() + 1, 0);
+		for (size_t e = 0; e < elements.size(); ++e) {
+			size_t k = rowMajor ? elements[e].row : elements[e].col;
+			size_t minor = rowMajor ? elements[e].col : elements[e].row;
+			if (e > 0 && elements[e].row == elements[e - 1].row && elements[e].col == elements[e - 1].col) {
+				_value.back() += elements[e].value;
+				continue;
+			}
+			_index.push_back(minor);
+			_value.push_back(elements[e].value);
+			++_ptr[k + 1];
+		}
+		for (size_t k = 0; k < major(); ++k) _ptr[k + 1] += _ptr[k];
+	}
+
+	size_t rows() const { return _rows; }
+	size_t cols() const { return _cols; }
+	size_t nonzeros() const { return _value.size(); }
+	sparse_format format() const { return _format; }
+
+	// the number of rows for csr and of columns for csc
+	size_t major() const { return (_format == sparse_format::csr) ? _rows : _cols; }
+	const std::vector<size_t>& ptr() const { return _ptr; }
+	const std::vector<size_t>& index() const { return _index; }
+	const std::vector<Scalar>& value() const { return _value; }
+
+	// the same matrix compressed in the other format
+	sparse_matrix convert(sparse_format format) const {
+		if (format == _format) return *this;
+		std::vector< triplet<Scalar> > elements;
+		elements.reserve(nonzeros());
+		for (size_t k = 0; k < major(); ++k) {
+			for (size_t e = _ptr[k]; e < _ptr[k + 1]; ++e) {
+				if (_format == sparse_format::csr) elements.push_back({ k, _index[e], _value[e] });
+				else                               elements.push_back({ _index[e], k, _value[e] });
+			}
+		}
+		return sparse_matrix(_rows, _cols, std::move(elements), format);
+	}
+
+private:
+	size_t _rows, _cols;
+	sparse_format _format;
+	std::vector<size_t> _ptr;
+	std::vector<size_t> _index;
+	std::vector<Scalar> _value;
+};
+
+// partition_by_nonzeros splits the major lines [0, ptr.size() - 1) into nrParts contiguous ranges with about
+// the same number of nonzeros: part t covers [boundary[t], boundary[t + 1])
+inline std::vector<size_t> partition_by_nonzeros(const std::vector<size_t>& ptr, size_t nrParts) {
+	size_t lines = ptr.size() - 1;
+	size_t nnz = ptr.back();
+	std::vector<size_t> boundary(nrParts + 1, lines);
+	boundary[0] = 0;
+	for (size_t t = 1; t < nrParts; ++t) {
+		size_t target = nnz / nrParts * t + nnz % nrParts * t / nrParts;
+		boundary[t] = size_t(std::lower_bound(ptr.begin(), ptr.end(), target) - ptr.begin());
+		boundary[t] = std::min(lines, std::max(boundary[t - 1], boundary[t]));
+	}
+	return boundary;
+}
+
+// minimum number of nonzeros a thread is started for
+constexpr size_t sparse_nonzeros_per_thread = 16384;
+
+namespace internal {
+
+// run kernel(part, first, last) over the parts of the major lines, balanced by nonzeros, one part per thread
+template<typename Kernel>
+void parallel_nonzeros(const std::vector<size_t>& ptr, unsigned nrThreads, Kernel kernel) {
+	if (nrThreads == 0) nrThreads = std::max(1u, std::thread::hardware_concurrency());
+	size_t maxThreads = std::max(size_t(1), ptr.back() / sparse_nonzeros_per_thread);
+	if (nrThreads > maxThreads) nrThreads = unsigned(maxThreads);
+	std::vector<size_t> boundary = partition_by_nonzeros(ptr, nrThreads);
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < nrThreads; ++t) {
+		size_t first = boundary[t], last = boundary[t + 1];
+		workers.emplace_back([=]() { kernel(t, first, last); });
+	}
+	kernel(0u, boundary[0], boundary[1]);
+	for (std::thread& worker : workers) worker.join();
+}
+
+// y[k] for the major lines k in [first, last): the dot product of each line with x
+template<typename Scalar>
+void sparse_gather(accumulation acc, size_t first, size_t last, const size_t* ptr, const size_t* index, const Scalar* value, const Scalar* x, Scalar* y) {
+	for (size_t k = first; k < last; ++k) {
+		if (acc == accumulation::fused) {
+			dot_accumulator<Scalar> sum;
+			for (size_t e = ptr[k]; e < ptr[k + 1]; ++e) sum.mac(value[e], x[index[e]]);
+			y[k] = sum.value();
+		}
+		else {
+			Scalar sum(0);
+			for (size_t e = ptr[k]; e < ptr[k + 1]; ++e) sum += value[e] * x[index[e]];
+			y[k] = sum;
+		}
+	}
+}
+
+// y = the sum over the major lines k of x[k] times line k, with a set of accumulators per thread
+template<typename Scalar>
+void sparse_scatter(accumulation acc, size_t n, const std::vector<size_t>& ptr, const std::vector<size_t>& index, const std::vector<Scalar>& value,
+                    const Scalar* x, Scalar* y, unsigned nrThreads) {
+	if (nrThreads == 0) nrThreads = std::max(1u, std::thread::hardware_concurrency());
+	nrThreads = unsigned(std::min(size_t(nrThreads), std::max(size_t(1), ptr.back() / sparse_nonzeros_per_thread)));
+	const size_t* p = ptr.data();
+	const size_t* idx = index.data();
+	const Scalar* val = value.data();
+	if (acc == accumulation::fused) {
+		std::vector< std::vector< dot_accumulator<Scalar> > > partial(nrThreads, std::vector< dot_accumulator<Scalar> >(n));
+		std::vector< dot_accumulator<Scalar> >* sums = partial.data();
+		parallel_nonzeros(ptr, nrThreads, [=](unsigned t, size_t first, size_t last) {
+			dot_accumulator<Scalar>* sum = sums[t].data();
+			for (size_t k = first; k < last; ++k) {
+				for (size_t e = p[k]; e < p[k + 1]; ++e) sum[idx[e]].mac(val[e], x[k]);
+			}
+		});
+		// the sums of the threads merge exactly
+		for (size_t i = 0; i < n; ++i) {
+			for (unsigned t = 1; t < nrThreads; ++t) partial[0][i].add(partial[t][i]);
+			y[i] = partial[0][i].value();
+		}
+	}
+	else {
+		std::vector< std::vector<Scalar> > partial(nrThreads, std::vector<Scalar>(n, Scalar(0)));
+		std::vector<Scalar>* sums = partial.data();
+		parallel_nonzeros(ptr, nrThreads, [=](unsigned t, size_t first, size_t last) {
+			Scalar* sum = sums[t].data();
+			for (size_t k = first; k < last; ++k) {
+				for (size_t e = p[k]; e < p[k + 1]; ++e) sum[idx[e]] += val[e] * x[k];
+			}
+		});
+		for (size_t i = 0; i < n; ++i) {
+			Scalar sum = partial[0][i];
+			for (unsigned t = 1; t < nrThreads; ++t) sum += partial[t][i];
+			y[i] = sum;
+		}
+	}
+}
+
+} // namespace internal
+
+// spmv computes y = A * x, and y is resized to the rows of A.
+// A csr matrix computes every row as a dot product, with the rows distributed over threads in ranges of equal
+// numbers of nonzeros. A csc matrix adds the columns into an accumulator per row, one set of accumulators per thread,
+// which are merged at the end. With fused accumulation every element of y is rounded once in both formats,
+// so for posits the result does not depend on the format or the number of threads.
+// nrThreads of 0 selects the hardware concurrency of the host.
+template<typename Scalar>
+void spmv(const sparse_matrix<Scalar>& A, const std::vector<Scalar>& x, std::vector<Scalar>& y,
+          accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	if (x.size() != A.cols()) throw std::invalid_argument("spmv: x does not match the columns of A");
+	y.resize(A.rows());
+	const Scalar* xx = x.data();
+	Scalar* yy = y.data();
+	if (A.format() == sparse_format::csr) {
+		const size_t* ptr = A.ptr().data();
+		const size_t* index = A.index().data();
+		const Scalar* value = A.value().data();
+		internal::parallel_nonzeros(A.ptr(), nrThreads, [=](unsigned, size_t first, size_t last) {
+			internal::sparse_gather(acc, first, last, ptr, index, value, xx, yy);
+		});
+	}
+	else {
+		internal::sparse_scatter(acc, A.rows(), A.ptr(), A.index(), A.value(), xx, yy, nrThreads);
+	}
+}
+
+// spmv_transpose computes y = A^T * x, and y is resized to the columns of A:
+// csc matrices gather by column, csr matrices scatter by row
+template<typename Scalar>
+void spmv_transpose(const sparse_matrix<Scalar>& A, const std::vector<Scalar>& x, std::vector<Scalar>& y,
+                    accumulation acc = accumulation::fused, unsigned nrThreads = 0) {
+	if (x.size() != A.rows()) throw std::invalid_argument("spmv_transpose: x does not match the rows of A");
+	y.resize(A.cols());
+	const Scalar* xx = x.data();
+	Scalar* yy = y.data();
+	if (A.format() == sparse_format::csc) {
+		const size_t* ptr = A.ptr().data();
+		const size_t* index = A.index().data();
+		const Scalar* value = A.value().data();
+		internal::parallel_nonzeros(A.ptr(), nrThreads, [=](unsigned, size_t first, size_t last) {
+			internal::sparse_gather(acc, first, last, ptr, index, value, xx, yy);
+		});
+	}
+	else {
+		internal::sparse_scatter(acc, A.cols(), A.ptr(), A.index(), A.value(), xx, yy, nrThreads);
+	}
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,89 @@
+#pragma once
+// trsv.hpp: triangular solve with quire accumulation of the residuals
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "gemv.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// triangle of the matrix that holds the system
+enum class triangle { lower, upper };
+// unit diagonals are not read and taken to be 1
+enum class diagonal { non_unit, unit };
+
+// rows of a diagonal block that are solved sequentially
+constexpr size_t trsv_block_size = 128;
+
+// trsv solves T * x = b in place, where T is the lower or upper triangle of the n x n matrix A with
+// leading dimension lda, and x holds b on entry.
+// Every row keeps a dot_accumulator that starts at b_i and collects the products of the solved unknowns,
+// so for posits the residual b_i - sum(T_ij * x_j) is exact and rounded once before the division by T_ii.
+// The unknowns are solved in diagonal blocks of trsv_block_size rows; the products of a solved block
+// are added to the accumulators of the remaining rows in parallel over nrThreads threads, where
+// 0 selects the hardware concurrency of the host.
+template<typename Scalar>
+void trsv(matrix_layout layout, triangle uplo, diagonal diag, size_t n, const Scalar* A, size_t lda, Scalar* x, unsigned nrThreads = 0) {
+	const bool rowMajor = (layout == matrix_layout::row_major);
+	auto element = [=](size_t i, size_t j) -> const Scalar& { return rowMajor ? A[i * lda + j] : A[i + j * lda]; };
+
+	std::vector< dot_accumulator<Scalar> > residual(n);
+	for (size_t i = 0; i < n; ++i) residual[i].load(x[i]);
+	dot_accumulator<Scalar>* r = residual.data();
+
+	// residuals of rows [first, last) minus the products with the unknowns [b0, b1)
+	auto update = [=](size_t first, size_t last, size_t b0, size_t b1) {
+		if (rowMajor) {
+			for (size_t i = first; i < last; ++i) {
+				for (size_t j = b0; j < b1; ++j) r[i].msc(element(i, j), x[j]);
+			}
+		}
+		else {
+			for (size_t j = b0; j < b1; ++j) {
+				for (size_t i = first; i < last; ++i) r[i].msc(element(i, j), x[j]);
+			}
+		}
+	};
+	auto solve = [&](size_t i, size_t b0, size_t b1) {
+		update(i, i + 1, b0, b1);
+		x[i] = r[i].value();
+		if (diag == diagonal::non_unit) x[i] /= element(i, i);
+	};
+
+	if (uplo == triangle::lower) {
+		for (size_t b0 = 0; b0 < n; b0 += trsv_block_size) {
+			size_t b1 = std::min(n, b0 + trsv_block_size);
+			for (size_t i = b0; i < b1; ++i) solve(i, b0, i);
+			size_t remaining = n - b1;
+			parallel_rows(remaining, 1, internal::level2_min_rows(b1 - b0), nrThreads, [=](size_t first, size_t last) {
+				update(b1 + first, b1 + last, b0, b1);
+			});
+		}
+	}
+	else {
+		for (size_t b1 = n; b1 > 0; ) {
+			size_t b0 = (b1 > trsv_block_size) ? b1 - trsv_block_size : 0;
+			for (size_t i = b1; i-- > b0; ) solve(i, i + 1, b1);
+			parallel_rows(b0, 1, internal::level2_min_rows(b1 - b0), nrThreads, [=](size_t first, size_t last) {
+				update(first, last, b0, b1);
+			});
+			b1 = b0;
+		}
+	}
+}
+
+// convenience overload for a dense matrix held in a vector: x holds b on entry and the solution on exit
+template<typename Scalar>
+void trsv(matrix_layout layout, triangle uplo, diagonal diag, size_t n, const std::vector<Scalar>& A, std::vector<Scalar>& x, unsigned nrThreads = 0) {
+	trsv(layout, uplo, diag, n, A.data(), n, x.data(), nrThreads);
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
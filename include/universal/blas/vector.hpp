@@ -0,0 +1,263 @@
+#pragma once
+// vector.hpp: vectors with expression templates that evaluate compound expressions in one pass
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include "accumulator.hpp"
+#include "parallel.hpp"
+
+namespace sw {
+namespace unum {
+namespace blas {
+
+// The arithmetic operators on vectors do not compute anything: they build an expression, a tree of small
+// nodes that refer to the operand vectors, and a vector computes every element of an expression when the
+// expression is assigned to it. A compound expression such as a * x + b * z thus takes one pass over the
+// operands and allocates no temporary vectors.
+//
+// An expression is evaluated with rounded or fused accumulation. Rounded evaluation computes each element
+// with the scalar operators, rounding after every operation like a hand-written loop. Fused evaluation collects
+// each element as a sum of exact products in a dot_accumulator, for posits a quire, and rounds once: a sum or
+// difference of vectors, scaled vectors, and elementwise products of vectors is contracted into one rounding
+// per element, so a * x + b * z is the fused multiply-multiply-add of every element and a * x + y its fused
+// multiply-add. Operands that are not of this form, such as the product of two sums, are rounded first and
+// then enter the sum as an exact term.
+
+// minimum number of elements a thread is started for
+constexpr size_t vector_elements_per_thread = 16384;
+
+// base of all vector expressions: E is the type of the expression
+template<typename E>
+struct vector_expression {
+	const E& self() const { return static_cast<const E&>(*this); }
+};
+
+template<typename Scalar> class vector;
+
+namespace internal {
+
+// expression nodes hold vectors by reference and other nodes by value
+template<typename E>
+struct operand { using type = const E; };
+template<typename Scalar>
+struct operand< vector<Scalar> > { using type = const vector<Scalar>&; };
+
+} // namespace internal
+
+// Every expression type provides
+//   size()                                 the number of elements
+//   operator[](i)                          element i with rounded evaluation
+//   accumulate(acc, i, negate, factor)     add element i, times *factor when factor is not null, to the
+//                                          dot_accumulator acc, exactly when the expression allows it
+
+// x + y and x - y
+template<typename L, typename R, bool subtract>
+class vector_sum : public vector_expression< vector_sum<L, R, subtract> > {
+public:
+	using value_type = typename L::value_type;
+
+	vector_sum(const L& l, const R& r) : _l(l), _r(r) {
+		if (l.size() != r.size()) throw std::invalid_argument("vector expression: operands of different size");
+	}
+	size_t size() const { return _l.size(); }
+	value_type operator[](size_t i) const { return subtract ? value_type(_l[i] - _r[i]) : value_type(_l[i] + _r[i]); }
+	void accumulate(dot_accumulator<value_type>& acc, size_t i, bool negate, const value_type* factor) const {
+		_l.accumulate(acc, i, negate, factor);
+		_r.accumulate(acc, i, negate != subtract, factor);
+	}
+
+private:
+	typename internal::operand<L>::type _l;
+	typename internal::operand<R>::type _r;
+};
+
+// -x
+template<typename E>
+class vector_negate : public vector_expression< vector_negate<E> > {
+public:
+	using value_type = typename E::value_type;
+
+	explicit vector_negate(const E& e) : _e(e) {}
+	size_t size() const { return _e.size(); }
+	value_type operator[](size_t i) const { return -_e[i]; }
+	void accumulate(dot_accumulator<value_type>& acc, size_t i, bool negate, const value_type* factor) const {
+		_e.accumulate(acc, i, !negate, factor);
+	}
+
+private:
+	typename internal::operand<E>::type _e;
+};
+
+// alpha * x: the scalar distributes over the terms of x, a second scalar factor makes the product round
+template<typename E>
+class vector_scale : public vector_expression< vector_scale<E> > {
+public:
+	using value_type = typename E::value_type;
+
+	vector_scale(const value_type& alpha, const E& e) : _alpha(alpha), _e(e) {}
+	size_t size() const { return _e.size(); }
+	value_type operator[](size_t i) const { return _alpha * _e[i]; }
+	void accumulate(dot_accumulator<value_type>& acc, size_t i, bool negate, const value_type* factor) const {
+		if (factor == nullptr) {
+			_e.accumulate(acc, i, negate, &_alpha);
+			return;
+		}
+		value_type alpha = *factor * _alpha;
+		_e.accumulate(acc, i, negate, &alpha);
+	}
+
+private:
+	value_type _alpha;
+	typename internal::operand<E>::type _e;
+};
+
+// x * y elementwise: exact when no scalar factor applies, otherwise the product rounds
+template<typename L, typename R>
+class vector_product : public vector_expression< vector_product<L, R> > {
+public:
+	using value_type = typename L::value_type;
+
+	vector_product(const L& l, const R& r) : _l(l), _r(r) {
+		if (l.size() != r.size()) throw std::invalid_argument("vector expression: operands of different size");
+	}
+	size_t size() const { return _l.size(); }
+	value_type operator[](size_t i) const { return _l[i] * _r[i]; }
+	void accumulate(dot_accumulator<value_type>& acc, size_t i, bool negate, const value_type* factor) const {
+		value_type a = _l[i], b = _r[i];
+		if (factor != nullptr) a = *factor * a;
+		if (negate) acc.msc(a, b); else acc.mac(a, b);
+	}
+
+private:
+	typename internal::operand<L>::type _l;
+	typename internal::operand<R>::type _r;
+};
+
+// vector owns its elements and evaluates expressions assigned to it
+template<typename Scalar>
+class vector : public vector_expression< vector<Scalar> > {
+public:
+	using value_type = Scalar;
+
+	vector() = default;
+	explicit vector(size_t n, const Scalar& init = Scalar(0)) : _data(n, init) {}
+	vector(std::initializer_list<Scalar> init) : _data(init) {}
+	explicit vector(const std::vector<Scalar>& elements) : _data(elements) {}
+	template<typename E>
+	vector(const vector_expression<E>& e) { assign(e); }
+
+	vector& operator=(const vector&) = default;
+	template<typename E>
+	vector& operator=(const vector_expression<E>& e) { return assign(e); }
+	template<typename E>
+	vector& operator+=(const vector_expression<E>& e) { return assign(*this + e.self()); }
+	template<typename E>
+	vector& operator-=(const vector_expression<E>& e) { return assign(*this - e.self()); }
+	vector& operator*=(const Scalar& alpha) { return assign(alpha * *this); }
+
+	// evaluate e into this vector, spread over nrThreads threads. Element i of e only reads element i of its
+	// operands, so this vector may appear in e.
+	template<typename E>
+	vector& assign(const vector_expression<E>& e, accumulation acc = accumulation::rounded, unsigned nrThreads = 0) {
+		const E& expr = e.self();
+		_data.resize(expr.size());
+		Scalar* y = _data.data();
+		parallel_rows(expr.size(), 1, vector_elements_per_thread, nrThreads, [&](size_t first, size_t last) {
+			if (acc == accumulation::fused) {
+				dot_accumulator<Scalar> sum;
+				for (size_t i = first; i < last; ++i) {
+					sum.reset();
+					expr.accumulate(sum, i, false, nullptr);
+					y[i] = sum.value();
+				}
+			}
+			else {
+				for (size_t i = first; i < last; ++i) y[i] = expr[i];
+			}
+		});
+		return *this;
+	}
+
+	size_t size() const { return _data.size(); }
+	bool empty() const { return _data.empty(); }
+	void resize(size_t n) { _data.resize(n); }
+	Scalar& operator[](size_t i) { return _data[i]; }
+	const Scalar& operator[](size_t i) const { return _data[i]; }
+	Scalar* data() { return _data.data(); }
+	const Scalar* data() const { return _data.data(); }
+	typename std::vector<Scalar>::iterator begin() { return _data.begin(); }
+	typename std::vector<Scalar>::iterator end() { return _data.end(); }
+	typename std::vector<Scalar>::const_iterator begin() const { return _data.begin(); }
+	typename std::vector<Scalar>::const_iterator end() const { return _data.end(); }
+	// the elements as a std::vector, for the kernels that take one
+	const std::vector<Scalar>& elements() const { return _data; }
+
+	void accumulate(dot_accumulator<Scalar>& acc, size_t i, bool negate, const Scalar* factor) const {
+		Scalar one(1);
+		const Scalar& a = (factor == nullptr) ? one : *factor;
+		if (negate) acc.msc(a, _data[i]); else acc.mac(a, _data[i]);
+	}
+
+private:
+	std::vector<Scalar> _data;
+};
+
+// operators that build expressions
+template<typename L, typename R>
+vector_sum<L, R, false> operator+(const vector_expression<L>& l, const vector_expression<R>& r) {
+	return vector_sum<L, R, false>(l.self(), r.self());
+}
+template<typename L, typename R>
+vector_sum<L, R, true> operator-(const vector_expression<L>& l, const vector_expression<R>& r) {
+	return vector_sum<L, R, true>(l.self(), r.self());
+}
+template<typename E>
+vector_negate<E> operator-(const vector_expression<E>& e) {
+	return vector_negate<E>(e.self());
+}
+template<typename E>
+vector_scale<E> operator*(const typename E::value_type& alpha, const vector_expression<E>& e) {
+	return vector_scale<E>(alpha, e.self());
+}
+template<typename E>
+vector_scale<E> operator*(const vector_expression<E>& e, const typename E::value_type& alpha) {
+	return vector_scale<E>(alpha, e.self());
+}
+template<typename L, typename R>
+vector_product<L, R> operator*(const vector_expression<L>& l, const vector_expression<R>& r) {
+	return vector_product<L, R>(l.self(), r.self());
+}
+
+// evaluate an expression into a new vector
+template<typename E>
+vector<typename E::value_type> evaluate(const vector_expression<E>& e, accumulation acc = accumulation::rounded, unsigned nrThreads = 0) {
+	vector<typename E::value_type> v;
+	v.assign(e, acc, nrThreads);
+	return v;
+}
+
+// sum of the elements of an expression: fused accumulation collects all the terms of all the elements in one
+// dot_accumulator, so sum(x * y) is the fused dot product of x and y
+template<typename E>
+typename E::value_type sum(const vector_expression<E>& e, accumulation acc = accumulation::fused) {
+	using Scalar = typename E::value_type;
+	const E& expr = e.self();
+	if (acc == accumulation::fused) {
+		dot_accumulator<Scalar> total;
+		for (size_t i = 0; i < expr.size(); ++i) expr.accumulate(total, i, false, nullptr);
+		return total.value();
+	}
+	Scalar total(0);
+	for (size_t i = 0; i < expr.size(); ++i) total += expr[i];
+	return total;
+}
+
+} // namespace blas
+} // namespace unum
+} // namespace sw
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include "../native/word_arithmetic.hpp"
 
 // compiler specific operators
 #if defined(__clang__)
@@ -43,6 +45,10 @@ namespace sw {
 namespace unum {
 
 
+// default storage unit: 64-bit limbs once the number spans a full machine word, bytes below that
+template<size_t nbits>
+using default_block_type = typename std::conditional<(nbits >= 64), uint64_t, uint8_t>::type;
+
 // forward references
 template<size_t nbits, typename BlockType> class blockbinary;
 template<size_t nbits, typename BlockType> blockbinary<nbits, BlockType> twosComplement(const blockbinary<nbits, BlockType>&);
@@ -58,7 +64,7 @@ struct quorem {
 };
 
 // maximum positive 2's complement number: b01111...1111
-template<size_t nbits, typename BlockType = uint8_t>
+template<size_t nbits, typename BlockType = default_block_type<nbits>>
 blockbinary<nbits, BlockType> maxpos() {
 	blockbinary<nbits, BlockType> mpos;
 	mpos.flip();
@@ -67,7 +73,7 @@ blockbinary<nbits, BlockType> maxpos() {
 }
 
 // maximum negative 2's complement number: b1000...0000
-template<size_t nbits, typename BlockType = uint8_t>
+template<size_t nbits, typename BlockType = default_block_type<nbits>>
 blockbinary<nbits, BlockType> maxneg() {
 	blockbinary<nbits, BlockType> maximum;
 	maximum.set(nbits - 1);
@@ -84,28 +90,59 @@ blockbinary<nbits, BlockType> twosComplement(const blockbinary<nbits, BlockType>
 	return twosC;
 }
 
+// copy the bits of a blockbinary into 64-bit limbs, least significant limb first
+template<size_t nbits, typename BlockType, size_t N>
+inline void to_limbs(const blockbinary<nbits, BlockType>& v, uint64_t (&limbs)[N]) {
+	static_assert(64 * N >= nbits, "limbs too small to hold the blockbinary");
+	constexpr size_t bitsInBlock = blockbinary<nbits, BlockType>::bitsInBlock;
+	for (size_t i = 0; i < N; ++i) limbs[i] = 0;
+	for (size_t i = 0; i < blockbinary<nbits, BlockType>::nrBlocks; ++i) {
+		limbs[(i * bitsInBlock) / 64] |= uint64_t(v.block(i)) << ((i * bitsInBlock) % 64);
+	}
+}
+
+// set a blockbinary to the lower nbits of 64-bit limbs
+template<size_t nbits, typename BlockType, size_t N>
+inline void from_limbs(const uint64_t (&limbs)[N], blockbinary<nbits, BlockType>& v) {
+	static_assert(64 * N >= nbits, "limbs too small to fill the blockbinary");
+	constexpr size_t bitsInBlock = blockbinary<nbits, BlockType>::bitsInBlock;
+	for (size_t i = 0; i < blockbinary<nbits, BlockType>::nrBlocks; ++i) {
+		v.setblock(i, BlockType(limbs[(i * bitsInBlock) / 64] >> ((i * bitsInBlock) % 64)));
+	}
+}
+
+// the magnitude of a 2's complement blockbinary in 64-bit limbs, returns true when the value is negative
+template<size_t nbits, typename BlockType, size_t N>
+inline bool to_magnitude_limbs(const blockbinary<nbits, BlockType>& v, uint64_t (&limbs)[N]) {
+	to_limbs(v, limbs);
+	if (!v.sign()) return false;
+	// sign extend to the full width of the limbs, then negate
+	if (nbits % 64) limbs[(nbits - 1) / 64] |= ~uint64_t(0) << (nbits % 64);
+	for (size_t i = (nbits - 1) / 64 + 1; i < N; ++i) limbs[i] = ~uint64_t(0);
+	limbs_negate(limbs);
+	return true;
+}
+
 /*
 NOTES
 
 for block arithmetic, we need to manage a carry bit.
-This disqualifies using uint64_t as a block type as we can't catch the overflow condition
-in the same way as the other native types, uint8_t, uint16_t, uint32_t.
-
-We could use a sint64_t and then convert to uint64_t and observe the MSB. Very different 
-logic though.
+For uint8_t, uint16_t, and uint32_t blocks the sum is computed in a uint64_t and the carry
+is observed as an overflow of the block value. A uint64_t block has no wider native type
+to cast up to, so its carry is taken from the add-with-carry primitive of word_arithmetic.hpp.
 */
 
 // a block-based 2's complement binary number
-template<size_t nbits, typename BlockType = uint8_t>
+template<size_t nbits, typename BlockType = default_block_type<nbits>>
 class blockbinary {
 public:
 	static constexpr size_t bitsInByte = 8;
 	static constexpr size_t bitsInBlock = sizeof(BlockType) * bitsInByte;
-	static_assert(bitsInBlock <= 32, "storage unit for block arithmetic needs to be <= uint32_t");
+	static_assert(bitsInBlock <= 64, "storage unit for block arithmetic needs to be <= uint64_t");
 
 	static constexpr size_t nrBlocks = 1 + ((nbits - 1) / bitsInBlock);
 	static constexpr uint64_t storageMask = (0xFFFFFFFFFFFFFFFFul >> (64 - bitsInBlock));
-	static constexpr BlockType maxBlockValue = (uint64_t(1) << bitsInBlock) - 1;
+	static constexpr BlockType maxBlockValue = BlockType(storageMask);
 
 	static constexpr size_t MSU = nrBlocks - 1; // MSU == Most Significant Unit
 	// warning C4310 : cast truncates constant value
@@ -133,7 +170,7 @@ public:
 	blockbinary& operator=(long long rhs) {
 		for (unsigned i = 0; i < nrBlocks; ++i) {
 			_block[i] = rhs & storageMask;
-			rhs >>= bitsInBlock;
+			rhs >>= (bitsInBlock < 64 ? bitsInBlock : 63); // a 64-bit block consumed all bits: only the sign fill remains
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -188,13 +225,20 @@ public:
 	// arithmetic operators
 	blockbinary& operator+=(const blockbinary& rhs) {
 		bool carry = false;
-		for (unsigned i = 0; i < nrBlocks; ++i) {
-			// cast up so we can test for overflow
-			uint64_t l = uint64_t(_block[i]);
-			uint64_t r = uint64_t(rhs._block[i]);
-			uint64_t s = l + r + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > maxBlockValue ? true : false);
-			_block[i] = BlockType(s);
+		if (bitsInBlock == 64) {
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				_block[i] = BlockType(add_words(uint64_t(_block[i]), uint64_t(rhs._block[i]), carry));
+			}
+		}
+		else {
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				// cast up so we can test for overflow
+				uint64_t l = uint64_t(_block[i]);
+				uint64_t r = uint64_t(rhs._block[i]);
+				uint64_t s = l + r + (carry ? uint64_t(1) : uint64_t(0));
+				carry = (s > maxBlockValue ? true : false);
+				_block[i] = BlockType(s);
+			}
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -204,17 +248,13 @@ public:
 		return operator+=(twosComplement(rhs));
 	}
 	blockbinary& operator*=(const blockbinary& rhs) { // modulo in-place
-		blockbinary base(*this);
-		blockbinary multiplicant(rhs);
-		clear();
-		for (size_t i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				operator+=(multiplicant);
-			}
-			multiplicant <<= 1;
-		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// the lower nbits of the product of the bit patterns is the 2's complement product modulo 2^nbits
+		constexpr size_t N = 1 + (nbits - 1) / 64;
+		uint64_t x[N], y[N], product[2 * N];
+		to_limbs(*this, x);
+		to_limbs(rhs, y);
+		limbs_multiply(x, y, product);
+		from_limbs(product, *this);
 		return *this;
 	}
 	blockbinary& operator/=(const blockbinary& rhs) {
@@ -338,7 +378,7 @@ public:
 	inline void reset(size_t i) {
 		if (i < nbits) {
 			BlockType block = _block[i / bitsInBlock];
-			BlockType mask = ~(1 << (i % bitsInBlock));
+			BlockType mask = BlockType(~(BlockType(1) << (i % bitsInBlock)));
 			_block[i / bitsInBlock] = block & mask;
 			return;
 		}
@@ -347,7 +387,7 @@ public:
 	inline void set(size_t i, bool v = true) {
 		if (i < nbits) {
 			BlockType block = _block[i / bitsInBlock];
-			BlockType null = ~(1 << (i % bitsInBlock));
+			BlockType null = BlockType(~(BlockType(1) << (i % bitsInBlock)));
 			BlockType bit = (v ? 1 : 0);
 			BlockType mask = (bit << (i % bitsInBlock));
 			_block[i / bitsInBlock] = (block & null) | mask;
@@ -358,7 +398,7 @@ public:
 	inline void set_raw_bits(uint64_t value) {
 		for (size_t i = 0; i < nrBlocks; ++i) {
 			_block[i] = value & storageMask;
-			value >>= bitsInBlock;
+			value = (bitsInBlock < 64 ? value >> (bitsInBlock % 64) : 0);
 		}
 		_block[MSU] &= MSU_MASK; // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 	}
@@ -400,7 +440,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			BlockType word = _block[(n * 4) / bitsInBlock];
 			int nibbleIndexInWord = n % (bitsInBlock >> 2);
-			BlockType mask = 0xF << (nibbleIndexInWord*4);
+			BlockType mask = BlockType(BlockType(0xF) << (nibbleIndexInWord*4));
 			BlockType nibblebits = mask & word;
 			return (nibblebits >> (nibbleIndexInWord*4));
 		}
@@ -412,6 +452,14 @@ public:
 		}
 		throw "block index out of bounds";
 	}
+	inline void setblock(size_t b, BlockType value) {
+		if (b < nrBlocks) {
+			_block[b] = value;
+			_block[MSU] &= MSU_MASK; // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
+			return;
+		}
+		throw "block index out of bounds";
+	}
 	template<size_t nnbits>
 	inline blockbinary<nbits, BlockType>& assign(const blockbinary<nnbits, BlockType>& rhs) {
 		clear();
@@ -435,13 +483,7 @@ public:
 	inline signed msb() const {
 		for (signed i = int(MSU); i >= 0; --i) {
 			if (_block[i] != 0) {
-				BlockType mask = (BlockType(1) << (bitsInBlock-1));
-				for (signed j = bitsInBlock - 1; j >= 0; --j) {
-					if (_block[i] & mask) {
-						return i * bitsInBlock + j;
-					}
-					mask >>= 1;
-				}
+				return i * bitsInBlock + 63 - countLeadingZeros(uint64_t(_block[i]));
 			}
 		}
 		return -1; // no significant bit found, all bits are zero
@@ -582,6 +624,8 @@ inline blockbinary<nbits, BlockType> operator>>(const blockbinary<nbits, BlockTy
 }
 
 // divide a by b and return both quotient and remainder
+// the magnitudes are divided by Knuth's Algorithm D on 64-bit limbs, with a single-limb divisor taking one
+// 128/64-bit division per quotient limb; the quotient truncates toward zero and the remainder takes the sign of a
 template<size_t nbits, typename BlockType>
 quorem<nbits, BlockType> longdivision(const blockbinary<nbits, BlockType>& _a, const blockbinary<nbits, BlockType>& _b) {
 	quorem<nbits, BlockType> result = { 0, 0, 0 };
@@ -589,50 +633,22 @@ quorem<nbits, BlockType> longdivision(const blockbinary<nbits, BlockType>& _a, c
 		result.exceptionId = 1; // division by zero
 		return result;
 	}
-	// generate the absolute values to do long division 
-	// 2's complement special case -max requires an signed int that is 1 bit bigger to represent abs()
-	bool a_sign = _a.sign();
-	bool b_sign = _b.sign();
+	// the magnitude of maxneg, 2^(nbits-1), still fits in nbits unsigned bits
+	constexpr size_t N = 1 + (nbits - 1) / 64;
+	uint64_t a[N], b[N], q[N], r[N];
+	bool a_sign = to_magnitude_limbs(_a, a);
+	bool b_sign = to_magnitude_limbs(_b, b);
 	bool result_negative = (a_sign ^ b_sign);
-	// normalize both arguments to positive, which requires expansion by 1-bit to deal with maxneg
-	blockbinary<nbits + 1, BlockType> a(_a);
-	blockbinary<nbits + 1, BlockType> b(_b);
-	if (a_sign) a.twoscomplement();
-	if (b_sign) b.twoscomplement();
 
-	if (a < b) { // optimization for integer numbers
+	if (limbs_compare(a, b) < 0) { // optimization for integer numbers
 		result.rem = _a; // a % b = a when a / b = 0
 		return result;   // a / b = 0 when b > a
 	}
-	// initialize the long division
-	blockbinary<nbits + 1, BlockType> accumulator = a;
-	// prepare the subtractand
-	blockbinary<nbits + 1, BlockType> subtractand = b;
-	int msb_b = b.msb();
-	int msb_a = a.msb();
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			result.quo.set(i);
-		}
-		else {
-			result.quo.reset(i);
-		}
-		subtractand >>= 1;
-	}
-	if (result_negative) {  // take 2's complement
-		result.quo.flip();
-		result.quo += 1;
-	}
-	if (_a.isneg()) {
-		result.rem = -accumulator;
-	}
-	else {
-		result.rem = accumulator;
-	}
+	limbs_divide_unsigned(a, b, q, r);
+	if (result_negative) limbs_negate(q);
+	if (a_sign) limbs_negate(r);
+	from_limbs(q, result.quo);
+	from_limbs(r, result.rem);
 	return result;
 }
 
@@ -655,72 +671,32 @@ inline blockbinary<nbits + 1, BlockType> ursub(const blockbinary<nbits, BlockTyp
 
 #define TRACE_URMUL 0
 // unrounded multiplication, returns a blockbinary that is of size 2*nbits
-// using brute-force sign-extending of operands to yield correct sign-extended result for 2*nbits 2's complement.
+// the product of the magnitudes is computed by the multi-word dispatcher of native/word_arithmetic.hpp,
+// which selects schoolbook, Karatsuba, or Toom-3 on the number of limbs at compile time, and the sign is applied last
 template<size_t nbits, typename BlockType>
 inline blockbinary<2*nbits, BlockType> urmul(const blockbinary<nbits, BlockType>& a, const blockbinary<nbits, BlockType>& b) {
 	blockbinary<2 * nbits, BlockType> result;
 	if (a.iszero() || b.iszero()) return result;
 
-	// compute the result
-	blockbinary<2 * nbits, BlockType> signextended_a(a);
-	blockbinary<2 * nbits, BlockType> multiplicant(b);
+	// the magnitude of maxneg, 2^(nbits-1), still fits in nbits unsigned bits
+	constexpr size_t N = 1 + (nbits - 1) / 64;
+	uint64_t x[N], y[N], product[2 * N];
+	bool result_sign = to_magnitude_limbs(a, x) ^ to_magnitude_limbs(b, y);
+	limbs_multiply(x, y, product);
+	if (result_sign) limbs_negate(product);
+	from_limbs(product, result);
 #if TRACE_URMUL
 	std::cout << "    " << to_binary(a) << " * " << to_binary(b) << std::endl;
-	std::cout << std::setw(3) << 0 << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
-#endif
-	for (size_t i = 0; i < 2* nbits; ++i) {
-		if (signextended_a.at(i)) {
-			result += multiplicant;
-		}
-		multiplicant <<= 1;
-#if TRACE_URMUL
-		std::cout << std::setw(3) << i << ' ' << to_binary(multiplicant) << ' ' << to_binary(result) << std::endl;
-#endif
-
-	}
-#if TRACE_URMUL
 	std::cout << "fnl " << to_binary(result) << std::endl;
 #endif
-	//blockbinary<2 * nbits, BlockType> clipped(result);
-	// since we used operator+=, which enforces the nulling of leading bits
-	// we don't need to null here
 	return result;
 }
 
 // unrounded multiplication, returns a blockbinary that is of size 2*nbits
-// using nbits modulo arithmetic with final sign
+// the 2*nbits 2's complement product is exact, so this is the same computation as urmul
 template<size_t nbits, typename BlockType>
 inline blockbinary<2 * nbits, BlockType> urmul2(const blockbinary<nbits, BlockType>& a, const blockbinary<nbits, BlockType>& b) {
-	blockbinary<2 * nbits, BlockType> result;
-	if (a.iszero() || b.iszero()) return result;
-
-	// compute the result
-	bool result_sign = a.sign() ^ b.sign();
-	// normalize both arguments to positive in new size
-	blockbinary<nbits + 1, BlockType> a_new(a); // TODO optimize: now create a, create _a.bb, copy, destroy _a.bb_copy
-	blockbinary<nbits + 1, BlockType> b_new(b);
-	if (a.sign()) a_new.twoscomplement();
-	if (b.sign()) b_new.twoscomplement();
-	blockbinary<2*nbits, BlockType> multiplicant(b_new);
-
-#if TRACE_URMUL
-	std::cout << "    " << a_new << " * " << b_new << std::endl;
-	std::cout << std::setw(3) << 0 << ' ' << multiplicant << ' ' << result << std::endl;
-#endif
-	for (size_t i = 0; i < (nbits+1); ++i) {
-		if (a_new.at(i)) {
-			result += multiplicant;  // if multiplicant is not the same size as result, the assignment will get sign-extended if the MSB is true, this is not correct because we are assuming unsigned binaries in this loop
-		}
-		multiplicant <<= 1;
-#if TRACE_URMUL
-		std::cout << std::setw(3) << i << ' ' << multiplicant << ' ' << result << std::endl;
-#endif
-	}
-	if (result_sign) result.twoscomplement();
-#if TRACE_URMUL
-	std::cout << "fnl " << result << std::endl;
-#endif
-	return result;
+	return urmul(a, b);
 }
 
 #define TRACE_DIV 0
@@ -22,7 +22,7 @@ template<size_t ebits, size_t fbits, typename BlockType> class blocktriple;
 template<size_t ebits, size_t fbits, typename BlockType> blocktriple<ebits,fbits,BlockType> abs(const blocktriple<ebits,fbits,BlockType>& v);
 
 template<size_t nbits, typename BlockType>
-blockbinary<nbits> extract_23b_fraction(uint32_t _23b_fraction_without_hidden_bit) {
+blockbinary<nbits, BlockType> extract_23b_fraction(uint32_t _23b_fraction_without_hidden_bit) {
 	blockbinary<nbits, typename BlockType> _fraction;
 	uint32_t mask = uint32_t(0x00400000ul);
 	unsigned int ub = (nbits < 23 ? nbits : 23);
@@ -65,7 +65,7 @@ public:
 	static constexpr size_t fhbits = fbits + 1;    // number of fraction bits including the hidden bit
 
 	blocktriple() : _sign(false), _scale(0), _nrOfBits(fbits), _fraction(), _inf(false), _zero(true), _nan(false) {}
-	blocktriple(bool sign, int scale, const blockbinary<fbits>& fraction_without_hidden_bit, bool zero = true, bool inf = false) 
+	blocktriple(bool sign, int scale, const blockbinary<fbits, BlockType>& fraction_without_hidden_bit, bool zero = true, bool inf = false) 
 		: _sign(sign), _scale(scale), _nrOfBits(fbits), _fraction(fraction_without_hidden_bit), _inf(inf), _zero(zero), _nan(false) {}
 
 	blocktriple(const signed char initial_value)        { *this = initial_value; }
@@ -300,7 +300,7 @@ public:
 		_nan = false;
 		_fraction.clear();
 	}
-	void set(bool sign, int scale, blockbinary<fbits> fraction_without_hidden_bit, bool zero, bool inf, bool nan = false) {
+	void set(bool sign, int scale, blockbinary<fbits, BlockType> fraction_without_hidden_bit, bool zero, bool inf, bool nan = false) {
 		_sign     = sign;
 		_scale    = scale;
 		_fraction = fraction_without_hidden_bit;
@@ -344,10 +344,10 @@ public:
 	inline bool isnan() const { return _nan; }
 	inline bool sign() const { return _sign; }
 	inline int scale() const { return _scale; }
-	blockbinary<fbits> fraction() const { return _fraction; }
+	blockbinary<fbits, BlockType> fraction() const { return _fraction; }
 	/// Normalized shift (e.g., for addition).
 	template <size_t Size>
-	blockbinary<Size> nshift(long shift) const {
+	blockbinary<Size, BlockType> nshift(long shift) const {
 		bitblock<Size> number;
 
 #if POSIT_THROW_ARITHMETIC_EXCEPTIONS
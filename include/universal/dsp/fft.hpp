@@ -0,0 +1,228 @@
+#pragma once
+// fft.hpp: Stockham fast Fourier transform templated on the number system
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "../blas/accumulator.hpp"
+#include "../blas/parallel.hpp"
+
+namespace sw {
+namespace unum {
+namespace dsp {
+
+using blas::accumulation;
+
+// forward computes X[k] = sum x[j] exp(-2 pi i j k / n), inverse uses exp(+2 pi i j k / n) and does not divide by n
+enum class fft_direction { forward, inverse };
+
+// per_stage divides the outputs of every stage by its radix, so the transform is scaled by 1/n and intermediate
+// values stay within the magnitude of the input: this is what keeps a fixed-point transform from overflowing
+enum class fft_scaling { none, per_stage };
+
+// minimum number of samples a thread is started for in a batch of transforms
+constexpr size_t fft_samples_per_thread = 16384;
+
+// An fft_plan transforms sequences of a power-of-2 length n with the Stockham autosort algorithm: radix-4
+// stages, and a radix-2 stage when log2(n) is odd. Every stage streams through the input and the output with
+// unit stride, ping-ponging between the data and a scratch buffer, so no bit-reversal pass is needed.
+//
+// The twiddle factors are computed in double and rounded once into Scalar when the plan is created.
+// With fused accumulation, each output of a butterfly is a sum of products of inputs and twiddle factors
+// collected in a blas::dot_accumulator, which for posits is a quire and for fixpnt an exact fixed-point sum,
+// so every stage rounds once per output. The per_stage scaling of a fused plan is folded into the twiddle table.
+template<typename Scalar>
+class fft_plan {
+public:
+	using complex_type = std::complex<Scalar>;
+
+	fft_plan(size_t n, fft_direction direction = fft_direction::forward, fft_scaling scaling = fft_scaling::none, accumulation acc = accumulation::rounded)
+		: _n(n), _direction(direction), _scaling(scaling), _acc(acc), _scratch(n) {
+		if (n == 0 || (n & (n - 1)) != 0) throw std::invalid_argument("fft_plan: the length must be a power of 2");
+		const double pi = 3.14159265358979323846;
+		double sign = (direction == fft_direction::forward) ? -1.0 : 1.0;
+		double factor = (scaling == fft_scaling::per_stage && acc == accumulation::fused) ? 0.25 : 1.0;
+		_twiddles.reserve(n);
+		for (size_t k = 0; k < n; ++k) {
+			double theta = 2.0 * pi * double(k) / double(n);
+			_twiddles.push_back(complex_type(Scalar(factor * std::cos(theta)), Scalar(factor * sign * std::sin(theta))));
+		}
+	}
+
+	size_t size() const { return _n; }
+	fft_direction direction() const { return _direction; }
+	fft_scaling scaling() const { return _scaling; }
+
+	// transform the n elements of data in place
+	void transform(complex_type* data) { execute(data, _scratch.data()); }
+	void transform(std::vector<complex_type>& data) {
+		if (data.size() != _n) throw std::invalid_argument("fft_plan: the data does not match the length of the plan");
+		transform(data.data());
+	}
+
+	// transform count sequences in place, sequence b starting at data + b * distance, spread over nrThreads threads
+	void transform_batch(complex_type* data, size_t count, size_t distance, unsigned nrThreads = 0) const {
+		size_t minTransforms = std::max(size_t(1), fft_samples_per_thread / _n);
+		blas::parallel_rows(count, 1, minTransforms, nrThreads, [&](size_t first, size_t last) {
+			std::vector<complex_type> scratch(_n);
+			for (size_t b = first; b < last; ++b) execute(data + b * distance, scratch.data());
+		});
+	}
+
+private:
+	size_t _n;
+	fft_direction _direction;
+	fft_scaling _scaling;
+	accumulation _acc;
+	std::vector<complex_type> _twiddles;
+	std::vector<complex_type> _scratch;
+
+	// multiply by r^k, where r = -i for the forward and +i for the inverse transform: exact in any number system
+	complex_type rotate(const complex_type& z, unsigned k) const {
+		if (_direction == fft_direction::inverse) k = (4 - k) & 3;
+		switch (k & 3) {
+		default:
+		case 0: return z;
+		case 1: return complex_type(z.imag(), -z.real());
+		case 2: return complex_type(-z.real(), -z.imag());
+		case 3: return complex_type(-z.imag(), z.real());
+		}
+	}
+
+	void execute(complex_type* data, complex_type* scratch) const {
+		complex_type* x = data;
+		complex_type* y = scratch;
+		size_t s = 1;
+		for (size_t length = _n; length > 1; ) {
+			if (length >= 4) {
+				if (_acc == accumulation::fused) radix4_fused(length, s, x, y); else radix4(length, s, x, y);
+				length /= 4;
+				s *= 4;
+			}
+			else {
+				radix2(s, x, y);
+				length /= 2;
+				s *= 2;
+			}
+			std::swap(x, y);
+		}
+		if (x != data) std::copy(x, x + _n, data);
+	}
+
+	// radix-4 stage on subsequences of the given length at stride s: y1 = w1 (a - c + r (b - d)), y3 = w3 (a - c - r (b - d))
+	void radix4(size_t length, size_t s, const complex_type* x, complex_type* y) const {
+		size_t m = length / 4;
+		bool scaled = (_scaling == fft_scaling::per_stage);
+		Scalar quarter(0.25);
+		for (size_t p = 0; p < m; ++p) {
+			const complex_type& w1 = _twiddles[p * s];
+			const complex_type& w2 = _twiddles[2 * p * s];
+			const complex_type& w3 = _twiddles[3 * p * s];
+			for (size_t q = 0; q < s; ++q) {
+				complex_type a = x[q + s * p], b = x[q + s * (p + m)], c = x[q + s * (p + 2 * m)], d = x[q + s * (p + 3 * m)];
+				if (scaled) {
+					a = complex_type(a.real() * quarter, a.imag() * quarter);
+					b = complex_type(b.real() * quarter, b.imag() * quarter);
+					c = complex_type(c.real() * quarter, c.imag() * quarter);
+					d = complex_type(d.real() * quarter, d.imag() * quarter);
+				}
+				complex_type apc(a.real() + c.real(), a.imag() + c.imag());
+				complex_type amc(a.real() - c.real(), a.imag() - c.imag());
+				complex_type bpd(b.real() + d.real(), b.imag() + d.imag());
+				complex_type rbmd = rotate(complex_type(b.real() - d.real(), b.imag() - d.imag()), 1);
+				y[q + s * (4 * p)]     = complex_type(apc.real() + bpd.real(), apc.imag() + bpd.imag());
+				y[q + s * (4 * p + 1)] = multiply(w1, complex_type(amc.real() + rbmd.real(), amc.imag() + rbmd.imag()));
+				y[q + s * (4 * p + 2)] = multiply(w2, complex_type(apc.real() - bpd.real(), apc.imag() - bpd.imag()));
+				y[q + s * (4 * p + 3)] = multiply(w3, complex_type(amc.real() - rbmd.real(), amc.imag() - rbmd.imag()));
+			}
+		}
+	}
+
+	// fused radix-4 stage: output j of a butterfly is w_j sum_k x_k r^(jk), one sum of eight products per component
+	void radix4_fused(size_t length, size_t s, const complex_type* x, complex_type* y) const {
+		size_t m = length / 4;
+		Scalar one(1), zero(0);
+		complex_type w0 = (_scaling == fft_scaling::per_stage) ? complex_type(Scalar(0.25), zero) : complex_type(one, zero);
+		blas::dot_accumulator<Scalar> re, im;
+		for (size_t p = 0; p < m; ++p) {
+			const complex_type w[4] = { w0, _twiddles[p * s], _twiddles[2 * p * s], _twiddles[3 * p * s] };
+			for (size_t q = 0; q < s; ++q) {
+				const complex_type in[4] = { x[q + s * p], x[q + s * (p + m)], x[q + s * (p + 2 * m)], x[q + s * (p + 3 * m)] };
+				for (unsigned j = 0; j < 4; ++j) {
+					re.reset();
+					im.reset();
+					for (unsigned k = 0; k < 4; ++k) {
+						complex_type c = rotate(w[j], j * k);
+						re.mac(in[k].real(), c.real());
+						re.msc(in[k].imag(), c.imag());
+						im.mac(in[k].real(), c.imag());
+						im.mac(in[k].imag(), c.real());
+					}
+					y[q + s * (4 * p + j)] = complex_type(re.value(), im.value());
+				}
+			}
+		}
+	}
+
+	// the radix-2 stage is the last stage: its subsequences have length 2 and all its twiddle factors are 1
+	void radix2(size_t s, const complex_type* x, complex_type* y) const {
+		bool scaled = (_scaling == fft_scaling::per_stage);
+		Scalar f = scaled ? Scalar(0.5) : Scalar(1);
+		for (size_t q = 0; q < s; ++q) {
+			complex_type a = x[q], b = x[q + s];
+			if (_acc == accumulation::fused) {
+				// f a + f b and f a - f b round once in the accumulator
+				y[q]     = fused_sum(a, b, f, false);
+				y[q + s] = fused_sum(a, b, f, true);
+				continue;
+			}
+			if (scaled) {
+				a = complex_type(a.real() * f, a.imag() * f);
+				b = complex_type(b.real() * f, b.imag() * f);
+			}
+			y[q]     = complex_type(a.real() + b.real(), a.imag() + b.imag());
+			y[q + s] = complex_type(a.real() - b.real(), a.imag() - b.imag());
+		}
+	}
+
+	static complex_type fused_sum(const complex_type& a, const complex_type& b, const Scalar& f, bool subtract) {
+		blas::dot_accumulator<Scalar> re, im;
+		re.mac(a.real(), f);
+		im.mac(a.imag(), f);
+		if (subtract) {
+			re.msc(b.real(), f);
+			im.msc(b.imag(), f);
+		}
+		else {
+			re.mac(b.real(), f);
+			im.mac(b.imag(), f);
+		}
+		return complex_type(re.value(), im.value());
+	}
+
+	static complex_type multiply(const complex_type& a, const complex_type& b) {
+		return complex_type(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+	}
+};
+
+// transform data in place with a plan made for this call
+template<typename Scalar>
+void fft(std::vector< std::complex<Scalar> >& data, fft_scaling scaling = fft_scaling::none, accumulation acc = accumulation::rounded) {
+	fft_plan<Scalar> plan(data.size(), fft_direction::forward, scaling, acc);
+	plan.transform(data);
+}
+template<typename Scalar>
+void ifft(std::vector< std::complex<Scalar> >& data, fft_scaling scaling = fft_scaling::none, accumulation acc = accumulation::rounded) {
+	fft_plan<Scalar> plan(data.size(), fft_direction::inverse, scaling, acc);
+	plan.transform(data);
+}
+
+} // namespace dsp
+} // namespace unum
+} // namespace sw
@@ -0,0 +1,221 @@
+#pragma once
+// filter.hpp: streaming FIR, IIR, and polyphase multirate filters with quire accumulation
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "../blas/accumulator.hpp"
+
+namespace sw {
+namespace unum {
+namespace dsp {
+
+using blas::accumulation;
+
+// The filters process a stream one sample or one block of samples per call. All storage is allocated when a filter
+// is constructed: processing a sample only writes into the ring buffer of the filter state and never allocates.
+// Each output sample is a sum of products of coefficients and samples: with fused accumulation the sum is collected
+// in a blas::dot_accumulator, for posits a quire, and rounds once, with rounded accumulation every product and
+// every partial sum rounds in the number system of the samples.
+
+// A ring_buffer holds the last capacity samples of a stream, newest first. Every sample is stored twice,
+// capacity elements apart, so that the window of the last capacity samples is always contiguous in memory.
+template<typename Scalar>
+class ring_buffer {
+public:
+	explicit ring_buffer(size_t capacity) : _capacity(capacity), _head(0), _data(2 * capacity, Scalar(0)) {
+		if (capacity == 0) throw std::invalid_argument("ring_buffer: capacity must be positive");
+	}
+
+	size_t capacity() const { return _capacity; }
+	void push(const Scalar& sample) {
+		_head = (_head == 0 ? _capacity : _head) - 1;
+		_data[_head] = sample;
+		_data[_head + _capacity] = sample;
+	}
+	// sample age ago: 0 is the newest sample
+	const Scalar& operator[](size_t age) const { return _data[_head + age]; }
+	// the last capacity samples, newest first
+	const Scalar* window() const { return _data.data() + _head; }
+	void reset() {
+		std::fill(_data.begin(), _data.end(), Scalar(0));
+		_head = 0;
+	}
+
+private:
+	size_t _capacity;
+	size_t _head;
+	std::vector<Scalar> _data;
+};
+
+namespace internal {
+
+// sum of coefficient[k] * window[k] for k in [0, n)
+template<typename Scalar>
+inline Scalar filter_dot(size_t n, const Scalar* coefficient, const Scalar* window, accumulation acc) {
+	if (acc == accumulation::fused) {
+		blas::dot_accumulator<Scalar> sum;
+		for (size_t k = 0; k < n; ++k) sum.mac(coefficient[k], window[k]);
+		return sum.value();
+	}
+	Scalar sum(0);
+	for (size_t k = 0; k < n; ++k) sum += coefficient[k] * window[k];
+	return sum;
+}
+
+} // namespace internal
+
+// fir_filter computes y[n] = sum h[k] x[n - k] for the taps h
+template<typename Scalar>
+class fir_filter {
+public:
+	fir_filter(const std::vector<Scalar>& taps, accumulation acc = accumulation::fused) : _taps(taps), _acc(acc), _history(std::max(size_t(1), taps.size())) {
+		if (taps.empty()) throw std::invalid_argument("fir_filter: no taps");
+	}
+
+	size_t taps() const { return _taps.size(); }
+	Scalar process(const Scalar& sample) {
+		_history.push(sample);
+		return internal::filter_dot(_taps.size(), _taps.data(), _history.window(), _acc);
+	}
+	// filter a block of n samples: out may alias in
+	void process(const Scalar* in, Scalar* out, size_t n) {
+		for (size_t i = 0; i < n; ++i) out[i] = process(in[i]);
+	}
+	void reset() { _history.reset(); }
+
+private:
+	std::vector<Scalar> _taps;
+	accumulation _acc;
+	ring_buffer<Scalar> _history;
+};
+
+// second-order section with a0 normalized to 1: y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+template<typename Scalar>
+struct biquad {
+	Scalar b0, b1, b2, a1, a2;
+};
+
+// iir_filter is a cascade of second-order sections in direct form I: the input and output history of every
+// section is kept, so each section output is a single sum of five products that rounds once when fused
+template<typename Scalar>
+class iir_filter {
+public:
+	iir_filter(const std::vector< biquad<Scalar> >& sections, accumulation acc = accumulation::fused) : _sections(sections), _acc(acc), _state(4 * sections.size(), Scalar(0)) {
+		if (sections.empty()) throw std::invalid_argument("iir_filter: no sections");
+	}
+
+	size_t sections() const { return _sections.size(); }
+	Scalar process(const Scalar& sample) {
+		Scalar x = sample;
+		for (size_t s = 0; s < _sections.size(); ++s) {
+			const biquad<Scalar>& c = _sections[s];
+			Scalar* z = _state.data() + 4 * s;  // x[n-1], x[n-2], y[n-1], y[n-2]
+			Scalar y;
+			if (_acc == accumulation::fused) {
+				blas::dot_accumulator<Scalar> sum;
+				sum.mac(c.b0, x);
+				sum.mac(c.b1, z[0]);
+				sum.mac(c.b2, z[1]);
+				sum.msc(c.a1, z[2]);
+				sum.msc(c.a2, z[3]);
+				y = sum.value();
+			}
+			else {
+				y = c.b0 * x + c.b1 * z[0] + c.b2 * z[1] - c.a1 * z[2] - c.a2 * z[3];
+			}
+			z[1] = z[0];
+			z[0] = x;
+			z[3] = z[2];
+			z[2] = y;
+			x = y;
+		}
+		return x;
+	}
+	void process(const Scalar* in, Scalar* out, size_t n) {
+		for (size_t i = 0; i < n; ++i) out[i] = process(in[i]);
+	}
+	void reset() { std::fill(_state.begin(), _state.end(), Scalar(0)); }
+
+private:
+	std::vector< biquad<Scalar> > _sections;
+	accumulation _acc;
+	std::vector<Scalar> _state;
+};
+
+// fir_decimator filters and keeps every factor-th output: y[m] = sum h[k] x[m * factor - k].
+// Only the kept outputs are computed, which is the work of the polyphase decomposition: taps / factor
+// products per input sample.
+template<typename Scalar>
+class fir_decimator {
+public:
+	fir_decimator(const std::vector<Scalar>& taps, size_t factor, accumulation acc = accumulation::fused)
+		: _taps(taps), _factor(factor), _acc(acc), _phase(0), _history(std::max(size_t(1), taps.size())) {
+		if (taps.empty() || factor == 0) throw std::invalid_argument("fir_decimator: no taps or a zero factor");
+	}
+
+	size_t factor() const { return _factor; }
+	// filter a block of n input samples, and return the number of output samples written to out
+	size_t process(const Scalar* in, Scalar* out, size_t n) {
+		size_t produced = 0;
+		for (size_t i = 0; i < n; ++i) {
+			_history.push(in[i]);
+			if (_phase == 0) out[produced++] = internal::filter_dot(_taps.size(), _taps.data(), _history.window(), _acc);
+			if (++_phase == _factor) _phase = 0;
+		}
+		return produced;
+	}
+	void reset() {
+		_history.reset();
+		_phase = 0;
+	}
+
+private:
+	std::vector<Scalar> _taps;
+	size_t _factor;
+	accumulation _acc;
+	size_t _phase;
+	ring_buffer<Scalar> _history;
+};
+
+// fir_interpolator inserts factor - 1 zeros after every input sample and filters the result. It is computed with the
+// polyphase decomposition: output j after an input uses the sub-filter h[j], h[j + factor], h[j + 2 factor], ...
+// on the input history, so the zeros are never multiplied. Taps designed for the upsampled rate have a gain of factor.
+template<typename Scalar>
+class fir_interpolator {
+public:
+	fir_interpolator(const std::vector<Scalar>& taps, size_t factor, accumulation acc = accumulation::fused)
+		: _factor(factor), _length(0), _acc(acc), _history(std::max(size_t(1), factor ? (taps.size() + factor - 1) / factor : 1)) {
+		if (taps.empty() || factor == 0) throw std::invalid_argument("fir_interpolator: no taps or a zero factor");
+		_length = (taps.size() + factor - 1) / factor;
+		_phases.assign(factor * _length, Scalar(0));
+		for (size_t k = 0; k < taps.size(); ++k) _phases[(k % factor) * _length + k / factor] = taps[k];
+	}
+
+	size_t factor() const { return _factor; }
+	// filter a block of n input samples into n * factor output samples
+	void process(const Scalar* in, Scalar* out, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			_history.push(in[i]);
+			for (size_t j = 0; j < _factor; ++j) {
+				*out++ = internal::filter_dot(_length, _phases.data() + j * _length, _history.window(), _acc);
+			}
+		}
+	}
+	void reset() { _history.reset(); }
+
+private:
+	size_t _factor;
+	size_t _length;                // taps per phase
+	accumulation _acc;
+	std::vector<Scalar> _phases;   // the sub-filters, one after the other
+	ring_buffer<Scalar> _history;
+};
+
+} // namespace dsp
+} // namespace unum
+} // namespace sw
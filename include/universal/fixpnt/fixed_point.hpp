@@ -334,6 +334,8 @@ public:
 		int radixPoint = 23 - (decoder.parts.exponent - 127); // move radix point to the right if scale > 0, left if scale < 0
 		// our fixed-point has its radixPoint at rbits
 		int shiftRight = radixPoint - int(rbits);
+		// values below half the smallest fixpnt value round to zero: this also keeps the shifts below the word size
+		if (shiftRight > 25) return *this;
 		// do we need to round?
 		if (shiftRight > 0) {
 			// yes, round the raw bits
@@ -392,6 +394,8 @@ public:
 		int radixPoint = 52 - (int(decoder.parts.exponent) - 1023);  // move radix point to the right if scale > 0, left if scale < 0
 		// our fixed-point has its radixPoint at rbits
 		int shiftRight = radixPoint - int(rbits);
+		// values below half the smallest fixpnt value round to zero: this also keeps the shifts below the word size
+		if (shiftRight > 54) return *this;
 		// do we need to round?
 		if (shiftRight > 0) {
 			// yes, round the raw bits
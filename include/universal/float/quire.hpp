@@ -182,7 +182,7 @@ public:
 		if (scale < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
-		if (rhs.sign()) {			// subtract
+		if (rhs.sign() != _sign) {	// subtract the magnitude of rhs from the magnitude of the quire
 			// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
 			int lsb = scale - int(fbits);  
 			bool borrow = false;
@@ -288,8 +288,10 @@ public:
 					}
 				}			
 			}
+			// the magnitude of rhs was larger: the accumulator holds the two's complement of the difference
+			if (borrow) negate();
 		}
-		else {			// add
+		else {			// add the magnitudes
 			// scale is the location of the msb in the fixed point representation
 			// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
 			// and scale = -1 is the first bit of the fraction
@@ -400,6 +402,9 @@ public:
 		}
 		return *this;
 	}
+	// add or subtract the value of another quire, exactly
+	quire& operator+=(const quire& rhs) { return accumulate(rhs, rhs._sign != _sign); }
+	quire& operator-=(const quire& rhs) { return accumulate(rhs, rhs._sign == _sign); }
 	// reset the state of a quire to zero
 	void reset() {
 		_sign  = false;
@@ -462,6 +467,44 @@ public:
 	}
 
 private:
+	static constexpr int accumulator_bits = int(half_range + upper_range + capacity);
+
+	// bit i of the accumulator, counting from the lsb of the lower through the upper to the capacity segment
+	bool bit(int i) const {
+		if (i < int(half_range)) return _lower[i];
+		if (i < int(half_range + upper_range)) return _upper[i - int(half_range)];
+		return _capacity[i - int(half_range + upper_range)];
+	}
+	void set_bit(int i, bool b) {
+		if (i < int(half_range)) _lower[i] = b;
+		else if (i < int(half_range + upper_range)) _upper[i - int(half_range)] = b;
+		else _capacity[i - int(half_range + upper_range)] = b;
+	}
+	// add the magnitude of rhs to the magnitude of the quire, or subtract it
+	quire& accumulate(const quire& rhs, bool subtract) {
+		if (rhs.iszero()) return *this;
+		bool carry = false;   // the borrow when subtracting
+		for (int i = 0; i < accumulator_bits; i++) {
+			bool _a = bit(i);
+			bool _b = rhs.bit(i);
+			set_bit(i, _a ^ _b ^ carry);
+			carry = subtract ? ((!_a & _b) | (!(_a ^ _b) & carry)) : ((_a & _b) | (carry & (_a ^ _b)));
+		}
+		if (subtract && carry) negate();
+		return *this;
+	}
+	// a subtraction that borrows out of the accumulator leaves the two's complement of the magnitude:
+	// negate the accumulator to restore the magnitude, and flip the sign
+	void negate() {
+		bool carry = true;
+		for (int i = 0; i < accumulator_bits; i++) {
+			bool _a = !bit(i);
+			set_bit(i, _a ^ carry);
+			carry = carry & _a;
+		}
+		_sign = !_sign;
+	}
+
 	bool				   _sign;
 	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
 	// TODO: don't pull a type from sw::unum
@@ -4,6 +4,7 @@
 // Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -13,6 +14,7 @@
 #include <map>
 
 #include "./integer_exceptions.hpp"
+#include "../native/word_arithmetic.hpp"
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -393,17 +395,14 @@ public:
 		return *this;
 	}
 	integer& operator*=(const integer& rhs) {
-		integer<nbits, BlockType> base(*this);
-		integer<nbits, BlockType> multiplicant(rhs);
-		clear();
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				operator+=(multiplicant);
-			}
-			multiplicant <<= 1;
-		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		// the lower nbits of the product of the bit patterns is the 2's complement product modulo 2^nbits:
+		// gather the bytes into 64-bit limbs for the multi-word dispatcher of native/word_arithmetic.hpp
+		constexpr size_t N = 1 + (nbits - 1) / 64;
+		uint64_t x[N], y[N], product[2 * N];
+		to_limbs(*this, x);
+		to_limbs(rhs, y);
+		limbs_multiply(x, y, product);
+		from_limbs(product, *this);
 		return *this;
 	}
 	integer& operator/=(const integer& rhs) {
@@ -998,58 +997,58 @@ void remainder(const integer<nbits, BlockType>& a, const integer<nbits, BlockTyp
 	remainder = divresult.rem;
 }
 
+// gather the bytes of an integer into 64-bit limbs
+template<size_t nbits, typename BlockType, size_t N>
+inline void to_limbs(const integer<nbits, BlockType>& v, uint64_t (&limbs)[N]) {
+	static_assert(64 * N >= nbits, "limbs too small to hold the integer");
+	for (size_t i = 0; i < N; ++i) limbs[i] = 0;
+	for (unsigned i = 0; i < integer<nbits, BlockType>::nrBytes; ++i) {
+		limbs[i / 8] |= uint64_t(v.byte(i)) << (8 * (i % 8));
+	}
+}
+
+// set an integer to the lower nbits of 64-bit limbs
+template<size_t nbits, typename BlockType, size_t N>
+inline void from_limbs(const uint64_t (&limbs)[N], integer<nbits, BlockType>& v) {
+	static_assert(64 * N >= nbits, "limbs too small to fill the integer");
+	constexpr unsigned MS_BYTE = integer<nbits, BlockType>::MS_BYTE;
+	for (unsigned i = 0; i < MS_BYTE; ++i) {
+		v.setbyte(i, uint8_t(limbs[i / 8] >> (8 * (i % 8))));
+	}
+	v.setbyte(MS_BYTE, uint8_t(limbs[MS_BYTE / 8] >> (8 * (MS_BYTE % 8))) & integer<nbits, BlockType>::MS_BYTE_MASK);
+}
+
 // divide integer<nbits, BlockType> a and b and return result argument
+// the magnitudes are divided by Knuth's Algorithm D on 64-bit limbs, with a single-limb divisor taking one
+// 128/64-bit division per quotient limb; the quotient truncates toward zero and the remainder takes the sign of a
 template<size_t nbits, typename BlockType>
 idiv_t<nbits, BlockType> idiv(const integer<nbits, BlockType>& _a, const integer<nbits, BlockType>& _b) {
+	idiv_t<nbits, BlockType> divresult;
 	if (_b == integer<nbits, BlockType>(0)) {
 #if INTEGER_THROW_ARITHMETIC_EXCEPTION
 		throw integer_divide_by_zero{};
 #else
 		std::cerr << "integer_divide_by_zero\n";
+		return divresult;
 #endif // INTEGER_THROW_ARITHMETIC_EXCEPTION
 	}
-	// generate the absolute values to do long division 
-	// 2's complement special case -max requires an signed int that is 1 bit bigger to represent abs()
+	// the negation of min_int is min_int, whose bit pattern read unsigned is its magnitude 2^(nbits-1)
 	bool a_negative = _a.sign();
 	bool b_negative = _b.sign();
 	bool result_negative = (a_negative ^ b_negative);
-	integer<nbits + 1, BlockType> a; a.bitcopy(a_negative ? -_a : _a);
-	integer<nbits + 1, BlockType> b; b.bitcopy(b_negative ? -_b : _b);
-	idiv_t<nbits, BlockType> divresult;
-	if (a < b) {
+	constexpr size_t N = 1 + (nbits - 1) / 64;
+	uint64_t a[N], b[N], q[N], r[N];
+	to_limbs(a_negative ? -_a : _a, a);
+	to_limbs(b_negative ? -_b : _b, b);
+	if (limbs_compare(a, b) < 0) {
 		divresult.rem = _a; // a % b = a when a / b = 0
 		return divresult; // a / b = 0 when b > a
 	}
-	// initialize the long division
-	integer<nbits + 1, BlockType> accumulator = a;
-	// prepare the subtractand
-	integer<nbits + 1, BlockType> subtractand = b;
-	int msb_b = findMsb(b);
-	int msb_a = findMsb(a);
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			divresult.quot.set(i);
-		}
-		else {
-			divresult.quot.reset(i);
-		}
-		subtractand >>= 1;
-	}
-	if (result_negative) {  // take 2's complement
-		divresult.quot.flip();
-		divresult.quot += 1;
-	} 
-	if (_a < integer<nbits, BlockType>(0)) {
-		divresult.rem = -accumulator;
-	}
-	else {
-		divresult.rem = accumulator;
-	}
-
+	limbs_divide_unsigned(a, b, q, r);
+	if (result_negative) limbs_negate(q);
+	if (a_negative) limbs_negate(r);
+	from_limbs(q, divresult.quot);
+	from_limbs(r, divresult.rem);
 	return divresult;
 }
 
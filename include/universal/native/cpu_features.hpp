@@ -0,0 +1,70 @@
+#pragma once
+// cpu_features.hpp: runtime detection of the SIMD instruction set extensions of the host processor
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// This file contains functions that DO NOT use the posit type.
+namespace sw {
+namespace unum {
+
+// SIMD instruction set levels that the vectorized kernels of the library are compiled for, in increasing order
+enum class simd_isa {
+	scalar = 0,
+	avx2   = 1,   // 256-bit integer SIMD
+	avx512 = 2    // 512-bit integer SIMD: AVX-512F and AVX-512CD
+};
+
+inline const char* to_string(simd_isa isa) {
+	switch (isa) {
+	case simd_isa::avx2:   return "AVX2";
+	case simd_isa::avx512: return "AVX-512";
+	default:               return "scalar";
+	}
+}
+
+namespace internal {
+
+inline simd_isa detect_simd_isa() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	// __builtin_cpu_supports also verifies that the operating system saves the extended register state
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd")) return simd_isa::avx512;
+	if (__builtin_cpu_supports("avx2")) return simd_isa::avx2;
+	return simd_isa::scalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return simd_isa::scalar;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx) return simd_isa::scalar;
+	unsigned long long xcr0 = _xgetbv(0);
+	if ((xcr0 & 0x6) != 0x6) return simd_isa::scalar;          // XMM and YMM state
+	__cpuidex(info, 7, 0);
+	bool avx2     = (info[1] & (1 << 5)) != 0;
+	bool avx512f  = (info[1] & (1 << 16)) != 0;
+	bool avx512cd = (info[1] & (1 << 28)) != 0;
+	if (avx512f && avx512cd && (xcr0 & 0xE6) == 0xE6) return simd_isa::avx512;   // opmask and ZMM state
+	if (avx2) return simd_isa::avx2;
+	return simd_isa::scalar;
+#else
+	return simd_isa::scalar;
+#endif
+}
+
+} // namespace internal
+
+// the highest SIMD instruction set level supported by the host processor, detected once
+inline simd_isa host_simd_isa() {
+	static const simd_isa isa = internal::detect_simd_isa();
+	return isa;
+}
+
+}  // namespace unum
+}  // namespace sw
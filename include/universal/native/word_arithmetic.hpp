@@ -0,0 +1,689 @@
+#pragma once
+// word_arithmetic.hpp: word-level arithmetic primitives on 64-bit unsigned integers
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+#include "bit_functions.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#pragma intrinsic(_BitScanReverse64)
+#pragma intrinsic(_umul128)
+#pragma intrinsic(_addcarry_u64)
+#pragma intrinsic(_subborrow_u64)
+#endif
+
+// These primitives are the building blocks of the word-native arithmetic engines:
+// they operate on 64-bit words and represent 128-bit intermediates as (hi, lo) word pairs.
+// Compilers that provide a native 128-bit integer type use it, otherwise a portable
+// 32-bit digit implementation is used.
+#if defined(__SIZEOF_INT128__)
+#define UNIVERSAL_NATIVE_INT128 1
+#else
+#define UNIVERSAL_NATIVE_INT128 0
+#endif
+
+namespace sw {
+namespace unum {
+
+#if UNIVERSAL_NATIVE_INT128
+__extension__ typedef unsigned __int128 uint128_native;
+#endif
+
+// count the number of leading zeros of a 64-bit word, returns 64 when the word is 0
+inline int countLeadingZeros(uint64_t x) {
+	if (x == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - int(index);
+#else
+	return 64 - int(findMostSignificantBit((unsigned long long)x));
+#endif
+}
+
+// number of set bits of a 64-bit word
+inline int countSetBits(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(x);
+#else
+	int count = 0;
+	for (; x; x &= x - 1) ++count;
+	return count;
+#endif
+}
+
+// sum of two 64-bit words and a carry in: returns the sum and replaces carry with the carry out
+inline uint64_t add_words(uint64_t a, uint64_t b, bool& carry) {
+#if defined(__clang__)
+	unsigned long long carry_out;
+	uint64_t sum = __builtin_addcll(a, b, carry ? 1ull : 0ull, &carry_out);
+	carry = carry_out != 0;
+	return sum;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long long sum;
+	carry = _addcarry_u64(carry ? 1 : 0, a, b, &sum) != 0;
+	return sum;
+#else
+	// gcc recognizes the carry idiom and emits an add-with-carry chain
+	uint64_t sum = a + b;
+	bool carry_out = sum < a;
+	uint64_t c = carry ? 1 : 0;
+	sum += c;
+	carry = carry_out || (sum < c);
+	return sum;
+#endif
+}
+
+// difference of two 64-bit words and a borrow in: returns the difference and replaces borrow with the borrow out
+inline uint64_t subtract_words(uint64_t a, uint64_t b, bool& borrow) {
+#if defined(__clang__)
+	unsigned long long borrow_out;
+	uint64_t difference = __builtin_subcll(a, b, borrow ? 1ull : 0ull, &borrow_out);
+	borrow = borrow_out != 0;
+	return difference;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long long difference;
+	borrow = _subborrow_u64(borrow ? 1 : 0, a, b, &difference) != 0;
+	return difference;
+#else
+	uint64_t difference = a - b;
+	bool borrow_out = a < b;
+	uint64_t c = borrow ? 1 : 0;
+	borrow = borrow_out || (difference < c);
+	return difference - c;
+#endif
+}
+
+// full product of two 64-bit words: returns the upper word and stores the lower word in lo
+inline uint64_t multiply_words(uint64_t a, uint64_t b, uint64_t& lo) {
+#if UNIVERSAL_NATIVE_INT128
+	uint128_native p = uint128_native(a) * b;
+	lo = uint64_t(p);
+	return uint64_t(p >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t hi;
+	lo = _umul128(a, b, &hi);
+	return hi;
+#else
+	uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+	uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+	uint64_t p0 = a_lo * b_lo;
+	uint64_t p1 = a_lo * b_hi;
+	uint64_t p2 = a_hi * b_lo;
+	uint64_t p3 = a_hi * b_hi;
+	uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFull) + (p2 & 0xFFFFFFFFull);
+	lo = (middle << 32) | (p0 & 0xFFFFFFFFull);
+	return p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+#endif
+}
+
+// divide the 128-bit value (hi, lo) by a 64-bit divisor: requires hi < divisor so that the quotient fits in a word
+// returns the quotient and stores the remainder in rem
+inline uint64_t divide_words(uint64_t hi, uint64_t lo, uint64_t divisor, uint64_t& rem) {
+#if UNIVERSAL_NATIVE_INT128
+	uint128_native n = (uint128_native(hi) << 64) | lo;
+	uint64_t q = uint64_t(n / divisor);
+	rem = uint64_t(n - uint128_native(q) * divisor);
+	return q;
+#else
+	// normalized two-digit long division with 32-bit digits (Hacker's Delight, divlu)
+	const uint64_t b = 0x100000000ull;
+	int s = countLeadingZeros(divisor);
+	divisor <<= s;
+	uint64_t vn1 = divisor >> 32;
+	uint64_t vn0 = divisor & 0xFFFFFFFFull;
+	uint64_t un32 = s == 0 ? hi : (hi << s) | (lo >> (64 - s));
+	uint64_t un10 = lo << s;
+	uint64_t un1 = un10 >> 32;
+	uint64_t un0 = un10 & 0xFFFFFFFFull;
+
+	uint64_t q1 = un32 / vn1;
+	uint64_t rhat = un32 - q1 * vn1;
+	while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+		--q1;
+		rhat += vn1;
+		if (rhat >= b) break;
+	}
+	uint64_t un21 = un32 * b + un1 - q1 * divisor;
+
+	uint64_t q0 = un21 / vn1;
+	rhat = un21 - q0 * vn1;
+	while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+		--q0;
+		rhat += vn1;
+		if (rhat >= b) break;
+	}
+	rem = (un21 * b + un0 - q0 * divisor) >> s;
+	return q1 * b + q0;
+#endif
+}
+
+// integer square root of the 128-bit value (hi, lo) with hi >= 2^62, so that the root occupies a full word
+// returns floor(sqrt(hi:lo)) and sets inexact when the root is not exact
+inline uint64_t sqrt_words(uint64_t hi, uint64_t lo, bool& inexact) {
+	// estimate the root of (hi:lo)/4 in double precision and refine it with one Newton step
+	uint64_t n_hi = hi >> 2;
+	uint64_t n_lo = (lo >> 2) | (hi << 62);
+	double estimate = std::sqrt(std::ldexp(double(n_hi), 64) + double(n_lo));
+	uint64_t y = estimate >= 9223372036854775808.0 ? 0x8000000000000000ull : uint64_t(estimate);
+	if (y <= n_hi) y = n_hi + 1;
+	uint64_t rem;
+	uint64_t q = divide_words(n_hi, n_lo, y, rem);
+	y = (y >> 1) + (q >> 1) + (y & q & 1);
+	uint64_t r = (y >> 63) ? 0xFFFFFFFFFFFFFFFFull : (y << 1);
+
+	// correct the estimate to floor(sqrt(hi:lo))
+	uint64_t p_lo, p_hi = multiply_words(r, r, p_lo);
+	while (p_hi > hi || (p_hi == hi && p_lo > lo)) {
+		--r;
+		p_hi = multiply_words(r, r, p_lo);
+	}
+	while (r != 0xFFFFFFFFFFFFFFFFull) {
+		uint64_t s_lo, s_hi = multiply_words(r + 1, r + 1, s_lo);
+		if (s_hi > hi || (s_hi == hi && s_lo > lo)) break;
+		++r;
+		p_hi = s_hi; p_lo = s_lo;
+	}
+	inexact = (p_hi != hi || p_lo != lo);
+	return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// multi-word arithmetic on arrays of 64-bit limbs
+//
+// A multi-word integer is a uint64_t array with the least significant limb at index 0.
+// The functions are templated on the number of limbs so that all loops have constant trip counts.
+
+// true when all limbs are zero
+template<size_t N>
+inline bool limbs_is_zero(const uint64_t (&x)[N]) {
+	uint64_t any = 0;
+	for (size_t i = 0; i < N; ++i) any |= x[i];
+	return any == 0;
+}
+
+// compare two multi-word integers: returns -1, 0, or 1
+template<size_t N>
+inline int limbs_compare(const uint64_t (&a)[N], const uint64_t (&b)[N]) {
+	for (size_t i = N; i-- > 0; ) {
+		if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+// number of leading zeros, returns 64*N when the value is 0
+template<size_t N>
+inline int limbs_clz(const uint64_t (&x)[N]) {
+	for (size_t i = N; i-- > 0; ) {
+		if (x[i]) return int(64 * (N - 1 - i)) + countLeadingZeros(x[i]);
+	}
+	return int(64 * N);
+}
+
+// x <<= shift
+template<size_t N>
+inline void limbs_shift_left(uint64_t (&x)[N], unsigned shift) {
+	if (shift == 0) return;
+	const size_t words = shift / 64;
+	const unsigned bits = shift % 64;
+	for (size_t i = N; i-- > 0; ) {
+		uint64_t v = 0;
+		if (i >= words) {
+			v = x[i - words] << bits;
+			if (bits && i > words) v |= x[i - words - 1] >> (64 - bits);
+		}
+		x[i] = v;
+	}
+}
+
+// x >>= shift, returns true when any of the bits shifted out was set
+template<size_t N>
+inline bool limbs_shift_right(uint64_t (&x)[N], unsigned shift) {
+	if (shift == 0) return false;
+	const size_t words = shift / 64;
+	const unsigned bits = shift % 64;
+	uint64_t sticky = 0;
+	for (size_t i = 0; i < N && i < words; ++i) sticky |= x[i];
+	if (bits && words < N) sticky |= x[words] << (64 - bits);
+	for (size_t i = 0; i < N; ++i) {
+		uint64_t v = 0;
+		if (i + words < N) {
+			v = x[i + words] >> bits;
+			if (bits && i + words + 1 < N) v |= x[i + words + 1] << (64 - bits);
+		}
+		x[i] = v;
+	}
+	return sticky != 0;
+}
+
+// x += y, returns the carry out
+template<size_t N>
+inline bool limbs_add(uint64_t (&x)[N], const uint64_t (&y)[N]) {
+	bool carry = false;
+	for (size_t i = 0; i < N; ++i) x[i] = add_words(x[i], y[i], carry);
+	return carry;
+}
+
+// x -= y, returns the borrow out
+template<size_t N>
+inline bool limbs_subtract(uint64_t (&x)[N], const uint64_t (&y)[N]) {
+	bool borrow = false;
+	for (size_t i = 0; i < N; ++i) x[i] = subtract_words(x[i], y[i], borrow);
+	return borrow;
+}
+
+// ++x, returns the carry out
+template<size_t N>
+inline bool limbs_increment(uint64_t (&x)[N]) {
+	for (size_t i = 0; i < N; ++i) {
+		if (++x[i] != 0) return false;
+	}
+	return true;
+}
+
+// --x, returns the borrow out
+template<size_t N>
+inline bool limbs_decrement(uint64_t (&x)[N]) {
+	for (size_t i = 0; i < N; ++i) {
+		if (x[i]-- != 0) return false;
+	}
+	return true;
+}
+
+// x = -x in two's complement
+template<size_t N>
+inline void limbs_negate(uint64_t (&x)[N]) {
+	for (size_t i = 0; i < N; ++i) x[i] = ~x[i];
+	limbs_increment(x);
+}
+
+// r[0, n) += x[0, m) with m <= n, returns the carry out of r[n - 1]
+inline bool limbs_add_into(uint64_t* r, size_t n, const uint64_t* x, size_t m) {
+	bool carry = false;
+	size_t i = 0;
+	for (; i < m; ++i) r[i] = add_words(r[i], x[i], carry);
+	for (; carry && i < n; ++i) r[i] = add_words(r[i], 0, carry);
+	return carry;
+}
+
+// r[0, n) -= x[0, m) with m <= n, returns the borrow out of r[n - 1]
+inline bool limbs_subtract_from(uint64_t* r, size_t n, const uint64_t* x, size_t m) {
+	bool borrow = false;
+	size_t i = 0;
+	for (; i < m; ++i) r[i] = subtract_words(r[i], x[i], borrow);
+	for (; borrow && i < n; ++i) r[i] = subtract_words(r[i], 0, borrow);
+	return borrow;
+}
+
+// operand sizes, in limbs, at which limbs_multiply switches algorithm: schoolbook below karatsuba_threshold,
+// Karatsuba from karatsuba_threshold, and Toom-3 from toom3_threshold. The crossovers are measured by perf/limb_multiply.cpp:
+// below 32 limbs, 2048 bits, the extra additions and copies of Karatsuba cost more than the partial products it saves,
+// and between 200 and 1000 limbs Toom-3 and Karatsuba trade places depending on where their recursions bottom out,
+// so Toom-3 only takes over from 1024 limbs, 65536 bits, where its five third-size products pull ahead
+constexpr size_t karatsuba_threshold = 32;
+constexpr size_t toom3_threshold = 1024;
+
+template<size_t N, size_t M>
+inline void limbs_multiply(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M]);
+
+// schoolbook product p = a * b of 64x64->128-bit partial products
+template<size_t N, size_t M>
+inline void limbs_multiply_schoolbook(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M]) {
+	static_assert(M == 2 * N, "product requires twice the number of limbs of the operands");
+	for (size_t i = 0; i < M; ++i) p[i] = 0;
+	for (size_t i = 0; i < N; ++i) {
+		uint64_t carry = 0;
+		for (size_t j = 0; j < N; ++j) {
+			uint64_t lo, hi = multiply_words(a[i], b[j], lo);
+			lo += carry;
+			hi += (lo < carry) ? 1 : 0;
+			p[i + j] += lo;
+			hi += (p[i + j] < lo) ? 1 : 0;
+			carry = hi;
+		}
+		p[i + N] = carry;
+	}
+}
+
+// Karatsuba product: with a = a1 B^L + a0 and b = b1 B^L + b0, a b = z2 B^2L + (z1 - z2 - z0) B^L + z0
+// for z0 = a0 b0, z2 = a1 b1, and z1 = (a0 + a1)(b0 + b1): three half-size products instead of four
+template<size_t N, size_t M>
+inline void limbs_multiply_karatsuba(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M]) {
+	static_assert(M == 2 * N, "product requires twice the number of limbs of the operands");
+	constexpr size_t L = N / 2, H = N - L;   // the high halves are at least as long as the low halves
+	uint64_t a0[H] = {}, a1[H], b0[H] = {}, b1[H];
+	for (size_t i = 0; i < L; ++i) { a0[i] = a[i]; b0[i] = b[i]; }
+	for (size_t i = 0; i < H; ++i) { a1[i] = a[L + i]; b1[i] = b[L + i]; }
+	uint64_t z0[2 * H], z2[2 * H], z1[2 * H + 1];
+	limbs_multiply(a0, b0, z0);
+	limbs_multiply(a1, b1, z2);
+	// the sums of the halves carry into a bit above H limbs: fold the carries into the middle product
+	bool ca = limbs_add_into(a0, H, a1, H);
+	bool cb = limbs_add_into(b0, H, b1, H);
+	uint64_t middle[2 * H];
+	limbs_multiply(a0, b0, middle);
+	for (size_t i = 0; i < 2 * H; ++i) z1[i] = middle[i];
+	z1[2 * H] = (ca && cb) ? 1 : 0;
+	if (ca) limbs_add_into(z1 + H, H + 1, b0, H);
+	if (cb) limbs_add_into(z1 + H, H + 1, a0, H);
+	limbs_subtract_from(z1, 2 * H + 1, z0, 2 * H);
+	limbs_subtract_from(z1, 2 * H + 1, z2, 2 * H);
+	// assemble: z0 occupies the low 2L limbs, z2 the high 2H limbs, and z1 adds in at limb L
+	for (size_t i = 0; i < 2 * L; ++i) p[i] = z0[i];
+	for (size_t i = 0; i < 2 * H; ++i) p[2 * L + i] = z2[i];
+	limbs_add_into(p + L, M - L, z1, (2 * H + 1 < M - L) ? 2 * H + 1 : M - L);
+}
+
+// x = x / 3 for a multiple of 3 in two's complement: exact division is multiplication by the inverse of 3 modulo 2^64N
+template<size_t N>
+inline void limbs_divide_exact_by_3(uint64_t (&x)[N]) {
+	constexpr uint64_t inverse = 0xAAAAAAAAAAAAAAABull; // 3 * inverse == 1 mod 2^64
+	uint64_t c = 0;
+	for (size_t i = 0; i < N; ++i) {
+		bool borrow = false;
+		uint64_t s = subtract_words(x[i], c, borrow);
+		uint64_t q = s * inverse;
+		uint64_t lo;
+		c = multiply_words(q, 3, lo) + (borrow ? 1 : 0);
+		x[i] = q;
+	}
+}
+
+// x = x / 2 for an even number in two's complement
+template<size_t N>
+inline void limbs_halve(uint64_t (&x)[N]) {
+	bool negative = (x[N - 1] >> 63) != 0;
+	limbs_shift_right(x, 1);
+	if (negative) x[N - 1] |= 0x8000000000000000ull;
+}
+
+// Toom-3 evaluation a0 - a1 + a2 and a0 - 2 a1 + 4 a2 of a three-way split, as magnitude and sign
+template<size_t K>
+inline void toom3_evaluate(const uint64_t (&a0)[K], const uint64_t (&a1)[K], const uint64_t (&a2)[K],
+	uint64_t (&at1)[K + 1], uint64_t (&atm1)[K + 1], bool& negm1, uint64_t (&atm2)[K + 1], bool& negm2) {
+	// a(1) = a0 + a1 + a2, and a(-1) = a0 + a2 - a1 from the shared a0 + a2
+	uint64_t even[K + 1];
+	for (size_t i = 0; i < K; ++i) even[i] = a0[i];
+	even[K] = 0;
+	limbs_add_into(even, K + 1, a2, K);
+	for (size_t i = 0; i <= K; ++i) at1[i] = even[i];
+	limbs_add_into(at1, K + 1, a1, K);
+	uint64_t a1x[K + 1];
+	for (size_t i = 0; i < K; ++i) a1x[i] = a1[i];
+	a1x[K] = 0;
+	negm1 = limbs_compare(even, a1x) < 0;
+	for (size_t i = 0; i <= K; ++i) atm1[i] = negm1 ? a1x[i] : even[i];
+	limbs_subtract_from(atm1, K + 1, negm1 ? even : a1x, K + 1);
+	// a(-2) = 2 (a(-1) + a2) - a0 in two's complement, magnitudes stay below 7 B^K
+	uint64_t t[K + 1];
+	for (size_t i = 0; i <= K; ++i) t[i] = atm1[i];
+	if (negm1) limbs_negate(t);
+	limbs_add_into(t, K + 1, a2, K);
+	limbs_shift_left(t, 1);
+	limbs_subtract_from(t, K + 1, a0, K);
+	negm2 = (t[K] >> 63) != 0;
+	if (negm2) limbs_negate(t);
+	for (size_t i = 0; i <= K; ++i) atm2[i] = t[i];
+}
+
+// signed product r = (-1)^(na ^ nb) a b in W-limb two's complement
+template<size_t K, size_t W>
+inline void toom3_signed_product(const uint64_t (&a)[K], bool na, const uint64_t (&b)[K], bool nb, uint64_t (&r)[W]) {
+	uint64_t p[2 * K];
+	limbs_multiply(a, b, p);
+	for (size_t i = 0; i < W; ++i) r[i] = (i < 2 * K) ? p[i] : 0;
+	if (na != nb) limbs_negate(r);
+}
+
+// Toom-3 product: a and b are split in three parts of K limbs, a = a2 B^2K + a1 B^K + a0, and the product is
+// interpolated from the five products of the evaluations at 0, 1, -1, -2, and infinity (Bodrato's sequence)
+template<size_t N, size_t M>
+inline void limbs_multiply_toom3(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M]) {
+	static_assert(M == 2 * N, "product requires twice the number of limbs of the operands");
+	constexpr size_t K = (N + 2) / 3;
+	constexpr size_t W = 2 * K + 3;   // two's complement width of the interpolation: |r(-2)| < 49 B^2K
+	uint64_t a0[K] = {}, a1[K] = {}, a2[K] = {}, b0[K] = {}, b1[K] = {}, b2[K] = {};
+	for (size_t i = 0; i < N; ++i) {
+		if (i < K) { a0[i] = a[i]; b0[i] = b[i]; }
+		else if (i < 2 * K) { a1[i - K] = a[i]; b1[i - K] = b[i]; }
+		else { a2[i - 2 * K] = a[i]; b2[i - 2 * K] = b[i]; }
+	}
+	uint64_t at1[K + 1], atm1[K + 1], atm2[K + 1], bt1[K + 1], btm1[K + 1], btm2[K + 1];
+	bool anm1, anm2, bnm1, bnm2;
+	toom3_evaluate(a0, a1, a2, at1, atm1, anm1, atm2, anm2);
+	toom3_evaluate(b0, b1, b2, bt1, btm1, bnm1, btm2, bnm2);
+
+	uint64_t r0[W], r1[W], rm1[W], rm2[W], rinf[W];
+	toom3_signed_product(a0, false, b0, false, r0);
+	toom3_signed_product(at1, false, bt1, false, r1);
+	toom3_signed_product(atm1, anm1, btm1, bnm1, rm1);
+	toom3_signed_product(atm2, anm2, btm2, bnm2, rm2);
+	toom3_signed_product(a2, false, b2, false, rinf);
+
+	// interpolation: r3 = (r(-2) - r(1)) / 3, r1 = (r(1) - r(-1)) / 2, r2 = r(-1) - r(0),
+	// r3 = (r2 - r3) / 2 + 2 r(inf), r2 = r2 + r1 - r(inf), r1 = r1 - r3
+	uint64_t r2[W], r3[W];
+	for (size_t i = 0; i < W; ++i) r3[i] = rm2[i];
+	limbs_subtract(r3, r1);
+	limbs_divide_exact_by_3(r3);
+	limbs_subtract(r1, rm1);
+	limbs_halve(r1);
+	for (size_t i = 0; i < W; ++i) r2[i] = rm1[i];
+	limbs_subtract(r2, r0);
+	limbs_subtract(r3, r2);
+	limbs_negate(r3);
+	limbs_halve(r3);
+	limbs_add(r3, rinf);
+	limbs_add(r3, rinf);
+	limbs_add(r2, r1);
+	limbs_subtract(r2, rinf);
+	limbs_subtract(r1, r3);
+
+	// recomposition: the coefficients are non-negative and their weighted sum fits in M limbs
+	for (size_t i = 0; i < M; ++i) p[i] = 0;
+	const uint64_t* coefficient[5] = { r0, r1, r2, r3, rinf };
+	for (size_t j = 0; j < 5; ++j) {
+		size_t offset = j * K;
+		if (offset >= M) break;
+		limbs_add_into(p + offset, M - offset, coefficient[j], (W < M - offset) ? W : M - offset);
+	}
+}
+
+template<size_t N, size_t M>
+inline void limbs_multiply(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M], std::integral_constant<int, 0>) {
+	limbs_multiply_schoolbook(a, b, p);
+}
+
+template<size_t N, size_t M>
+inline void limbs_multiply(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M], std::integral_constant<int, 1>) {
+	limbs_multiply_karatsuba(a, b, p);
+}
+
+template<size_t N, size_t M>
+inline void limbs_multiply(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M], std::integral_constant<int, 2>) {
+	limbs_multiply_toom3(a, b, p);
+}
+
+// full product p = a * b, dispatched on the operand size at compile time
+template<size_t N, size_t M>
+inline void limbs_multiply(const uint64_t (&a)[N], const uint64_t (&b)[N], uint64_t (&p)[M]) {
+	static_assert(M == 2 * N, "product requires twice the number of limbs of the operands");
+	limbs_multiply(a, b, p, std::integral_constant<int, (N >= toom3_threshold) ? 2 : (N >= karatsuba_threshold) ? 1 : 0>());
+}
+
+// long division with 64-bit digits (Knuth, TAOCP Vol 2, Algorithm D) on a dividend of m digits and a divisor of n digits,
+// 1 < n <= m: w holds the dividend plus one extra digit w[m], v is normalized, i.e. its most significant bit is set.
+// Computes the m - n + 1 quotient digits q[0..m-n] and leaves the remainder in w[0..n)
+inline void limbs_divide_digits(uint64_t* w, size_t m, const uint64_t* v, size_t n, uint64_t* q) {
+	for (size_t j = m - n + 1; j-- > 0; ) {
+		// estimate the quotient digit from the top two digits of the partial remainder
+		uint64_t qhat, rhat;
+		bool rhat_overflow = false;
+		if (w[j + n] >= v[n - 1]) {
+			qhat = 0xFFFFFFFFFFFFFFFFull;
+			rhat = w[j + n - 1] + v[n - 1];
+			rhat_overflow = rhat < v[n - 1];
+		}
+		else {
+			qhat = divide_words(w[j + n], w[j + n - 1], v[n - 1], rhat);
+		}
+		while (!rhat_overflow) {
+			uint64_t plo, phi = multiply_words(qhat, v[n - 2], plo);
+			if (phi < rhat || (phi == rhat && plo <= w[j + n - 2])) break;
+			--qhat;
+			rhat += v[n - 1];
+			rhat_overflow = rhat < v[n - 1];
+		}
+		// multiply and subtract qhat * v from the partial remainder
+		uint64_t borrow = 0, carry = 0;
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t plo, phi = multiply_words(qhat, v[i], plo);
+			plo += carry;
+			phi += (plo < carry) ? 1 : 0;
+			carry = phi;
+			uint64_t diff = w[i + j] - plo;
+			uint64_t b = (w[i + j] < plo) ? 1 : 0;
+			b += (diff < borrow) ? 1 : 0;
+			w[i + j] = diff - borrow;
+			borrow = b;
+		}
+		uint64_t top = w[j + n] - carry - borrow;
+		bool negative = (w[j + n] < carry) || (w[j + n] - carry < borrow);
+		w[j + n] = top;
+		if (negative) {
+			// qhat was one too large: add the divisor back
+			--qhat;
+			uint64_t c = 0;
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t sum = w[i + j] + c;
+				c = (sum < c) ? 1 : 0;
+				w[i + j] = sum + v[i];
+				c += (w[i + j] < sum) ? 1 : 0;
+			}
+			w[j + n] += c;
+		}
+		q[j] = qhat;
+	}
+}
+
+// long division q = u / v with 64-bit digits
+// requires a normalized divisor, i.e. the most significant bit of v is set, and a quotient
+// that fits in N limbs, i.e. the upper N limbs of u are smaller than v
+// stores the remainder in r and returns true when the remainder is not zero
+template<size_t N, size_t M>
+inline bool limbs_divide(const uint64_t (&u)[M], const uint64_t (&v)[N], uint64_t (&q)[N], uint64_t (&r)[N]) {
+	static_assert(M == 2 * N, "dividend requires twice the number of limbs of the divisor");
+	if (N == 1) {
+		uint64_t remainder;
+		q[0] = divide_words(u[1], u[0], v[0], remainder);
+		r[0] = remainder;
+		return remainder != 0;
+	}
+	// the top digit u[M - 1] serves as the extra digit of the dividend, as the quotient fits in N digits
+	uint64_t w[M];
+	for (size_t i = 0; i < M; ++i) w[i] = u[i];
+	limbs_divide_digits(w, M - 1, v, N, q);
+	uint64_t any = 0;
+	for (size_t i = 0; i < N; ++i) {
+		r[i] = w[i];
+		any |= w[i];
+	}
+	return any != 0;
+}
+
+// quotient q = floor(u / v) and remainder r = u - q * v of two N-limb integers
+// a zero divisor leaves the quotient and the remainder cleared: callers report the division by zero
+// the division only runs over the significant limbs: a divisor of n limbs and a dividend of m limbs
+// produce m - n + 1 quotient digits. A divisor that fits in a single limb takes one 128/64-bit division
+// per quotient limb; a wider divisor is normalized for Algorithm D, which leaves the quotient unchanged
+// and scales the remainder by the same shift
+// returns true when the remainder is not zero
+template<size_t N>
+inline bool limbs_divide_unsigned(const uint64_t (&u)[N], const uint64_t (&v)[N], uint64_t (&q)[N], uint64_t (&r)[N]) {
+	const size_t n = N - size_t(limbs_clz(v)) / 64;
+	const size_t m = N - size_t(limbs_clz(u)) / 64;
+	for (size_t i = 0; i < N; ++i) {
+		q[i] = 0;
+		r[i] = 0;
+	}
+	if (n == 0) return false;
+	if (m < n) {
+		// u < v
+		uint64_t any = 0;
+		for (size_t i = 0; i < m; ++i) {
+			r[i] = u[i];
+			any |= u[i];
+		}
+		return any != 0;
+	}
+	if (N == 1 || n == 1) {
+		uint64_t remainder = 0;
+		for (size_t i = m; i-- > 0; ) q[i] = divide_words(remainder, u[i], v[0], remainder);
+		r[0] = remainder;
+		return remainder != 0;
+	}
+	// normalize the divisor within its n limbs, the dividend shifts into its extra digit w[m]
+	const unsigned shift = unsigned(countLeadingZeros(v[n - 1]));
+	uint64_t w[N + 1], normalized_v[N];
+	for (size_t i = 0; i < n; ++i) {
+		normalized_v[i] = (v[i] << shift) | ((shift && i > 0) ? v[i - 1] >> (64 - shift) : 0);
+	}
+	w[m] = shift ? u[m - 1] >> (64 - shift) : 0;
+	for (size_t i = 0; i < m; ++i) {
+		w[i] = (u[i] << shift) | ((shift && i > 0) ? u[i - 1] >> (64 - shift) : 0);
+	}
+	limbs_divide_digits(w, m, normalized_v, n, q);
+	// denormalize the remainder
+	uint64_t any = 0;
+	for (size_t i = 0; i < n; ++i) {
+		r[i] = (w[i] >> shift) | ((shift && i + 1 < n) ? w[i + 1] << (64 - shift) : 0);
+		any |= r[i];
+	}
+	return any != 0;
+}
+
+// integer square root r = floor(sqrt(n)) of a multi-word radicand whose most significant limb is >= 2^62,
+// so that the root occupies all N limbs. Newton's iteration from an estimate above the root decreases
+// monotonically to the floor of the root. Returns true when the root is inexact.
+template<size_t N, size_t M>
+inline bool limbs_sqrt(const uint64_t (&n)[M], uint64_t (&r)[N]) {
+	static_assert(M == 2 * N, "radicand requires twice the number of limbs of the root");
+	// the root of the top two limbs, plus one, scaled up is an estimate at or above the root
+	bool top_inexact;
+	uint64_t top = sqrt_words(n[M - 1], n[M - 2], top_inexact);
+	for (size_t i = 0; i < N; ++i) r[i] = 0;
+	if (top == 0xFFFFFFFFFFFFFFFFull) {
+		for (size_t i = 0; i < N; ++i) r[i] = 0xFFFFFFFFFFFFFFFFull;
+	}
+	else {
+		r[N - 1] = top + 1;
+	}
+	if (N == 1) {
+		r[0] = top;
+		return top_inexact;
+	}
+	uint64_t q[N], rem[N];
+	for (;;) {
+		limbs_divide(n, r, q, rem);
+		// next = (r + q) / 2 with the carry of the sum shifted back in
+		bool carry = limbs_add(q, r);
+		limbs_shift_right(q, 1);
+		if (carry) q[N - 1] |= 0x8000000000000000ull;
+		if (limbs_compare(q, r) >= 0) break;
+		for (size_t i = 0; i < N; ++i) r[i] = q[i];
+	}
+	uint64_t square[M];
+	limbs_multiply(r, r, square);
+	return limbs_compare(square, n) != 0;
+}
+
+}  // namespace unum
+}  // namespace sw
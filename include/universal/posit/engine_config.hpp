@@ -0,0 +1,36 @@
+#pragma once
+// engine_config.hpp: defaults of the switches that select the posit arithmetic engines
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Each switch can be set by the calling environment before including the library:
+// <posit>, posit.hpp, posit_array.hpp, and lane_engine.hpp all include this file,
+// so a switch has the same value in every header that tests it.
+
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable the word-native arithmetic engine for posits with nbits <= 64
+#if !defined(POSIT_WORD_ENGINE)
+// default is to use the word-native engine, set to 0 to use the bitblock reference arithmetic
+#define POSIT_WORD_ENGINE 1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable the table-driven lookup engine for posit<8,es> configurations
+#if !defined(POSIT_LOOKUP_POSIT_8)
+// default is to compute, set to 1 to replace the arithmetic, reciprocal, sqrt, exp, and log by table lookups
+// that take 257KB per exponent configuration
+#define POSIT_LOOKUP_POSIT_8 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable the vectorized AVX2/AVX-512 kernels of the posit array operators
+#if !defined(POSIT_ARRAY_SIMD)
+// default follows the USE_AVX2 build option, the kernel is selected at run time from the host capabilities
+#if defined(LIB_USE_AVX2) && (defined(__x86_64__) || defined(_M_X64))
+#define POSIT_ARRAY_SIMD 1
+#else
+#define POSIT_ARRAY_SIMD 0
+#endif
+#endif
@@ -6,6 +6,9 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
 #include <vector>
+#include <thread>
+#include <algorithm>
+#include <exception>
 
 namespace sw {
 	namespace unum {
@@ -29,13 +32,22 @@ Ty dot(size_t n, const std::vector<Ty>& x, size_t incx, const std::vector<Ty>& y
 /// fdp_qc         fused dot product with quire continuation
 /// fdp_stride     fused dot product with non-negative stride
 /// fdp            fused dot product of two vectors
+/// fdp_stride_parallel, fdp_parallel
+///                the fused dot products with the elements split across threads
+///
+/// The products are accumulated with quire::mac, which multiplies the integer significands of
+/// each pair of posits and adds the exact product into the quire limbs.
+/// The parallel versions accumulate each block of elements into a quire of its own thread and
+/// add the quires limb by limb: the quire sum is exact, so the result does not depend on the
+/// number of threads and is rounded once, like the sequential fused dot product.
+/// A NaR element makes the dot product NaR, or throws operand_is_nar when POSIT_THROW_ARITHMETIC_EXCEPTION is set.
 
 // Fused dot product with quire continuation
 template<typename Qy, typename Vector>
 void fdp_qc(Qy& sum_of_products, size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
 	size_t ix, iy;
 	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		sum_of_products += sw::unum::quire_mul(x[ix], y[iy]);
+		sum_of_products.mac(x[ix], y[iy]);
 	}
 }
 
@@ -44,10 +56,10 @@ template<typename Vector, size_t capacity = 10>
 typename Vector::value_type fdp_stride(size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
 	constexpr size_t nbits = Vector::value_type::nbits;
 	constexpr size_t es = Vector::value_type::es;
-	quire<nbits, es, capacity> q = 0;
+	quire<nbits, es, capacity> q(0);
 	size_t ix, iy;
 	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
+		q.mac(x[ix], y[iy]);
 		if (sw::unum::_trace_quire_add) std::cout << q << '\n';
 	}
 	typename Vector::value_type sum;
@@ -66,7 +78,7 @@ typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 	quire<nbits, es, capacity> q(0);
 	size_t ix, iy, n = size(x);
 	for (ix = 0, iy = 0; ix < n && iy < n; ++ix, ++iy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
+		q.mac(x[ix], y[iy]);
 	}
 	typename Vector::value_type sum;
 	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
@@ -82,7 +94,7 @@ typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 	quire<nbits, es, capacity> q(0);
 	size_t ix, iy, n = x.size();
 	for (ix = 0, iy = 0; ix < n && iy < n; ++ix, ++iy) {
-		q += sw::unum::quire_mul(x[ix], y[iy]);
+		q.mac(x[ix], y[iy]);
 	}
 	typename Vector::value_type sum;
 	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
@@ -90,6 +102,76 @@ typename Vector::value_type fdp(const Vector& x, const Vector& y) {
 }
 #endif
 
+namespace internal {
+
+// smallest number of elements worth a thread of its own
+constexpr size_t fdp_elements_per_thread = 8192;
+
+// accumulate the products of elements [first, last) of a pair of strided vectors
+template<typename Quire, typename Vector>
+void fdp_block(Quire& sum_of_products, size_t first, size_t last, const Vector& x, size_t incx, const Vector& y, size_t incy) {
+	Quire q;   // thread-local: the partial sums of different threads do not share cache lines
+	for (size_t i = first; i < last; ++i) {
+		q.mac(x[i * incx], y[i * incy]);
+	}
+	sum_of_products = q;
+}
+
+// the worker thread of fdp_block: an exception, such as operand_is_nar, is handed to the calling thread
+template<typename Quire, typename Vector>
+void fdp_block_worker(Quire& sum_of_products, std::exception_ptr& error, size_t first, size_t last, const Vector& x, size_t incx, const Vector& y, size_t incy) {
+	try {
+		fdp_block(sum_of_products, first, last, x, incx, y, incy);
+	}
+	catch (...) {
+		error = std::current_exception();
+	}
+}
+
+} // namespace internal
+
+// Resolved fused dot product with non-negative stride, with the elements split across nrThreads threads,
+// where 0 selects the hardware concurrency of the host
+template<typename Vector, size_t capacity = 10>
+typename Vector::value_type fdp_stride_parallel(size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy, unsigned nrThreads = 0) {
+	constexpr size_t nbits = Vector::value_type::nbits;
+	constexpr size_t es = Vector::value_type::es;
+	using Quire = quire<nbits, es, capacity>;
+	// same elements as fdp_stride: ix and iy stay below n
+	size_t nrElementsX = (incx == 0) ? size_t(-1) : (n + incx - 1) / incx;
+	size_t nrElementsY = (incy == 0) ? size_t(-1) : (n + incy - 1) / incy;
+	size_t nrElements = (incx == 0 && incy == 0) ? 0 : std::min(nrElementsX, nrElementsY);
+	if (nrThreads == 0) nrThreads = std::max(1u, std::thread::hardware_concurrency());
+	size_t maxThreads = std::max(size_t(1), nrElements / internal::fdp_elements_per_thread);
+	if (nrThreads > maxThreads) nrThreads = unsigned(maxThreads);
+
+	std::vector<Quire> partial(nrThreads);
+	std::vector<std::exception_ptr> errors(nrThreads);
+	std::vector<std::thread> workers;
+	size_t blockSize = (nrElements + nrThreads - 1) / nrThreads;
+	for (unsigned t = 1; t < nrThreads; ++t) {
+		size_t first = std::min(nrElements, t * blockSize);
+		size_t last = std::min(nrElements, first + blockSize);
+		workers.emplace_back(internal::fdp_block_worker<Quire, Vector>, std::ref(partial[t]), std::ref(errors[t]), first, last, std::cref(x), incx, std::cref(y), incy);
+	}
+	internal::fdp_block_worker(partial[0], errors[0], 0, std::min(nrElements, blockSize), x, incx, y, incy);
+	for (std::thread& worker : workers) worker.join();
+	for (const std::exception_ptr& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+
+	Quire q = partial[0];
+	for (unsigned t = 1; t < nrThreads; ++t) q += partial[t];   // exact limb-level merge
+	typename Vector::value_type sum;
+	convert(q.to_value(), sum);     // one and only rounding step of the fused-dot product
+	return sum;
+}
+
+// Resolved fused dot product of two vectors, with the elements split across nrThreads threads
+template<typename Vector, size_t capacity = 10>
+typename Vector::value_type fdp_parallel(const Vector& x, const Vector& y, unsigned nrThreads = 0) {
+	return fdp_stride_parallel<Vector, capacity>(std::min(x.size(), y.size()), x, 1, y, 1, nrThreads);
+}
+
 } // namespace unum
 } // namespace sw
-
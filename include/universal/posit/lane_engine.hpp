@@ -0,0 +1,584 @@
+#pragma once
+// lane_engine.hpp: SIMD arithmetic engine that processes 8 or 16 posit encodings in parallel lanes
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "../native/cpu_features.hpp"
+#include "engine_config.hpp"
+
+#if POSIT_ARRAY_SIMD
+#include <immintrin.h>
+#endif
+
+namespace sw {
+namespace unum {
+
+// element-wise operators that have a vectorized kernel
+enum class lane_op {
+	add,
+	sub,
+	mul,
+	negate
+};
+
+// configurations without vectorized kernels process no elements and leave all the work to the scalar loop
+template<size_t nbits, size_t es>
+struct posit_lane_kernels {
+	static size_t apply(lane_op, simd_isa, const void*, const void*, void*, size_t, bool) { return 0; }
+	template<unsigned ebits, unsigned mbits, bool to_ieee>
+	static size_t convert(simd_isa, const void*, void*, size_t) { return 0; }
+};
+
+#if POSIT_ARRAY_SIMD
+
+// The lane engine is the SIMD counterpart of the word engine in word_engine.hpp.
+// A posit<nbits,es> encoding is zero-extended into a lane of at least 2*nbits bits:
+// posit<16,1> in 32-bit lanes, 8 per AVX2 register and 16 per AVX-512 register, and
+// posit<32,2> in 64-bit lanes, 4 per AVX2 register and 8 per AVX-512 register.
+// The regimes of all lanes are decoded at once with a vector leading zero count, the significands
+// are kept right-aligned with the hidden bit at bit fbits so that a product of two significands
+// fits a lane, and encode rounds to nearest even on the posit bit string, like word_encode.
+//
+// The kernels are compiled for their instruction set with target attributes, so that a build without
+// -mavx2 or -mavx512f carries them as well: posit_array.hpp selects the kernel that the host supports at run time.
+#if defined(__GNUC__) || defined(__clang__)
+#define POSIT_TARGET_AVX2   __attribute__((target("avx2")))
+#define POSIT_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512cd")))
+// the generic lane engine has no target of its own: flatten inlines it into the kernel of each instruction set
+#define POSIT_LANE_KERNEL   __attribute__((flatten))
+#else
+#define POSIT_TARGET_AVX2
+#define POSIT_TARGET_AVX512
+#define POSIT_LANE_KERNEL
+#endif
+
+// 8 lanes of 32 bits holding 16-bit encodings
+struct avx2_lanes32 {
+	using vec = __m256i;
+	using mask = __m256i;
+	using lane = uint32_t;
+	static constexpr unsigned width = 32;
+	static constexpr size_t lanes = 8;
+
+	POSIT_TARGET_AVX2 static inline vec set1(lane v)             { return _mm256_set1_epi32(int(v)); }
+	POSIT_TARGET_AVX2 static inline vec add(vec a, vec b)        { return _mm256_add_epi32(a, b); }
+	POSIT_TARGET_AVX2 static inline vec sub(vec a, vec b)        { return _mm256_sub_epi32(a, b); }
+	POSIT_TARGET_AVX2 static inline vec band(vec a, vec b)       { return _mm256_and_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec bor(vec a, vec b)        { return _mm256_or_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec bxor(vec a, vec b)       { return _mm256_xor_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec sll(vec a, vec count)    { return _mm256_sllv_epi32(a, count); }   // counts >= 32 yield 0
+	POSIT_TARGET_AVX2 static inline vec srl(vec a, vec count)    { return _mm256_srlv_epi32(a, count); }
+	POSIT_TARGET_AVX2 static inline mask eq(vec a, vec b)        { return _mm256_cmpeq_epi32(a, b); }
+	POSIT_TARGET_AVX2 static inline mask gt(vec a, vec b)        { return _mm256_cmpgt_epi32(a, b); }      // signed
+	POSIT_TARGET_AVX2 static inline mask mand(mask a, mask b)    { return _mm256_and_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline mask mor(mask a, mask b)     { return _mm256_or_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline mask mnot(mask a)            { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+	POSIT_TARGET_AVX2 static inline vec select(mask m, vec a, vec b) { return _mm256_blendv_epi8(b, a, m); }
+	// product of operands smaller than 2^16
+	POSIT_TARGET_AVX2 static inline vec mul(vec a, vec b)        { return _mm256_mullo_epi32(a, b); }
+	// leading zero count: the exponent of the conversion to float, which is exact for the 24 most significant bits
+	POSIT_TARGET_AVX2 static inline vec clz(vec a) {
+		vec top = _mm256_srli_epi32(a, 8);
+		mask small = _mm256_cmpeq_epi32(top, _mm256_setzero_si256());
+		vec x = _mm256_blendv_epi8(top, a, small);
+		vec exponent = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(x)), 23);
+		vec count = _mm256_sub_epi32(_mm256_set1_epi32(127 + 31), exponent);
+		count = _mm256_blendv_epi8(_mm256_sub_epi32(count, _mm256_set1_epi32(8)), count, small);
+		return _mm256_min_epu32(count, _mm256_set1_epi32(32));   // a zero lane converts to exponent 0
+	}
+	POSIT_TARGET_AVX2 static inline vec load(const void* p) {
+		return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+	}
+	POSIT_TARGET_AVX2 static inline void store(void* p, vec a) {
+		vec packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, a), 0xD8);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+	}
+	// lanes filled by 32-bit elements, such as floats
+	POSIT_TARGET_AVX2 static inline vec load_full(const void* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	POSIT_TARGET_AVX2 static inline void store_full(void* p, vec a)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+};
+
+// 4 lanes of 64 bits holding 32-bit encodings
+struct avx2_lanes64 {
+	using vec = __m256i;
+	using mask = __m256i;
+	using lane = uint64_t;
+	static constexpr unsigned width = 64;
+	static constexpr size_t lanes = 4;
+
+	POSIT_TARGET_AVX2 static inline vec set1(lane v)             { return _mm256_set1_epi64x((long long)v); }
+	POSIT_TARGET_AVX2 static inline vec add(vec a, vec b)        { return _mm256_add_epi64(a, b); }
+	POSIT_TARGET_AVX2 static inline vec sub(vec a, vec b)        { return _mm256_sub_epi64(a, b); }
+	POSIT_TARGET_AVX2 static inline vec band(vec a, vec b)       { return _mm256_and_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec bor(vec a, vec b)        { return _mm256_or_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec bxor(vec a, vec b)       { return _mm256_xor_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline vec sll(vec a, vec count)    { return _mm256_sllv_epi64(a, count); }   // counts >= 64 yield 0
+	POSIT_TARGET_AVX2 static inline vec srl(vec a, vec count)    { return _mm256_srlv_epi64(a, count); }
+	POSIT_TARGET_AVX2 static inline mask eq(vec a, vec b)        { return _mm256_cmpeq_epi64(a, b); }
+	POSIT_TARGET_AVX2 static inline mask gt(vec a, vec b)        { return _mm256_cmpgt_epi64(a, b); }      // signed
+	POSIT_TARGET_AVX2 static inline mask mand(mask a, mask b)    { return _mm256_and_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline mask mor(mask a, mask b)     { return _mm256_or_si256(a, b); }
+	POSIT_TARGET_AVX2 static inline mask mnot(mask a)            { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+	POSIT_TARGET_AVX2 static inline vec select(mask m, vec a, vec b) { return _mm256_blendv_epi8(b, a, m); }
+	// product of operands smaller than 2^32
+	POSIT_TARGET_AVX2 static inline vec mul(vec a, vec b)        { return _mm256_mul_epu32(a, b); }
+	// leading zero count: combine the counts of the two 32-bit halves
+	POSIT_TARGET_AVX2 static inline vec clz(vec a) {
+		vec count = avx2_lanes32::clz(a);
+		vec upper = _mm256_srli_epi64(count, 32);
+		vec lower = _mm256_and_si256(count, _mm256_set1_epi64x(0xFFFFFFFFll));
+		mask upper_is_zero = _mm256_cmpeq_epi64(upper, _mm256_set1_epi64x(32));
+		return _mm256_blendv_epi8(upper, _mm256_add_epi64(upper, lower), upper_is_zero);
+	}
+	POSIT_TARGET_AVX2 static inline vec load(const void* p) {
+		return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+	}
+	POSIT_TARGET_AVX2 static inline void store(void* p, vec a) {
+		vec packed = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+	}
+	// lanes filled by 64-bit elements, such as doubles
+	POSIT_TARGET_AVX2 static inline vec load_full(const void* p)     { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	POSIT_TARGET_AVX2 static inline void store_full(void* p, vec a)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+};
+
+// 16 lanes of 32 bits holding 16-bit encodings
+struct avx512_lanes32 {
+	using vec = __m512i;
+	using mask = __mmask16;
+	using lane = uint32_t;
+	static constexpr unsigned width = 32;
+	static constexpr size_t lanes = 16;
+	// the zero-masked forms of the intrinsics avoid the undefined pass-through operand of the unmasked forms
+	static constexpr mask all = 0xFFFF;
+
+	POSIT_TARGET_AVX512 static inline vec set1(lane v)             { return _mm512_set1_epi32(int(v)); }
+	POSIT_TARGET_AVX512 static inline vec add(vec a, vec b)        { return _mm512_add_epi32(a, b); }
+	POSIT_TARGET_AVX512 static inline vec sub(vec a, vec b)        { return _mm512_sub_epi32(a, b); }
+	POSIT_TARGET_AVX512 static inline vec band(vec a, vec b)       { return _mm512_and_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec bor(vec a, vec b)        { return _mm512_or_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec bxor(vec a, vec b)       { return _mm512_xor_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec sll(vec a, vec count)    { return _mm512_maskz_sllv_epi32(all, a, count); }
+	POSIT_TARGET_AVX512 static inline vec srl(vec a, vec count)    { return _mm512_maskz_srlv_epi32(all, a, count); }
+	POSIT_TARGET_AVX512 static inline mask eq(vec a, vec b)        { return _mm512_cmpeq_epi32_mask(a, b); }
+	POSIT_TARGET_AVX512 static inline mask gt(vec a, vec b)        { return _mm512_cmpgt_epi32_mask(a, b); }
+	POSIT_TARGET_AVX512 static inline mask mand(mask a, mask b)    { return mask(a & b); }
+	POSIT_TARGET_AVX512 static inline mask mor(mask a, mask b)     { return mask(a | b); }
+	POSIT_TARGET_AVX512 static inline mask mnot(mask a)            { return mask(~a); }
+	POSIT_TARGET_AVX512 static inline vec select(mask m, vec a, vec b) { return _mm512_mask_blend_epi32(m, b, a); }
+	POSIT_TARGET_AVX512 static inline vec mul(vec a, vec b)        { return _mm512_mullo_epi32(a, b); }
+	POSIT_TARGET_AVX512 static inline vec clz(vec a)               { return _mm512_lzcnt_epi32(a); }
+	POSIT_TARGET_AVX512 static inline vec load(const void* p) {
+		return _mm512_maskz_cvtepu16_epi32(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+	}
+	POSIT_TARGET_AVX512 static inline void store(void* p, vec a) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvtepi32_epi16(all, a));
+	}
+	POSIT_TARGET_AVX512 static inline vec load_full(const void* p)     { return _mm512_loadu_si512(p); }
+	POSIT_TARGET_AVX512 static inline void store_full(void* p, vec a)  { _mm512_storeu_si512(p, a); }
+};
+
+// 8 lanes of 64 bits holding 32-bit encodings
+struct avx512_lanes64 {
+	using vec = __m512i;
+	using mask = __mmask8;
+	using lane = uint64_t;
+	static constexpr unsigned width = 64;
+	static constexpr size_t lanes = 8;
+	static constexpr mask all = 0xFF;
+
+	POSIT_TARGET_AVX512 static inline vec set1(lane v)             { return _mm512_set1_epi64((long long)v); }
+	POSIT_TARGET_AVX512 static inline vec add(vec a, vec b)        { return _mm512_add_epi64(a, b); }
+	POSIT_TARGET_AVX512 static inline vec sub(vec a, vec b)        { return _mm512_sub_epi64(a, b); }
+	POSIT_TARGET_AVX512 static inline vec band(vec a, vec b)       { return _mm512_and_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec bor(vec a, vec b)        { return _mm512_or_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec bxor(vec a, vec b)       { return _mm512_xor_si512(a, b); }
+	POSIT_TARGET_AVX512 static inline vec sll(vec a, vec count)    { return _mm512_maskz_sllv_epi64(all, a, count); }
+	POSIT_TARGET_AVX512 static inline vec srl(vec a, vec count)    { return _mm512_maskz_srlv_epi64(all, a, count); }
+	POSIT_TARGET_AVX512 static inline mask eq(vec a, vec b)        { return _mm512_cmpeq_epi64_mask(a, b); }
+	POSIT_TARGET_AVX512 static inline mask gt(vec a, vec b)        { return _mm512_cmpgt_epi64_mask(a, b); }
+	POSIT_TARGET_AVX512 static inline mask mand(mask a, mask b)    { return mask(a & b); }
+	POSIT_TARGET_AVX512 static inline mask mor(mask a, mask b)     { return mask(a | b); }
+	POSIT_TARGET_AVX512 static inline mask mnot(mask a)            { return mask(~a); }
+	POSIT_TARGET_AVX512 static inline vec select(mask m, vec a, vec b) { return _mm512_mask_blend_epi64(m, b, a); }
+	POSIT_TARGET_AVX512 static inline vec mul(vec a, vec b)        { return _mm512_maskz_mul_epu32(all, a, b); }
+	POSIT_TARGET_AVX512 static inline vec clz(vec a)               { return _mm512_lzcnt_epi64(a); }
+	POSIT_TARGET_AVX512 static inline vec load(const void* p) {
+		return _mm512_maskz_cvtepu32_epi64(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+	}
+	POSIT_TARGET_AVX512 static inline void store(void* p, vec a) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_maskz_cvtepi64_epi32(all, a));
+	}
+	POSIT_TARGET_AVX512 static inline vec load_full(const void* p)     { return _mm512_loadu_si512(p); }
+	POSIT_TARGET_AVX512 static inline void store_full(void* p, vec a)  { _mm512_storeu_si512(p, a); }
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// the engine functions are only ever inlined into the kernels, which carry the target of the instruction set
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+// posit<nbits,es> arithmetic on the lanes of L
+template<typename L, size_t nbits, size_t es>
+struct posit_lanes {
+	using vec = typename L::vec;
+	using mask = typename L::mask;
+	using lane = typename L::lane;
+	static constexpr unsigned width = L::width;
+	static constexpr unsigned fbits = unsigned(nbits - 3 - es);
+	// guard bits of the addition: enough to never shift the sum left after a cancellation
+	static constexpr unsigned gbits = width - fbits - 3;
+	static constexpr lane nar = lane(1) << (nbits - 1);
+	static constexpr lane encoding_mask = (lane(1) << nbits) - 1;
+	static constexpr lane maxpos = nar - 1;
+	static constexpr lane max_scale = lane(nbits - 2) << es;
+	static_assert(2 * nbits <= width, "lane engine requires lanes of at least 2*nbits bits");
+	static_assert(fbits > 0, "lane engine requires at least one fraction bit");
+	static_assert(gbits >= fbits + 2, "lane engine requires room for the guard bits of the addition");
+
+	// sign and magnitude of an encoding
+	static inline void magnitude(const vec& bits, mask& negative, vec& magnitude) {
+		negative = L::eq(L::srl(bits, L::set1(nbits - 1)), L::set1(1));
+		magnitude = L::select(negative, L::band(L::sub(L::set1(0), bits), L::set1(encoding_mask)), bits);
+	}
+
+	// decode the magnitude of a non-zero encoding into scale and a significand with the hidden bit at bit fbits
+	static inline void decode(const vec& magnitude, vec& scale, vec& significand) {
+		vec regime = L::sll(magnitude, L::set1(width - nbits + 1));   // the regime starts at the most significant bit
+		mask ones = L::eq(L::srl(regime, L::set1(width - 1)), L::set1(1));
+		vec run = L::clz(L::select(ones, L::bxor(regime, L::set1(~lane(0))), regime));
+		vec k = L::select(ones, L::sub(run, L::set1(1)), L::sub(L::set1(0), run));
+		vec rest = L::sll(regime, L::add(run, L::set1(1)));
+		vec e = (es > 0) ? L::srl(rest, L::set1(width - es)) : L::set1(0);
+		vec fraction = L::srl(L::sll(rest, L::set1(es)), L::set1(width - fbits));
+		significand = L::bor(fraction, L::set1(lane(1) << fbits));
+		scale = L::add(L::sll(k, L::set1(es)), e);
+	}
+
+	// round to nearest even and encode from scale and a significand with the hidden bit at bit fbits+1
+	static inline void encode(const mask& negative, const vec& scale, const vec& significand, mask sticky, vec& result) {
+		mask overflow = L::gt(scale, L::set1(max_scale));
+		mask underflow = L::gt(L::set1(0 - max_scale), scale);
+		vec biased = L::add(scale, L::set1(max_scale));   // non-negative for the scales that are in range
+		vec kb = L::srl(biased, L::set1(es));            // k + nbits - 2
+		vec e = L::band(biased, L::set1((lane(1) << es) - 1));
+		mask positive_k = L::gt(kb, L::set1(nbits - 3));
+		vec k = L::sub(kb, L::set1(nbits - 2));
+		// a run of k+1 1's terminated by a 0, or a run of -k 0's terminated by a 1
+		vec length = L::select(positive_k, L::add(k, L::set1(2)), L::sub(L::set1(1), k));
+		vec ones = L::sub(L::sll(L::set1(1), L::add(k, L::set1(1))), L::set1(1));
+		vec regime = L::select(positive_k, L::sll(ones, L::set1(1)), L::set1(1));
+		// regime, exponent, and fraction bits: at most 2*nbits-2 bits, which fits the lane
+		vec tail = L::bor(L::sll(e, L::set1(fbits + 1)), L::band(significand, L::set1((lane(1) << (fbits + 1)) - 1)));
+		vec pattern = L::bor(L::sll(regime, L::set1(nbits - 2)), tail);
+		vec shift = L::sub(length, L::set1(1));
+		vec bits = L::srl(pattern, shift);
+		vec guard = L::sub(shift, L::set1(1));
+		mask round = L::eq(L::band(L::srl(pattern, guard), L::set1(1)), L::set1(1));
+		vec remainder = L::band(pattern, L::sub(L::sll(L::set1(1), guard), L::set1(1)));
+		sticky = L::mor(sticky, L::mnot(L::eq(remainder, L::set1(0))));
+		mask odd = L::eq(L::band(bits, L::set1(1)), L::set1(1));
+		bits = L::select(L::mand(round, L::mor(sticky, odd)), L::add(bits, L::set1(1)), bits);
+		bits = L::select(overflow, L::set1(maxpos), L::select(underflow, L::set1(1), bits));
+		result = L::select(negative, L::band(L::sub(L::set1(0), bits), L::set1(encoding_mask)), bits);
+	}
+
+	static inline void negate(const vec& a, vec& result) {
+		result = L::band(L::sub(L::set1(0), a), L::set1(encoding_mask));
+	}
+
+	static inline void add(const vec& a, const vec& b, vec& result) {
+		mask na, nb;
+		vec ma, mb;
+		magnitude(a, na, ma);
+		magnitude(b, nb, mb);
+		// assign the largest magnitude to x: the sign of the result is the sign of x
+		mask swap = L::gt(mb, ma);
+		mask negative = L::mor(L::mand(swap, nb), L::mand(L::mnot(swap), na));
+		mask same_sign = L::eq(L::srl(L::bxor(a, b), L::set1(nbits - 1)), L::set1(0));
+		vec ex, fx, ey, fy;
+		decode(L::select(swap, mb, ma), ex, fx);
+		decode(L::select(swap, ma, mb), ey, fy);
+		vec x = L::sll(fx, L::set1(gbits));
+		vec y = L::sll(fy, L::set1(gbits));
+		vec distance = L::sub(ex, ey);
+		mask sticky = L::mnot(L::eq(L::band(y, L::sub(L::sll(L::set1(1), distance), L::set1(1))), L::set1(0)));
+		y = L::srl(y, distance);
+		// the shifted out bits make the exact difference slightly smaller: truncate one ulp down
+		vec sum = L::select(same_sign, L::add(x, y), L::sub(L::sub(x, y), L::select(sticky, L::set1(1), L::set1(0))));
+		mask cancelled = L::eq(sum, L::set1(0));
+		// the guard bits keep the hidden bit of the sum at or above bit fbits+1
+		vec msb = L::sub(L::set1(width - 1), L::clz(sum));
+		vec shift = L::sub(msb, L::set1(fbits + 1));
+		sticky = L::mor(sticky, L::mnot(L::eq(L::band(sum, L::sub(L::sll(L::set1(1), shift), L::set1(1))), L::set1(0))));
+		vec scale = L::add(ex, L::sub(msb, L::set1(fbits + gbits)));
+		encode(negative, scale, L::srl(sum, shift), sticky, result);
+		// special cases
+		result = L::select(cancelled, L::set1(0), result);
+		result = L::select(L::eq(b, L::set1(0)), a, result);
+		result = L::select(L::eq(a, L::set1(0)), b, result);
+		result = L::select(L::mor(L::eq(a, L::set1(nar)), L::eq(b, L::set1(nar))), L::set1(nar), result);
+	}
+
+	static inline void sub(const vec& a, const vec& b, vec& result) {
+		vec negated;
+		negate(b, negated);
+		add(a, negated, result);
+	}
+
+	static inline void mul(const vec& a, const vec& b, vec& result) {
+		mask na, nb;
+		vec ma, mb, ea, fa, eb, fb;
+		magnitude(a, na, ma);
+		magnitude(b, nb, mb);
+		decode(ma, ea, fa);
+		decode(mb, eb, fb);
+		// the product of two significands in [1,2) is in [1,4)
+		vec product = L::mul(fa, fb);
+		mask carry = L::eq(L::srl(product, L::set1(2 * fbits + 1)), L::set1(1));
+		vec scale = L::add(L::add(ea, eb), L::select(carry, L::set1(1), L::set1(0)));
+		vec shift = L::select(carry, L::set1(fbits), L::set1(fbits - 1));
+		mask sticky = L::mnot(L::eq(L::band(product, L::sub(L::sll(L::set1(1), shift), L::set1(1))), L::set1(0)));
+		mask negative = L::eq(L::srl(L::bxor(a, b), L::set1(nbits - 1)), L::set1(1));
+		encode(negative, scale, L::srl(product, shift), sticky, result);
+		// special cases
+		result = L::select(L::mor(L::eq(a, L::set1(0)), L::eq(b, L::set1(0))), L::set1(0), result);
+		result = L::select(L::mor(L::eq(a, L::set1(nar)), L::eq(b, L::set1(nar))), L::set1(nar), result);
+	}
+
+	// IEEE-754 binary format with ebits exponent bits and mbits fraction bits, right-aligned in a lane
+	template<unsigned ebits, unsigned mbits>
+	struct ieee_format {
+		static constexpr unsigned size = 1 + ebits + mbits;
+		static constexpr lane bias = (lane(1) << (ebits - 1)) - 1;
+		static constexpr lane exponent_mask = (lane(1) << ebits) - 1;
+		static constexpr bool fits_lane = (size <= width);
+		static constexpr lane fraction_mask = fits_lane ? (lane(1) << (mbits % width)) - 1 : 0;
+		// the vectorized conversions require that the posit dynamic range is inside the normal range of the format
+		static constexpr bool fits = fits_lane && (max_scale + 1 < bias);
+	};
+
+	// round the bits of an IEEE-754 value to the posit: zeros map to zero, infinities and NaNs to NaR,
+	// and subnormals, which are smaller than minpos, to minpos
+	template<unsigned ebits, unsigned mbits>
+	static inline void from_ieee(const vec& x, vec& result) {
+		using ieee = ieee_format<ebits, mbits>;
+		// align the fraction with bit fbits+1, the significand format of encode
+		constexpr unsigned down = (mbits > fbits + 1) ? mbits - fbits - 1 : 0;
+		constexpr unsigned up = (mbits > fbits + 1) ? 0 : fbits + 1 - mbits;
+		mask negative = L::eq(L::srl(x, L::set1(ieee::size - 1)), L::set1(1));
+		vec exponent = L::band(L::srl(x, L::set1(mbits)), L::set1(ieee::exponent_mask));
+		vec fraction = L::band(x, L::set1(ieee::fraction_mask));
+		vec scale = L::sub(exponent, L::set1(ieee::bias));
+		vec significand = L::srl(L::sll(L::bor(fraction, L::set1(lane(1) << mbits)), L::set1(up)), L::set1(down));
+		mask sticky = L::mnot(L::eq(L::band(fraction, L::set1((lane(1) << down) - 1)), L::set1(0)));
+		encode(negative, scale, significand, sticky, result);
+		// special cases
+		result = L::select(L::eq(exponent, L::set1(ieee::exponent_mask)), L::set1(nar), result);
+		result = L::select(L::eq(L::band(x, L::set1(ieee::exponent_mask << mbits | ieee::fraction_mask)), L::set1(0)), L::set1(0), result);
+	}
+
+	// convert a posit to the bits of an IEEE-754 value, rounding to nearest even when the format has fewer
+	// fraction bits than the posit: zero maps to +0 and NaR to the quiet NaN
+	template<unsigned ebits, unsigned mbits>
+	static inline void to_ieee(const vec& a, vec& result) {
+		using ieee = ieee_format<ebits, mbits>;
+		constexpr unsigned down = (fbits > mbits) ? fbits - mbits : 0;
+		constexpr unsigned up = (fbits > mbits) ? 0 : mbits - fbits;
+		constexpr lane quiet_nan = (ieee::exponent_mask << mbits) | (lane(1) << (mbits - 1));
+		mask negative;
+		vec m, scale, significand;
+		magnitude(a, negative, m);
+		decode(m, scale, significand);
+		vec fraction = L::band(significand, L::set1((lane(1) << fbits) - 1));
+		// a round up that carries out of the fraction increments the exponent, as it should
+		vec bits = L::add(L::sll(L::add(scale, L::set1(ieee::bias)), L::set1(mbits)), L::srl(L::sll(fraction, L::set1(up)), L::set1(down)));
+		if (down > 0) {
+			constexpr unsigned guard = (down > 0) ? down - 1 : 0;
+			mask round = L::eq(L::band(L::srl(fraction, L::set1(guard)), L::set1(1)), L::set1(1));
+			mask sticky = L::mnot(L::eq(L::band(fraction, L::set1((lane(1) << guard) - 1)), L::set1(0)));
+			mask odd = L::eq(L::band(bits, L::set1(1)), L::set1(1));
+			bits = L::select(L::mand(round, L::mor(sticky, odd)), L::add(bits, L::set1(1)), bits);
+		}
+		result = L::select(negative, L::bor(bits, L::set1(lane(1) << (ieee::size - 1))), bits);
+		// special cases
+		result = L::select(L::eq(a, L::set1(0)), L::set1(0), result);
+		result = L::select(L::eq(a, L::set1(nar)), L::set1(quiet_nan), result);
+	}
+
+	template<lane_op op>
+	static inline void apply(const vec& a, const vec& b, vec& result) {
+		switch (op) {
+		case lane_op::add:    add(a, b, result);  break;
+		case lane_op::sub:    sub(a, b, result);  break;
+		case lane_op::mul:    mul(a, b, result);  break;
+		case lane_op::negate: negate(a, result);  break;
+		}
+	}
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// load an encoding of nbits into the low bits of a lane
+template<typename lane, size_t nbits>
+inline lane load_encoding(const void* p) {
+	lane v = 0;
+	std::memcpy(&v, p, nbits / 8);   // x86 is little endian
+	return v;
+}
+
+// kernels: apply op to the largest multiple of the lane count that fits n and return the number of elements processed
+// when broadcast is set, b points to a single operand that is applied to all elements of a
+template<typename L, size_t nbits, size_t es, lane_op op>
+POSIT_TARGET_AVX2 POSIT_LANE_KERNEL
+size_t avx2_posit_kernel(const void* a, const void* b, void* c, size_t n, bool broadcast) {
+	using engine = posit_lanes<L, nbits, es>;
+	constexpr size_t bytes = nbits / 8;
+	const char* pa = static_cast<const char*>(a);
+	const char* pb = static_cast<const char*>(b);
+	char* pc = static_cast<char*>(c);
+	typename L::vec scalar = L::set1(broadcast ? load_encoding<typename L::lane, nbits>(b) : 0);
+	size_t i = 0;
+	for (; i + L::lanes <= n; i += L::lanes) {
+		typename L::vec x = L::load(pa + i * bytes);
+		typename L::vec y = (op == lane_op::negate || broadcast) ? scalar : L::load(pb + i * bytes);
+		typename L::vec z;
+		engine::template apply<op>(x, y, z);
+		L::store(pc + i * bytes, z);
+	}
+	return i;
+}
+
+template<typename L, size_t nbits, size_t es, lane_op op>
+POSIT_TARGET_AVX512 POSIT_LANE_KERNEL
+size_t avx512_posit_kernel(const void* a, const void* b, void* c, size_t n, bool broadcast) {
+	using engine = posit_lanes<L, nbits, es>;
+	constexpr size_t bytes = nbits / 8;
+	const char* pa = static_cast<const char*>(a);
+	const char* pb = static_cast<const char*>(b);
+	char* pc = static_cast<char*>(c);
+	typename L::vec scalar = L::set1(broadcast ? load_encoding<typename L::lane, nbits>(b) : 0);
+	size_t i = 0;
+	for (; i + L::lanes <= n; i += L::lanes) {
+		typename L::vec x = L::load(pa + i * bytes);
+		typename L::vec y = (op == lane_op::negate || broadcast) ? scalar : L::load(pb + i * bytes);
+		typename L::vec z;
+		engine::template apply<op>(x, y, z);
+		L::store(pc + i * bytes, z);
+	}
+	return i;
+}
+
+// conversion kernels: convert the largest multiple of the lane count that fits n between a span of IEEE-754 values
+// and a span of posits, in the direction of to_ieee, and return the number of elements processed
+template<typename L, size_t nbits, size_t es, unsigned ebits, unsigned mbits, bool to_ieee>
+POSIT_TARGET_AVX2 POSIT_LANE_KERNEL
+size_t avx2_conversion_kernel(const void* src, void* dst, size_t n) {
+	using engine = posit_lanes<L, nbits, es>;
+	constexpr size_t posit_bytes = nbits / 8;
+	constexpr size_t ieee_bytes = (1 + ebits + mbits) / 8;
+	constexpr bool full = (1 + ebits + mbits) == L::width;   // else the IEEE values fill half a lane, like the encodings
+	const char* ps = static_cast<const char*>(src);
+	char* pd = static_cast<char*>(dst);
+	size_t i = 0;
+	for (; i + L::lanes <= n; i += L::lanes) {
+		typename L::vec x, z;
+		if (to_ieee) {
+			x = L::load(ps + i * posit_bytes);
+			engine::template to_ieee<ebits, mbits>(x, z);
+			if (full) L::store_full(pd + i * ieee_bytes, z); else L::store(pd + i * ieee_bytes, z);
+		}
+		else {
+			x = full ? L::load_full(ps + i * ieee_bytes) : L::load(ps + i * ieee_bytes);
+			engine::template from_ieee<ebits, mbits>(x, z);
+			L::store(pd + i * posit_bytes, z);
+		}
+	}
+	return i;
+}
+
+template<typename L, size_t nbits, size_t es, unsigned ebits, unsigned mbits, bool to_ieee>
+POSIT_TARGET_AVX512 POSIT_LANE_KERNEL
+size_t avx512_conversion_kernel(const void* src, void* dst, size_t n) {
+	using engine = posit_lanes<L, nbits, es>;
+	constexpr size_t posit_bytes = nbits / 8;
+	constexpr size_t ieee_bytes = (1 + ebits + mbits) / 8;
+	constexpr bool full = (1 + ebits + mbits) == L::width;
+	const char* ps = static_cast<const char*>(src);
+	char* pd = static_cast<char*>(dst);
+	size_t i = 0;
+	for (; i + L::lanes <= n; i += L::lanes) {
+		typename L::vec x, z;
+		if (to_ieee) {
+			x = L::load(ps + i * posit_bytes);
+			engine::template to_ieee<ebits, mbits>(x, z);
+			if (full) L::store_full(pd + i * ieee_bytes, z); else L::store(pd + i * ieee_bytes, z);
+		}
+		else {
+			x = full ? L::load_full(ps + i * ieee_bytes) : L::load(ps + i * ieee_bytes);
+			engine::template from_ieee<ebits, mbits>(x, z);
+			L::store(pd + i * posit_bytes, z);
+		}
+	}
+	return i;
+}
+
+// dispatch to the kernel of the requested instruction set, limited to what the host supports
+template<typename Lanes256, typename Lanes512, size_t nbits, size_t es>
+struct posit_lane_dispatch {
+	template<lane_op op>
+	static size_t kernel(simd_isa isa, const void* a, const void* b, void* c, size_t n, bool broadcast) {
+		if (isa > host_simd_isa()) isa = host_simd_isa();
+		switch (isa) {
+		case simd_isa::avx512: return avx512_posit_kernel<Lanes512, nbits, es, op>(a, b, c, n, broadcast);
+		case simd_isa::avx2:   return avx2_posit_kernel<Lanes256, nbits, es, op>(a, b, c, n, broadcast);
+		default:               return 0;
+		}
+	}
+	static size_t apply(lane_op op, simd_isa isa, const void* a, const void* b, void* c, size_t n, bool broadcast) {
+		switch (op) {
+		case lane_op::add:    return kernel<lane_op::add>(isa, a, b, c, n, broadcast);
+		case lane_op::sub:    return kernel<lane_op::sub>(isa, a, b, c, n, broadcast);
+		case lane_op::mul:    return kernel<lane_op::mul>(isa, a, b, c, n, broadcast);
+		case lane_op::negate: return kernel<lane_op::negate>(isa, a, b, c, n, broadcast);
+		}
+		return 0;
+	}
+	template<unsigned ebits, unsigned mbits, bool to_ieee>
+	static size_t convert(simd_isa isa, const void* src, void* dst, size_t n) {
+		// IEEE formats that do not fit the lanes, or that do not cover the posit dynamic range, use the scalar conversion
+		using fits = std::integral_constant<bool, posit_lanes<Lanes256, nbits, es>::template ieee_format<ebits, mbits>::fits>;
+		return convert<ebits, mbits, to_ieee>(fits(), isa, src, dst, n);
+	}
+
+private:
+	template<unsigned ebits, unsigned mbits, bool to_ieee>
+	static size_t convert(std::true_type, simd_isa isa, const void* src, void* dst, size_t n) {
+		if (isa > host_simd_isa()) isa = host_simd_isa();
+		switch (isa) {
+		case simd_isa::avx512: return avx512_conversion_kernel<Lanes512, nbits, es, ebits, mbits, to_ieee>(src, dst, n);
+		case simd_isa::avx2:   return avx2_conversion_kernel<Lanes256, nbits, es, ebits, mbits, to_ieee>(src, dst, n);
+		default:               return 0;
+		}
+	}
+	template<unsigned ebits, unsigned mbits, bool to_ieee>
+	static size_t convert(std::false_type, simd_isa, const void*, void*, size_t) { return 0; }
+};
+
+template<>
+struct posit_lane_kernels<16, 1> : public posit_lane_dispatch<avx2_lanes32, avx512_lanes32, 16, 1> {};
+template<>
+struct posit_lane_kernels<32, 2> : public posit_lane_dispatch<avx2_lanes64, avx512_lanes64, 32, 2> {};
+
+#endif // POSIT_ARRAY_SIMD
+
+}  // namespace unum
+}  // namespace sw
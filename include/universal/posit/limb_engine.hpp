@@ -0,0 +1,266 @@
+#pragma once
+// limb_engine.hpp: multi-limb arithmetic engine for posit configurations that are a multiple of 64 bits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <utility>
+#include "../native/word_arithmetic.hpp"
+
+namespace sw {
+namespace unum {
+
+// The limb engine is the multi-word counterpart of the word engine in word_engine.hpp.
+// Posit encodings of nbits = 64*N are held in N uint64_t limbs, least significant limb first.
+// Operands are decoded into (sign, scale, significand) triples where the significand
+// is an N-limb integer with the hidden bit at the most significant bit, so that all fraction
+// bits are available to multi-word add/sub/mul/div/sqrt built on 64x64->128-bit partial products.
+// Results are rounded to nearest even on the posit bit string by limb_encode.
+// All functions require non-zero, non-NaR operands: the special cases are handled by the caller.
+
+// decode a posit encoding into sign, scale, and a significand with the hidden bit at the most significant bit
+template<size_t nbits, size_t es>
+inline void limb_decode(const uint64_t (&bits)[nbits / 64], bool& sign, int& scale, uint64_t (&significand)[nbits / 64]) {
+	static_assert(nbits % 64 == 0, "limb engine requires nbits to be a multiple of 64");
+	static_assert(es < 64, "limb engine requires es < 64");
+	constexpr size_t N = nbits / 64;
+
+	uint64_t regime[N];
+	for (size_t i = 0; i < N; ++i) regime[i] = bits[i];
+	sign = bool(regime[N - 1] >> 63);
+	if (sign) limbs_negate(regime);
+	limbs_shift_left(regime, 1);   // drop the sign bit: the regime starts at the most significant bit
+	int run, k;
+	if (regime[N - 1] >> 63) {
+		uint64_t ones[N];
+		for (size_t i = 0; i < N; ++i) ones[i] = ~regime[i];
+		run = limbs_clz(ones);
+		k = run - 1;
+	}
+	else {
+		run = limbs_clz(regime);
+		k = -run;
+	}
+	// remove the regime run and its terminating bit
+	limbs_shift_left(regime, unsigned(run + 1));
+	int e = 0;
+	if (es > 0) {
+		e = int(regime[N - 1] >> (64 - es));
+		limbs_shift_left(regime, unsigned(es));
+	}
+	scale = k * (1 << es) + e;
+	limbs_shift_right(regime, 1);
+	regime[N - 1] |= 0x8000000000000000ull;
+	for (size_t i = 0; i < N; ++i) significand[i] = regime[i];
+}
+
+// round to nearest even and encode a posit from sign, scale, and a significand with the hidden bit at the most significant bit
+// sticky summarizes any non-zero bits beyond the significand
+// The encoder accepts any nbits and any significand length: the encoding occupies the least significant nbits
+// of (nbits+63)/64 limbs, and significand bits beyond the rounding position of the posit only contribute to sticky.
+template<size_t nbits, size_t es, size_t N>
+inline void limb_encode(bool sign, int scale, const uint64_t (&significand)[N], bool sticky, uint64_t (&bits)[(nbits + 63) / 64]) {
+	constexpr size_t M = (nbits + 63) / 64;
+	constexpr size_t T = M + 1;   // the tail holds the nbits encoding and rounding bits, and at least 64 more
+	constexpr int max_k = int(nbits) - 2;
+	constexpr int max_scale = max_k * (1 << es);
+	constexpr uint64_t top_mask = (nbits % 64) ? ((1ull << (nbits % 64)) - 1) : 0xFFFFFFFFFFFFFFFFull;
+
+	if (scale > max_scale) {         // inward projection to maxpos
+		for (size_t i = 0; i < M; ++i) bits[i] = 0xFFFFFFFFFFFFFFFFull;
+		bits[M - 1] = top_mask >> 1;
+	}
+	else if (scale < -max_scale) {   // inward projection to minpos
+		for (size_t i = 0; i < M; ++i) bits[i] = 0;
+		bits[0] = 1;
+	}
+	else {
+		int k = scale >> es;
+		uint64_t e = uint64_t(scale - k * (1 << es));
+		// the exponent bits followed by the fraction bits, as a T limb tail
+		uint64_t tail[T];
+		for (size_t i = 0; i < T; ++i) tail[i] = (i + N >= T) ? significand[i + N - T] : 0;
+		for (size_t i = 0; i + T < N; ++i) sticky = sticky || significand[i] != 0;
+		limbs_shift_left(tail, 1);   // drop the hidden bit
+		if (es > 0) {
+			sticky = limbs_shift_right(tail, unsigned(es)) || sticky;
+			tail[T - 1] |= e << (64 - es);
+		}
+		// make room for the regime: a run of k+1 1's terminated by a 0, or a run of -k 0's terminated by a 1
+		int regime_length = (k >= 0) ? k + 2 : -k + 1;
+		sticky = limbs_shift_right(tail, unsigned(regime_length)) || sticky;
+		if (k >= 0) {
+			unsigned ones = unsigned(k + 1);
+			for (size_t i = T; i-- > 0 && ones > 0; ) {
+				if (ones >= 64) {
+					tail[i] = 0xFFFFFFFFFFFFFFFFull;
+					ones -= 64;
+				}
+				else {
+					tail[i] |= 0xFFFFFFFFFFFFFFFFull << (64 - ones);
+					ones = 0;
+				}
+			}
+		}
+		else {
+			unsigned position = unsigned(64 * T - 1 + k);
+			tail[position / 64] |= 1ull << (position % 64);
+		}
+		// the upper nbits of the tail hold the nbits-1 encoding bits followed by the rounding bit
+		sticky = limbs_shift_right(tail, unsigned(64 * T - nbits)) || sticky;
+		bool round = bool(tail[0] & 1);
+		limbs_shift_right(tail, 1);
+		for (size_t i = 0; i < M; ++i) bits[i] = tail[i];
+		if (round && (sticky || (bits[0] & 1))) limbs_increment(bits);
+	}
+	if (sign) {
+		limbs_negate(bits);
+		bits[M - 1] &= top_mask;
+	}
+}
+
+// negate a posit encoding
+template<size_t nbits>
+inline void limb_negate(uint64_t (&bits)[nbits / 64]) {
+	limbs_negate(bits);
+}
+
+// sum of two posit encodings
+template<size_t nbits, size_t es>
+inline void limb_add(const uint64_t (&a)[nbits / 64], const uint64_t (&b)[nbits / 64], uint64_t (&result)[nbits / 64]) {
+	constexpr size_t N = nbits / 64;
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa[N], fb[N];
+	limb_decode<nbits, es>(a, sa, ea, fa);
+	limb_decode<nbits, es>(b, sb, eb, fb);
+	// assign the largest magnitude to a: the sign of the result is the sign of a
+	if (ea < eb || (ea == eb && limbs_compare(fa, fb) < 0)) {
+		std::swap(sa, sb);
+		std::swap(ea, eb);
+		std::swap(fa, fb);
+	}
+	// align b to a in a 2N limb window, bits shifted beyond the window become sticky
+	uint64_t sum[2 * N], addend[2 * N];
+	for (size_t i = 0; i < N; ++i) {
+		sum[i] = 0;          sum[i + N] = fa[i];
+		addend[i] = 0;       addend[i + N] = fb[i];
+	}
+	bool sticky = limbs_shift_right(addend, unsigned(ea - eb));
+
+	int scale = ea;
+	if (sa == sb) {
+		if (limbs_add(sum, addend)) {   // carry out of the significand
+			sticky = limbs_shift_right(sum, 1) || sticky;
+			sum[2 * N - 1] |= 0x8000000000000000ull;
+			++scale;
+		}
+	}
+	else {
+		limbs_subtract(sum, addend);
+		// the shifted out bits make the exact difference slightly smaller: truncate one ulp down
+		if (sticky) limbs_decrement(sum);
+		if (limbs_is_zero(sum)) {   // exact cancellation
+			for (size_t i = 0; i < N; ++i) result[i] = 0;
+			return;
+		}
+		int lz = limbs_clz(sum);
+		limbs_shift_left(sum, unsigned(lz));
+		scale -= lz;
+	}
+	uint64_t significand[N];
+	for (size_t i = 0; i < N; ++i) {
+		significand[i] = sum[i + N];
+		sticky = sticky || sum[i] != 0;
+	}
+	limb_encode<nbits, es>(sa, scale, significand, sticky, result);
+}
+
+// difference of two posit encodings
+template<size_t nbits, size_t es>
+inline void limb_sub(const uint64_t (&a)[nbits / 64], const uint64_t (&b)[nbits / 64], uint64_t (&result)[nbits / 64]) {
+	constexpr size_t N = nbits / 64;
+	uint64_t negated[N];
+	for (size_t i = 0; i < N; ++i) negated[i] = b[i];
+	limb_negate<nbits>(negated);
+	limb_add<nbits, es>(a, negated, result);
+}
+
+// product of two posit encodings
+template<size_t nbits, size_t es>
+inline void limb_mul(const uint64_t (&a)[nbits / 64], const uint64_t (&b)[nbits / 64], uint64_t (&result)[nbits / 64]) {
+	constexpr size_t N = nbits / 64;
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa[N], fb[N];
+	limb_decode<nbits, es>(a, sa, ea, fa);
+	limb_decode<nbits, es>(b, sb, eb, fb);
+	// the product of two significands in [1,2) is in [1,4)
+	uint64_t product[2 * N];
+	limbs_multiply(fa, fb, product);
+	int scale = ea + eb;
+	if (product[2 * N - 1] & 0x8000000000000000ull) {
+		++scale;
+	}
+	else {
+		limbs_shift_left(product, 1);
+	}
+	uint64_t significand[N];
+	bool sticky = false;
+	for (size_t i = 0; i < N; ++i) {
+		significand[i] = product[i + N];
+		sticky = sticky || product[i] != 0;
+	}
+	limb_encode<nbits, es>(sa != sb, scale, significand, sticky, result);
+}
+
+// quotient of two posit encodings
+template<size_t nbits, size_t es>
+inline void limb_div(const uint64_t (&a)[nbits / 64], const uint64_t (&b)[nbits / 64], uint64_t (&result)[nbits / 64]) {
+	constexpr size_t N = nbits / 64;
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa[N], fb[N];
+	limb_decode<nbits, es>(a, sa, ea, fa);
+	limb_decode<nbits, es>(b, sb, eb, fb);
+	// align the dividend so that the quotient has its hidden bit at the most significant bit
+	int scale = ea - eb;
+	uint64_t dividend[2 * N];
+	for (size_t i = 0; i < N; ++i) {
+		dividend[i] = 0;
+		dividend[i + N] = fa[i];
+	}
+	if (limbs_compare(fa, fb) >= 0) {
+		limbs_shift_right(dividend, 1);
+	}
+	else {
+		--scale;
+	}
+	uint64_t quotient[N], remainder[N];
+	bool sticky = limbs_divide(dividend, fb, quotient, remainder);
+	limb_encode<nbits, es>(sa != sb, scale, quotient, sticky, result);
+}
+
+// square root of a positive posit encoding
+template<size_t nbits, size_t es>
+inline void limb_sqrt(const uint64_t (&a)[nbits / 64], uint64_t (&result)[nbits / 64]) {
+	constexpr size_t N = nbits / 64;
+	bool s;
+	int scale;
+	uint64_t f[N];
+	limb_decode<nbits, es>(a, s, scale, f);
+	// make the scale even, so that the root of the 2N limb radicand has its hidden bit at the most significant bit
+	uint64_t radicand[2 * N];
+	for (size_t i = 0; i < N; ++i) {
+		radicand[i] = 0;
+		radicand[i + N] = f[i];
+	}
+	if ((scale & 1) == 0) limbs_shift_right(radicand, 1);
+	uint64_t root[N];
+	bool inexact = limbs_sqrt(radicand, root);
+	limb_encode<nbits, es>(false, scale >> 1, root, inexact, result);
+}
+
+}  // namespace unum
+}  // namespace sw
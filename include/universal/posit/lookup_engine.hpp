@@ -0,0 +1,153 @@
+#pragma once
+// lookup_engine.hpp: table-driven arithmetic engine for 8-bit posit configurations
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include "word_engine.hpp"
+
+namespace sw {
+namespace unum {
+
+// The lookup engine replaces the arithmetic of posit<8,es> by table lookups.
+// The binary operators are 64K-entry tables indexed by (a << 8) | b, which at 64KB per table
+// stay resident in L2, and the unary functions are 256-entry tables indexed by the encoding.
+// The tables follow the quiet NaR semantics of the posit operators: an application that
+// enables POSIT_THROW_ARITHMETIC_EXCEPTION has the exceptional cases intercepted before the lookup.
+//
+// The tables are generated once, on first use, from the word-native engine, so that the lookup
+// engine rounds identically to the word engine; exp and log mirror the library's math shims.
+// tools/utils/lookup_arithmetic.cpp can print them as C arrays for targets that need them in ROM.
+// Generating them on first use, rather than in a static data member, also makes them available to
+// posit<8,es> arithmetic in the initializers of global objects.
+template<size_t es>
+class posit8_lookup_tables {
+public:
+	static constexpr uint8_t NAR = 0x80;
+
+	// the tables are constructed in a thread-safe manner on first use
+	static const posit8_lookup_tables& instance() {
+		static const posit8_lookup_tables tables;
+		return tables;
+	}
+
+	uint8_t add[65536];
+	uint8_t sub[65536];
+	uint8_t mul[65536];
+	uint8_t div[65536];
+	uint8_t reciprocal[256];
+	uint8_t sqrt[256];
+	uint8_t exp[256];
+	uint8_t log[256];
+
+	posit8_lookup_tables(const posit8_lookup_tables&) = delete;
+	posit8_lookup_tables& operator=(const posit8_lookup_tables&) = delete;
+
+private:
+	posit8_lookup_tables() {
+		for (unsigned a = 0; a < 256; ++a) {
+			for (unsigned b = 0; b < 256; ++b) {
+				unsigned index = (a << 8) | b;
+				add[index] = generate_add(uint8_t(a), uint8_t(b));
+				sub[index] = generate_add(uint8_t(a), uint8_t(word_negate<8>(b)));
+				mul[index] = generate_mul(uint8_t(a), uint8_t(b));
+				div[index] = generate_div(uint8_t(a), uint8_t(b));
+			}
+			reciprocal[a] = generate_div(0x40, uint8_t(a));
+			sqrt[a]       = generate_sqrt(uint8_t(a));
+			exp[a]        = generate_exp(uint8_t(a));
+			log[a]        = generate_log(uint8_t(a));
+		}
+	}
+
+	static uint8_t generate_add(uint8_t a, uint8_t b) {
+		if (a == NAR || b == NAR) return NAR;
+		if (a == 0) return b;
+		if (b == 0) return a;
+		return uint8_t(word_add<8, es>(a, b));
+	}
+	static uint8_t generate_mul(uint8_t a, uint8_t b) {
+		if (a == NAR || b == NAR) return NAR;
+		if (a == 0 || b == 0) return 0;
+		return uint8_t(word_mul<8, es>(a, b));
+	}
+	static uint8_t generate_div(uint8_t a, uint8_t b) {
+		if (a == NAR || b == NAR || b == 0) return NAR;
+		if (a == 0) return 0;
+		return uint8_t(word_div<8, es>(a, b));
+	}
+	static uint8_t generate_sqrt(uint8_t a) {
+		if (a & 0x80) return NAR;   // negative or NaR
+		if (a == 0) return 0;
+		return uint8_t(word_sqrt<8, es>(a));
+	}
+	// exp(x) and log(x) are evaluated in double precision and rounded to the posit, like the math shims
+	static uint8_t generate_exp(uint8_t a) {
+		if (a == NAR) return NAR;
+		double d = std::exp(to_double(a));
+		if (d == 0.0) return 1;   // minpos
+		return from_double(d);
+	}
+	static uint8_t generate_log(uint8_t a) {
+		return from_double(std::log(to_double(a)));
+	}
+
+	static double to_double(uint8_t a) {
+		if (a == 0) return 0.0;
+		if (a == NAR) return NAN;
+		bool sign;
+		int scale;
+		uint64_t significand;
+		word_decode<8, es>(a, sign, scale, significand);
+		double v = std::ldexp(double(significand), scale - 63);
+		return sign ? -v : v;
+	}
+	static uint8_t from_double(double d) {
+		if (d == 0.0) return 0;
+		if (std::isinf(d) || std::isnan(d)) return NAR;
+		bool sign = std::signbit(d);
+		int exponent;
+		double mantissa = std::frexp(sign ? -d : d, &exponent);   // mantissa in [0.5, 1)
+		uint64_t significand = uint64_t(std::ldexp(mantissa, 64));   // exact: the mantissa has 53 bits
+		return uint8_t(word_encode<8, es>(sign, exponent - 1, significand, false));
+	}
+};
+
+// table-driven operators on posit<8,es> encodings
+template<size_t es>
+inline uint8_t lookup_add(uint8_t a, uint8_t b) {
+	return posit8_lookup_tables<es>::instance().add[(unsigned(a) << 8) | b];
+}
+template<size_t es>
+inline uint8_t lookup_sub(uint8_t a, uint8_t b) {
+	return posit8_lookup_tables<es>::instance().sub[(unsigned(a) << 8) | b];
+}
+template<size_t es>
+inline uint8_t lookup_mul(uint8_t a, uint8_t b) {
+	return posit8_lookup_tables<es>::instance().mul[(unsigned(a) << 8) | b];
+}
+template<size_t es>
+inline uint8_t lookup_div(uint8_t a, uint8_t b) {
+	return posit8_lookup_tables<es>::instance().div[(unsigned(a) << 8) | b];
+}
+template<size_t es>
+inline uint8_t lookup_reciprocal(uint8_t a) {
+	return posit8_lookup_tables<es>::instance().reciprocal[a];
+}
+template<size_t es>
+inline uint8_t lookup_sqrt(uint8_t a) {
+	return posit8_lookup_tables<es>::instance().sqrt[a];
+}
+template<size_t es>
+inline uint8_t lookup_exp(uint8_t a) {
+	return posit8_lookup_tables<es>::instance().exp[a];
+}
+template<size_t es>
+inline uint8_t lookup_log(uint8_t a) {
+	return posit8_lookup_tables<es>::instance().log[a];
+}
+
+}  // namespace unum
+}  // namespace sw
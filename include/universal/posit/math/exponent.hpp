@@ -13,8 +13,15 @@ namespace sw {
 		// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
 
 		// Base-e exponential function
+		// posit<8,es> with the lookup engine read the exponential from a table
 		template<size_t nbits, size_t es>
-		posit<nbits,es> exp(posit<nbits,es> x) {
+		posit<nbits,es> exp(posit<nbits,es> x, lookup_engine_tag) {
+			posit<nbits, es> p;
+			p.set_raw_bits(lookup_exp<es>(uint8_t(x.encoding())));
+			return p;
+		}
+		template<size_t nbits, size_t es, typename EngineTag>
+		posit<nbits,es> exp(posit<nbits,es> x, EngineTag) {
 			if (isnar(x)) return x;
 			posit<nbits, es> p;
 			double d = std::exp(double(x));
@@ -26,6 +33,10 @@ namespace sw {
 			}
 			return p;
 		}
+		template<size_t nbits, size_t es>
+		posit<nbits,es> exp(posit<nbits,es> x) {
+			return exp(x, posit_arithmetic_engine<nbits>{});
+		}
 
 		// Base-2 exponential function
 		template<size_t nbits, size_t es>
@@ -13,10 +13,21 @@ namespace sw {
 		// correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
 
 		// Natural logarithm of x
+		// posit<8,es> with the lookup engine read the logarithm from a table
 		template<size_t nbits, size_t es>
-		posit<nbits,es> log(posit<nbits,es> x) {
+		posit<nbits,es> log(posit<nbits,es> x, lookup_engine_tag) {
+			posit<nbits, es> p;
+			p.set_raw_bits(lookup_log<es>(uint8_t(x.encoding())));
+			return p;
+		}
+		template<size_t nbits, size_t es, typename EngineTag>
+		posit<nbits,es> log(posit<nbits,es> x, EngineTag) {
 			return posit<nbits,es>(std::log(double(x)));
 		}
+		template<size_t nbits, size_t es>
+		posit<nbits,es> log(posit<nbits,es> x) {
+			return log(x, posit_arithmetic_engine<nbits>{});
+		}
 
 		// Binary logarithm of x
 		template<size_t nbits, size_t es>
@@ -178,10 +178,34 @@ namespace sw {
 			return p;
 		}
 #else
+		// posit<8,es> with the lookup engine read the root from a table
 		template<size_t nbits, size_t es>
-		inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
+		inline posit<nbits, es> sqrt(const posit<nbits, es>& a, lookup_engine_tag) {
+			posit<nbits, es> p;
+			p.set_raw_bits(lookup_sqrt<es>(uint8_t(a.encoding())));
+			return p;
+		}
+		// posits that fit in a word compute a correctly rounded integer square root
+		template<size_t nbits, size_t es>
+		inline posit<nbits, es> sqrt(const posit<nbits, es>& a, word_engine_tag) {
+			posit<nbits, es> p;
+			p.set_raw_bits(word_sqrt<nbits, es>(a.encoding()));
+			return p;
+		}
+		template<size_t nbits, size_t es>
+		inline posit<nbits, es> sqrt(const posit<nbits, es>& a, bitblock_engine_tag) {
 			return posit<nbits, es>(std::sqrt((long double)a));
 		}
+		template<size_t nbits, size_t es>
+		inline posit<nbits, es> sqrt(const posit<nbits, es>& a) {
+			posit<nbits, es> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) return p;
+			return sqrt(a, posit_arithmetic_engine<nbits>{});
+		}
 #endif
 
 		// reciprocal sqrt
@@ -479,8 +503,18 @@ namespace sw {
 		// fast sqrt for posit<64,3>
 		template<>
 		inline posit<64, 3> sqrt(const posit<64, 3>& a) {
-			throw "fast sqrt(posit<64,3>) not yet implemented";
-			return 0;
+			posit<64, 3> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) {
+				p.setzero();
+				return p;
+			}
+			// correctly rounded integer square root of the 128-bit radicand
+			p.set_raw_bits(word_sqrt<64, 3>(a.encoding()));
+			return p;
 		}
 
 #endif // POSIT_FAST_POSIT_64_3
@@ -490,8 +524,22 @@ namespace sw {
 		// fast sqrt for posit<128,4>
 		template<>
 		inline posit<128, 4> sqrt(const posit<128, 4>& a) {
-			throw "fast sqrt(posit<128,4>) not yet implemented";
-			return 0;
+			posit<128, 4> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) {
+				p.setzero();
+				return p;
+			}
+			// correctly rounded integer square root of the 256-bit radicand
+			constexpr size_t nlimbs = posit<128, 4>::nlimbs;
+			uint64_t bits[nlimbs], root[nlimbs];
+			for (size_t i = 0; i < nlimbs; ++i) bits[i] = a.limb(i);
+			limb_sqrt<128, 4>(bits, root);
+			for (size_t i = 0; i < nlimbs; ++i) p.setlimb(i, root[i]);
+			return p;
 		}
 
 #endif // POSIT_FAST_POSIT_128_4
@@ -501,8 +549,22 @@ namespace sw {
 		// fast sqrt for posit<256,5>
 		template<>
 		inline posit<256, 5> sqrt(const posit<256, 5>& a) {
-			throw "fast sqrt(posit<256,5>) not yet implemented";
-			return 0;
+			posit<256, 5> p;
+			if (a.isneg() || a.isnar()) {
+				p.setnar();
+				return p;
+			}
+			if (a.iszero()) {
+				p.setzero();
+				return p;
+			}
+			// correctly rounded integer square root of the 512-bit radicand
+			constexpr size_t nlimbs = posit<256, 5>::nlimbs;
+			uint64_t bits[nlimbs], root[nlimbs];
+			for (size_t i = 0; i < nlimbs; ++i) bits[i] = a.limb(i);
+			limb_sqrt<256, 5>(bits, root);
+			for (size_t i = 0; i < nlimbs; ++i) p.setlimb(i, root[i]);
+			return p;
 		}
 
 #endif // POSIT_FAST_POSIT_256_5
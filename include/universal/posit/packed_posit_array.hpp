@@ -0,0 +1,367 @@
+#pragma once
+// packed_posit_array.hpp: arrays of posits bit-packed at nbits per element
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
+#include "word_engine.hpp"
+
+namespace sw {
+namespace unum {
+
+// A packed_posit_array stores the encodings of its posits back to back in a vector of 64-bit words:
+// element i occupies bits [i*nbits, (i+1)*nbits) of the little-endian bit stream, so a posit<10,0>
+// takes 10 bits of memory instead of the 8 bytes of the bitblock inside the generic posit.
+// Encodings that straddle a word boundary are assembled from the two words.
+//
+// Element access decodes to a posit by value, and writes go through a proxy reference, like the
+// bits of std::vector<bool>. Kernels that stream over the array should use the bulk operations:
+// unpack widens a span of elements into lanes of the smallest unsigned integer that holds nbits,
+// into posits, or into float or double, and pack narrows a span back, rounding IEEE values like
+// the posit conversion. The lanes are the bare encodings consumed by the posit array operators.
+
+// the smallest unsigned integer that holds an nbits posit encoding
+template<size_t nbits>
+struct posit_lane {
+	using type = typename std::conditional<(nbits <= 8), uint8_t,
+	             typename std::conditional<(nbits <= 16), uint16_t,
+	             typename std::conditional<(nbits <= 32), uint32_t, uint64_t>::type>::type>::type;
+};
+
+namespace internal {
+
+// widen a posit encoding to an IEEE value, rounding the significand to nearest even: NaR widens to the quiet NaN
+template<typename Real, size_t nbits, size_t es>
+inline Real widen_encoding(uint64_t bits) {
+	using Bits = typename std::conditional<sizeof(Real) == 4, uint32_t, uint64_t>::type;
+	constexpr int mbits = std::numeric_limits<Real>::digits - 1;
+	constexpr int bias = std::numeric_limits<Real>::max_exponent - 1;
+	constexpr int down = 63 - mbits;
+	constexpr uint64_t nar = 1ull << (nbits - 1);
+	if (bits == 0) return Real(0);
+	if (bits == nar) return std::numeric_limits<Real>::quiet_NaN();
+	bool sign;
+	int scale;
+	uint64_t significand;
+	word_decode<nbits, es>(bits, sign, scale, significand);
+	int exponent = scale + bias;
+	if (exponent < 1 || exponent >= 2 * bias) {
+		// subnormal or out of range of the IEEE format: only posits with a wider dynamic range get here
+		Real v = std::ldexp(Real(significand), scale - 63);
+		return sign ? -v : v;
+	}
+	uint64_t mantissa = significand >> down;
+	bool round = bool((significand >> (down - 1)) & 1);
+	bool sticky = bool(significand & ((1ull << (down - 1)) - 1));
+	if (round && (sticky || (mantissa & 1))) ++mantissa;
+	// the hidden bit adds one to the biased exponent, and a round up that carries out of the fraction one more
+	Bits ieee = (Bits(exponent - 1) << mbits) + Bits(mantissa);
+	if (sign) ieee |= Bits(1) << (sizeof(Bits) * 8 - 1);
+	Real v;
+	std::memcpy(&v, &ieee, sizeof(v));
+	return v;
+}
+
+// narrow an IEEE double to a posit encoding, rounding to nearest even: NaN and infinities encode as NaR
+template<size_t nbits, size_t es>
+inline uint64_t narrow_to_encoding(double v) {
+	constexpr uint64_t nar = 1ull << (nbits - 1);
+	uint64_t ieee;
+	std::memcpy(&ieee, &v, sizeof(ieee));
+	bool sign = bool(ieee >> 63);
+	int exponent = int((ieee >> 52) & 0x7FF);
+	uint64_t fraction = ieee & 0xFFFFFFFFFFFFFull;
+	if (exponent == 0x7FF) return nar;
+	if (exponent == 0 && fraction == 0) return 0;
+	int scale;
+	uint64_t significand;
+	if (exponent == 0) {  // subnormal: normalize the fraction
+		int shift = countLeadingZeros(fraction);
+		significand = fraction << shift;
+		scale = -1074 + 63 - shift;
+	}
+	else {
+		significand = 0x8000000000000000ull | (fraction << 11);
+		scale = exponent - 1023;
+	}
+	return word_encode<nbits, es>(sign, scale, significand, false);
+}
+
+// posits up to widen_table_bits widen through a table of the IEEE values of all their encodings
+constexpr size_t widen_table_bits = 12;
+
+template<typename Real, size_t nbits, size_t es>
+inline const Real* widen_table() {
+	static_assert(nbits <= widen_table_bits, "widen table is limited to widen_table_bits");
+	static const std::vector<Real> table = [] {
+		std::vector<Real> t(size_t(1) << nbits);
+		for (size_t i = 0; i < t.size(); ++i) t[i] = widen_encoding<Real, nbits, es>(i);
+		return t;
+	}();
+	return table.data();
+}
+
+} // namespace internal
+
+template<size_t nbits, size_t es>
+class packed_posit_array {
+	static_assert(nbits >= 2 && nbits <= 64, "packed_posit_array requires 2 <= nbits <= 64");
+	static constexpr uint64_t mask = (nbits == 64 ? 0xFFFFFFFFFFFFFFFFull : ((1ull << (nbits % 64)) - 1));
+public:
+	using value_type = posit<nbits, es>;
+	using lane_type  = typename posit_lane<nbits>::type;
+	using size_type  = size_t;
+
+	// proxy to a packed element: converts to the posit and assigns through to the packed bits
+	class reference {
+	public:
+		reference(packed_posit_array& array, size_t index) : _array(array), _index(index) {}
+		operator value_type() const { return _array.at(_index); }
+		reference& operator=(const value_type& p) { _array.set_raw(_index, p.encoding()); return *this; }
+		reference& operator=(const reference& r) { _array.set_raw(_index, r._array.raw(r._index)); return *this; }
+		reference& operator+=(const value_type& p) { return *this = value_type(*this) + p; }
+		reference& operator-=(const value_type& p) { return *this = value_type(*this) - p; }
+		reference& operator*=(const value_type& p) { return *this = value_type(*this) * p; }
+		reference& operator/=(const value_type& p) { return *this = value_type(*this) / p; }
+	private:
+		packed_posit_array& _array;
+		size_t _index;
+	};
+
+	// random access iterator over the elements: dereferencing yields a posit, or a reference for mutable arrays
+	template<typename Array, typename Reference>
+	class basic_iterator {
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = posit<nbits, es>;
+		using difference_type   = std::ptrdiff_t;
+		using reference         = Reference;
+		using pointer           = void;
+
+		basic_iterator() : _array(nullptr), _index(0) {}
+		basic_iterator(Array* array, size_t index) : _array(array), _index(index) {}
+		// a mutable iterator converts to a const iterator
+		template<typename A, typename R>
+		basic_iterator(const basic_iterator<A, R>& rhs) : _array(rhs._array), _index(rhs._index) {}
+
+		Reference operator*() const { return (*_array)[_index]; }
+		Reference operator[](difference_type n) const { return (*_array)[_index + n]; }
+		basic_iterator& operator++() { ++_index; return *this; }
+		basic_iterator& operator--() { --_index; return *this; }
+		basic_iterator operator++(int) { basic_iterator tmp(*this); ++_index; return tmp; }
+		basic_iterator operator--(int) { basic_iterator tmp(*this); --_index; return tmp; }
+		basic_iterator& operator+=(difference_type n) { _index += n; return *this; }
+		basic_iterator& operator-=(difference_type n) { _index -= n; return *this; }
+		basic_iterator operator+(difference_type n) const { return basic_iterator(_array, _index + n); }
+		basic_iterator operator-(difference_type n) const { return basic_iterator(_array, _index - n); }
+		friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; }
+		difference_type operator-(const basic_iterator& rhs) const { return difference_type(_index) - difference_type(rhs._index); }
+		bool operator==(const basic_iterator& rhs) const { return _index == rhs._index; }
+		bool operator!=(const basic_iterator& rhs) const { return _index != rhs._index; }
+		bool operator< (const basic_iterator& rhs) const { return _index <  rhs._index; }
+		bool operator> (const basic_iterator& rhs) const { return _index >  rhs._index; }
+		bool operator<=(const basic_iterator& rhs) const { return _index <= rhs._index; }
+		bool operator>=(const basic_iterator& rhs) const { return _index >= rhs._index; }
+	private:
+		template<typename A, typename R> friend class basic_iterator;
+		Array* _array;
+		size_t _index;
+	};
+	using iterator       = basic_iterator<packed_posit_array, reference>;
+	using const_iterator = basic_iterator<const packed_posit_array, value_type>;
+
+	packed_posit_array() : _size(0) {}
+	explicit packed_posit_array(size_t n) : _size(n), _words(nr_words(n), 0) {}
+	packed_posit_array(size_t n, const value_type& p) : _size(0) { assign(n, p); }
+	packed_posit_array(std::initializer_list<value_type> elements) : _size(0) {
+		reserve(elements.size());
+		for (const value_type& p : elements) push_back(p);
+	}
+	template<typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+	packed_posit_array(InputIterator first, InputIterator last) : _size(0) {
+		for (; first != last; ++first) push_back(value_type(*first));
+	}
+
+	// capacity
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	void reserve(size_t n) { _words.reserve(nr_words(n)); }
+	// resize keeps the leading elements, new elements are zero
+	void resize(size_t n) {
+		if (n < _size) {
+			_size = n;
+			_words.resize(nr_words(n));
+			// clear the bits beyond the last element, so that growing again yields zeros
+			size_t used = (n * nbits) & 63;
+			if (used) _words.back() &= (1ull << used) - 1;
+		}
+		else {
+			_words.resize(nr_words(n), 0);
+			_size = n;
+		}
+	}
+	void clear() { _size = 0; _words.clear(); }
+	// the memory footprint of the elements in bytes
+	size_t bytes() const { return _words.size() * sizeof(uint64_t); }
+
+	// element access
+	value_type operator[](size_t i) const { return at(i); }
+	reference operator[](size_t i) { return reference(*this, i); }
+	value_type at(size_t i) const { value_type p; p.set_raw_bits(raw(i)); return p; }
+	value_type front() const { return at(0); }
+	value_type back() const { return at(_size - 1); }
+	void assign(size_t n, const value_type& p) {
+		clear();
+		reserve(n);
+		for (size_t i = 0; i < n; ++i) push_back(p);
+	}
+	void push_back(const value_type& p) {
+		resize(_size + 1);
+		set_raw(_size - 1, p.encoding());
+	}
+	void pop_back() { resize(_size - 1); }
+
+	// iterators
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _size); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+
+	// raw encodings
+	uint64_t raw(size_t i) const {
+		size_t bit = i * nbits;
+		size_t w = bit >> 6;
+		unsigned offset = unsigned(bit & 63);
+		uint64_t bits = _words[w] >> offset;
+		if (offset + nbits > 64) bits |= _words[w + 1] << (64 - offset);
+		return bits & mask;
+	}
+	void set_raw(size_t i, uint64_t bits) {
+		size_t bit = i * nbits;
+		size_t w = bit >> 6;
+		unsigned offset = unsigned(bit & 63);
+		bits &= mask;
+		_words[w] = (_words[w] & ~(mask << offset)) | (bits << offset);
+		if (offset + nbits > 64) {
+			unsigned shift = 64 - offset;
+			_words[w + 1] = (_words[w + 1] & ~(mask >> shift)) | (bits >> shift);
+		}
+	}
+	const uint64_t* data() const { return _words.data(); }
+	uint64_t* data() { return _words.data(); }
+
+	// bulk unpack of elements [first, first + n) into lanes, posits, or IEEE values
+	void unpack(size_t first, size_t n, lane_type* lanes) const {
+		if (n == 0) return;
+		size_t bit = first * nbits;
+		const uint64_t* word = _words.data() + (bit >> 6);
+		unsigned offset = unsigned(bit & 63);
+		// a sliding window over the bit stream: the low bits of window hold the next element
+		uint64_t window = *word++;
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t bits = window >> offset;
+			offset += unsigned(nbits);
+			if (offset >= 64) {
+				offset -= 64;
+				// the word with the upper bits is loaded only when the element needs it or more elements follow
+				if (offset > 0 || i + 1 < n) {
+					window = *word++;
+					if (offset > 0) bits |= window << (nbits - offset);
+				}
+			}
+			lanes[i] = lane_type(bits & mask);
+		}
+	}
+	void unpack(size_t first, size_t n, value_type* posits) const {
+		unpack_blocked(first, n, [posits](size_t i, const lane_type& bits) { posits[i].set_raw_bits(bits); });
+	}
+	void unpack(size_t first, size_t n, float* values) const {
+		widen(first, n, values, std::integral_constant<bool, (nbits <= internal::widen_table_bits)>());
+	}
+	void unpack(size_t first, size_t n, double* values) const {
+		widen(first, n, values, std::integral_constant<bool, (nbits <= internal::widen_table_bits)>());
+	}
+
+	// bulk pack of lanes, posits, or IEEE values into elements [first, first + n)
+	void pack(size_t first, size_t n, const lane_type* lanes) {
+		if (n == 0) return;
+		size_t bit = first * nbits;
+		uint64_t* word = _words.data() + (bit >> 6);
+		unsigned offset = unsigned(bit & 63);
+		// accumulate the window of the current word, and merge the partial words at both ends
+		uint64_t keep = offset ? (*word & ((1ull << offset) - 1)) : 0;
+		uint64_t window = keep;
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t bits = uint64_t(lanes[i]) & mask;
+			window |= bits << offset;
+			offset += unsigned(nbits);
+			if (offset >= 64) {
+				*word++ = window;
+				offset -= 64;
+				window = offset ? (bits >> (nbits - offset)) : 0;
+			}
+		}
+		if (offset) *word = (*word & ~((1ull << offset) - 1)) | window;
+	}
+	void pack(size_t first, size_t n, const value_type* posits) {
+		pack_blocked(first, n, [posits](size_t i) { return lane_type(posits[i].encoding()); });
+	}
+	void pack(size_t first, size_t n, const float* values) {
+		pack_blocked(first, n, [values](size_t i) { return lane_type(internal::narrow_to_encoding<nbits, es>(values[i])); });
+	}
+	void pack(size_t first, size_t n, const double* values) {
+		pack_blocked(first, n, [values](size_t i) { return lane_type(internal::narrow_to_encoding<nbits, es>(values[i])); });
+	}
+
+private:
+	// elements are unpacked and packed through a block of lanes on the stack
+	static constexpr size_t block_size = 256;
+
+	static size_t nr_words(size_t n) { return (n * nbits + 63) / 64; }
+
+	template<typename Store>
+	void unpack_blocked(size_t first, size_t n, Store store) const {
+		lane_type lanes[block_size];
+		for (size_t block = 0; block < n; block += block_size) {
+			size_t count = std::min(block_size, n - block);
+			unpack(first + block, count, lanes);
+			for (size_t i = 0; i < count; ++i) store(block + i, lanes[i]);
+		}
+	}
+	template<typename Real>
+	void widen(size_t first, size_t n, Real* values, std::true_type) const {
+		const Real* table = internal::widen_table<Real, nbits, es>();
+		unpack_blocked(first, n, [values, table](size_t i, const lane_type& bits) { values[i] = table[bits]; });
+	}
+	template<typename Real>
+	void widen(size_t first, size_t n, Real* values, std::false_type) const {
+		unpack_blocked(first, n, [values](size_t i, const lane_type& bits) { values[i] = internal::widen_encoding<Real, nbits, es>(bits); });
+	}
+	template<typename Load>
+	void pack_blocked(size_t first, size_t n, Load load) {
+		lane_type lanes[block_size];
+		for (size_t block = 0; block < n; block += block_size) {
+			size_t count = std::min(block_size, n - block);
+			for (size_t i = 0; i < count; ++i) lanes[i] = load(block + i);
+			pack(first + block, count, lanes);
+		}
+	}
+
+	size_t _size;
+	std::vector<uint64_t> _words;
+};
+
+}  // namespace unum
+}  // namespace sw
@@ -67,6 +67,12 @@ typedef __128bitdd double_double;
 // #define POSIT_ENABLE_LITERALS 1
 // - define to non-zero if you want to throw exceptions on arithmetic errors
 // #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+// - define to zero if you want posits with nbits <= 64 to use the bitblock reference arithmetic
+// #define POSIT_WORD_ENGINE 0
+// - define to non-zero if you want posit<8,es> configurations to use the table-driven lookup engine
+// #define POSIT_LOOKUP_POSIT_8 1
+// the defaults of the engine switches are defined in engine_config.hpp
+#include "engine_config.hpp"
 
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 // Posits encode error conditions as NaR (Not a Real), propagating the error through arithmetic operations is preferred
@@ -78,6 +84,9 @@ typedef __128bitdd double_double;
 #include "../bitblock/bitblock.hpp"
 #include "trace_constants.hpp"
 #include "value.hpp"
+#include "word_engine.hpp"
+#include "limb_engine.hpp"
+#include "lookup_engine.hpp"
 #include "fraction.hpp"
 #include "exponent.hpp"
 #include "regime.hpp"
@@ -207,7 +216,7 @@ void extract_fields(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits,
 	bitblock<fbits> _frac;
 	msb = msb - int(nrExponentBits);
 	size_t nrFractionBits = (msb < 0 ? 0 : msb + 1);
-	if (msb >= 0) {
+	if (fbits > 0 && msb >= 0) {
 		for (int i = msb; i >= 0; --i) {
 			_frac[fbits - 1 - (msb - i)] = tmp[i];
 		}
@@ -255,148 +264,43 @@ void decode(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits, es>& _re
 	// so no need to transform back via 2's complement of regime/exponent/fraction
 }
 
-// needed to avoid double rounding situations during arithmetic: TODO: does that mean the condensed version below should be removed?
+// round to nearest even and encode a posit from sign, scale, and a fraction without the hidden bit.
+// The fraction is loaded into words with the hidden bit at the most significant bit, and the integer
+// encoder of the word engine, or of the limb engine for posits wider than 64 bits, assembles the regime,
+// exponent, and fraction fields with shifts and masks, with the fraction bits beyond the rounding position
+// condensed into the sticky bit. Values beyond maxpos and minpos project inward to maxpos and minpos.
 template<size_t nbits, size_t es, size_t fbits>
 inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbits>& fraction_in, bitblock<nbits>& ptt) {
 	if (_trace_conversion) std::cout << "------------------- CONVERT ------------------" << std::endl;
 	if (_trace_conversion) std::cout << "sign " << (_sign ? "-1 " : " 1 ") << "scale " << std::setw(3) << _scale << " fraction " << fraction_in << std::endl;
 
-	ptt.reset(); // ptt will yield the final bits of the posit
-	// construct the posit
-	// interpolation rule checks
-	if (check_inward_projection_range<nbits, es>(_scale)) {    // regime dominated
-		if (_trace_conversion) std::cout << "inward projection" << std::endl;
-		// we are projecting to minpos/maxpos
-		int k = calculate_unconstrained_k<nbits, es>(_scale);
-		ptt = k < 0 ? minpos_pattern<nbits, es>(_sign) : maxpos_pattern<nbits, es>(_sign);
-		// we are done
-		if (_trace_rounding) std::cout << "projection  rounding ";
+	if (nbits <= 64) {
+		uint64_t fraction[1];
+		bool sticky = copy_msbs_to_limbs(fraction_in, fraction);
+		sticky = sticky || (fraction[0] & 1);
+		uint64_t significand = 0x8000000000000000ull | (fraction[0] >> 1);
+		ptt = word_encode<(nbits <= 64 ? nbits : 64), es>(_sign, _scale, significand, sticky);
 	}
 	else {
-		const size_t pt_len = nbits + 3 + es;
-		bitblock<pt_len> pt_bits;
-		bitblock<pt_len> regime;
-		bitblock<pt_len> exponent;
-		bitblock<pt_len> fraction;
-		bitblock<pt_len> sticky_bit;
-
-		bool s = _sign;
-		int e = _scale;
-		bool r = (e >= 0);
-
-		unsigned run = (r ? 1 + (e >> es) : -(e >> es));
-		regime.set(0, 1 ^ r);
-		for (unsigned i = 1; i <= run; i++) regime.set(i, r);
-
-		unsigned esval = e % (uint32_t(1) << es);
-		exponent = convert_to_bitblock<pt_len>(esval);
-		unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
-		// TODO: what needs to be done if nf > fbits?
-		//assert(nf <= input_fbits);
-		// copy the most significant nf fraction bits into fraction
-		unsigned lsb = nf <= fbits ? 0 : nf - fbits;
-		for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[fbits - nf + i];
-
-		bool sb = anyAfter(fraction_in, fbits - 1 - nf);
-
-		// construct the untruncated posit
-		// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
-		regime <<= es + nf + 1;
-		exponent <<= nf + 1;
-		fraction <<= 1;
-		sticky_bit.set(0, sb);
-
-		pt_bits |= regime;
-		pt_bits |= exponent;
-		pt_bits |= fraction;
-		pt_bits |= sticky_bit;
-
-		unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
-		bool blast = pt_bits.test(len - nbits);
-		bool bafter = pt_bits.test(len - nbits - 1);
-		bool bsticky = anyAfter(pt_bits, len - nbits - 1 - 1);
-
-		bool rb = (blast & bafter) | (bafter & bsticky);
-
-
-		pt_bits <<= pt_len - len;
-		truncate(pt_bits, ptt);
-		if (rb) increment_bitset(ptt);
-		if (s) ptt = twos_complement(ptt);
-	}
+		// the significand covers the encoding and its rounding bit with a limb to spare
+		constexpr size_t N = (nbits + 63) / 64 + 1;
+		uint64_t significand[N];
+		bool sticky = copy_msbs_to_limbs(fraction_in, significand);
+		sticky = limbs_shift_right(significand, 1) || sticky;
+		significand[N - 1] |= 0x8000000000000000ull;
+		uint64_t bits[(nbits + 63) / 64];
+		limb_encode<nbits, es>(_sign, _scale, significand, sticky, bits);
+		ptt = limbs_to_bitblock<nbits>(bits);
+	}
+	if (_trace_conversion) std::cout << "posit bits " << ptt << std::endl;
 	return ptt;
 }
 
-// needed to avoid double rounding situations during arithmetic: TODO: does that mean the condensed version below should be removed?
+// round to nearest even and encode a posit from sign, scale, and a fraction without the hidden bit
 template<size_t nbits, size_t es, size_t fbits>
 inline posit<nbits, es>& convert_(bool _sign, int _scale, const bitblock<fbits>& fraction_in, posit<nbits, es>& p) {
-	if (_trace_conversion) std::cout << "------------------- CONVERT ------------------" << std::endl;
-	if (_trace_conversion) std::cout << "sign " << (_sign ? "-1 " : " 1 ") << "scale " << std::setw(3) << _scale << " fraction " << fraction_in << std::endl;
-
-	p.clear();
-	// construct the posit
-	// interpolation rule checks
-	if (check_inward_projection_range<nbits, es>(_scale)) {    // regime dominated
-		if (_trace_conversion) std::cout << "inward projection" << std::endl;
-		// we are projecting to minpos/maxpos
-		int k = calculate_unconstrained_k<nbits, es>(_scale);
-		k < 0 ? p.set(minpos_pattern<nbits, es>(_sign)) : p.set(maxpos_pattern<nbits, es>(_sign));
-		// we are done
-		if (_trace_rounding) std::cout << "projection  rounding ";
-	}
-	else {
-		const size_t pt_len = nbits + 3 + es;
-		bitblock<pt_len> pt_bits;
-		bitblock<pt_len> regime;
-		bitblock<pt_len> exponent;
-		bitblock<pt_len> fraction;
-		bitblock<pt_len> sticky_bit;
-
-		bool s = _sign;
-		int e  = _scale;
-		bool r = (e >= 0);
-
-		unsigned run = (r ? 1 + (e >> es) : -(e >> es));
-		regime.set(0, 1 ^ r);
-		for (unsigned i = 1; i <= run; i++) regime.set(i, r);
-
-		unsigned esval = e % (uint32_t(1) << es);
-		exponent = convert_to_bitblock<pt_len>(esval);
-		unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
-		// TODO: what needs to be done if nf > fbits?
-		//assert(nf <= input_fbits);
-		// copy the most significant nf fraction bits into fraction
-		unsigned lsb = nf <= fbits ? 0 : nf - fbits;
-		for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[fbits - nf + i];
-
-		bool sb = anyAfter(fraction_in, fbits - 1 - nf);
-
-		// construct the untruncated posit
-		// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
-		regime <<= es + nf + 1;
-		exponent <<= nf + 1;
-		fraction <<= 1;
-		sticky_bit.set(0, sb);
-
-		pt_bits |= regime;
-		pt_bits |= exponent;
-		pt_bits |= fraction;
-		pt_bits |= sticky_bit;
-
-		unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
-		bool blast = pt_bits.test(len - nbits);
-		bool bafter = pt_bits.test(len - nbits - 1);
-		bool bsticky = anyAfter(pt_bits, len - nbits - 1 - 1);
-
-		bool rb = (blast & bafter) | (bafter & bsticky);
-
-		bitblock<nbits> ptt;
-		pt_bits <<= pt_len - len;
-		truncate(pt_bits, ptt);
-		if (rb) increment_bitset(ptt);
-		if (s) ptt = twos_complement(ptt);
-		p.set(ptt);
-	}
+	bitblock<nbits> ptt;
+	p.set(convert_to_bb<nbits, es, fbits>(_sign, _scale, fraction_in, ptt));
 	return p;
 }
 
@@ -528,6 +432,17 @@ bool parse(std::string& txt, posit<nbits, es>& p) {
 	return bSuccess;
 }
 
+// tags that select the arithmetic engine of a posit configuration
+struct bitblock_engine_tag {};   // bitblock-based reference arithmetic
+struct word_engine_tag {};       // word-native arithmetic, see word_engine.hpp
+struct lookup_engine_tag {};     // table-driven arithmetic for 8-bit posits, see lookup_engine.hpp
+
+// posit<8,es> configurations use the lookup engine when enabled, configurations that fit in a 64-bit word
+// use the word-native arithmetic engine, all other configurations use the bitblock-based reference arithmetic
+template<size_t nbits>
+using posit_arithmetic_engine = typename std::conditional<POSIT_LOOKUP_POSIT_8 && (nbits == 8), lookup_engine_tag,
+	typename std::conditional<POSIT_WORD_ENGINE && (nbits <= 64), word_engine_tag, bitblock_engine_tag>::type>::type;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // class posit represents posit numbers of arbitrary configuration and their basic arithmetic operations (add/sub, mul/div)
 template<size_t _nbits, size_t _es>
@@ -773,24 +688,8 @@ public:
 		if (rhs.iszero()) return *this;
 
 		// arithmetic operation
-		value<abits + 1> sum;
-		value<fbits> a, b;
-		// transform the inputs into (sign,scale,fraction) triples
-		normalize(a);
-		rhs.normalize(b);
-		module_add<fbits,abits>(a, b, sum);		// add the two inputs
-
-		// special case handling of the result
-		if (sum.iszero()) {
-			setzero();
-		}
-		else if (sum.isinf()) {
-			setnar();
-		}
-		else {
-			convert(sum, *this);
-		}
-		return *this;                
+		add_impl(rhs, arithmetic_engine{});
+		return *this;
 	}
 	posit& operator+=(double rhs) {
 		return *this += posit<nbits, es>(rhs);
@@ -815,23 +714,7 @@ public:
 		if (rhs.iszero()) return *this;
 
 		// arithmetic operation
-		value<abits + 1> difference;
-		value<fbits> a, b;
-		// transform the inputs into (sign,scale,fraction) triples
-		normalize(a);
-		rhs.normalize(b);
-		module_subtract<fbits, abits>(a, b, difference);	// add the two inputs
-
-		// special case handling of the result
-		if (difference.iszero()) {
-			setzero();
-		}
-		else if (difference.isinf()) {
-			setnar();
-		}
-		else {
-			convert(difference, *this);
-		}
+		sub_impl(rhs, arithmetic_engine{});
 		return *this;
 	}
 	posit& operator-=(double rhs) {
@@ -857,24 +740,7 @@ public:
 		}
 
 		// arithmetic operation
-		value<mbits> product;
-		value<fbits> a, b;
-		// transform the inputs into (sign,scale,fraction) triples
-		normalize(a);
-		rhs.normalize(b);
-
-		module_multiply(a, b, product);    // multiply the two inputs
-
-		// special case handling on the output
-		if (product.iszero()) {
-			setzero();
-		}
-		else if (product.isinf()) {
-			setnar();
-		}
-		else {
-			convert(product, *this);
-		}
+		mul_impl(rhs, arithmetic_engine{});
 		return *this;
 	}
 	posit& operator*=(double rhs) {
@@ -909,37 +775,8 @@ public:
 			return *this;
 		}
 #endif
-		value<divbits> ratio;
-		value<fbits> a, b;
-		// transform the inputs into (sign,scale,fraction) triples
-		normalize(a);
-		rhs.normalize(b);
-
-		module_divide(a, b, ratio);
-
-		// special case handling on the output
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-		if (ratio.iszero()) {
-			throw division_result_is_zero{};
-		}
-		else if (ratio.isinf()) {
-			throw division_result_is_infinite{};
-		}
-		else {
-			convert<nbits, es, divbits>(ratio, *this);
-		}
-#else
-		if (ratio.iszero()) {
-			setzero();  // this shouldn't happen as we should project back onto minpos
-		}
-		else if (ratio.isinf()) {
-			setnar();  // this shouldn't happen as we should project back onto maxpos
-		}
-		else {
-			convert<nbits, es, divbits>(ratio, *this);
-		}
-#endif
-
+		// arithmetic operation
+		div_impl(rhs, arithmetic_engine{});
 		return *this;
 	}
 	posit& operator/=(double rhs) {
@@ -959,57 +796,7 @@ public:
 			return p;
 		}
 		// compute the reciprocal
-		bool old_sign = _raw_bits[nbits-1];
-		bitblock<nbits> raw_bits;
-		if (ispowerof2()) {
-			raw_bits = twos_complement(_raw_bits);
-			raw_bits.set(nbits-1, old_sign);
-			p.set(raw_bits);
-		}
-		else {
-			bool s;
-			regime<nbits, es> r;
-			exponent<nbits, es> e;
-			fraction<fbits> f;
-			decode(_raw_bits, s, r, e, f);
-
-			constexpr size_t operand_size = fhbits;
-			bitblock<operand_size> one;
-			one.set(operand_size - 1, true);
-			bitblock<operand_size> frac;
-			copy_into(f.get(), 0, frac);
-			frac.set(operand_size - 1, true);
-			constexpr size_t reciprocal_size = 3 * fbits + 4;
-			bitblock<reciprocal_size> reciprocal;
-			divide_with_fraction(one, frac, reciprocal);
-			if (_trace_reciprocate) {
-				std::cout << "one    " << one << std::endl;
-				std::cout << "frac   " << frac << std::endl;
-				std::cout << "recip  " << reciprocal << std::endl;
-			}
-
-			// radix point falls at operand size == reciprocal_size - operand_size - 1
-			reciprocal <<= operand_size - 1;
-			if (_trace_reciprocate) std::cout << "frac   " << reciprocal << std::endl;
-			int new_scale = -scale(*this);
-			int msb = findMostSignificantBit(reciprocal);
-			if (msb > 0) {
-				int shift = reciprocal_size - msb;
-				reciprocal <<= shift;
-				new_scale -= (shift-1);
-				if (_trace_reciprocate) std::cout << "result " << reciprocal << std::endl;
-			}
-			//std::bitset<operand_size> tr;
-			//truncate(reciprocal, tr);
-			//std::cout << "tr     " << tr << std::endl;
-
-			// the following is failing for some reason
-			// value<reciprocal_size> v(old_sign, new_scale, reciprocal);
-			// convert(v, p);
-			// instead the following works
-			convert_<nbits,es, reciprocal_size>(old_sign, new_scale, reciprocal, p);
-		}
-		return p;
+		return reciprocate_impl(arithmetic_engine{});
 	}
 	// absolute value is simply the 2's complement when negative
 	posit abs() const {
@@ -1092,14 +879,7 @@ public:
 	}
 	// Set the raw bits of the posit given an unsigned value starting from the lsb. Handy for enumerating a posit state space
 	posit<nbits,es>& set_raw_bits(uint64_t value) {
-		clear();
-		bitblock<nbits> raw_bits;
-		uint64_t mask = 1;
-		for ( size_t i = 0; i < nbits; i++ ) {
-			raw_bits.set(i,(value & mask));
-			mask <<= 1;
-		}
-		_raw_bits = raw_bits;
+		_raw_bits = value;   // the bitblock takes the least significant nbits
 		return *this;
 	}
 
@@ -1153,6 +933,193 @@ public:
 private:
 	bitblock<nbits>      _raw_bits;	// raw bit representation
 
+	using arithmetic_engine = posit_arithmetic_engine<_nbits>;
+
+	// table-driven arithmetic: the encoding of the posit<8,es> indexes the lookup tables
+	void add_impl(const posit& rhs, lookup_engine_tag) {
+		_raw_bits = lookup_add<es>(uint8_t(_raw_bits.to_ulong()), uint8_t(rhs._raw_bits.to_ulong()));
+	}
+	void sub_impl(const posit& rhs, lookup_engine_tag) {
+		_raw_bits = lookup_sub<es>(uint8_t(_raw_bits.to_ulong()), uint8_t(rhs._raw_bits.to_ulong()));
+	}
+	void mul_impl(const posit& rhs, lookup_engine_tag) {
+		_raw_bits = lookup_mul<es>(uint8_t(_raw_bits.to_ulong()), uint8_t(rhs._raw_bits.to_ulong()));
+	}
+	void div_impl(const posit& rhs, lookup_engine_tag) {
+		_raw_bits = lookup_div<es>(uint8_t(_raw_bits.to_ulong()), uint8_t(rhs._raw_bits.to_ulong()));
+	}
+	posit reciprocate_impl(lookup_engine_tag) const {
+		posit<nbits, es> p;
+		p._raw_bits = lookup_reciprocal<es>(uint8_t(_raw_bits.to_ulong()));
+		return p;
+	}
+
+	// word-native arithmetic: the encoding of the posit is a single 64-bit word
+	void add_impl(const posit& rhs, word_engine_tag) {
+		_raw_bits = word_add<nbits, es>(_raw_bits.to_ullong(), rhs._raw_bits.to_ullong());
+	}
+	void sub_impl(const posit& rhs, word_engine_tag) {
+		_raw_bits = word_sub<nbits, es>(_raw_bits.to_ullong(), rhs._raw_bits.to_ullong());
+	}
+	void mul_impl(const posit& rhs, word_engine_tag) {
+		_raw_bits = word_mul<nbits, es>(_raw_bits.to_ullong(), rhs._raw_bits.to_ullong());
+	}
+	void div_impl(const posit& rhs, word_engine_tag) {
+		_raw_bits = word_div<nbits, es>(_raw_bits.to_ullong(), rhs._raw_bits.to_ullong());
+	}
+	posit reciprocate_impl(word_engine_tag) const {
+		constexpr uint64_t one = 1ull << (nbits - 2);
+		posit<nbits, es> p;
+		p._raw_bits = word_div<nbits, es>(one, _raw_bits.to_ullong());
+		return p;
+	}
+
+	// bitblock reference arithmetic
+	void add_impl(const posit& rhs, bitblock_engine_tag) {
+		value<abits + 1> sum;
+		value<fbits> a, b;
+		// transform the inputs into (sign,scale,fraction) triples
+		normalize(a);
+		rhs.normalize(b);
+		module_add<fbits,abits>(a, b, sum);		// add the two inputs
+
+		// special case handling of the result
+		if (sum.iszero()) {
+			setzero();
+		}
+		else if (sum.isinf()) {
+			setnar();
+		}
+		else {
+			convert(sum, *this);
+		}
+	}
+	void sub_impl(const posit& rhs, bitblock_engine_tag) {
+		value<abits + 1> difference;
+		value<fbits> a, b;
+		// transform the inputs into (sign,scale,fraction) triples
+		normalize(a);
+		rhs.normalize(b);
+		module_subtract<fbits, abits>(a, b, difference);	// add the two inputs
+
+		// special case handling of the result
+		if (difference.iszero()) {
+			setzero();
+		}
+		else if (difference.isinf()) {
+			setnar();
+		}
+		else {
+			convert(difference, *this);
+		}
+	}
+	void mul_impl(const posit& rhs, bitblock_engine_tag) {
+		value<mbits> product;
+		value<fbits> a, b;
+		// transform the inputs into (sign,scale,fraction) triples
+		normalize(a);
+		rhs.normalize(b);
+
+		module_multiply(a, b, product);    // multiply the two inputs
+
+		// special case handling on the output
+		if (product.iszero()) {
+			setzero();
+		}
+		else if (product.isinf()) {
+			setnar();
+		}
+		else {
+			convert(product, *this);
+		}
+	}
+	void div_impl(const posit& rhs, bitblock_engine_tag) {
+		value<divbits> ratio;
+		value<fbits> a, b;
+		// transform the inputs into (sign,scale,fraction) triples
+		normalize(a);
+		rhs.normalize(b);
+
+		module_divide(a, b, ratio);
+
+		// special case handling on the output
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (ratio.iszero()) {
+			throw division_result_is_zero{};
+		}
+		else if (ratio.isinf()) {
+			throw division_result_is_infinite{};
+		}
+		else {
+			convert<nbits, es, divbits>(ratio, *this);
+		}
+#else
+		if (ratio.iszero()) {
+			setzero();  // this shouldn't happen as we should project back onto minpos
+		}
+		else if (ratio.isinf()) {
+			setnar();  // this shouldn't happen as we should project back onto maxpos
+		}
+		else {
+			convert<nbits, es, divbits>(ratio, *this);
+		}
+#endif
+	}
+	posit reciprocate_impl(bitblock_engine_tag) const {
+		posit<nbits, es> p;
+		bool old_sign = _raw_bits[nbits-1];
+		bitblock<nbits> raw_bits;
+		if (ispowerof2()) {
+			raw_bits = twos_complement(_raw_bits);
+			raw_bits.set(nbits-1, old_sign);
+			p.set(raw_bits);
+		}
+		else {
+			bool s;
+			regime<nbits, es> r;
+			exponent<nbits, es> e;
+			fraction<fbits> f;
+			decode(_raw_bits, s, r, e, f);
+
+			constexpr size_t operand_size = fhbits;
+			bitblock<operand_size> one;
+			one.set(operand_size - 1, true);
+			bitblock<operand_size> frac;
+			copy_into(f.get(), 0, frac);
+			frac.set(operand_size - 1, true);
+			constexpr size_t reciprocal_size = 3 * fbits + 4;
+			bitblock<reciprocal_size> reciprocal;
+			divide_with_fraction(one, frac, reciprocal);
+			if (_trace_reciprocate) {
+				std::cout << "one    " << one << std::endl;
+				std::cout << "frac   " << frac << std::endl;
+				std::cout << "recip  " << reciprocal << std::endl;
+			}
+
+			// radix point falls at operand size == reciprocal_size - operand_size - 1
+			reciprocal <<= operand_size - 1;
+			if (_trace_reciprocate) std::cout << "frac   " << reciprocal << std::endl;
+			int new_scale = -scale(*this);
+			int msb = findMostSignificantBit(reciprocal);
+			if (msb > 0) {
+				int shift = reciprocal_size - msb;
+				reciprocal <<= shift;
+				new_scale -= (shift-1);
+				if (_trace_reciprocate) std::cout << "result " << reciprocal << std::endl;
+			}
+			//std::bitset<operand_size> tr;
+			//truncate(reciprocal, tr);
+			//std::cout << "tr     " << tr << std::endl;
+
+			// the following is failing for some reason
+			// value<reciprocal_size> v(old_sign, new_scale, reciprocal);
+			// convert(v, p);
+			// instead the following works
+			convert_<nbits,es, reciprocal_size>(old_sign, new_scale, reciprocal, p);
+		}
+		return p;
+	}
+
 	// HELPER methods
 
 	// Conversion functions
@@ -0,0 +1,204 @@
+#pragma once
+// posit_array.hpp: element-wise arithmetic on arrays of posits
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <vector>
+
+#include "engine_config.hpp"
+#include "lane_engine.hpp"
+
+namespace sw {
+namespace unum {
+
+// The posit array operators apply an arithmetic operator to each element of a span of posits,
+// given as a pointer and an element count, and write the results to a span of the same length.
+// The output span may alias an input span.
+//
+// The fast specializations of posit<16,1> and posit<32,2> store the bare encoding and have vectorized
+// kernels for add, sub, mul, scale, and negate, but not for div and fma: when POSIT_ARRAY_SIMD is set, the operators use the
+// AVX-512 or AVX2 kernel that the host processor supports and finish the remainder of the span with the
+// scalar operators. All other operators and configurations use the scalar operators, which also serve as
+// the reference for the vectorized kernels. The vectorized kernels produce the quiet NaR of the posit
+// operators: when POSIT_THROW_ARITHMETIC_EXCEPTION is set, the array operators use the scalar operators.
+//
+// The bulk conversions to_posit, to_float, and to_double convert between spans of IEEE-754 values and spans
+// of posits, rounding like the scalar conversions. The vectorized kernels decode the IEEE exponent and fraction
+// of all lanes at once and encode the regime with the rounding of the arithmetic kernels: posit<16,1> converts
+// to and from float, and posit<32,2> to and from float and double.
+
+// the SIMD instruction set used by the posit array operators
+inline simd_isa posit_array_isa() {
+#if POSIT_ARRAY_SIMD
+	return host_simd_isa();
+#else
+	return simd_isa::scalar;
+#endif
+}
+
+namespace internal {
+
+// run the vectorized kernel of a posit configuration and return the number of elements it processed
+template<size_t nbits, size_t es>
+inline size_t posit_array_kernel(lane_op op, simd_isa isa, const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, bool broadcast) {
+	// the lane kernels load and store bare encodings, and produce NaR instead of throwing
+	if (sizeof(posit<nbits, es>) * 8 != nbits || POSIT_THROW_ARITHMETIC_EXCEPTION) return 0;
+	return posit_lane_kernels<nbits, es>::apply(op, isa, a, b, c, n, broadcast);
+}
+
+// run the vectorized conversion kernel of a posit configuration and return the number of elements it processed
+template<unsigned ebits, unsigned mbits, bool to_ieee, size_t nbits, size_t es>
+inline size_t posit_conversion_kernel(simd_isa isa, const void* src, void* dst, size_t n) {
+	if (sizeof(posit<nbits, es>) * 8 != nbits || POSIT_THROW_ARITHMETIC_EXCEPTION) return 0;
+	return posit_lane_kernels<nbits, es>::template convert<ebits, mbits, to_ieee>(isa, src, dst, n);
+}
+
+} // namespace internal
+
+// c[i] = a[i] + b[i]
+template<size_t nbits, size_t es>
+void array_add(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_array_kernel(lane_op::add, isa, a, b, c, n, false);
+	for (; i < n; ++i) c[i] = a[i] + b[i];
+}
+
+// c[i] = a[i] - b[i]
+template<size_t nbits, size_t es>
+void array_sub(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_array_kernel(lane_op::sub, isa, a, b, c, n, false);
+	for (; i < n; ++i) c[i] = a[i] - b[i];
+}
+
+// c[i] = a[i] * b[i]
+template<size_t nbits, size_t es>
+void array_mul(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_array_kernel(lane_op::mul, isa, a, b, c, n, false);
+	for (; i < n; ++i) c[i] = a[i] * b[i];
+}
+
+// c[i] = a[i] / b[i]
+// scalar only: the lane engine has no division kernel, the isa argument keeps the signature uniform and is ignored
+template<size_t nbits, size_t es>
+void array_div(const posit<nbits, es>* a, const posit<nbits, es>* b, posit<nbits, es>* c, size_t n, simd_isa = posit_array_isa()) {
+	for (size_t i = 0; i < n; ++i) c[i] = a[i] / b[i];
+}
+
+// d[i] = a[i] * b[i] + c[i], rounded once
+// scalar only: the exact product and sum go through a quire per element, the isa argument is ignored
+template<size_t nbits, size_t es>
+void array_fma(const posit<nbits, es>* a, const posit<nbits, es>* b, const posit<nbits, es>* c, posit<nbits, es>* d, size_t n, simd_isa = posit_array_isa()) {
+	posit<nbits, es> one(1);
+	for (size_t i = 0; i < n; ++i) {
+		if (a[i].isnar() || b[i].isnar() || c[i].isnar()) {
+			d[i].setnar();
+			continue;
+		}
+		// the product and the addend are both exact in the quire
+		quire<nbits, es, 2> q;
+		q += quire_mul(a[i], b[i]);
+		q += quire_mul(c[i], one);
+		convert(q.to_value(), d[i]);
+	}
+}
+
+// c[i] = alpha * a[i]
+template<size_t nbits, size_t es>
+void array_scale(const posit<nbits, es>& alpha, const posit<nbits, es>* a, posit<nbits, es>* c, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_array_kernel(lane_op::mul, isa, a, &alpha, c, n, true);
+	for (; i < n; ++i) c[i] = alpha * a[i];
+}
+
+// c[i] = -a[i]
+template<size_t nbits, size_t es>
+void array_negate(const posit<nbits, es>* a, posit<nbits, es>* c, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_array_kernel(lane_op::negate, isa, a, a, c, n, false);
+	for (; i < n; ++i) c[i] = -a[i];
+}
+
+// dst[i] = posit(src[i])
+template<size_t nbits, size_t es>
+void to_posit(const float* src, posit<nbits, es>* dst, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_conversion_kernel<8, 23, false, nbits, es>(isa, src, dst, n);
+	for (; i < n; ++i) dst[i] = src[i];
+}
+template<size_t nbits, size_t es>
+void to_posit(const double* src, posit<nbits, es>* dst, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_conversion_kernel<11, 52, false, nbits, es>(isa, src, dst, n);
+	for (; i < n; ++i) dst[i] = src[i];
+}
+
+// dst[i] = float(src[i])
+template<size_t nbits, size_t es>
+void to_float(const posit<nbits, es>* src, float* dst, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_conversion_kernel<8, 23, true, nbits, es>(isa, src, dst, n);
+	for (; i < n; ++i) dst[i] = float(src[i]);
+}
+
+// dst[i] = double(src[i])
+template<size_t nbits, size_t es>
+void to_double(const posit<nbits, es>* src, double* dst, size_t n, simd_isa isa = posit_array_isa()) {
+	size_t i = internal::posit_conversion_kernel<11, 52, true, nbits, es>(isa, src, dst, n);
+	for (; i < n; ++i) dst[i] = double(src[i]);
+}
+
+// convenience overloads for vectors: the output vector is resized to the length of the first input
+template<size_t nbits, size_t es>
+void array_add(const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_add(a.data(), b.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_sub(const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_sub(a.data(), b.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_mul(const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_mul(a.data(), b.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_div(const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_div(a.data(), b.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_fma(const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b, const std::vector< posit<nbits, es> >& c, std::vector< posit<nbits, es> >& d) {
+	d.resize(a.size());
+	array_fma(a.data(), b.data(), c.data(), d.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_scale(const posit<nbits, es>& alpha, const std::vector< posit<nbits, es> >& a, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_scale(alpha, a.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void array_negate(const std::vector< posit<nbits, es> >& a, std::vector< posit<nbits, es> >& c) {
+	c.resize(a.size());
+	array_negate(a.data(), c.data(), a.size());
+}
+template<size_t nbits, size_t es>
+void to_posit(const std::vector<float>& src, std::vector< posit<nbits, es> >& dst) {
+	dst.resize(src.size());
+	to_posit(src.data(), dst.data(), src.size());
+}
+template<size_t nbits, size_t es>
+void to_posit(const std::vector<double>& src, std::vector< posit<nbits, es> >& dst) {
+	dst.resize(src.size());
+	to_posit(src.data(), dst.data(), src.size());
+}
+template<size_t nbits, size_t es>
+void to_float(const std::vector< posit<nbits, es> >& src, std::vector<float>& dst) {
+	dst.resize(src.size());
+	to_float(src.data(), dst.data(), src.size());
+}
+template<size_t nbits, size_t es>
+void to_double(const std::vector< posit<nbits, es> >& src, std::vector<double>& dst) {
+	dst.resize(src.size());
+	to_double(src.data(), dst.data(), src.size());
+}
+
+}  // namespace unum
+}  // namespace sw
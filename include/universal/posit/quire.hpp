@@ -4,6 +4,9 @@
 // Copyright (C) 2017-2018 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <type_traits>
+#include "word_engine.hpp"
 
 namespace sw {
 	namespace unum {
@@ -94,6 +97,17 @@ inline int min_scale() {
  All values in and out of the quire are normalized (sign, scale, fraction) triplets.
  Even though a quire is very strongly coupled to a posit configuration via the dynamic range
  a particular posit configuration exhibits, the class is designed to NOT depend on the posit<nbits,es> class definition.
+
+ The accumulator is a fixed-point integer in sign-magnitude form: bit 0 is the lsb of the lower segment,
+ the radix point sits at bit half_range, and the upper and capacity segments follow. The magnitude is stored
+ in 64-bit limbs that carry 56 bits each, least significant limb first. A value is added by shifting its
+ fixed-point significand into position with word shifts and adding it, or subtracting it, into the two or three
+ limbs it overlaps, without propagating the carries. The 8 spare bits of each limb absorb the carries and borrows
+ of carry_save_depth accumulations, after which, and before any observation of the quire, a single pass
+ propagates the carries, resolves the sign, and returns the limbs to their 56-bit canonical form.
+
+ A NaR operand throws operand_is_nar when POSIT_THROW_ARITHMETIC_EXCEPTION is set. Otherwise the quire
+ becomes NaR, stays NaR through further accumulations, and to_value() returns NaR until the quire is reset.
  */
 template<size_t nbits, size_t es, size_t capacity = 30>
 class quire {
@@ -105,9 +119,15 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr size_t upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr size_t qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
-	
+
+	// limb organization of the accumulator
+	static constexpr size_t accumulator_bits = half_range + upper_range + capacity;   // lower, upper, and capacity segments
+	static constexpr unsigned limb_bits = 56;                  // payload bits of a limb, the remaining 8 bits are carry headroom
+	static constexpr size_t nrLimbs = accumulator_bits / limb_bits + 2;   // with a spare limb for the carry out of the top limb
+	static constexpr unsigned carry_save_depth = 63;           // accumulations between carry propagations
+
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() { reset(); }
 
 	explicit quire(int8_t initial_value)   { *this = initial_value; }
 	explicit quire(int16_t initial_value)  { *this = initial_value; }
@@ -127,8 +147,10 @@ public:
 	quire& operator=(const value<fbits>& rhs) {
 		reset();
 		if (rhs.iszero()) return *this;
-		if (rhs.isinf() || rhs.isnan()) throw operand_is_nar{};
-		_sign = rhs.sign();
+		if (rhs.isinf() || rhs.isnan()) {
+			set_nar();
+			return *this;
+		}
 
 		int scale = rhs.scale();
 		// TODO: we are clamping the values of the RHS to be within the dynamic range of the posit
@@ -138,37 +160,13 @@ public:
 		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
 		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
 
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::unum::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
+		_sign = rhs.sign();
+		add_value(rhs, false);
 		return *this;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
-		*this = rhs.to_value();
-		return *this;
+		reset();
+		return *this += rhs;
 	}
 	quire& operator=(int8_t rhs) {
 		*this = int64_t(rhs);
@@ -183,30 +181,10 @@ public:
 		return *this;
 	}
 	quire& operator=(int64_t rhs) {
-		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
-		unsigned msb = findMostSignificantBit(magnitude);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			unsigned i, c;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		uint64_t magnitude = (rhs < 0) ? uint64_t(0) - uint64_t(rhs) : uint64_t(rhs);
+		*this = (unsigned long long)magnitude;
+		_sign = rhs < 0;
 		return *this;
 	}
 	quire& operator=(unsigned long long rhs) {
@@ -215,20 +193,9 @@ public:
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (unsigned i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		// copy the value into the quire: the integer bits start at the radix point
+		const uint64_t integer[1] = { uint64_t(rhs) };
+		add_limbs(integer, int(half_range) + 63, false);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -253,6 +220,10 @@ public:
 	template<size_t fbits>
 	quire& operator+=(const value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
+		if (rhs.isinf() || rhs.isnan()) {
+			set_nar();
+			return *this;
+		}
 
 		if (rhs.scale() > int(half_range)) {
 			throw operand_too_large_for_quire{};
@@ -260,67 +231,67 @@ public:
 		if (rhs.scale() < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
-		// sign/magnitude classification
-		// operation      add magnitudes           subtract magnitudes
-		//                                     a < b       a = b      a > b
-		// (+a) + (+b)      +(a + b)
-		// (+a) + (-b)                       -(b - a)    +(a - b)   +(a - b)
-		// (-a) + (+b)                       +(b - a)    +(a - b)   -(a - b)
-		// (-a) + (-b)      -(a + b)
-		if (_sign == rhs.sign()) {
-			add_value(rhs);
-			// _sign stays the same, so nothing new to assign
-		}
-		else {
-			// subtract magnitudes
-			int cmp = CompareMagnitude(rhs);
-			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
-				_sign = rhs.sign();
-			}
-			else if (cmp > 0) {
-				subtract_value(rhs);
-				// _sign stays the same
-			}
-			else {
-				subtract_value(rhs);
-				_sign = false;
-			}
-		}
+		// a value with the sign of the quire adds to the magnitude, otherwise it subtracts from it:
+		// a magnitude that turns negative flips the sign of the quire when the carries are propagated
+		add_value(rhs, rhs.sign() != _sign);
 		return *this;
 	}
 	// Subtract a normalized value from the quire value
 	template<size_t fbits>
 	quire& operator-=(const value<fbits>& rhs) {
+		if (rhs.isnan()) {   // negation does not carry the nan flag
+			set_nar();
+			return *this;
+		}
 		return *this += -rhs;
 	}
 	
 	// add a posit directly (syntactic sugar)
 	quire& operator+=(const posit<nbits, es>& rhs) {
-		return operator+=(rhs.to_value());
+		add_posit(rhs, false, std::integral_constant<bool, (nbits <= 64)>());
+		return *this;
 	}
 	// subtract a posit directly (syntactic sugar)
 	quire& operator-=(const posit<nbits, es>& rhs) {
-		return operator-=(rhs.to_value());
+		add_posit(rhs, true, std::integral_constant<bool, (nbits <= 64)>());
+		return *this;
+	}
+
+	// fused multiply-accumulate of a pair of posits: q += a * b, without materializing the product as a value
+	quire& mac(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		add_product(a, b, false, std::integral_constant<bool, (nbits <= 64)>());
+		return *this;
+	}
+	// fused multiply-subtract of a pair of posits: q -= a * b
+	quire& msc(const posit<nbits, es>& a, const posit<nbits, es>& b) {
+		add_product(a, b, true, std::integral_constant<bool, (nbits <= 64)>());
+		return *this;
+	}
+
+	// fused multiply-accumulate of decoded operands: q += (-1)^sign * 2^scale * significand_a * significand_b,
+	// where the significands carry their hidden bit at bit 63 and scale is the sum of the scales of the operands
+	quire& mac(bool sign, int scale, uint64_t significand_a, uint64_t significand_b) {
+		uint64_t product[2];
+		product[1] = multiply_words(significand_a, significand_b, product[0]);
+		// the product of the significands is in [1, 4): bit 127 has weight 2^(scale + 1)
+		add_limbs(product, int(half_range) + scale + 1, sign != _sign);
+		return *this;
 	}
 
-	// add two quires
+	// add two quires: the limbs are added exactly, without rounding through a value
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		add_quire(q, false);
+		return *this;
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		add_quire(q, true);
+		return *this;
 	}
 	
 	// bit addressing operator
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[index];
-		if (index < int(radix_point) + int(upper_range)) return _upper[index - int(radix_point)];
-		if (index < int(radix_point) + int(upper_range) + int(capacity)) return _capacity[index - int(radix_point) - int(upper_range)];
+		if (index < int(accumulator_bits)) return test(index);
 		throw "index out of range";
 	}
 
@@ -330,13 +301,13 @@ public:
 	// reset the state of a quire to zero
 	void reset() {
 		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		_nar = false;
+		_pending = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) _limb[i] = 0;
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
-	void set_sign(bool v) { _sign = v; }
+	void set_sign(bool v) { normalize(); _sign = v; }
 	bool load_bits(const std::string& string_of_bits) {
 		reset();
 		// format is "+:0000_000000000.000000000"
@@ -358,45 +329,30 @@ public:
 			return false; // fail, wrong format
 		}
 		int segment = 0; // capacity segment = 0, upper segment = 1, lower segment = 2
-		int msb_c = capacity - 1;
-		int msb_u = upper_range - 1;
-		int msb_l = half_range - 1;
+		int msb_c = int(half_range + upper_range + capacity) - 1;
+		int msb_u = int(half_range + upper_range) - 1;
+		int msb_l = int(half_range) - 1;
 		for (; it != string_of_bits.end(); ++it) {
 			if (*it == '_') {
-				if (msb_c != -1) return false; // fail: incorrect format
+				if (msb_c != int(half_range + upper_range) - 1) return false; // fail: incorrect format
 				segment = 1;
 			}
 			else if (*it == '.') {
-				if (msb_u != -1) return false; // fail, incorrect format
+				if (msb_u != int(half_range) - 1) return false; // fail, incorrect format
 				segment = 2;
 			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
 			else {
+				bool bit = (*it == '1');
 				switch (segment) {
 				case 0:
-					_capacity.reset(msb_c--);
+					set_bit(msb_c--, bit);
 					break;
 				case 1:
-					_upper.reset(msb_u--);
+					set_bit(msb_u--, bit);
 					break;
 				case 2:
 					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
+					set_bit(msb_l--, bit);
 					break;
 				default:
 					return false; // fail, incorrect state
@@ -409,19 +365,16 @@ public:
 // Selectors
 	
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
+	// the bits of the value below the lsb of the quire do not participate
 	template<size_t fbits>
-	int CompareMagnitude(const value<fbits>& v) {
-		// inefficient as we are copying a whole quire just to reset the sign bit, but we are leveraging the comparison logic
-		quire<nbits, es, capacity> absq = abs(*this);
-		//value<qbits> absq = abs(*this);
-		value<fbits> absv = abs(v);
-		if (absq < absv) {
-			return -1;
-		}
-		else if (absq > absv) {
-			return 1;
-		}
-		return 0;
+	int CompareMagnitude(const value<fbits>& v) const {
+		normalize();
+		if (v.iszero()) return iszero() ? 0 : 1;
+		if (v.scale() >= int(accumulator_bits - half_range)) return -1;
+		int64_t magnitude[nrLimbs] = { 0 };
+		place_value(magnitude, v, false);
+		propagate_carries(magnitude);
+		return compare_limbs(_limb, magnitude);
 	}
 	// query functions for quire attributes
 	inline int dynamic_range() const { return int(range); }
@@ -429,324 +382,241 @@ public:
 	inline int min_scale() const { return -int(half_range); }
 	inline int capacity_range() const { return int(capacity); }
 	inline size_t total_bits() const { return qbits + 1; }
-	inline bool isneg() const { return _sign; }
-	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	inline bool isneg() const { normalize(); return _sign; }
+	inline bool ispos() const { normalize(); return _sign; }
+	inline bool isnar() const { return _nar; }
+	inline bool iszero() const {
+		normalize();
+		int64_t any = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) any |= _limb[i];
+		return any == 0;
+	}
 	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(msb)) break;
-		}
-		if (msb >= 0) return msb + upper_range;
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(msb)) break;
-		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(i)) break;
-		}
-		return msb;
+		return msb() - int(half_range);   // a zero quire returns -(half_range + 1)
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
-	inline bool sign() const { return _sign; }
-	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
+	inline bool sign() const { normalize(); return _sign; }
+	inline float sign_value() const { return (sign() ? -1.0 : 1.0); }
 	bitblock<qbits+1> get() const {
-		bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
-		}
-		return q;
+		uint64_t words[nrWords];
+		to_words(words);
+		return limbs_to_bitblock<qbits + 1>(words);
 	}
 	value<qbits> to_value() const {
 		// find the MSB and build the fraction
 		bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _lower[i];
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		if (_nar) {
+			value<qbits> nar;
+			nar.setinf();     // maps to NaR on the posit side
+			return nar;
+		}
+		int msbit = msb();
+		if (msbit < 0) {
+			return value<qbits>(_sign, 0, fraction, true, false);
+		}
+		// the bits below the msb become the fraction, aligned to the top of the fraction bitblock
+		uint64_t words[nrWords];
+		to_words(words);
+		limbs_shift_left(words, unsigned(int(qbits) - msbit));
+		fraction = limbs_to_bitblock<qbits>(words);
+		return value<qbits>(_sign, msbit - int(half_range), fraction, false, false);
 	}
 	bool anyAfter(int index) const {
 		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
+			if (test(i)) return true;
 		}
 		return false;
 	}
 
 private:
-	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
-
-	// add a value to the quire
-	template<size_t fbits>
-	void add_value(const value<fbits>& v) {
-		if (v.iszero()) return;
-		// scale is the location of the msb in the fixed point representation
-		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - int(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry & _a;
-						i++;
-					}
-				}
-			}
+	static constexpr size_t nrWords = (accumulator_bits + 63) / 64;
+	static constexpr int64_t limb_mask = (int64_t(1) << limb_bits) - 1;
+
+	// the accumulator is observably const while the carries are propagated
+	mutable int64_t  _limb[nrLimbs];   // magnitude, least significant limb first
+	mutable bool     _sign;
+	bool             _nar;             // sticky: a NaR operand was accumulated
+	mutable unsigned _pending;         // accumulations since the last carry propagation
+
+	// add w * 2^lsb to, or subtract it from, the limbs it overlaps
+	static void deposit(int64_t (&limbs)[nrLimbs], uint64_t w, int lsb, bool subtract) {
+		size_t l = size_t(lsb) / limb_bits;
+		unsigned offset = unsigned(lsb) % limb_bits;
+		int64_t lo = int64_t((w << offset) & uint64_t(limb_mask));
+		uint64_t rest = w >> (limb_bits - offset);
+		int64_t mid = int64_t(rest & uint64_t(limb_mask));
+		int64_t hi = int64_t(rest >> limb_bits);
+		if (subtract) {
+			limbs[l] -= lo;
+			limbs[l + 1] -= mid;
+			if (hi && l + 2 < nrLimbs) limbs[l + 2] -= hi;
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
-			}
+		else {
+			limbs[l] += lo;
+			limbs[l + 1] += mid;
+			if (hi && l + 2 < nrLimbs) limbs[l + 2] += hi;
 		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ carry;
-				carry = (_a & _b) | (carry & (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ carry;
-				carry = carry & _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ carry;
-					carry = carry & _a;
-					i++;
-				}
+	}
+	// add a significand of 64-bit words, least significant word first, whose msb is at quire bit msb:
+	// the bits below the lsb of the quire are dropped
+	template<size_t N>
+	static void place_limbs(int64_t (&limbs)[nrLimbs], const uint64_t (&significand)[N], int msb, bool subtract) {
+		for (size_t j = N; j-- > 0; ) {
+			int lsb = msb - 63 - int(64 * (N - 1 - j));
+			if (lsb + 63 < 0) break;
+			uint64_t w = significand[j];
+			if (lsb < 0) {
+				w >>= -lsb;
+				lsb = 0;
 			}
+			if (w) deposit(limbs, w, lsb, subtract);
 		}
 	}
-	// subtract a value from the quire
 	template<size_t fbits>
-	void subtract_value(const value<fbits>& v) {
-		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - int(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			int lsb = int(half_range) + v.scale() - int(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[i];
-				_lower[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow & !_a;
-						i++;
-					}
-				}
-			}
+	static void place_value(int64_t (&limbs)[nrLimbs], const value<fbits>& v, bool subtract) {
+		constexpr size_t N = (fbits + 1 + 63) / 64;
+		uint64_t significand[N];
+		copy_msbs_to_limbs(v.get_fixed_point(), significand);   // hidden bit at the msb of the top word
+		place_limbs(limbs, significand, int(half_range) + v.scale(), subtract);
+	}
+	// propagate the carries and borrows, returns the carry out of the top limb
+	static int64_t propagate_carries(int64_t (&limbs)[nrLimbs]) {
+		int64_t carry = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) {
+			int64_t v = limbs[i] + carry;
+			carry = v >> limb_bits;      // arithmetic shift: floor division
+			limbs[i] = v & limb_mask;
+		}
+		return carry;
+	}
+	static int compare_limbs(const int64_t (&a)[nrLimbs], const int64_t (&b)[nrLimbs]) {
+		for (size_t i = nrLimbs; i-- > 0; ) {
+			if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+		return 0;
+	}
+
+	template<size_t fbits>
+	void add_value(const value<fbits>& v, bool subtract) {
+		place_value(_limb, v, subtract);
+		if (++_pending >= carry_save_depth) propagate();
+	}
+	template<size_t N>
+	void add_limbs(const uint64_t (&significand)[N], int msb, bool subtract) {
+		place_limbs(_limb, significand, msb, subtract);
+		if (++_pending >= carry_save_depth) propagate();
+	}
+	// posits that fit a word are decoded by the word engine and their integer significands multiplied:
+	// the 128-bit product goes straight into the limbs at the offset given by the sum of the scales
+	void add_product(const posit<nbits, es>& a, const posit<nbits, es>& b, bool negate, std::true_type) {
+		if (a.isnar() || b.isnar()) {
+			set_nar();
+			return;
+		}
+		if (a.iszero() || b.iszero()) return;
+		bool sign_a, sign_b;
+		int scale_a, scale_b;
+		uint64_t significand_a, significand_b;
+		word_decode<nbits, es>(uint64_t(a.encoding()), sign_a, scale_a, significand_a);
+		word_decode<nbits, es>(uint64_t(b.encoding()), sign_b, scale_b, significand_b);
+		mac((sign_a != sign_b) != negate, scale_a + scale_b, significand_a, significand_b);
+	}
+	// posits that fit a word are decoded by the word engine: the significand goes straight into the limbs
+	void add_posit(const posit<nbits, es>& p, bool negate, std::true_type) {
+		if (p.isnar()) {
+			set_nar();
+			return;
+		}
+		if (p.iszero()) return;
+		bool sign;
+		int scale;
+		uint64_t significand[1];
+		word_decode<nbits, es>(uint64_t(p.encoding()), sign, scale, significand[0]);
+		add_limbs(significand, int(half_range) + scale, (sign != negate) != _sign);
+	}
+	// the wider posits go through their normalized value
+	void add_posit(const posit<nbits, es>& p, bool negate, std::false_type) {
+		if (negate) *this -= p.to_value(); else *this += p.to_value();
+	}
+	// the wider posits go through the unrounded product of quire_mul
+	void add_product(const posit<nbits, es>& a, const posit<nbits, es>& b, bool negate, std::false_type) {
+		if (negate) *this -= quire_mul(a, b); else *this += quire_mul(a, b);
+	}
+	void add_quire(const quire& q, bool negate) {
+		_nar = _nar || q._nar;
+		normalize();
+		q.normalize();
+		bool subtract = (q._sign != negate) != _sign;
+		for (size_t i = 0; i < nrLimbs; ++i) {
+			if (subtract) _limb[i] -= q._limb[i]; else _limb[i] += q._limb[i];
+		}
+		if (++_pending >= carry_save_depth) propagate();
+	}
+
+	// a NaR operand: throw when arithmetic exceptions are enabled, otherwise make the quire NaR
+	void set_nar() {
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		throw operand_is_nar{};
+#else
+		_nar = true;
+#endif
+	}
+
+	// bring the limbs back to their canonical 56-bit form
+	void normalize() const {
+		if (_pending) propagate();
+	}
+	void propagate() const {
+		if (propagate_carries(_limb) < 0) {
+			// the magnitude went negative: negate the limbs and flip the sign
+			for (size_t i = 0; i < nrLimbs; ++i) _limb[i] = -_limb[i];
+			propagate_carries(_limb);
+			_sign = !_sign;
 		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-				bool _a = _lower[i];
-				bool _b = fraction[f];
-				_lower[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= int(fbits); i++, f++) {
-				bool _a = _upper[i];
-				bool _b = fraction[f];
-				_upper[i] = _a ^ _b ^ borrow;
-				borrow = (!_a & _b) | (!(!_a ^ !_b) & borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[i];
-				_upper[i] = _a ^ borrow;
-				borrow = borrow & !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[i];
-					_capacity[i] = _a ^ borrow;
-					borrow = borrow & !_a;
-					i++;
-				}
-			}
+		// carries beyond the capacity segment are dropped
+		for (size_t i = accumulator_bits / limb_bits; i < nrLimbs; ++i) {
+			int shift = int(accumulator_bits) - int(i * limb_bits);
+			if (shift <= 0) _limb[i] = 0; else _limb[i] &= (int64_t(1) << shift) - 1;
+		}
+		int64_t any = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) any |= _limb[i];
+		if (any == 0) _sign = false;
+		_pending = 0;
+	}
+
+	bool test(int index) const {
+		normalize();
+		return (_limb[size_t(index) / limb_bits] >> (unsigned(index) % limb_bits)) & 1;
+	}
+	void set_bit(int index, bool bit) {
+		int64_t mask = int64_t(1) << (unsigned(index) % limb_bits);
+		if (bit) _limb[size_t(index) / limb_bits] |= mask; else _limb[size_t(index) / limb_bits] &= ~mask;
+	}
+	// position of the most significant bit, -1 when the quire is zero
+	int msb() const {
+		normalize();
+		for (size_t i = nrLimbs; i-- > 0; ) {
+			if (_limb[i]) return int(i * limb_bits) + 63 - countLeadingZeros(uint64_t(_limb[i]));
+		}
+		return -1;
+	}
+	// repack the canonical limbs into 64-bit words, least significant word first
+	void to_words(uint64_t (&words)[nrWords]) const {
+		normalize();
+		for (size_t i = 0; i < nrWords; ++i) words[i] = 0;
+		for (size_t i = 0; i < nrLimbs; ++i) {
+			size_t position = i * limb_bits;
+			if (position >= 64 * nrWords || _limb[i] == 0) continue;
+			unsigned offset = unsigned(position % 64);
+			words[position / 64] |= uint64_t(_limb[i]) << offset;
+			if (offset > 64 - limb_bits && position / 64 + 1 < nrWords) words[position / 64 + 1] |= uint64_t(_limb[i]) >> (64 - offset);
 		}
 	}
+	// print the bits msb to lsb between two bit positions
+	void print_segment(std::ostream& ostr, int msb, int lsb) const {
+		for (int i = msb; i >= lsb; --i) ostr << (test(i) ? '1' : '0');
+	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<size_t nnbits, size_t nes, size_t ncapacity>
@@ -806,7 +676,13 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<size_t nbits, size_t es, size_t capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
+	using Quire = quire<nbits, es, capacity>;
+	ostr << (q.sign() ? "-:" : "+:");
+	q.print_segment(ostr, int(Quire::accumulator_bits) - 1, int(Quire::half_range + Quire::upper_range));
+	ostr << "_";
+	q.print_segment(ostr, int(Quire::half_range + Quire::upper_range) - 1, int(Quire::half_range));
+	ostr << ".";
+	q.print_segment(ostr, int(Quire::half_range) - 1, 0);
 	return ostr;
 }
 
@@ -817,25 +693,24 @@ inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capa
 }
 
 template<size_t nbits, size_t es, size_t capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
+	lhs.normalize();
+	rhs.normalize();
+	if (lhs._nar || rhs._nar) return lhs._nar == rhs._nar;
+	return lhs._sign == rhs._sign && quire<nbits, es, capacity>::compare_limbs(lhs._limb, rhs._limb) == 0;
+}
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<size_t nbits, size_t es, size_t capacity>
 inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { 
+	lhs.normalize();
+	rhs.normalize();
 	bool bSmaller = false;
 	if (!lhs._sign && rhs._sign) {
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
+		bSmaller = quire<nbits, es, capacity>::compare_limbs(lhs._limb, rhs._limb) < 0;
 	}
 	return bSmaller;
 }
@@ -859,36 +734,7 @@ inline bool operator< (const quire<nbits, es, capacity>& q, const value<fbits>&
 		bSmaller = true;
 	}
 	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale < vscale) {
-			bSmaller = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = quire<nbits, es, capacity>::radix_point + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (!q[i] && fixed[f]) {
-					bSmaller = true;
-					undecided = false;
-					break;
-				}
-				else if (q[i] && !fixed[f]) {
-					bSmaller = false;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-				// any bit set will make the quire bigger than the value
-				if (q.anyAfter(i)) {
-					bSmaller = false;
-				}
-			}
-		}
+		bSmaller = q.CompareMagnitude(v) < 0;
 	}
 	return bSmaller;
 }
@@ -899,37 +745,10 @@ inline bool operator> (const quire<nbits, es, capacity>& q, const value<fbits>&
 		bBigger = true;
 	}
 	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale > vscale) {
-			bBigger = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed_point = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = quire<nbits, es, capacity>::radix_point + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (q[i] && !fixed_point[f]) {
-					bBigger = true;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-									   // any bit set will make the quire bigger
-				if (q.anyAfter(i)) {
-					bBigger = true;
-				}
-			}
-		}
+		bBigger = q.CompareMagnitude(v) > 0;
 	}
 	return bBigger;
 }
-
-
-
 // QUIRE OPERATORS
 
 // unrounded posit addition to be added to the quire
@@ -21,9 +21,9 @@
 #define POSIT_FAST_POSIT_8_1   1
 #define POSIT_FAST_POSIT_16_1  1
 #define POSIT_FAST_POSIT_32_2  1
-#define POSIT_FAST_POSIT_64_3  0
-#define POSIT_FAST_POSIT_128_4 0
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_64_3  1
+#define POSIT_FAST_POSIT_128_4 1
+#define POSIT_FAST_POSIT_256_5 1
 #endif
 
 // fast specializations for special posit configurations
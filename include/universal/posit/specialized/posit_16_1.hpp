@@ -89,138 +89,11 @@ namespace sw {
 			posit p;
 			return p.set_raw_bits((~_bits) + 1);
 		}
-		posit& operator+=(const posit& b) { // derived from SoftPosit
-			uint16_t lhs = _bits;
-			uint16_t rhs = b._bits;
-			// process special cases
-			if (isnar() || b.isnar()) {  // NaR
-				_bits = 0x8000;
-				return *this;
-			}
-			if (iszero() || b.iszero()) { // zero
-				_bits = lhs | rhs;
-				return *this;
-			}
-			bool sign = bool(_bits & sign_mask);
-			if (sign) {
-				lhs = -lhs & 0xFFFF;
-				rhs = -rhs & 0xFFFF;
-			}
-			if (lhs < rhs) std::swap(lhs, rhs);
-			
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint16_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-
-			// extract the exponent
-			uint16_t exp = remaining >> 14;
-
-			// extract remaining fraction bits
-			uint32_t lhs_fraction = (0x4000 | remaining) << 16;
-			int8_t shiftRight = m;
-
-			// adjust shift and extract fraction bits of rhs
-			extractAddand(rhs, shiftRight, remaining);
-			uint32_t rhs_fraction = (0x4000 | remaining) << 16;
-
-			//This is 2kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
-			shiftRight = (shiftRight << 1) + exp - (remaining >> 14);
-
-			if (shiftRight == 0) {
-				lhs_fraction += rhs_fraction;  // this will always product a carry
-				if (exp) ++m;
-				exp ^= 1;
-				lhs_fraction >>= 1;
-			}
-			else {
-				//Manage CLANG (LLVM) compiler when shifting right more than number of bits
-				(shiftRight>31) ? (rhs_fraction = 0) : (rhs_fraction >>= shiftRight); //frac32B >>= shiftRight
-				lhs_fraction += rhs_fraction;
-
-				bool rcarry = 0x80000000 & lhs_fraction; // first left bit
-				if (rcarry) {
-					if (exp) ++m;
-					exp ^= 1;
-					lhs_fraction >>= 1;
-				}
-			}
-
-			_bits = round(m, exp, lhs_fraction);
-			if (sign) _bits = -_bits & 0xFFFF;
-			return *this;
+		posit& operator+=(const posit& b) {
+			return (isneg() == b.isneg()) ? add_magnitudes(b) : subtract_magnitudes(b);
 		}
-		posit& operator-=(const posit& b) {  // derived from SoftPosit
-			uint16_t lhs = _bits;
-			uint16_t rhs = b._bits;
-			// process special cases
-			if (isnar() || b.isnar()) {
-				_bits = 0x8000;
-				return *this;
-			}
-			if (iszero() || b.iszero()) {
-				_bits = lhs | rhs;
-				return *this;
-			}
-			// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
-			bool sign = bool(lhs & sign_mask);
-			(sign) ? (lhs = (-lhs & 0xFFFF)) : (rhs = (-rhs & 0xFFFF));
-
-			if (lhs == rhs) {
-				_bits = 0x0;
-				return *this;
-			}
-			if (lhs < rhs) {
-				std::swap(lhs, rhs);
-				sign = !sign;
-			}
-
-			// decode the regime of lhs
-			int8_t m = 0; // pattern length
-			uint16_t remaining = 0;
-			decode_regime(lhs, m, remaining);
-
-			// extract the exponent
-			uint16_t exp = remaining >> 14;
-
-			uint32_t lhs_fraction = (0x4000 | remaining) << 16;
-			int8_t shiftRight = m;
-
-			// adjust shift and extract fraction bits of rhs
-			extractAddand(rhs, shiftRight, remaining);
-			uint32_t rhs_fraction = (0x4000 | remaining) << 16;
-
-			// align the fractions for subtraction
-			shiftRight = (shiftRight << 1) + exp - (remaining >> 14);
-			if (shiftRight != 0) {
-				if (shiftRight >= 29) {
-					_bits = lhs;
-					if (sign) _bits = -_bits & 0xFFFF;
-					return *this;
-				}
-				else {
-					rhs_fraction >>= shiftRight;
-				}
-			}
-			else {
-				rhs_fraction >>= shiftRight;
-			}
-			lhs_fraction -= rhs_fraction;
-
-			while ((lhs_fraction >> 29) == 0) {
-				--m;
-				lhs_fraction <<= 2;
-			}
-			bool ecarry = bool (0x40000000 & lhs_fraction);
-			if (!ecarry) {
-				if (exp == 0) --m;
-				exp ^= 1;
-				lhs_fraction <<= 1;
-			}
-
-			_bits = round(m, exp, lhs_fraction);
-			if (sign) _bits = -_bits & 0xFFFF;
-			return *this;
+		posit& operator-=(const posit& b) {
+			return *this += b.twosComplement();
 		}
 		posit& operator*=(const posit& b) {
 			uint16_t lhs = _bits;
@@ -380,6 +253,141 @@ namespace sw {
 		}
 
 	private:
+		// add two posits of the same sign: derived from SoftPosit
+		posit& add_magnitudes(const posit& b) {
+			uint16_t lhs = _bits;
+			uint16_t rhs = b._bits;
+			// process special cases
+			if (isnar() || b.isnar()) {  // NaR
+				_bits = 0x8000;
+				return *this;
+			}
+			if (iszero() || b.iszero()) { // zero
+				_bits = lhs | rhs;
+				return *this;
+			}
+			bool sign = bool(_bits & sign_mask);
+			if (sign) {
+				lhs = -lhs & 0xFFFF;
+				rhs = -rhs & 0xFFFF;
+			}
+			if (lhs < rhs) std::swap(lhs, rhs);
+			
+			// decode the regime of lhs
+			int8_t m = 0; // pattern length
+			uint16_t remaining = 0;
+			decode_regime(lhs, m, remaining);
+
+			// extract the exponent
+			uint16_t exp = remaining >> 14;
+
+			// extract remaining fraction bits
+			uint32_t lhs_fraction = (0x4000 | remaining) << 16;
+			int8_t shiftRight = m;
+
+			// adjust shift and extract fraction bits of rhs
+			extractAddand(rhs, shiftRight, remaining);
+			uint32_t rhs_fraction = (0x4000 | remaining) << 16;
+
+			//This is 2kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
+			shiftRight = (shiftRight << 1) + exp - (remaining >> 14);
+
+			if (shiftRight == 0) {
+				lhs_fraction += rhs_fraction;  // this will always product a carry
+				if (exp) ++m;
+				exp ^= 1;
+				lhs_fraction >>= 1;
+			}
+			else {
+				//Manage CLANG (LLVM) compiler when shifting right more than number of bits
+				(shiftRight>31) ? (rhs_fraction = 0) : (rhs_fraction >>= shiftRight); //frac32B >>= shiftRight
+				lhs_fraction += rhs_fraction;
+
+				bool rcarry = 0x80000000 & lhs_fraction; // first left bit
+				if (rcarry) {
+					if (exp) ++m;
+					exp ^= 1;
+					lhs_fraction >>= 1;
+				}
+			}
+
+			_bits = round(m, exp, lhs_fraction);
+			if (sign) _bits = -_bits & 0xFFFF;
+			return *this;
+		}
+		// add two posits of opposite sign: derived from SoftPosit
+		posit& subtract_magnitudes(const posit& b) {
+			uint16_t lhs = _bits;
+			uint16_t rhs = b._bits;
+			// process special cases
+			if (isnar() || b.isnar()) {
+				_bits = 0x8000;
+				return *this;
+			}
+			if (iszero() || b.iszero()) {
+				_bits = lhs | rhs;
+				return *this;
+			}
+			// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
+			bool sign = bool(lhs & sign_mask);
+			(sign) ? (lhs = (-lhs & 0xFFFF)) : (rhs = (-rhs & 0xFFFF));
+
+			if (lhs == rhs) {
+				_bits = 0x0;
+				return *this;
+			}
+			if (lhs < rhs) {
+				std::swap(lhs, rhs);
+				sign = !sign;
+			}
+
+			// decode the regime of lhs
+			int8_t m = 0; // pattern length
+			uint16_t remaining = 0;
+			decode_regime(lhs, m, remaining);
+
+			// extract the exponent
+			uint16_t exp = remaining >> 14;
+
+			uint32_t lhs_fraction = (0x4000 | remaining) << 16;
+			int8_t shiftRight = m;
+
+			// adjust shift and extract fraction bits of rhs
+			extractAddand(rhs, shiftRight, remaining);
+			uint32_t rhs_fraction = (0x4000 | remaining) << 16;
+
+			// align the fractions for subtraction
+			shiftRight = (shiftRight << 1) + exp - (remaining >> 14);
+			if (shiftRight != 0) {
+				if (shiftRight >= 29) {
+					_bits = lhs;
+					if (sign) _bits = -_bits & 0xFFFF;
+					return *this;
+				}
+				else {
+					rhs_fraction >>= shiftRight;
+				}
+			}
+			else {
+				rhs_fraction >>= shiftRight;
+			}
+			lhs_fraction -= rhs_fraction;
+
+			while ((lhs_fraction >> 29) == 0) {
+				--m;
+				lhs_fraction <<= 2;
+			}
+			bool ecarry = bool (0x40000000 & lhs_fraction);
+			if (!ecarry) {
+				if (exp == 0) --m;
+				exp ^= 1;
+				lhs_fraction <<= 1;
+			}
+
+			_bits = round(m, exp, lhs_fraction);
+			if (sign) _bits = -_bits & 0xFFFF;
+			return *this;
+		}
 		uint16_t _bits;
 
 		// Conversion functions
@@ -794,24 +802,11 @@ namespace sw {
 
 	inline posit<NBITS_IS_16, ES_IS_1> operator+(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		posit<NBITS_IS_16, ES_IS_1> result = lhs;
-		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-			result += rhs;
-		} 
-		else {
-			result -= rhs;
-		}
-		return result;
+		return result += rhs;
 	}
 	inline posit<NBITS_IS_16, ES_IS_1> operator-(const posit<NBITS_IS_16, ES_IS_1>& lhs, const posit<NBITS_IS_16, ES_IS_1>& rhs) {
 		posit<NBITS_IS_16, ES_IS_1> result = lhs;
-		if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-			result -= rhs.twosComplement();
-		}
-		else {
-			result += rhs.twosComplement();
-		}
-		return result;
-
+		return result -= rhs;
 	}
 	// binary operator*() is provided by generic class
 	// binary operator/() is provided by generic class
@@ -13,6 +13,8 @@ namespace unum {
 #pragma message("Fast specialization of posit<256,5>")
 
 // fast specialized posit<256,5>
+// The encoding is held in 4 64-bit limbs, least significant limb first, and the arithmetic is carried out
+// by the multi-limb engine: 256-bit significands built from 64x64->128-bit partial products.
 template<>
 class posit<NBITS_IS_256, ES_IS_5> {
 public:
@@ -23,74 +25,44 @@ public:
 	static constexpr size_t ebits = es;
 	static constexpr size_t fbits = nbits - 3 - es;
 	static constexpr size_t fhbits = fbits + 1;
-	static constexpr uint64_t sign_mask = 0x8000000000000000ull;  // 0x8000'0000'0000'0000ull;
+	static constexpr size_t nlimbs = nbits / 64;
+	static constexpr uint64_t sign_mask = 0x8000000000000000ull;  // sign bit in the most significant limb
 
-	posit() { _bits = 0; }
+	constexpr posit() : _bits{ 0 } {}
 	posit(const posit&) = default;
 	posit(posit&&) = default;
 	posit& operator=(const posit&) = default;
 	posit& operator=(posit&&) = default;
 
 	// initializers for native types
-	constexpr explicit posit(signed char initial_value)        { *this = initial_value; }
-	constexpr explicit posit(short initial_value)              { *this = initial_value; }
-	constexpr explicit posit(int initial_value)                { *this = initial_value; }
-	constexpr explicit posit(long initial_value)               { *this = initial_value; }
-	constexpr explicit posit(long long initial_value)          { *this = initial_value; }
-	constexpr explicit posit(char initial_value)               { *this = initial_value; }
-	constexpr explicit posit(unsigned short initial_value)     { *this = initial_value; }
-	constexpr explicit posit(unsigned int initial_value)       { *this = initial_value; }
-	constexpr explicit posit(unsigned long initial_value)      { *this = initial_value; }
-	constexpr explicit posit(unsigned long long initial_value) { *this = initial_value; }
-	constexpr explicit posit(float initial_value)              { *this = initial_value; }
-	constexpr explicit posit(double initial_value)             { *this = initial_value; }
-	constexpr          posit(long double initial_value)        { *this = initial_value; }
+	explicit posit(signed char initial_value) : _bits{ 0 }        { *this = initial_value; }
+	explicit posit(short initial_value) : _bits{ 0 }              { *this = initial_value; }
+	explicit posit(int initial_value) : _bits{ 0 }                { *this = initial_value; }
+	explicit posit(long initial_value) : _bits{ 0 }               { *this = initial_value; }
+	explicit posit(long long initial_value) : _bits{ 0 }          { *this = initial_value; }
+	explicit posit(char initial_value) : _bits{ 0 }               { *this = initial_value; }
+	explicit posit(unsigned short initial_value) : _bits{ 0 }     { *this = initial_value; }
+	explicit posit(unsigned int initial_value) : _bits{ 0 }       { *this = initial_value; }
+	explicit posit(unsigned long initial_value) : _bits{ 0 }      { *this = initial_value; }
+	explicit posit(unsigned long long initial_value) : _bits{ 0 } { *this = initial_value; }
+	explicit posit(float initial_value) : _bits{ 0 }              { *this = initial_value; }
+	explicit posit(double initial_value) : _bits{ 0 }             { *this = initial_value; }
+	         posit(long double initial_value) : _bits{ 0 }        { *this = initial_value; }
 
 	// assignment operators for native types
-	posit& operator=(signed char rhs)       { 
-		// special case for speed as this is a common initialization
-		if (rhs == 0) {
-			_bits = 0x00;
-			return *this;
-		}
-
-		bool sign = bool(rhs & 0x80);
-		int8_t v = sign ? -rhs : rhs; // project to positve side of the projective reals
-		uint8_t raw;
-		if (v > 48 || v == -128) { // +-maxpos, 0x80 is special in int8 arithmetic as it is its own negation
-			raw = 0x7F;
-		}
-		else {
-			uint8_t mask = 0x40;
-			int8_t k = 6;
-			uint8_t fraction_bits = v;
-			while (!(fraction_bits & mask)) {
-				k--;
-				fraction_bits <<= 1;
-			}
-			fraction_bits = (fraction_bits ^ mask);
-			raw = (0x7F ^ (0x3F >> k)) | (fraction_bits >> (k + 1));
-
-			mask = 0x1 << k; //bitNPlusOne
-			if (mask & fraction_bits) {
-				if (((mask - 1) & fraction_bits) | ((mask << 1) & fraction_bits)) raw++;
-			}
-		}
-		_bits = sign ? -raw : raw;
-		return *this;
-	}
-	posit& operator=(short rhs)             { return operator=((signed char)(rhs)); }
-	posit& operator=(int rhs)               { return operator=((signed char)(rhs)); }
-	posit& operator=(long rhs)              { return operator=((signed char)(rhs)); }
-	posit& operator=(long long rhs)         { return operator=((signed char)(rhs)); }
-	posit& operator=(char rhs)              { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned short rhs)    { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned int rhs)      { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned long rhs)     { return operator=((signed char)(rhs)); }
-	posit& operator=(unsigned long long rhs){ return operator=((signed char)(rhs)); }
-	posit& operator=(float rhs)             { return float_assign(rhs); }
-	posit& operator=(double rhs)            { return float_assign(rhs); }
-	constexpr posit& operator=(long double rhs)       { return float_assign(rhs); }
+	posit& operator=(signed char rhs)       { return integer_assign((long long)(rhs)); }
+	posit& operator=(short rhs)             { return integer_assign((long long)(rhs)); }
+	posit& operator=(int rhs)               { return integer_assign((long long)(rhs)); }
+	posit& operator=(long rhs)              { return integer_assign((long long)(rhs)); }
+	posit& operator=(long long rhs)         { return integer_assign(rhs); }
+	posit& operator=(char rhs)              { return integer_assign((long long)(rhs)); }
+	posit& operator=(unsigned short rhs)    { return unsigned_assign((unsigned long long)(rhs)); }
+	posit& operator=(unsigned int rhs)      { return unsigned_assign((unsigned long long)(rhs)); }
+	posit& operator=(unsigned long rhs)     { return unsigned_assign((unsigned long long)(rhs)); }
+	posit& operator=(unsigned long long rhs){ return unsigned_assign(rhs); }
+	posit& operator=(float rhs)             { return float_assign((long double)rhs); }
+	posit& operator=(double rhs)            { return float_assign((long double)rhs); }
+	posit& operator=(long double rhs)       { return float_assign(rhs); }
 
 	explicit operator long double() const { return to_long_double(); }
 	explicit operator double() const { return to_double(); }
@@ -102,12 +74,20 @@ public:
 	explicit operator unsigned long() const { return to_long(); }
 	explicit operator unsigned int() const { return to_int(); }
 
-	posit& set(sw::unum::bitblock<NBITS_IS_256>& raw) {
-		_bits = uint8_t(raw.to_ulong());
+	posit& set(const sw::unum::bitblock<NBITS_IS_256>& raw) {
+		for (size_t i = 0; i < nlimbs; ++i) {
+			uint64_t limb = 0;
+			for (size_t j = 0; j < 64; ++j) {
+				if (raw[64 * i + j]) limb |= (1ull << j);
+			}
+			_bits[i] = limb;
+		}
 		return *this;
 	}
+	// set the least significant limb and clear the others
 	posit& set_raw_bits(uint64_t value) {
-		_bits = uint8_t(value & 0xff);
+		clear();
+		_bits[0] = value;
 		return *this;
 	}
 	posit operator-() const {
@@ -117,198 +97,118 @@ public:
 		if (isnar()) {
 			return *this;
 		}
-		posit p;
-		return p.set_raw_bits((~_bits) + 1);
-	}
-	posit& operator+=(const posit& b) { // derived from SoftPosit
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
-		if (isnar() || b.isnar()) {  // infinity
-			_bits = 0x80;
-			return *this;
+		return twosComplement();
+	}
+	posit& operator+=(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (isnar() || b.isnar()) {
+			throw operand_is_nar{};
 		}
-		if (iszero() || b.iszero()) { // zero
-			_bits = lhs | rhs;
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
-		bool sign = bool(_bits & 0x80);
-		if (sign) {
-			lhs = -lhs & 0xFF;
-			rhs = -rhs & 0xFF;
-		}
-		if (lhs < rhs) std::swap(lhs, rhs);
-			
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t frac16A = (0x80 | remaining) << 7;
-		int8_t shiftRight = m;
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint16_t frac16B = (0x80 | remaining) << 7;
-
-		// Work-around CLANG (LLVM) compiler when shifting right more than number of bits
-		(shiftRight>7) ? (frac16B = 0) : (frac16B >>= shiftRight); 
-
-		frac16A += frac16B;
-
-		bool rcarry = bool(0x8000 & frac16A); // is MSB set
-		if (rcarry) {
-			m++;
-			frac16A >>= 1;
+#endif
+		if (b.iszero()) return *this;
+		if (iszero()) {
+			*this = b;
+			return *this;
 		}
-
-		_bits = round(m, frac16A);
-		if (sign) _bits = -_bits & 0xFF;
+		uint64_t sum[nlimbs];
+		limb_add<NBITS_IS_256, ES_IS_5>(_bits, b._bits, sum);
+		assign_limbs(sum);
 		return *this;
 	}
-	posit& operator-=(const posit& b) {  // derived from SoftPosit
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+	posit& operator+=(double rhs) {
+		return *this += posit<nbits, es>(rhs);
+	}
+	posit& operator-=(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || b.isnar()) {
-			_bits = 0x80;
-			return *this;
+			throw operand_is_nar{};
 		}
-		if (iszero() || b.iszero()) {
-			_bits = lhs | rhs;
-			return *this;
-		}
-		// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
-		bool sign = bool(lhs & 0x80);
-		(sign) ? (lhs = (-lhs & 0xFF)) : (rhs = (-rhs & 0xFF));
-
-		if (lhs == rhs) {
-			_bits = 0x00;
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
-		if (lhs < rhs) {
-			std::swap(lhs, rhs);
-			sign = !sign;
-		}
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t frac16A = (0x80 | remaining) << 7;
-		int8_t shiftRight = m;
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint16_t frac16B = (0x80 | remaining) << 7;
-
-		// do the subtraction of the fractions
-		if (shiftRight >= 14) {
-			_bits = lhs;
-			if (sign) _bits = -_bits & 0xFFFF;
+#endif
+		if (b.iszero()) return *this;
+		if (iszero()) {
+			*this = b.twosComplement();
 			return *this;
 		}
-		else {
-			frac16B >>= shiftRight;
-		}
-		frac16A -= frac16B;
-
-		while ((frac16A >> 14) == 0) {
-			m--;
-			frac16A <<= 1;
-		}
-		bool ecarry = bool (0x4000 & frac16A);
-		if (!ecarry) {
-			m--;
-			frac16A <<= 1;
-		}
-
-		_bits = round(m, frac16A);
-		if (sign) _bits = -_bits & 0xFF;
+		uint64_t difference[nlimbs];
+		limb_sub<NBITS_IS_256, ES_IS_5>(_bits, b._bits, difference);
+		assign_limbs(difference);
 		return *this;
 	}
+	posit& operator-=(double rhs) {
+		return *this -= posit<nbits, es>(rhs);
+	}
 	posit& operator*=(const posit& b) {
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (isnar() || b.isnar()) {
-			_bits = 0x80;
+			throw operand_is_nar{};
+		}
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
 			return *this;
 		}
+#endif
 		if (iszero() || b.iszero()) {
-			_bits = 0x00;
+			setzero();
 			return *this;
 		}
-
-		// calculate the sign of the result
-		bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-		lhs = lhs & 0x80 ? -lhs : lhs;
-		rhs = rhs & 0x80 ? -rhs : rhs;
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint8_t lhs_fraction = (0x80 | remaining);
-		// adjust shift and extract fraction bits of rhs
-		extractMultiplicand(rhs, m, remaining);
-		uint8_t rhs_fraction = (0x80 | remaining);
-		uint16_t result_fraction = uint16_t(lhs_fraction) * uint16_t(rhs_fraction);
-
-		bool rcarry = bool(result_fraction & 0x8000);
-		if (rcarry) {
-			m++;
-			result_fraction >>= 1;
-		}
-
-		// round
-		_bits = round(m, result_fraction);
-		if (sign) _bits = -_bits & 0xFF;
+		// the product of the significands is computed in 512 bits
+		uint64_t product[nlimbs];
+		limb_mul<NBITS_IS_256, ES_IS_5>(_bits, b._bits, product);
+		assign_limbs(product);
 		return *this;
 	}
+	posit& operator*=(double rhs) {
+		return *this *= posit<nbits, es>(rhs);
+	}
 	posit& operator/=(const posit& b) {
-		uint8_t lhs = _bits;
-		uint8_t rhs = b._bits;
-		// process special cases
+		// since we are encoding error conditions as NaR (Not a Real), we need to process that condition first
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (b.iszero()) {
+			throw divide_by_zero{};    // not throwing is a quiet signalling NaR
+		}
+		if (b.isnar()) {
+			throw divide_by_nar{};
+		}
+		if (isnar()) {
+			throw numerator_is_nar{};
+		}
+#else
 		if (isnar() || b.isnar() || b.iszero()) {
-			_bits = 0x80;
+			setnar();
 			return *this;
 		}
+#endif // POSIT_THROW_ARITHMETIC_EXCEPTION
 		if (iszero()) {
-			_bits = 0x00;
+			setzero();
 			return *this;
 		}
-
-		// calculate the sign of the result
-		bool sign = bool(lhs & 0x80) ^ bool(rhs & 0x80);
-		lhs = (lhs & 0x80) ? -lhs : lhs;
-		rhs = (rhs & 0x80) ? -rhs : rhs;
-
-		// decode the regime of lhs
-		int8_t m = 0; // pattern length
-		uint8_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-		uint16_t lhs_fraction = (0x80 | remaining) << 7;
-		// adjust shift and extract fraction bits of rhs
-		extractDividand(rhs, m, remaining);
-		uint8_t rhs_fraction = (0x80 | remaining);
-		div_t result = div(lhs_fraction, uint16_t(rhs_fraction));
-		uint16_t result_fraction = result.quot;
-		uint16_t remainder = result.rem;
-
-		if (result_fraction != 0) {
-			bool rcarry = result_fraction >> 7; // this is the hidden bit (7th bit) , extreme right bit is bit 0
-			if (!rcarry) {
-				--m;
-				result_fraction <<= 1;
-			}
-		}
-
-		// round
-		_bits = adjustAndRound(m, result_fraction, remainder != 0);
-		if (sign) _bits = -_bits & 0xFF;
-
+		// the 512-bit by 256-bit long division yields the quotient significand and a remainder for the sticky bit
+		uint64_t quotient[nlimbs];
+		limb_div<NBITS_IS_256, ES_IS_5>(_bits, b._bits, quotient);
+		assign_limbs(quotient);
 		return *this;
 	}
+	posit& operator/=(double rhs) {
+		return *this /= posit<nbits, es>(rhs);
+	}
+
+	// prefix/postfix operators
 	posit& operator++() {
-		++_bits;
+		limbs_increment(_bits);
 		return *this;
 	}
 	posit operator++(int) {
@@ -317,7 +217,7 @@ public:
 		return tmp;
 	}
 	posit& operator--() {
-		--_bits;
+		limbs_decrement(_bits);
 		return *this;
 	}
 	posit operator--(int) {
@@ -326,270 +226,166 @@ public:
 		return tmp;
 	}
 	posit reciprocate() const {
-		posit p = 1.0 / *this;
+		posit p;
+		if (isnar() || iszero()) {
+			p.setnar();
+			return p;
+		}
+		posit one;
+		one._bits[nlimbs - 1] = 0x4000000000000000ull;
+		limb_div<NBITS_IS_256, ES_IS_5>(one._bits, _bits, p._bits);
 		return p;
 	}
 	// SELECTORS
-	inline bool isnar() const      { return (_bits == 0x80); }
-	inline bool iszero() const     { return (_bits == 0x00); }
-	inline bool isone() const      { return (_bits == 0x40); } // pattern 010000...
-	inline bool isminusone() const { return (_bits == 0xC0); } // pattern 110000...
-	inline bool isneg() const      { return (_bits & 0x80); }
-	inline bool ispos() const      { return !isneg(); }
-	inline bool ispowerof2() const { return !(_bits & 0x1); }
-
-	inline int sign_value() const  { return (_bits & 0x8 ? -1 : 1); }
-
-	bitblock<NBITS_IS_256> get() const { bitblock<NBITS_IS_256> bb; bb = int(_bits); return bb; }
-	unsigned long long encoding() const { return (unsigned long long)(_bits); }
+	inline bool isnar() const      { return (_bits[nlimbs - 1] == sign_mask) && lower_limbs_are_zero(); }
+	inline bool iszero() const     { return (_bits[nlimbs - 1] == 0) && lower_limbs_are_zero(); }
+	inline bool isone() const      { return (_bits[nlimbs - 1] == 0x4000000000000000ull) && lower_limbs_are_zero(); } // pattern 010000...
+	inline bool isminusone() const { return (_bits[nlimbs - 1] == 0xC000000000000000ull) && lower_limbs_are_zero(); } // pattern 110000...
+	inline constexpr bool isneg() const      { return (_bits[nlimbs - 1] & sign_mask); }
+	inline constexpr bool ispos() const      { return !isneg(); }
+	inline constexpr bool ispowerof2() const { return !(_bits[0] & 0x1); }
+
+	inline int sign_value() const  { return (_bits[nlimbs - 1] & sign_mask) ? -1 : 1; }
+
+	bitblock<NBITS_IS_256> get() const {
+		bitblock<NBITS_IS_256> bb;
+		for (size_t i = 0; i < nbits; ++i) {
+			bb[i] = bool((_bits[i / 64] >> (i % 64)) & 1);
+		}
+		return bb;
+	}
+	// the least significant limb of the encoding
+	unsigned long long encoding() const { return (unsigned long long)(_bits[0]); }
+	// limb access for the multi-limb math functions
+	uint64_t limb(size_t i) const { return _bits[i]; }
+	posit& setlimb(size_t i, uint64_t value) {
+		_bits[i] = value;
+		return *this;
+	}
 
-	inline void clear() { _bits = 0; }
+	inline void clear() { for (size_t i = 0; i < nlimbs; ++i) _bits[i] = 0; }
 	inline void setzero() { clear(); }
-	inline void setnar() { _bits = 0x80; }
+	inline void setnar() { clear(); _bits[nlimbs - 1] = sign_mask; }
 	inline posit twosComplement() const {
-		posit<NBITS_IS_256, ES_IS_5> p;
-		int8_t v = -*(int8_t*)&_bits;
-		p.set_raw_bits(v);
+		posit<NBITS_IS_256, ES_IS_5> p(*this);
+		limb_negate<NBITS_IS_256>(p._bits);
 		return p;
 	}
+
 private:
-	uint8_t _bits;
+	uint64_t _bits[4];
+
+	inline bool lower_limbs_are_zero() const {
+		uint64_t any = 0;
+		for (size_t i = 0; i < nlimbs - 1; ++i) any |= _bits[i];
+		return any == 0;
+	}
+	inline void assign_limbs(const uint64_t (&limbs)[4]) {
+		for (size_t i = 0; i < nlimbs; ++i) _bits[i] = limbs[i];
+	}
 
 	// Conversion functions
 #if POSIT_THROW_ARITHMETIC_EXCEPTION
 	int         to_int() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return int(to_float());
+		return int(to_double());
 	}
 	long        to_long() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return long(to_double());
+		return long(to_long_double());
 	}
 	long long   to_long_long() const {
 		if (iszero()) return 0;
 		if (isnar()) throw not_a_real{};
-		return long(to_long_double());
+		return (long long)(to_long_double());
 	}
 #else
 	int         to_int() const {
 		if (iszero()) return 0;
 		if (isnar())  return int(INFINITY);
-		return int(to_float());
+		return int(to_double());
 	}
 	long        to_long() const {
 		if (iszero()) return 0;
 		if (isnar())  return long(INFINITY);
-		return long(to_double());
+		return long(to_long_double());
 	}
 	long long   to_long_long() const {
 		if (iszero()) return 0;
 		if (isnar())  return (long long)(INFINITY);
-		return long(to_long_double());
+		return (long long)(to_long_double());
 	}
 #endif
 	float       to_float() const {
 		return (float)to_double();
 	}
 	double      to_double() const {
-		if (iszero())	return 0.0;
-		if (isnar())	return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		bitblock<nbits>		 _raw_bits;
-		_raw_bits.reset();
-		uint64_t mask = 1;
-		for (size_t i = 0; i < nbits; i++) {
-			_raw_bits.set(i, (_bits & mask));
-			mask <<= 1;
-		}
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		double s = (_sign ? -1.0 : 1.0);
-		double r = _regime.value();
-		double e = _exponent.value();
-		double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		return (double)to_long_double();
 	}
 	long double to_long_double() const {
 		if (iszero())  return 0.0;
 		if (isnar())   return NAN;
-		bool		     	 _sign;
-		regime<nbits, es>    _regime;
-		exponent<nbits, es>  _exponent;
-		fraction<fbits>      _fraction;
-		bitblock<nbits>		 _raw_bits;
-		_raw_bits.reset();
-		uint64_t mask = 1;
-		for (size_t i = 0; i < nbits; i++) {
-			_raw_bits.set(i, (_bits & mask));
-			mask <<= 1;
+		bool sign;
+		int scale;
+		uint64_t significand[nlimbs];
+		limb_decode<NBITS_IS_256, ES_IS_5>(_bits, sign, scale, significand);
+		// the top two limbs of the significand cover the precision of any long double
+		long double v = std::ldexp((long double)significand[nlimbs - 1], scale - 63)
+		              + std::ldexp((long double)significand[nlimbs - 2], scale - 127);
+		return sign ? -v : v;
+	}
+
+	// helper methods
+	posit& unsigned_assign(unsigned long long rhs) {
+		if (rhs == 0) {
+			clear();
+			return *this;
 		}
-		decode(_raw_bits, _sign, _regime, _exponent, _fraction);
-		long double s = (_sign ? -1.0 : 1.0);
-		long double r = _regime.value();
-		long double e = _exponent.value();
-		long double f = (1.0 + _fraction.value());
-		return s * r * e * f;
+		int lz = countLeadingZeros(rhs);
+		uint64_t significand[nlimbs] = { 0 };
+		significand[nlimbs - 1] = uint64_t(rhs) << lz;
+		limb_encode<NBITS_IS_256, ES_IS_5>(false, 63 - lz, significand, false, _bits);
+		return *this;
 	}
-
-	template <typename T>
-	posit& float_assign(const T& rhs) {
-		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
-		value<dfbits> v((T)rhs);
-
+	posit& integer_assign(long long rhs) {
+		if (rhs == 0) {
+			clear();
+			return *this;
+		}
+		bool sign = rhs < 0;
+		uint64_t v = sign ? (~uint64_t(rhs) + 1) : uint64_t(rhs); // project to positive side of the projective reals
+		int lz = countLeadingZeros(v);
+		uint64_t significand[nlimbs] = { 0 };
+		significand[nlimbs - 1] = v << lz;
+		limb_encode<NBITS_IS_256, ES_IS_5>(sign, 63 - lz, significand, false, _bits);
+		return *this;
+	}
+	posit& float_assign(long double rhs) {
 		// special case processing
-		if (v.iszero()) {
+		if (rhs == 0.0l) {
 			setzero();
 			return *this;
 		}
-		if (v.isinf() || v.isnan()) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
+		if (std::isinf(rhs) || std::isnan(rhs)) {  // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
 			setnar();
 			return *this;
 		}
-
-		bitblock<NBITS_IS_256> ptt;
-		convert_to_bb<NBITS_IS_256, ES_IS_5, dfbits>(v.sign(), v.scale(), v.fraction(), ptt); // TODO: needs to be faster
-		_bits = uint8_t(ptt.to_ulong());
+		bool sign = std::signbit(rhs);
+		int exp;
+		long double mantissa = std::frexp(sign ? -rhs : rhs, &exp);  // mantissa in [0.5, 1)
+		// scale the mantissa into the top two limbs of the significand with the hidden bit at the most significant bit
+		uint64_t significand[nlimbs] = { 0 };
+		long double scaled = std::ldexp(mantissa, 64);
+		significand[nlimbs - 1] = uint64_t(scaled);
+		scaled = std::ldexp(scaled - (long double)significand[nlimbs - 1], 64);
+		significand[nlimbs - 2] = uint64_t(scaled);
+		bool sticky = (scaled - (long double)significand[nlimbs - 2]) != 0.0l;
+		limb_encode<NBITS_IS_256, ES_IS_5>(sign, exp - 1, significand, sticky, _bits);
 		return *this;
 	}
 
-	// helper method
-	// decode_regime takes the raw bits of the posit, and returns the regime run-length, m, and the remaining fraction bits in remainder
-	inline void decode_regime(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			m = -1;
-			while (!(remaining >> 7)) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractAddand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			++m;
-			while (!(remaining >> 7)) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractMultiplicand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			--m;
-			while (!(remaining >> 7)) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline void extractDividand(const uint8_t bits, int8_t& m, uint8_t& remaining) const {
-		remaining = (bits << 2) & 0xFF;
-		if (bits & 0x40) {  // positive regimes
-			while (remaining >> 7) {
-				--m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-		}
-		else {              // negative regimes
-			++m;
-			while (!(remaining >> 7)) {
-				++m;
-				remaining = (remaining << 1) & 0xFF;
-			}
-			remaining &= 0x7F;
-		}
-	}
-	inline uint8_t round(const int8_t m, uint16_t fraction) const {
-		uint8_t scale, regime, bits;
-		if (m < 0) {
-			scale = (-m & 0xFF);
-			regime = 0x40 >> scale;
-		}
-		else {
-			scale = m + 1;
-			regime = 0x7F - (0x7F >> scale);
-		}
-
-		if (scale > 6) {
-			bits = m<0 ? 0x1 : 0x7F;  // minpos and maxpos
-		}
-		else {
-			fraction = (fraction & 0x3FFF) >> scale;
-			uint8_t final_fbits = uint8_t(fraction >> 8);
-			bool bitNPlusOne = bool(0x80 & fraction);
-			bits = uint8_t(regime) + uint8_t(final_fbits);
-			// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-			if (bitNPlusOne) {
-				uint8_t moreBits = (0x7F & fraction) ? 0x01 : 0x00;
-				bits += (bits & 0x01) | moreBits;
-			}
-		}
-		return bits;
-	}
-	inline uint8_t adjustAndRound(const int8_t k, uint16_t fraction, bool nonZeroRemainder) const {
-		uint8_t scale, regime, bits;
-		if (k < 0) {
-			scale = (-k & 0xFF);
-			regime = 0x40 >> scale;
-		}
-		else {
-			scale = k + 1;
-			regime = 0x7F - (0x7F >> scale);
-		}
-
-		if (scale > 6) {
-			bits = k<0 ? 0x1 : 0x7F;  // minpos and maxpos
-		}
-		else {
-			//remove carry and rcarry bits and shift to correct position
-			fraction &= 0x7F;
-			uint8_t final_fbits = (uint_fast16_t)fraction >> (scale + 1);
-			bool bitNPlusOne = (0x1 & (fraction >> scale));
-			bits = uint8_t(regime) + uint8_t(final_fbits);
-#ifdef NOW
-			std::cout << std::hex;
-			std::cout << "fraction raw   = " << int(fraction) << std::endl;
-			std::cout << "fraction final = " << int(final_fbits) << std::endl;
-			std::cout << "posit bits     = " << int(bits) << std::endl;
-			std::cout << std::dec;
-#endif
-			if (bitNPlusOne) {
-				uint8_t moreBits = (((1 << scale) - 1) & fraction) ? 0x01 : 0x00;
-				if (nonZeroRemainder) moreBits = 0x01;
-				//std::cout << "bitsMore = " << (moreBits ? "true" : "false") << std::endl;
-				// n+1 frac bit is 1. Need to check if another bit is 1 too if not round to even
-				bits += (bits & 0x01) | moreBits;
-			}
-		}
-		return bits;
-	}
 	// I/O operators
 	friend std::ostream& operator<< (std::ostream& ostr, const posit<NBITS_IS_256, ES_IS_5>& p);
 	friend std::istream& operator>> (std::istream& istr, posit<NBITS_IS_256, ES_IS_5>& p);
@@ -601,7 +397,6 @@ private:
 	friend bool operator> (const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs);
 	friend bool operator<=(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs);
 	friend bool operator>=(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs);
-
 };
 
 // posit I/O operators
@@ -634,24 +429,27 @@ inline std::istream& operator>> (std::istream& istr, posit<NBITS_IS_256, ES_IS_5
 }
 
 // convert a posit value to a string using "nar" as designation of NaR
-std::string to_string(const posit<NBITS_IS_256, ES_IS_5>& p, std::streamsize precision) {
+inline std::string to_string(const posit<NBITS_IS_256, ES_IS_5>& p, std::streamsize precision) {
 	if (p.isnar()) {
 		return std::string("nar");
 	}
 	std::stringstream ss;
-	ss << std::setprecision(precision) << float(p);
+	ss << std::setprecision(precision) << (long double)p;
 	return ss.str();
 }
 
 // posit - posit binary logic operators
 inline bool operator==(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
-	return lhs._bits == rhs._bits;
+	return limbs_compare(lhs._bits, rhs._bits) == 0;
 }
 inline bool operator!=(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 	return !operator==(lhs, rhs);
 }
 inline bool operator< (const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
-	return *(signed char*)(&lhs._bits) < *(signed char*)(&rhs._bits);
+	// two's complement order: signed comparison of the most significant limb, unsigned comparison of the rest
+	constexpr size_t top = posit<NBITS_IS_256, ES_IS_5>::nlimbs - 1;
+	if (lhs._bits[top] != rhs._bits[top]) return int64_t(lhs._bits[top]) < int64_t(rhs._bits[top]);
+	return limbs_compare(lhs._bits, rhs._bits) < 0;
 }
 inline bool operator> (const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 	return operator< (rhs, lhs);
@@ -665,26 +463,14 @@ inline bool operator>=(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBIT
 
 inline posit<NBITS_IS_256, ES_IS_5> operator+(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 	posit<NBITS_IS_256, ES_IS_5> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result += rhs;
-	} 
-	else {
-		result -= rhs;
-	}
-	return result;
+	return result += rhs;
 }
 inline posit<NBITS_IS_256, ES_IS_5> operator-(const posit<NBITS_IS_256, ES_IS_5>& lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 	posit<NBITS_IS_256, ES_IS_5> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result -= rhs.twosComplement();
-	}
-	else {
-		result += rhs.twosComplement();
-	}
-	return result;
-
+	return result -= rhs;
 }
 // binary operator*() is provided by generic class
+// binary operator/() is provided by generic class
 
 #if POSIT_ENABLE_LITERALS
 // posit - literal logic functions
@@ -732,9 +518,10 @@ inline bool operator>=(int lhs, const posit<NBITS_IS_256, ES_IS_5>& rhs) {
 #endif // POSIT_ENABLE_LITERALS
 
 #else  // POSIT_FAST_POSIT_256_5
-// too verbose #pragma message("Standard posit<256,5>")
+// too verbose during compilation, so disabled
+// #pragma message("Standard posit<256,5>")
 #	define POSIT_FAST_POSIT_256_5 0
 #endif // POSIT_FAST_POSIT_256_5
 
-}
-}
+} // namespace unum
+} // namespace sw
@@ -89,153 +89,14 @@ public:
 		posit p;
 		return p.set_raw_bits((~_bits) + 1);
 	}
-	posit& operator+=(const posit& b) { // derived from SoftPosit
-		// special case handling of the inputs
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-		if (isnar() || b.isnar()) {
-			throw operand_is_nar{};
-		}
-#else
-		if (isnar() || b.isnar()) {
-			setnar();
-			return *this;
-		}
-#endif
-		uint32_t lhs = _bits;
-		uint32_t rhs = b._bits;
-		if (iszero() || b.iszero()) { // zero
-			_bits = lhs | rhs;
-			return *this;
-		}
-		bool sign = bool(_bits & sign_mask);
-		if (sign) {
-			lhs = -int32_t(lhs) & 0xFFFFFFFF;
-			rhs = -int32_t(rhs) & 0xFFFFFFFF;
-		}
-		if (lhs < rhs) std::swap(lhs, rhs);
-			
-		// decode the regime of lhs
-		int32_t m = 0; // pattern length
-		uint32_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-
-		// extract the exponent
-		uint32_t exp = remaining >> 29;
-
-		// extract the remaining fraction
-		uint64_t frac64A = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;  // ((0x4000'0000ull | remaining << 1) & 0x7FFF'FFFFull) << 32;
-		int32_t shiftRight = m;
-
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint64_t frac64B = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32; // ((0x4000'0000ull | remaining << 1) & 0x7FFF'FFFFull) << 32;
-		// This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
-		shiftRight = (shiftRight << 2) + exp - (remaining >> 29);
-
-		// Work-around CLANG (LLVM) compiler when shifting right more than number of bits
-		frac64B = (shiftRight > 63) ? 0 : (frac64B >> shiftRight); 
-
-		frac64A += frac64B; // add the now aligned fractions
-
-		bool rcarry = bool(0x8000000000000000 & frac64A); // is MSB set   bool(0x8000'0000'0000'0000 & frac64A); 
-		if (rcarry) {
-			++exp;
-			if (exp > 3) {
-				++m;
-				exp &= 0x3;
-			}
-			frac64A >>= 1;
-		}
-
-		_bits = round(m, exp, frac64A);
-		if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
-		return *this;
+	posit& operator+=(const posit& b) {
+		return (isneg() == b.isneg()) ? add_magnitudes(b) : subtract_magnitudes(b);
 	}
 	posit& operator+=(double rhs) {
 		return *this += posit<nbits, es>(rhs);
 	}
-	posit& operator-=(const posit& b) {  // derived from SoftPosit
-		// special case handling of the inputs
-#if POSIT_THROW_ARITHMETIC_EXCEPTION
-		if (isnar() || b.isnar()) {
-			throw operand_is_nar{};
-		}
-#else
-		if (isnar() || b.isnar()) {
-			setnar();
-			return *this;
-		}
-#endif
-		uint32_t lhs = _bits;
-		uint32_t rhs = b._bits;
-		if (iszero() || b.iszero()) {
-			_bits = lhs | rhs;
-			return *this;
-		}
-		// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
-		bool sign = bool(lhs & sign_mask);
-		(sign) ? (lhs = (-int32_t(lhs) & 0xFFFFFFFF)) : (rhs = (-int32_t(rhs) & 0xFFFFFFFF));
-
-		if (lhs == rhs) {
-			_bits = 0;
-			return *this;
-		}
-		if (lhs < rhs) {
-			std::swap(lhs, rhs);
-			sign = !sign;
-		}
-
-		// decode the regime of lhs
-		int32_t m = 0; // pattern length
-		uint32_t remaining = 0;
-		decode_regime(lhs, m, remaining);
-
-		// extract the exponent
-		uint32_t exp = remaining >> 29;
-
-		// extract the remaining fraction
-		uint64_t frac64A = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;
-		int32_t shiftRight = m;
-
-		// adjust shift and extract fraction bits of rhs
-		extractAddand(rhs, shiftRight, remaining);
-		uint64_t frac64B = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;
-
-		// This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
-		shiftRight = (shiftRight << 2) + exp - (remaining >> 29);
-		if (shiftRight > 63) {  // catastrophic cancellation case
-			_bits = lhs;
-			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
-			return *this;
-		}
-		else {
-			frac64B >>= shiftRight;  // adjust the rhs fraction
-		}
-		frac64A -= frac64B;			// subtract the aligned fractions
-
-		// adjust the results
-		while ((frac64A >> 59) == 0) {
-			--m;
-			frac64A <<= 4;
-		}
-		bool ecarry = bool (0x4000000000000000 & frac64A);
-		//bool ecarry = bool(0x4000'0000'0000'0000 & frac64A);
-		while (!ecarry) {
-			if (exp == 0) {
-				--m;
-				exp = 0x3;
-			}
-			else {
-				exp--;
-			}
-			frac64A <<= 1;
-			ecarry = bool(0x4000000000000000 & frac64A);
-			//ecarry = bool(0x4000'0000'0000'0000 & frac64A);
-		}
-
-		_bits = round(m, exp, frac64A);
-		if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
-		return *this;
+	posit& operator-=(const posit& b) {
+		return *this += b.twosComplement();
 	}
 	posit& operator-=(double rhs) {
 		return *this -= posit<nbits, es>(rhs);
@@ -425,12 +286,158 @@ public:
 	inline constexpr void setnar() { _bits = 0x80000000; }
 	inline posit twosComplement() const {
 		posit<NBITS_IS_32, ES_IS_2> p;
-		int32_t v = -(int32_t)_bits;
-		p.set_raw_bits(v);
+		p.set_raw_bits((~_bits) + 1);   // unsigned negation: NaR maps to itself without signed overflow
 		return p;
 	}
 
 private:
+	// add two posits of the same sign: derived from SoftPosit
+	posit& add_magnitudes(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (isnar() || b.isnar()) {
+			throw operand_is_nar{};
+		}
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
+			return *this;
+		}
+#endif
+		uint32_t lhs = _bits;
+		uint32_t rhs = b._bits;
+		if (iszero() || b.iszero()) { // zero
+			_bits = lhs | rhs;
+			return *this;
+		}
+		bool sign = bool(_bits & sign_mask);
+		if (sign) {
+			lhs = -int32_t(lhs) & 0xFFFFFFFF;
+			rhs = -int32_t(rhs) & 0xFFFFFFFF;
+		}
+		if (lhs < rhs) std::swap(lhs, rhs);
+			
+		// decode the regime of lhs
+		int32_t m = 0; // pattern length
+		uint32_t remaining = 0;
+		decode_regime(lhs, m, remaining);
+
+		// extract the exponent
+		uint32_t exp = remaining >> 29;
+
+		// extract the remaining fraction
+		uint64_t frac64A = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;  // ((0x4000'0000ull | remaining << 1) & 0x7FFF'FFFFull) << 32;
+		int32_t shiftRight = m;
+
+		// adjust shift and extract fraction bits of rhs
+		extractAddand(rhs, shiftRight, remaining);
+		uint64_t frac64B = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32; // ((0x4000'0000ull | remaining << 1) & 0x7FFF'FFFFull) << 32;
+		// This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
+		shiftRight = (shiftRight << 2) + exp - (remaining >> 29);
+
+		// Work-around CLANG (LLVM) compiler when shifting right more than number of bits
+		frac64B = (shiftRight > 63) ? 0 : (frac64B >> shiftRight); 
+
+		frac64A += frac64B; // add the now aligned fractions
+
+		bool rcarry = bool(0x8000000000000000 & frac64A); // is MSB set   bool(0x8000'0000'0000'0000 & frac64A); 
+		if (rcarry) {
+			++exp;
+			if (exp > 3) {
+				++m;
+				exp &= 0x3;
+			}
+			frac64A >>= 1;
+		}
+
+		_bits = round(m, exp, frac64A);
+		if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
+		return *this;
+	}
+	// add two posits of opposite sign: derived from SoftPosit
+	posit& subtract_magnitudes(const posit& b) {
+		// special case handling of the inputs
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+		if (isnar() || b.isnar()) {
+			throw operand_is_nar{};
+		}
+#else
+		if (isnar() || b.isnar()) {
+			setnar();
+			return *this;
+		}
+#endif
+		uint32_t lhs = _bits;
+		uint32_t rhs = b._bits;
+		if (iszero() || b.iszero()) {
+			_bits = lhs | rhs;
+			return *this;
+		}
+		// Both operands are actually the same sign if rhs inherits sign of sub: Make both positive
+		bool sign = bool(lhs & sign_mask);
+		(sign) ? (lhs = (-int32_t(lhs) & 0xFFFFFFFF)) : (rhs = (-int32_t(rhs) & 0xFFFFFFFF));
+
+		if (lhs == rhs) {
+			_bits = 0;
+			return *this;
+		}
+		if (lhs < rhs) {
+			std::swap(lhs, rhs);
+			sign = !sign;
+		}
+
+		// decode the regime of lhs
+		int32_t m = 0; // pattern length
+		uint32_t remaining = 0;
+		decode_regime(lhs, m, remaining);
+
+		// extract the exponent
+		uint32_t exp = remaining >> 29;
+
+		// extract the remaining fraction
+		uint64_t frac64A = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;
+		int32_t shiftRight = m;
+
+		// adjust shift and extract fraction bits of rhs
+		extractAddand(rhs, shiftRight, remaining);
+		uint64_t frac64B = ((0x40000000ull | remaining << 1) & 0x7FFFFFFFull) << 32;
+
+		// This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
+		shiftRight = (shiftRight << 2) + exp - (remaining >> 29);
+		if (shiftRight > 63) {  // catastrophic cancellation case
+			_bits = lhs;
+			if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
+			return *this;
+		}
+		else {
+			frac64B >>= shiftRight;  // adjust the rhs fraction
+		}
+		frac64A -= frac64B;			// subtract the aligned fractions
+
+		// adjust the results
+		while ((frac64A >> 59) == 0) {
+			--m;
+			frac64A <<= 4;
+		}
+		bool ecarry = bool (0x4000000000000000 & frac64A);
+		//bool ecarry = bool(0x4000'0000'0000'0000 & frac64A);
+		while (!ecarry) {
+			if (exp == 0) {
+				--m;
+				exp = 0x3;
+			}
+			else {
+				exp--;
+			}
+			frac64A <<= 1;
+			ecarry = bool(0x4000000000000000 & frac64A);
+			//ecarry = bool(0x4000'0000'0000'0000 & frac64A);
+		}
+
+		_bits = round(m, exp, frac64A);
+		if (sign) _bits = -int32_t(_bits) & 0xFFFFFFFF;
+		return *this;
+	}
 	uint32_t _bits;
 
 	// Conversion functions
@@ -866,7 +873,7 @@ inline bool operator!=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS
 	return !operator==(lhs, rhs);
 }
 inline bool operator< (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
-	return long(lhs._bits) < long(rhs._bits);
+	return int32_t(lhs._bits) < int32_t(rhs._bits);
 }
 inline bool operator> (const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 	return operator< (rhs, lhs);
@@ -880,24 +887,11 @@ inline bool operator>=(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS
 
 inline posit<NBITS_IS_32, ES_IS_2> operator+(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 	posit<NBITS_IS_32, ES_IS_2> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result += rhs;
-	} 
-	else {
-		result -= rhs;
-	}
-	return result;
+	return result += rhs;
 }
 inline posit<NBITS_IS_32, ES_IS_2> operator-(const posit<NBITS_IS_32, ES_IS_2>& lhs, const posit<NBITS_IS_32, ES_IS_2>& rhs) {
 	posit<NBITS_IS_32, ES_IS_2> result = lhs;
-	if (lhs.isneg() == rhs.isneg()) {  // are the posits the same sign?
-		result -= rhs.twosComplement();
-	}
-	else {
-		result += rhs.twosComplement();
-	}
-	return result;
-
+	return result -= rhs;
 }
 // binary operator*() is provided by generic class
 // binary operator/() is provided by generic class
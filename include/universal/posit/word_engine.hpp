@@ -0,0 +1,257 @@
+#pragma once
+// word_engine.hpp: word-native arithmetic engine for posit configurations with nbits <= 64
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <utility>
+#include "../native/word_arithmetic.hpp"
+
+namespace sw {
+namespace unum {
+
+// The word engine operates on posit encodings held right-aligned in a uint64_t.
+// Operands are decoded into (sign, scale, significand) triples where the significand
+// carries the hidden bit at bit 63, so that all fraction bits of any posit with nbits <= 64
+// are available to integer add/sub/mul/div/sqrt. The results are rounded to nearest even
+// on the posit bit string by word_encode, which is also the encoder behind convert_() in posit.hpp.
+// All functions require non-zero, non-NaR operands: the special cases are handled by the caller.
+
+// decode a posit encoding into sign, scale, and a significand with the hidden bit at bit 63
+template<size_t nbits, size_t es>
+inline void word_decode(uint64_t bits, bool& sign, int& scale, uint64_t& significand) {
+	static_assert(nbits >= 2 && nbits <= 64, "word engine requires 2 <= nbits <= 64");
+	constexpr uint64_t mask = (nbits == 64 ? 0xFFFFFFFFFFFFFFFFull : ((1ull << (nbits % 64)) - 1));
+	constexpr unsigned exponent_shift = (es == 0 ? 0 : 64 - es);
+
+	sign = bool((bits >> (nbits - 1)) & 1);
+	if (sign) bits = (~bits + 1) & mask;
+	uint64_t regime = bits << (65 - nbits);  // drop the sign bit: the regime starts at bit 63
+	int run, k;
+	if (regime >> 63) {
+		run = countLeadingZeros(~regime);
+		k = run - 1;
+	}
+	else {
+		run = countLeadingZeros(regime);
+		k = -run;
+	}
+	// remove the regime run and its terminating bit
+	uint64_t remaining = (run + 1 >= 64) ? 0 : (regime << (run + 1));
+	int e = (es == 0) ? 0 : int(remaining >> exponent_shift);
+	uint64_t fraction = (es == 0) ? remaining : (remaining << es);
+	scale = k * (1 << es) + e;
+	significand = 0x8000000000000000ull | (fraction >> 1);
+}
+
+// round to nearest even and encode a posit from sign, scale, and a significand with the hidden bit at bit 63
+// sticky summarizes any non-zero bits beyond the significand
+template<size_t nbits, size_t es>
+inline uint64_t word_encode(bool sign, int scale, uint64_t significand, bool sticky) {
+	static_assert(nbits >= 2 && nbits <= 64, "word engine requires 2 <= nbits <= 64");
+	constexpr uint64_t mask = (nbits == 64 ? 0xFFFFFFFFFFFFFFFFull : ((1ull << (nbits % 64)) - 1));
+	constexpr uint64_t sign_bit = 1ull << (nbits - 1);
+	constexpr int max_k = int(nbits) - 2;
+	constexpr int max_scale = max_k * (1 << es);
+	constexpr unsigned exponent_shift = (es == 0 ? 0 : 64 - es);
+
+	uint64_t bits;
+	if (scale > max_scale) {         // inward projection to maxpos
+		bits = sign_bit - 1;
+	}
+	else if (scale < -max_scale) {   // inward projection to minpos
+		bits = 1;
+	}
+	else {
+		int k = scale >> es;
+		uint64_t e = uint64_t(scale - k * (1 << es));
+		// the regime is a run of k+1 1's terminated by a 0, or a run of -k 0's terminated by a 1
+		int regime_length;
+		uint64_t regime;
+		if (k >= 0) {
+			regime_length = k + 2;
+			regime = 0xFFFFFFFFFFFFFFFFull << (63 - k);
+		}
+		else {
+			regime_length = -k + 1;
+			regime = 1ull << (63 + k);
+		}
+		// the exponent bits followed by the fraction bits, as a 128-bit tail
+		uint64_t fraction = significand << 1;  // drop the hidden bit
+		uint64_t tail_hi, tail_lo;
+		if (es == 0) {
+			tail_hi = fraction;
+			tail_lo = 0;
+		}
+		else {
+			tail_hi = (e << exponent_shift) | (fraction >> es);
+			tail_lo = fraction << exponent_shift;
+		}
+		uint64_t word, remainder;
+		if (regime_length < 64) {
+			word = regime | (tail_hi >> regime_length);
+			remainder = (tail_hi << (64 - regime_length)) | tail_lo;
+		}
+		else {
+			word = regime;
+			remainder = tail_hi | tail_lo;
+		}
+		// word now holds the nbits-1 encoding bits, followed by the rounding bit and the top sticky bits
+		uint64_t field = word >> (65 - nbits);
+		bool round = bool((word >> (64 - nbits)) & 1);
+		sticky = sticky || (word & ((1ull << (64 - nbits)) - 1)) || remainder;
+		if (round && (sticky || (field & 1))) ++field;
+		bits = field;
+	}
+	if (sign) bits = (~bits + 1) & mask;
+	return bits;
+}
+
+// negate a posit encoding
+template<size_t nbits>
+inline uint64_t word_negate(uint64_t bits) {
+	constexpr uint64_t mask = (nbits == 64 ? 0xFFFFFFFFFFFFFFFFull : ((1ull << (nbits % 64)) - 1));
+	return (~bits + 1) & mask;
+}
+
+// sum of two posit encodings
+template<size_t nbits, size_t es>
+inline uint64_t word_add(uint64_t a, uint64_t b) {
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa, fb;
+	word_decode<nbits, es>(a, sa, ea, fa);
+	word_decode<nbits, es>(b, sb, eb, fb);
+	// assign the largest magnitude to a: the sign of the result is the sign of a
+	if (ea < eb || (ea == eb && fa < fb)) {
+		std::swap(sa, sb);
+		std::swap(ea, eb);
+		std::swap(fa, fb);
+	}
+	// align b to a in a 128-bit (hi, lo) window, bits shifted beyond the window become sticky
+	int shift = ea - eb;
+	uint64_t b_hi, b_lo;
+	bool sticky = false;
+	if (shift == 0) {
+		b_hi = fb; b_lo = 0;
+	}
+	else if (shift < 64) {
+		b_hi = fb >> shift; b_lo = fb << (64 - shift);
+	}
+	else if (shift < 128) {
+		b_hi = 0;
+		b_lo = fb >> (shift - 64);
+		sticky = (shift > 64) && (fb << (128 - shift)) != 0;
+	}
+	else {
+		b_hi = 0; b_lo = 0;
+		sticky = true;
+	}
+
+	int scale = ea;
+	uint64_t hi, lo;
+	if (sa == sb) {
+		hi = fa + b_hi;
+		lo = b_lo;
+		if (hi < fa) {   // carry out of the significand
+			sticky = sticky || (hi & 1);
+			hi = 0x8000000000000000ull | (hi >> 1);
+			++scale;
+		}
+		return word_encode<nbits, es>(sa, scale, hi, sticky || lo != 0);
+	}
+
+	// subtract the aligned magnitudes: (fa:0) - (b_hi:b_lo)
+	lo = 0 - b_lo;
+	hi = fa - b_hi - (b_lo != 0 ? 1 : 0);
+	if (sticky) {
+		// the shifted out bits make the exact difference slightly smaller: truncate one ulp down
+		if (lo == 0) --hi;
+		--lo;
+	}
+	if (hi == 0 && lo == 0) return 0;   // exact cancellation
+	int lz = (hi != 0) ? countLeadingZeros(hi) : 64 + countLeadingZeros(lo);
+	if (lz >= 64) {
+		hi = lo << (lz - 64);
+		lo = 0;
+	}
+	else if (lz > 0) {
+		hi = (hi << lz) | (lo >> (64 - lz));
+		lo <<= lz;
+	}
+	scale -= lz;
+	return word_encode<nbits, es>(sa, scale, hi, sticky || lo != 0);
+}
+
+// difference of two posit encodings
+template<size_t nbits, size_t es>
+inline uint64_t word_sub(uint64_t a, uint64_t b) {
+	return word_add<nbits, es>(a, word_negate<nbits>(b));
+}
+
+// product of two posit encodings
+template<size_t nbits, size_t es>
+inline uint64_t word_mul(uint64_t a, uint64_t b) {
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa, fb;
+	word_decode<nbits, es>(a, sa, ea, fa);
+	word_decode<nbits, es>(b, sb, eb, fb);
+	// the product of two significands in [1,2) is in [1,4): 2^126 <= (hi:lo) < 2^128
+	uint64_t lo;
+	uint64_t hi = multiply_words(fa, fb, lo);
+	int scale = ea + eb;
+	if (hi & 0x8000000000000000ull) {
+		++scale;
+	}
+	else {
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+	}
+	return word_encode<nbits, es>(sa != sb, scale, hi, lo != 0);
+}
+
+// quotient of two posit encodings
+template<size_t nbits, size_t es>
+inline uint64_t word_div(uint64_t a, uint64_t b) {
+	bool sa, sb;
+	int ea, eb;
+	uint64_t fa, fb;
+	word_decode<nbits, es>(a, sa, ea, fa);
+	word_decode<nbits, es>(b, sb, eb, fb);
+	// align the dividend so that the quotient has its hidden bit at bit 63
+	int scale = ea - eb;
+	uint64_t rem, q;
+	if (fa >= fb) {
+		q = divide_words(fa >> 1, fa << 63, fb, rem);
+	}
+	else {
+		q = divide_words(fa, 0, fb, rem);
+		--scale;
+	}
+	return word_encode<nbits, es>(sa != sb, scale, q, rem != 0);
+}
+
+// square root of a positive posit encoding
+template<size_t nbits, size_t es>
+inline uint64_t word_sqrt(uint64_t a) {
+	bool s;
+	int scale;
+	uint64_t f;
+	word_decode<nbits, es>(a, s, scale, f);
+	// make the scale even, so that the root of the 128-bit radicand has its hidden bit at bit 63
+	uint64_t hi, lo;
+	if (scale & 1) {
+		hi = f; lo = 0;
+	}
+	else {
+		hi = f >> 1; lo = f << 63;
+	}
+	bool inexact;
+	uint64_t root = sqrt_words(hi, lo, inexact);
+	return word_encode<nbits, es>(false, scale >> 1, root, inexact);
+}
+
+}  // namespace unum
+}  // namespace sw
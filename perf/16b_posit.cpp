@@ -9,6 +9,10 @@
 #define POSIT_FAST_POSIT_16_1 1
 // second: disable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: compile the vectorized kernels of the array operators, the host decides at run time
+#if !defined(POSIT_ARRAY_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define POSIT_ARRAY_SIMD 1
+#endif
 #include <universal/posit/posit>
 #include "posit_performance.hpp"
 
@@ -25,6 +29,8 @@ try {
 	GeneratePerformanceReport<nbits, es>(perfReport);
 	ReportPerformance<nbits, es>(cout, "posit<16,1>", perfReport);
 
+	CompareArrayKernels<nbits, es>(cout, "posit<16,1>");
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -0,0 +1,53 @@
+// 256b_posit.cpp: performance characterization of standard posit<256,5> configuration
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable fast specialized posit<256,5>
+#define POSIT_FAST_POSIT_256_5 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include "posit_performance.hpp"
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	constexpr size_t nbits = 256;
+	constexpr size_t es = 5;
+	//constexpr size_t capacity = 6;   // 2^6 accumulations of maxpos^2
+
+	OperatorPerformance perfReport;
+	GeneratePerformanceReport<nbits, es>(perfReport);
+	ReportPerformance<nbits, es>(cout, "posit<256,5>", perfReport);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
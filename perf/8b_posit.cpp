@@ -1,6 +1,6 @@
 // posit_8b.cpp: performance characterization of standard posit<8,0> configuration
 //
-// Copyright (C) 2017-2019 Stillwater Supercomputing, Inc.
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
@@ -12,6 +12,57 @@
 #include <universal/posit/posit>
 #include "posit_performance.hpp"
 
+namespace sw {
+namespace unum {
+
+// throughput of a binary operator on raw 8-bit encodings, in operations per second
+template<typename BinaryOperator>
+float MeasureEncodingThroughput(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, BinaryOperator op) {
+	constexpr int NR_REPETITIONS = 100;
+	using namespace std::chrono;
+	uint8_t checksum = 0;
+	steady_clock::time_point begin = steady_clock::now();
+	for (int r = 0; r < NR_REPETITIONS; ++r) {
+		for (size_t i = 0; i < a.size(); ++i) {
+			checksum ^= op(a[i], b[i]);
+		}
+	}
+	steady_clock::time_point end = steady_clock::now();
+	double elapsed = duration_cast<duration<double>>(end - begin).count();
+	if (checksum == 0xFF) std::cout << "checksum " << unsigned(checksum) << '\n';  // keep the computation alive
+	return float(double(a.size()) * NR_REPETITIONS / elapsed);
+}
+
+// compare the table-driven lookup engine to the SoftPosit-style bit-twiddling of the posit<8,0> specialization
+void CompareLookupToBitTwiddling(std::ostream& ostr) {
+	std::mt19937 generator(8);
+	std::uniform_int_distribution<unsigned> distribution(0, 255);
+	std::vector<uint8_t> a(NR_TEST_CASES), b(NR_TEST_CASES);
+	for (int i = 0; i < NR_TEST_CASES; ++i) {
+		a[i] = uint8_t(distribution(generator));
+		b[i] = uint8_t(distribution(generator));
+	}
+	posit8_lookup_tables<0>::instance();  // generate the tables outside of the measurement
+	auto soft_add = [](uint8_t x, uint8_t y) { posit8_t l = { { x } }, r = { { y } }; return uint8_t(posit8_addp8(l, r).v); };
+	auto soft_sub = [](uint8_t x, uint8_t y) { posit8_t l = { { x } }, r = { { y } }; return uint8_t(posit8_subp8(l, r).v); };
+	auto soft_mul = [](uint8_t x, uint8_t y) { posit8_t l = { { x } }, r = { { y } }; return uint8_t(posit8_mulp8(l, r).v); };
+	auto soft_div = [](uint8_t x, uint8_t y) { posit8_t l = { { x } }, r = { { y } }; return uint8_t(posit8_divp8(l, r).v); };
+	ostr << "Lookup engine versus bit-twiddling: posit<8,0>\n"
+		<< "                 bit-twiddling    lookup\n"
+		<< "Addition        : " << to_scientific(MeasureEncodingThroughput(a, b, soft_add)) << "POPS      "
+		<< to_scientific(MeasureEncodingThroughput(a, b, lookup_add<0>)) << "POPS\n"
+		<< "Subtraction     : " << to_scientific(MeasureEncodingThroughput(a, b, soft_sub)) << "POPS      "
+		<< to_scientific(MeasureEncodingThroughput(a, b, lookup_sub<0>)) << "POPS\n"
+		<< "Multiplication  : " << to_scientific(MeasureEncodingThroughput(a, b, soft_mul)) << "POPS      "
+		<< to_scientific(MeasureEncodingThroughput(a, b, lookup_mul<0>)) << "POPS\n"
+		<< "Division        : " << to_scientific(MeasureEncodingThroughput(a, b, soft_div)) << "POPS      "
+		<< to_scientific(MeasureEncodingThroughput(a, b, lookup_div<0>)) << "POPS\n"
+		<< std::endl;
+}
+
+} // namespace unum
+} // namespace sw
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
@@ -25,6 +76,8 @@ try {
 	GeneratePerformanceReport<nbits, es>(perfReport);
 	ReportPerformance<nbits, es>(cout, "posit<8,0>", perfReport);
 
+	CompareLookupToBitTwiddling(cout);
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -0,0 +1,145 @@
+// bitblock_arithmetic.cpp: time of the multi-word multiply and divide of bitblock against bit-serial shift-and-add and restoring division
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// bit-serial reference: one shifted addend per set bit of a
+template<size_t operand_size>
+void ShiftAndAddMultiply(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<2 * operand_size>& result) {
+	constexpr size_t result_size = 2 * operand_size;
+	bitblock<result_size> addend;
+	result.reset();
+	for (size_t i = 0; i < operand_size; ++i) {
+		if (a.test(i)) {
+			copy_into<operand_size, result_size>(b, i, addend);
+			accumulate(addend, result);
+		}
+	}
+}
+
+// bit-serial reference: restoring division, one quotient bit per step
+template<size_t operand_size, size_t result_size>
+void RestoringDivide(const bitblock<operand_size>& a, const bitblock<operand_size>& b, bitblock<result_size>& result) {
+	bitblock<result_size> subtractand, accumulator;
+	result.reset();
+	copy_into<operand_size, result_size>(a, result_size - operand_size, accumulator);
+	int msb = findMostSignificantBit(b);
+	copy_into<operand_size, result_size>(b, result_size - operand_size, subtractand);
+	subtractand <<= operand_size - msb - 1;
+	for (int i = int(result_size) - msb - 1; i >= 0; --i) {
+		if (subtractand <= accumulator) {
+			subtract(accumulator, subtractand);
+			result.set(i);
+		}
+		subtractand >>= 1;
+	}
+}
+
+template<size_t nbits>
+bitblock<nbits> RandomBitblock(std::mt19937_64& generator, size_t significantBits = nbits) {
+	bitblock<nbits> bits;
+	for (size_t i = 0; i < bitblock<nbits>::nrBlocks; ++i) bits.setblock(i, generator());
+	for (size_t i = significantBits; i < nbits; ++i) bits.reset(i);
+	bits.set(significantBits - 1);
+	return bits;
+}
+
+// ns per operation of the multi-word and the bit-serial algorithms for nbits operands:
+// multiply into 2*nbits, integer divide by an nbits/2 divisor, and fraction divide into 2*nbits quotient bits
+template<size_t nbits>
+void CompareMultiplyDivide(std::ostream& ostr) {
+	std::mt19937_64 generator(nbits);
+	bitblock<nbits> a = RandomBitblock<nbits>(generator);
+	bitblock<nbits> b = RandomBitblock<nbits>(generator);
+	bitblock<nbits> d = RandomBitblock<nbits>(generator, nbits / 2);
+	bitblock<2 * nbits> product, reference, quotient;
+	bitblock<nbits> integerQuotient;
+	size_t mismatches = 0;
+	// batches of operations, so that the clock reads of the measurement loop do not dominate at small sizes
+	constexpr int batch = 100;
+	auto perOperation = [](double seconds) { return seconds * 1.0e9 / batch; };
+
+	double mul = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { multiply_unsigned(a, b, product); a.flip(0); } });
+	double serialMul = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { ShiftAndAddMultiply(a, b, reference); a.flip(0); } });
+	multiply_unsigned(a, b, product);
+	ShiftAndAddMultiply(a, b, reference);
+	if (product != reference) ++mismatches;
+
+	double div = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { integer_divide_unsigned(a, d, quotient); a.flip(0); } });
+	double serialDiv = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { RestoringDivide(a, d, integerQuotient); a.flip(0); } });
+	integer_divide_unsigned(a, d, quotient);
+	RestoringDivide(a, d, integerQuotient);
+	copy_into(integerQuotient, 0, reference);
+	if (quotient != reference) ++mismatches;
+
+	double fdiv = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { divide_with_fraction(a, b, quotient); a.flip(0); } });
+	double serialFdiv = MeasureSecondsPerCall([&]() { for (int i = 0; i < batch; ++i) { RestoringDivide(a, b, reference); a.flip(0); } });
+	divide_with_fraction(a, b, quotient);
+	RestoringDivide(a, b, reference);
+	if (quotient != reference) ++mismatches;
+
+	ostr << std::setw(8) << nbits << std::fixed << std::setprecision(1)
+	     << std::setw(12) << perOperation(mul) << std::setw(12) << perOperation(serialMul)
+	     << std::setw(12) << perOperation(div) << std::setw(12) << perOperation(serialDiv)
+	     << std::setw(12) << perOperation(fdiv) << std::setw(12) << perOperation(serialFdiv)
+	     << (mismatches ? "  MISMATCH" : "") << std::endl;
+}
+
+}} // namespace sw::unum
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << "bitblock multiply and divide: ns per operation, multi-word against bit-serial\n";
+	cout << "multiply into 2n bits, integer divide by an n/2-bit divisor, fraction divide into 2n quotient bits\n";
+	cout << setw(8) << "nbits" << setw(12) << "mul" << setw(12) << "shift-add"
+	     << setw(12) << "idiv" << setw(12) << "restoring" << setw(12) << "fdiv" << setw(12) << "restoring" << '\n';
+	CompareMultiplyDivide<32>(cout);
+	CompareMultiplyDivide<64>(cout);
+	CompareMultiplyDivide<128>(cout);
+	CompareMultiplyDivide<256>(cout);
+	CompareMultiplyDivide<512>(cout);
+	CompareMultiplyDivide<1024>(cout);
+	CompareMultiplyDivide<2048>(cout);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+// blas_gemm.cpp: posit-GFLOPS of the cache-blocked posit matrix-matrix multiplication
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/gemm.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// naive triple loop that rounds every multiply and add, for comparison
+template<size_t nbits, size_t es>
+void NaiveMatmul(size_t N, const std::vector< posit<nbits, es> >& A, const std::vector< posit<nbits, es> >& B, std::vector< posit<nbits, es> >& C) {
+	for (size_t i = 0; i < N; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			posit<nbits, es> sum(0);
+			for (size_t p = 0; p < N; ++p) sum += A[i * N + p] * B[p * N + j];
+			C[i * N + j] = sum;
+		}
+	}
+}
+
+// posit-GFLOPS, counting a multiply and an add per product, of square matrix multiplies of size 64 to maxSize
+template<size_t nbits, size_t es>
+void MeasureGemm(std::ostream& ostr, const std::string& header, size_t maxSize, unsigned nrThreads) {
+	using namespace std::chrono;
+	using Posit = posit<nbits, es>;
+	ostr << "gemm: " << header << " with " << nrThreads << " threads\n";
+	ostr << std::setw(8) << "size" << std::setw(FLOAT_TABLE_WIDTH) << "gemm" << std::setw(FLOAT_TABLE_WIDTH) << "naive" << '\n';
+	std::ios_base::fmtflags flags = ostr.flags();
+	std::streamsize precision = ostr.precision();
+	for (size_t N = 64; N <= maxSize; N *= 2) {
+		std::mt19937_64 generator(N);
+		std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+		std::vector<Posit> A(N * N), B(N * N), C(N * N);
+		for (size_t i = 0; i < N * N; ++i) {
+			A[i] = distribution(generator);
+			B[i] = distribution(generator);
+		}
+		double flops = 2.0 * double(N) * double(N) * double(N);
+		steady_clock::time_point begin = steady_clock::now();
+		blas::gemm(N, N, N, A, B, C, nrThreads);
+		double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+		ostr << std::setw(8) << N << std::setw(FLOAT_TABLE_WIDTH - 7) << std::fixed << std::setprecision(3) << flops / elapsed / 1.0e9 << " GFLOPS";
+		if (N <= 256) {
+			begin = steady_clock::now();
+			NaiveMatmul(N, A, B, C);
+			elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+			ostr << std::setw(FLOAT_TABLE_WIDTH - 7) << flops / elapsed / 1.0e9 << " GFLOPS";
+		}
+		ostr << '\n';
+	}
+	ostr << std::endl;
+	ostr.flags(flags);
+	ostr.precision(precision);
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: blas_gemm [largest matrix size, default 512, at most 4096] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t maxSize = (argc > 1) ? std::min(size_t(std::stoul(argv[1])), size_t(4096)) : 512;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	MeasureGemm<32, 2>(cout, "posit<32,2>", maxSize, nrThreads);
+	MeasureGemm<16, 1>(cout, "posit<16,1>", maxSize, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
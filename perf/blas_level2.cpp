@@ -0,0 +1,92 @@
+// blas_level2.cpp: performance of the matrix-vector kernels in posits, float, and double
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/blas>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// MFLOPS of gemv in both layouts and both accumulations, and of a lower triangular solve, on an N x N matrix
+template<typename Scalar>
+void MeasureLevel2(std::ostream& ostr, const std::string& header, size_t N, unsigned nrThreads) {
+	using namespace blas;
+	std::mt19937_64 generator(N);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Scalar> A(N * N), x(N), y(N);
+	for (Scalar& a : A) a = distribution(generator);
+	for (Scalar& e : x) e = distribution(generator);
+	for (size_t i = 0; i < N; ++i) A[i * N + i] = Scalar(double(N));
+	double flops = 2.0 * double(N) * double(N);
+	auto mflops = [flops](double seconds) { return flops / seconds / 1.0e6; };
+
+	ostr << std::setw(14) << header << std::setw(6) << N;
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { gemv(matrix_layout::row_major, N, N, A, x, y, accumulation::fused, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { gemv(matrix_layout::row_major, N, N, A, x, y, accumulation::rounded, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { gemv(matrix_layout::column_major, N, N, A, x, y, accumulation::fused, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { gemv(matrix_layout::column_major, N, N, A, x, y, accumulation::rounded, nrThreads); }));
+	// the triangular solve takes half the operations of gemv
+	ostr << std::setw(12) << 0.5 * mflops(MeasureSecondsPerCall([&]() { y = x; trsv(matrix_layout::row_major, triangle::lower, diagonal::non_unit, N, A, y, nrThreads); }));
+	ostr << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: blas_level2 [matrix size, default 512] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t N = (argc > 1) ? size_t(std::stoul(argv[1])) : 512;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	cout << "BLAS level 2 performance in MFLOPS with " << nrThreads << " threads\n";
+	cout << std::setw(14) << "type" << std::setw(6) << "size"
+	     << std::setw(12) << "gemv row" << std::setw(12) << "rounded"
+	     << std::setw(12) << "gemv col" << std::setw(12) << "rounded"
+	     << std::setw(12) << "trsv" << '\n';
+	cout << std::fixed << std::setprecision(1);
+	MeasureLevel2< posit<16, 1> >(cout, "posit<16,1>", N, nrThreads);
+	MeasureLevel2< posit<32, 2> >(cout, "posit<32,2>", N, nrThreads);
+	MeasureLevel2< posit<64, 3> >(cout, "posit<64,3>", N / 4, nrThreads);
+	MeasureLevel2<float>(cout, "float", N, nrThreads);
+	MeasureLevel2<double>(cout, "double", N, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
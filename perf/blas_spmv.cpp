@@ -0,0 +1,105 @@
+// blas_spmv.cpp: performance of the sparse matrix-vector products in posits, fixed-point, and double
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/blas/sparse.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// the 5-point Laplacian of a grid x grid mesh
+template<typename Scalar>
+blas::sparse_matrix<Scalar> Laplacian2D(size_t grid, blas::sparse_format format) {
+	std::vector< blas::triplet<Scalar> > elements;
+	size_t n = grid * grid;
+	for (size_t i = 0; i < n; ++i) {
+		size_t r = i / grid, c = i % grid;
+		elements.push_back({ i, i, Scalar(4) });
+		if (r > 0)        elements.push_back({ i, i - grid, Scalar(-1) });
+		if (r + 1 < grid) elements.push_back({ i, i + grid, Scalar(-1) });
+		if (c > 0)        elements.push_back({ i, i - 1, Scalar(-1) });
+		if (c + 1 < grid) elements.push_back({ i, i + 1, Scalar(-1) });
+	}
+	return blas::sparse_matrix<Scalar>(n, n, std::move(elements), format);
+}
+
+// MFLOPS of the products of the csr and csc forms of the Laplacian, counting a multiply and an add per nonzero
+template<typename Scalar>
+void MeasureSpmv(std::ostream& ostr, const std::string& header, size_t grid, unsigned nrThreads) {
+	using namespace blas;
+	sparse_matrix<Scalar> csr = Laplacian2D<Scalar>(grid, sparse_format::csr);
+	sparse_matrix<Scalar> csc = csr.convert(sparse_format::csc);
+	std::mt19937_64 generator(grid);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Scalar> x(csr.cols()), y;
+	for (Scalar& e : x) e = Scalar(distribution(generator));
+	double flops = 2.0 * double(csr.nonzeros());
+	auto mflops = [flops](double seconds) { return flops / seconds / 1.0e6; };
+
+	ostr << std::setw(14) << header << std::setw(10) << csr.nonzeros();
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { spmv(csr, x, y, accumulation::fused, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { spmv(csr, x, y, accumulation::rounded, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { spmv(csc, x, y, accumulation::fused, nrThreads); }));
+	ostr << std::setw(12) << mflops(MeasureSecondsPerCall([&]() { spmv_transpose(csr, x, y, accumulation::fused, nrThreads); }));
+	ostr << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: blas_spmv [grid size of the 2D Laplacian, default 256] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t grid = (argc > 1) ? size_t(std::stoul(argv[1])) : 256;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	cout << "sparse matrix-vector product of the " << grid << " x " << grid << " 2D Laplacian in MFLOPS with " << nrThreads << " threads\n";
+	cout << std::setw(14) << "type" << std::setw(10) << "nonzeros"
+	     << std::setw(12) << "csr" << std::setw(12) << "rounded"
+	     << std::setw(12) << "csc" << std::setw(12) << "csr^T" << '\n';
+	cout << std::fixed << std::setprecision(1);
+	MeasureSpmv< posit<32, 2> >(cout, "posit<32,2>", grid, nrThreads);
+	MeasureSpmv< posit<16, 1> >(cout, "posit<16,1>", grid, nrThreads);
+	MeasureSpmv< fixpnt<32, 16> >(cout, "fixpnt<32,16>", grid / 4, nrThreads);
+	MeasureSpmv<double>(cout, "double", grid, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+// cg_solve.cpp: iterations and time-to-solution of the conjugate gradient solver with fused versus rounded inner products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/cg.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// the 5-point Laplacian of a grid x grid mesh
+template<typename Scalar>
+blas::sparse_matrix<Scalar> Laplacian2D(size_t grid) {
+	std::vector< blas::triplet<Scalar> > elements;
+	size_t n = grid * grid;
+	for (size_t i = 0; i < n; ++i) {
+		size_t r = i / grid, c = i % grid;
+		elements.push_back({ i, i, Scalar(4) });
+		if (r > 0)        elements.push_back({ i, i - grid, Scalar(-1) });
+		if (r + 1 < grid) elements.push_back({ i, i + grid, Scalar(-1) });
+		if (c > 0)        elements.push_back({ i, i - 1, Scalar(-1) });
+		if (c + 1 < grid) elements.push_back({ i, i + 1, Scalar(-1) });
+	}
+	return blas::sparse_matrix<Scalar>(n, n, std::move(elements));
+}
+
+// solve the Laplacian for a smooth right-hand side, and report the iterations, the wall time,
+// and the true relative residual of the solution evaluated in double
+template<typename Scalar>
+void MeasureCG(std::ostream& ostr, const std::string& header, size_t grid, blas::accumulation acc, double tolerance, unsigned nrThreads) {
+	using namespace std::chrono;
+	using namespace blas;
+	sparse_matrix<Scalar> A = Laplacian2D<Scalar>(grid);
+	size_t n = A.rows();
+	std::vector<Scalar> b(n), x;
+	for (size_t i = 0; i < n; ++i) b[i] = Scalar(1.0 + std::sin(double(i) / double(grid)));
+
+	cg_options options;
+	options.tolerance = tolerance;
+	options.max_iterations = 20 * grid;
+	options.inner_products = acc;
+	options.threads = nrThreads;
+	steady_clock::time_point begin = steady_clock::now();
+	cg_result result = cg(A, b, x, options);
+	double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+
+	sparse_matrix<double> reference = Laplacian2D<double>(grid);
+	std::vector<double> xd(n), bd(n), Ax;
+	for (size_t i = 0; i < n; ++i) {
+		xd[i] = double(x[i]);
+		bd[i] = double(b[i]);
+	}
+	spmv(reference, xd, Ax);
+	double rnorm = 0.0, bnorm = 0.0;
+	for (size_t i = 0; i < n; ++i) {
+		rnorm += (bd[i] - Ax[i]) * (bd[i] - Ax[i]);
+		bnorm += bd[i] * bd[i];
+	}
+
+	ostr << std::setw(14) << header << std::setw(10) << (acc == accumulation::fused ? "fused" : "rounded")
+	     << std::setw(10) << std::scientific << std::setprecision(0) << tolerance
+	     << std::setw(12) << result.iterations << (result.converged ? ' ' : '*')
+	     << std::setw(12) << std::fixed << std::setprecision(3) << elapsed
+	     << std::setw(12) << std::scientific << std::setprecision(2) << std::sqrt(rnorm / bnorm) << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: cg_solve [grid size of the 2D Laplacian, default 64] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using blas::accumulation;
+
+	size_t grid = (argc > 1) ? size_t(std::stoul(argv[1])) : 64;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	cout << "Jacobi preconditioned conjugate gradients on the " << grid << " x " << grid << " 2D Laplacian with " << nrThreads << " threads\n";
+	cout << "(* marks a solve that did not reach the tolerance)\n";
+	cout << setw(14) << "type" << setw(10) << "dot" << setw(10) << "tolerance"
+	     << setw(13) << "iterations" << setw(12) << "seconds" << setw(12) << "residual" << '\n';
+	MeasureCG<double>(cout, "double", grid, accumulation::rounded, 1.0e-6, nrThreads);
+	MeasureCG<float>(cout, "float", grid, accumulation::rounded, 1.0e-6, nrThreads);
+	MeasureCG< posit<32, 2> >(cout, "posit<32,2>", grid, accumulation::rounded, 1.0e-6, nrThreads);
+	MeasureCG< posit<32, 2> >(cout, "posit<32,2>", grid, accumulation::fused, 1.0e-6, nrThreads);
+	MeasureCG< posit<16, 1> >(cout, "posit<16,1>", grid, accumulation::rounded, 1.0e-3, nrThreads);
+	MeasureCG< posit<16, 1> >(cout, "posit<16,1>", grid, accumulation::fused, 1.0e-3, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
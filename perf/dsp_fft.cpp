@@ -0,0 +1,121 @@
+// dsp_fft.cpp: throughput and signal-to-noise ratio of the Stockham FFT in posit, fixed-point, and IEEE arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/dsp/fft.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// a sum of tones and noise with peak magnitude below one, so that a fixed-point transform with per-stage scaling cannot overflow
+std::vector< std::complex<double> > TestSignal(size_t n) {
+	const double pi = 3.14159265358979323846;
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> noise(-0.05, 0.05);
+	std::vector< std::complex<double> > x(n);
+	for (size_t i = 0; i < n; ++i) {
+		double t = double(i) / double(n);
+		x[i] = std::complex<double>(0.4 * std::cos(2.0 * pi * 17.0 * t) + 0.2 * std::sin(2.0 * pi * 101.0 * t) + noise(generator),
+		                            0.3 * std::sin(2.0 * pi * 43.0 * t) + noise(generator));
+	}
+	return x;
+}
+
+// SNR in dB of the transform against the double precision transform of the same rounded input, the time per transform
+// on one thread, and the throughput of a batch of transforms spread over nrThreads threads
+template<typename Scalar>
+void MeasureFFT(std::ostream& ostr, const std::string& header, size_t n, dsp::accumulation acc, unsigned nrThreads) {
+	using namespace dsp;
+	std::vector< std::complex<double> > x = TestSignal(n);
+	std::vector< std::complex<Scalar> > data(n);
+	for (size_t i = 0; i < n; ++i) {
+		data[i] = std::complex<Scalar>(Scalar(x[i].real()), Scalar(x[i].imag()));
+		x[i] = std::complex<double>(double(data[i].real()), double(data[i].imag()));
+	}
+	fft_plan<double> reference(n, fft_direction::forward, fft_scaling::per_stage);
+	reference.transform(x);
+	fft_plan<Scalar> plan(n, fft_direction::forward, fft_scaling::per_stage, acc);
+	std::vector< std::complex<Scalar> > X(data);
+	plan.transform(X);
+	double signal = 0.0, noise = 0.0;
+	for (size_t k = 0; k < n; ++k) {
+		signal += std::norm(x[k]);
+		noise += std::norm(std::complex<double>(double(X[k].real()), double(X[k].imag())) - x[k]);
+	}
+	double snr = (noise == 0.0) ? 0.0 : 10.0 * std::log10(signal / noise);
+
+	double seconds = MeasureSecondsPerCall([&]() { X = data; plan.transform(X); });
+	size_t count = std::max(size_t(2 * nrThreads), (size_t(1) << 16) / n);
+	std::vector< std::complex<Scalar> > batch(count * n);
+	for (size_t b = 0; b < count; ++b) std::copy(data.begin(), data.end(), batch.begin() + b * n);
+	double batchSeconds = MeasureSecondsPerCall([&]() { plan.transform_batch(batch.data(), count, n, nrThreads); });
+
+	ostr << std::setw(14) << header << std::setw(10) << (acc == accumulation::fused ? "fused" : "rounded")
+	     << std::setw(10) << std::fixed << std::setprecision(1) << snr
+	     << std::setw(14) << std::setprecision(1) << seconds * 1.0e6
+	     << std::setw(14) << std::setprecision(2) << double(n) / seconds / 1.0e6
+	     << std::setw(14) << std::setprecision(2) << double(count * n) / batchSeconds / 1.0e6 << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: dsp_fft [transform length, default 1024] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using dsp::accumulation;
+	using Fixed = fixpnt<16, 14, Modulo, uint16_t>;
+
+	size_t n = (argc > 1) ? size_t(std::stoul(argv[1])) : 1024;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	cout << "Stockham FFT of length " << n << " with per-stage scaling, batches on " << nrThreads << " threads\n";
+	cout << setw(14) << "type" << setw(10) << "butterfly" << setw(10) << "SNR dB"
+	     << setw(14) << "us/transform" << setw(14) << "Msamples/s" << setw(14) << "batch Ms/s" << '\n';
+	MeasureFFT<float>(cout, "float", n, accumulation::rounded, nrThreads);
+	MeasureFFT< posit<32, 2> >(cout, "posit<32,2>", n, accumulation::rounded, nrThreads);
+	MeasureFFT< posit<32, 2> >(cout, "posit<32,2>", n, accumulation::fused, nrThreads);
+	MeasureFFT< posit<16, 1> >(cout, "posit<16,1>", n, accumulation::rounded, nrThreads);
+	MeasureFFT< posit<16, 1> >(cout, "posit<16,1>", n, accumulation::fused, nrThreads);
+	MeasureFFT<Fixed>(cout, "fixpnt<16,14>", n, accumulation::rounded, nrThreads);
+	MeasureFFT<Fixed>(cout, "fixpnt<16,14>", n, accumulation::fused, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
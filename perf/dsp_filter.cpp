@@ -0,0 +1,122 @@
+// dsp_filter.cpp: throughput in samples per second of the streaming FIR, IIR, and polyphase filters
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/dsp/filter.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// number of samples each call processes
+constexpr size_t filter_block_size = 1024;
+
+// random values in [-amplitude, amplitude] rounded to Scalar
+template<typename Scalar>
+std::vector<Scalar> RandomValues(size_t n, double amplitude, uint64_t seed) {
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<double> distribution(-amplitude, amplitude);
+	std::vector<Scalar> x(n);
+	for (auto& e : x) e = Scalar(distribution(generator));
+	return x;
+}
+
+// samples per second of a filter that processes a block of filter_block_size samples per call
+template<typename Filter, typename Scalar>
+double SamplesPerSecond(Filter& filter, const std::vector<Scalar>& in, std::vector<Scalar>& out) {
+	double seconds = MeasureSecondsPerCall([&]() { filter.process(in.data(), out.data(), in.size()); });
+	return double(in.size()) / seconds;
+}
+
+// FIR throughput in Msamples/s for 32 to 512 taps
+template<typename Scalar>
+void MeasureFIR(std::ostream& ostr, const std::string& header, dsp::accumulation acc) {
+	std::vector<Scalar> in = RandomValues<Scalar>(filter_block_size, 0.5, 1), out(filter_block_size);
+	ostr << std::setw(14) << header << std::setw(10) << (acc == dsp::accumulation::fused ? "fused" : "rounded");
+	for (size_t taps = 32; taps <= 512; taps *= 2) {
+		dsp::fir_filter<Scalar> filter(RandomValues<Scalar>(taps, 1.0 / double(taps), taps), acc);
+		ostr << std::setw(10) << std::fixed << std::setprecision(3) << SamplesPerSecond(filter, in, out) / 1.0e6;
+	}
+	ostr << '\n';
+}
+
+// input Msamples/s of a cascade of four biquads, and of decimation and interpolation by 4 with 128 taps
+template<typename Scalar>
+void MeasureMultirate(std::ostream& ostr, const std::string& header, dsp::accumulation acc) {
+	std::vector<Scalar> in = RandomValues<Scalar>(filter_block_size, 0.5, 2), out(4 * filter_block_size);
+	std::vector< dsp::biquad<Scalar> > sections(4, dsp::biquad<Scalar>{ Scalar(0.0200833655642112), Scalar(0.0401667311284225), Scalar(0.0200833655642112), Scalar(-1.5610180758007182), Scalar(0.6413515380575631) });
+	dsp::iir_filter<Scalar> iir(sections, acc);
+	std::vector<Scalar> taps = RandomValues<Scalar>(128, 1.0 / 32.0, 3);
+	dsp::fir_decimator<Scalar> decimator(taps, 4, acc);
+	dsp::fir_interpolator<Scalar> interpolator(taps, 4, acc);
+	ostr << std::setw(14) << header << std::setw(10) << (acc == dsp::accumulation::fused ? "fused" : "rounded") << std::fixed << std::setprecision(3)
+	     << std::setw(12) << SamplesPerSecond(iir, in, out) / 1.0e6
+	     << std::setw(12) << SamplesPerSecond(decimator, in, out) / 1.0e6
+	     << std::setw(12) << SamplesPerSecond(interpolator, in, out) / 1.0e6 << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using dsp::accumulation;
+	using Fixed = fixpnt<16, 14, Modulo, uint16_t>;
+
+	cout << "FIR filter throughput in Msamples/s, blocks of " << filter_block_size << " samples\n";
+	cout << setw(14) << "type" << setw(10) << "sum";
+	for (size_t taps = 32; taps <= 512; taps *= 2) cout << setw(10) << (to_string(taps) + " taps");
+	cout << '\n';
+	MeasureFIR<float>(cout, "float", accumulation::rounded);
+	MeasureFIR< posit<32, 2> >(cout, "posit<32,2>", accumulation::rounded);
+	MeasureFIR< posit<32, 2> >(cout, "posit<32,2>", accumulation::fused);
+	MeasureFIR< posit<16, 1> >(cout, "posit<16,1>", accumulation::rounded);
+	MeasureFIR< posit<16, 1> >(cout, "posit<16,1>", accumulation::fused);
+	MeasureFIR<Fixed>(cout, "fixpnt<16,14>", accumulation::rounded);
+	MeasureFIR<Fixed>(cout, "fixpnt<16,14>", accumulation::fused);
+
+	cout << "\nIIR and multirate throughput in input Msamples/s\n";
+	cout << setw(14) << "type" << setw(10) << "sum" << setw(12) << "4 biquads" << setw(12) << "decimate 4" << setw(12) << "interp 4" << '\n';
+	MeasureMultirate<float>(cout, "float", accumulation::rounded);
+	MeasureMultirate< posit<32, 2> >(cout, "posit<32,2>", accumulation::fused);
+	MeasureMultirate< posit<16, 1> >(cout, "posit<16,1>", accumulation::fused);
+	MeasureMultirate<Fixed>(cout, "fixpnt<16,14>", accumulation::fused);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+// limb_multiply.cpp: crossover measurement of the schoolbook, Karatsuba, and Toom-3 multi-word products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/integer/integer.hpp>
+#include <universal/blockbin/blockbinary.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// ns per product of N-limb operands for each algorithm, and the algorithm limbs_multiply dispatches to:
+// karatsuba_threshold and toom3_threshold in native/word_arithmetic.hpp are set at the crossovers of these columns
+template<size_t N>
+void CompareMultiplyAlgorithms(std::ostream& ostr) {
+	std::mt19937_64 generator(N);
+	uint64_t a[N], b[N], schoolbook[2 * N], karatsuba[2 * N], toom3[2 * N];
+	for (size_t i = 0; i < N; ++i) {
+		a[i] = generator();
+		b[i] = generator();
+	}
+
+	double sb = MeasureSecondsPerCall([&]() { limbs_multiply_schoolbook(a, b, schoolbook); a[0] ^= schoolbook[N]; });
+	double ka = MeasureSecondsPerCall([&]() { limbs_multiply_karatsuba(a, b, karatsuba); a[0] ^= karatsuba[N]; });
+	double tc = MeasureSecondsPerCall([&]() { limbs_multiply_toom3(a, b, toom3); a[0] ^= toom3[N]; });
+	limbs_multiply_schoolbook(a, b, schoolbook);
+	limbs_multiply_karatsuba(a, b, karatsuba);
+	limbs_multiply_toom3(a, b, toom3);
+	bool mismatch = false;
+	for (size_t i = 0; i < 2 * N; ++i) mismatch |= (schoolbook[i] != karatsuba[i]) || (schoolbook[i] != toom3[i]);
+
+	const char* dispatch = (N >= toom3_threshold) ? "toom-3" : (N >= karatsuba_threshold) ? "karatsuba" : "schoolbook";
+	ostr << std::setw(8) << N << std::setw(8) << 64 * N << std::fixed << std::setprecision(1)
+	     << std::setw(14) << sb * 1.0e9 << std::setw(14) << ka * 1.0e9 << std::setw(14) << tc * 1.0e9
+	     << std::setw(14) << dispatch << (mismatch ? "  MISMATCH" : "") << std::endl;
+}
+
+// ns per modular multiplication of integer<nbits> and blockbinary<nbits>, which both go through limbs_multiply
+template<size_t nbits>
+void MeasureMultiply(std::ostream& ostr) {
+	std::mt19937_64 generator(nbits);
+	integer<nbits> a, b, c;
+	blockbinary<nbits> x, y, z;
+	for (unsigned i = 0; i < integer<nbits>::nrBytes; ++i) {
+		a.setbyte(i, uint8_t(generator()));
+		b.setbyte(i, uint8_t(generator()));
+	}
+	for (size_t i = 0; i < blockbinary<nbits>::nrBlocks; ++i) {
+		x.setblock(i, generator());
+		y.setblock(i, generator());
+	}
+	double integerMul = MeasureSecondsPerCall([&]() { c = a * b; a.setbyte(0, c.byte(0) | 1); });
+	double blockbinaryMul = MeasureSecondsPerCall([&]() { z = x * y; x.setblock(0, z.block(0) | 1); });
+	ostr << std::setw(8) << nbits << std::fixed << std::setprecision(1)
+	     << std::setw(14) << integerMul * 1.0e9 << std::setw(14) << blockbinaryMul * 1.0e9 << std::endl;
+}
+
+}} // namespace sw::unum
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << "multi-word multiplication: ns per product of two N-limb operands\n";
+	cout << setw(8) << "limbs" << setw(8) << "bits" << setw(14) << "schoolbook" << setw(14) << "karatsuba"
+	     << setw(14) << "toom-3" << setw(14) << "dispatch" << '\n';
+	CompareMultiplyAlgorithms<8>(cout);
+	CompareMultiplyAlgorithms<16>(cout);
+	CompareMultiplyAlgorithms<24>(cout);
+	CompareMultiplyAlgorithms<32>(cout);
+	CompareMultiplyAlgorithms<48>(cout);
+	CompareMultiplyAlgorithms<64>(cout);
+	CompareMultiplyAlgorithms<128>(cout);
+	CompareMultiplyAlgorithms<256>(cout);
+	CompareMultiplyAlgorithms<512>(cout);
+	CompareMultiplyAlgorithms<1024>(cout);
+	CompareMultiplyAlgorithms<2048>(cout);
+
+	cout << "\nmodular multiplication: ns per product\n";
+	cout << setw(8) << "nbits" << setw(14) << "integer" << setw(14) << "blockbinary" << '\n';
+	MeasureMultiply<64>(cout);
+	MeasureMultiply<128>(cout);
+	MeasureMultiply<512>(cout);
+	MeasureMultiply<1024>(cout);
+	MeasureMultiply<2048>(cout);
+	MeasureMultiply<4096>(cout);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
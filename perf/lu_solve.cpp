@@ -0,0 +1,114 @@
+// lu_solve.cpp: time-to-solution of mixed-precision LU with quire-based refinement versus a posit<64,3> solve
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/lu.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+using Working = posit<64, 3>;
+
+// random matrix with a dominant element in each column, and b = A * x for x = 1, 2, ..., n
+void GenerateSystem(size_t n, std::vector<Working>& A, std::vector<Working>& b) {
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	A.resize(n * n);
+	b.resize(n);
+	for (Working& a : A) a = distribution(generator);
+	for (size_t i = 0; i < n; ++i) A[((i + 1) % n) * n + i] += Working(double(n));
+	for (size_t i = 0; i < n; ++i) {
+		quire<64, 3, 30> q;
+		for (size_t j = 0; j < n; ++j) q.mac(A[i * n + j], Working(double(j + 1)));
+		convert(q.to_value(), b[i]);
+	}
+}
+
+double LargestRelativeError(const std::vector<Working>& x) {
+	double largest = 0.0;
+	for (size_t i = 0; i < x.size(); ++i) largest = std::max(largest, std::abs(double(x[i]) - double(i + 1)) / double(i + 1));
+	return largest;
+}
+
+void Report(std::ostream& ostr, const std::string& method, double seconds, size_t iterations, double error) {
+	ostr << std::setw(28) << method << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+	     << std::setw(12) << iterations << std::setw(16) << std::scientific << std::setprecision(2) << error << '\n';
+}
+
+template<typename Low>
+void MeasureRefinedSolve(std::ostream& ostr, const std::string& method, size_t n, const std::vector<Working>& A, const std::vector<Working>& b, unsigned nrThreads) {
+	using namespace std::chrono;
+	std::vector<Working> x;
+	steady_clock::time_point begin = steady_clock::now();
+	blas::refinement_result result = blas::refined_solve<Low>(n, A, b, x, 1.0e-16, 30, nrThreads);
+	double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+	Report(ostr, method + (result.converged ? "" : " (no convergence)"), elapsed, result.iterations, LargestRelativeError(x));
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: lu_solve [matrix size, default 256] [number of threads, default all]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace std::chrono;
+	using namespace sw::unum;
+
+	size_t n = (argc > 1) ? size_t(std::stoul(argv[1])) : 256;
+	unsigned nrThreads = (argc > 2) ? unsigned(std::stoul(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<Working> A, b;
+	GenerateSystem(n, A, b);
+
+	cout << "time-to-solution of A * x = b for a " << n << " x " << n << " system with " << nrThreads << " threads\n";
+	cout << std::setw(28) << "method" << std::setw(12) << "seconds" << std::setw(12) << "refinements" << std::setw(16) << "max rel error" << '\n';
+
+	{
+		std::vector<Working> LU = A, x = b;
+		std::vector<size_t> piv;
+		steady_clock::time_point begin = steady_clock::now();
+		blas::lu(n, LU, piv, nrThreads);
+		blas::lu_solve(n, LU, piv, x, nrThreads);
+		double elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+		Report(cout, "posit<64,3> LU", elapsed, 0, LargestRelativeError(x));
+	}
+	MeasureRefinedSolve< posit<32, 2> >(cout, "posit<32,2> LU + refinement", n, A, b, nrThreads);
+	MeasureRefinedSolve< posit<16, 1> >(cout, "posit<16,1> LU + refinement", n, A, b, nrThreads);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
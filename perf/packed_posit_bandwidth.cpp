@@ -0,0 +1,131 @@
+// packed_posit_bandwidth.cpp: memory footprint and streaming bandwidth of packed posit arrays
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// the sum of the elements widened to float keeps the reduction from being optimized away
+volatile float sink;
+
+void Report(std::ostream& ostr, const std::string& header, const std::string& storage, size_t n, size_t bytes, double seconds) {
+	ostr << std::setw(14) << header << std::setw(16) << storage
+	     << std::setw(14) << std::fixed << std::setprecision(2) << double(8 * bytes) / double(n)
+	     << std::setw(12) << std::setprecision(1) << double(bytes) / 1.0e6
+	     << std::setw(12) << std::setprecision(2) << double(bytes) / seconds / 1.0e9
+	     << std::setw(14) << std::setprecision(1) << double(n) / seconds / 1.0e6 << '\n';
+}
+
+// stream the elements from a vector of posits and from a packed array, widening them to float with the same decoder
+template<size_t nbits, size_t es>
+void MeasureStreaming(std::ostream& ostr, const std::string& header, size_t n) {
+	using Posit = posit<nbits, es>;
+	std::mt19937_64 generator(nbits);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Posit> unpacked(n);
+	packed_posit_array<nbits, es> packed(n);
+	for (size_t i = 0; i < n; ++i) {
+		unpacked[i] = distribution(generator);
+		packed[i] = unpacked[i];
+	}
+
+	double seconds = MeasureSecondsPerCall([&]() {
+		float sum = 0.0f;
+		for (size_t i = 0; i < n; ++i) sum += internal::widen_encoding<float, nbits, es>(unpacked[i].encoding());
+		sink = sum;
+	});
+	Report(ostr, header, "vector<posit>", n, n * sizeof(Posit), seconds);
+
+	seconds = MeasureSecondsPerCall([&]() {
+		constexpr size_t block = 1024;
+		float values[block];
+		float sum = 0.0f;
+		for (size_t first = 0; first < n; first += block) {
+			size_t count = std::min(block, n - first);
+			packed.unpack(first, count, values);
+			for (size_t i = 0; i < count; ++i) sum += values[i];
+		}
+		sink = sum;
+	});
+	Report(ostr, header, "packed", n, packed.bytes(), seconds);
+
+	seconds = MeasureSecondsPerCall([&]() {
+		constexpr size_t block = 1024;
+		typename packed_posit_array<nbits, es>::lane_type lanes[block];
+		uint64_t sum = 0;
+		for (size_t first = 0; first < n; first += block) {
+			size_t count = std::min(block, n - first);
+			packed.unpack(first, count, lanes);
+			for (size_t i = 0; i < count; ++i) sum += lanes[i];
+		}
+		sink = float(sum);
+	});
+	Report(ostr, header, "packed lanes", n, packed.bytes(), seconds);
+}
+
+void MeasureFloatStreaming(std::ostream& ostr, size_t n) {
+	std::vector<float> values(n, 0.5f);
+	double seconds = MeasureSecondsPerCall([&]() {
+		float sum = 0.0f;
+		for (size_t i = 0; i < n; ++i) sum += values[i];
+		sink = sum;
+	});
+	Report(ostr, "float", "vector<float>", n, n * sizeof(float), seconds);
+}
+
+} // namespace unum
+} // namespace sw
+
+// usage: packed_posit_bandwidth [number of elements, default 4M]
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	size_t n = (argc > 1) ? size_t(std::stoul(argv[1])) : (size_t(1) << 22);
+
+	cout << "streaming " << n << " posits widened to float: bandwidth of the storage read\n";
+	cout << setw(14) << "type" << setw(16) << "storage" << setw(14) << "bits/element"
+	     << setw(12) << "MB" << setw(12) << "GB/s" << setw(14) << "Melements/s" << '\n';
+	MeasureFloatStreaming(cout, n);
+	MeasureStreaming< 8, 0>(cout, "posit<8,0>", n);
+	MeasureStreaming<10, 0>(cout, "posit<10,0>", n);
+	MeasureStreaming<12, 1>(cout, "posit<12,1>", n);
+	MeasureStreaming<16, 1>(cout, "posit<16,1>", n);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
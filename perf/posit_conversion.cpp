@@ -0,0 +1,55 @@
+// posit_conversion.cpp: bandwidth of the bulk conversions between IEEE-754 arrays and posit arrays
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations that have vectorized conversion kernels
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: compile the vectorized kernels of the array conversions, the host decides at run time
+#if !defined(POSIT_ARRAY_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define POSIT_ARRAY_SIMD 1
+#endif
+#include <universal/posit/posit>
+#include "posit_performance.hpp"
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << "host SIMD instruction set: " << to_string(host_simd_isa()) << endl;
+	CompareArrayConversions<16, 1>(cout, "posit<16,1>");
+	CompareArrayConversions<32, 2>(cout, "posit<32,2>");
+	CompareArrayConversions<8, 0>(cout, "posit<8,0>");
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -11,6 +11,8 @@
 #include <random>
 #include <limits>
 #include <chrono>
+#include <thread>
+#include <algorithm>
 
 namespace sw {
 namespace unum {
@@ -519,6 +521,147 @@ namespace unum {
 		report.div = float((positives + negatives) / elapsed);
 	}
 
+	// throughput of an array operator, in operations per second
+	template<typename ArrayOperator>
+	float MeasureArrayThroughput(size_t n, ArrayOperator op) {
+		constexpr int NR_REPETITIONS = 100;
+		using namespace std::chrono;
+		steady_clock::time_point begin = steady_clock::now();
+		for (int r = 0; r < NR_REPETITIONS; ++r) op();
+		steady_clock::time_point end = steady_clock::now();
+		double elapsed = duration_cast<duration<double>>(end - begin).count();
+		return float(double(n) * NR_REPETITIONS / elapsed);
+	}
+
+	// seconds per call of kernel, averaged over as many calls as fit in a tenth of a second, and at least one
+	template<typename Kernel>
+	double MeasureSecondsPerCall(Kernel kernel) {
+		using namespace std::chrono;
+		size_t nrCalls = 0;
+		steady_clock::time_point begin = steady_clock::now();
+		double elapsed = 0.0;
+		do {
+			kernel();
+			++nrCalls;
+			elapsed = duration_cast<duration<double>>(steady_clock::now() - begin).count();
+		} while (elapsed < 0.1);
+		return elapsed / double(nrCalls);
+	}
+
+	// compare the scalar operators to the vectorized kernels of the posit array operators
+	template<size_t nbits, size_t es>
+	void CompareArrayKernels(std::ostream& ostr, const std::string& header) {
+		using Posit = posit<nbits, es>;
+		const size_t n = NR_TEST_CASES;
+		std::mt19937_64 generator(nbits);
+		std::uniform_real_distribution<double> distribution(-1024.0, 1024.0);
+		std::vector<Posit> a(n), b(n), c(n);
+		for (size_t i = 0; i < n; ++i) {
+			a[i] = distribution(generator);
+			b[i] = distribution(generator);
+		}
+		Posit alpha = b[0];
+		ostr << "Array operators: " << header << '\n' << "                ";
+		for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) ostr << std::setw(FLOAT_TABLE_WIDTH) << to_string(simd_isa(level));
+		ostr << '\n';
+		const char* labels[] = { "Addition        : ", "Subtraction     : ", "Multiplication  : ", "Scale           : ", "Negation        : " };
+		for (int op = 0; op < 5; ++op) {
+			ostr << labels[op];
+			for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) {
+				simd_isa isa = simd_isa(level);
+				float pops = 0;
+				switch (op) {
+				case 0: pops = MeasureArrayThroughput(n, [&]() { array_add(a.data(), b.data(), c.data(), n, isa); }); break;
+				case 1: pops = MeasureArrayThroughput(n, [&]() { array_sub(a.data(), b.data(), c.data(), n, isa); }); break;
+				case 2: pops = MeasureArrayThroughput(n, [&]() { array_mul(a.data(), b.data(), c.data(), n, isa); }); break;
+				case 3: pops = MeasureArrayThroughput(n, [&]() { array_scale(alpha, a.data(), c.data(), n, isa); }); break;
+				case 4: pops = MeasureArrayThroughput(n, [&]() { array_negate(a.data(), c.data(), n, isa); }); break;
+				}
+				ostr << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(pops) << "POPS";
+			}
+			ostr << '\n';
+		}
+		ostr << std::endl;
+	}
+
+	// bandwidth of the bulk conversions between IEEE-754 and posit arrays, in GB/s of source plus destination bytes
+	template<size_t nbits, size_t es>
+	void CompareArrayConversions(std::ostream& ostr, const std::string& header) {
+		using Posit = posit<nbits, es>;
+		const size_t n = NR_TEST_CASES;
+		std::mt19937_64 generator(nbits);
+		std::uniform_real_distribution<double> distribution(-1024.0, 1024.0);
+		std::vector<float> f(n);
+		std::vector<double> d(n);
+		std::vector<Posit> p(n);
+		for (size_t i = 0; i < n; ++i) {
+			d[i] = distribution(generator);
+			f[i] = float(d[i]);
+		}
+		ostr << "Array conversions: " << header << '\n' << "                ";
+		for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) ostr << std::setw(FLOAT_TABLE_WIDTH) << to_string(simd_isa(level));
+		ostr << '\n';
+		const char* labels[] = { "float  -> posit : ", "double -> posit : ", "posit  -> float : ", "posit  -> double: " };
+		const size_t bytes[] = { sizeof(float), sizeof(double), sizeof(float), sizeof(double) };
+		std::ios_base::fmtflags flags = ostr.flags();
+		std::streamsize precision = ostr.precision();
+		for (int op = 0; op < 4; ++op) {
+			ostr << labels[op];
+			for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) {
+				simd_isa isa = simd_isa(level);
+				float elements = 0;
+				switch (op) {
+				case 0: elements = MeasureArrayThroughput(n, [&]() { to_posit(f.data(), p.data(), n, isa); }); break;
+				case 1: elements = MeasureArrayThroughput(n, [&]() { to_posit(d.data(), p.data(), n, isa); }); break;
+				case 2: elements = MeasureArrayThroughput(n, [&]() { to_float(p.data(), f.data(), n, isa); }); break;
+				case 3: elements = MeasureArrayThroughput(n, [&]() { to_double(p.data(), d.data(), n, isa); }); break;
+				}
+				float bandwidth = elements * float(bytes[op] + sizeof(Posit)) / 1.0e9f;
+				ostr << std::setw(FLOAT_TABLE_WIDTH - 5) << std::fixed << std::setprecision(2) << bandwidth << " GB/s";
+			}
+			ostr << '\n';
+		}
+		ostr << std::endl;
+		ostr.flags(flags);
+		ostr.precision(precision);
+	}
+
+	// accumulation rate of the quire: the products are generated up front to isolate the quire from the multiplier
+	template<size_t nbits, size_t es, size_t capacity>
+	void MeasureQuireAccumulation(std::ostream& ostr, const std::string& header) {
+		using Posit = posit<nbits, es>;
+		const size_t n = NR_TEST_CASES / 10;
+		std::mt19937_64 generator(nbits);
+		std::uniform_real_distribution<double> distribution(-1024.0, 1024.0);
+		std::vector<Posit> a(n), b(n);
+		std::vector< value<2 * (nbits - 2 - es)> > products(n);
+		for (size_t i = 0; i < n; ++i) {
+			a[i] = distribution(generator);
+			b[i] = distribution(generator);
+			products[i] = quire_mul(a[i], b[i]);
+		}
+		quire<nbits, es, capacity> q;
+		float accumulate = MeasureArrayThroughput(n, [&]() { for (size_t i = 0; i < n; ++i) q += products[i]; });
+		float fused = MeasureArrayThroughput(n, [&]() { for (size_t i = 0; i < n; ++i) q += quire_mul(a[i], b[i]); });
+		float mac = MeasureArrayThroughput(n, [&]() { for (size_t i = 0; i < n; ++i) q.mac(a[i], b[i]); });
+		Posit sum;
+		float dot = MeasureArrayThroughput(n, [&]() { sum = fdp(a, b); });
+		std::vector<Posit> pa(n * 10), pb(n * 10);
+		for (size_t i = 0; i < pa.size(); ++i) {
+			pa[i] = a[i % n];
+			pb[i] = b[i % n];
+		}
+		unsigned nrThreads = std::max(1u, std::thread::hardware_concurrency());
+		float parallel_dot = MeasureArrayThroughput(pa.size(), [&]() { sum = fdp_parallel(pa, pb, nrThreads); });
+		ostr << "Quire accumulation: " << header << '\n';
+		ostr << "q += product        : " << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(accumulate) << "ACC/s" << '\n';
+		ostr << "q += quire_mul(a, b): " << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(fused) << "ACC/s" << '\n';
+		ostr << "q.mac(a, b)         : " << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(mac) << "ACC/s" << '\n';
+		ostr << "fdp(a, b)           : " << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(dot) << "ACC/s" << '\n';
+		ostr << "fdp_parallel(a, b)  : " << std::setw(FLOAT_TABLE_WIDTH - 4) << to_scientific(parallel_dot) << "ACC/s with " << nrThreads << " threads" << '\n';
+		ostr << "(quire sign " << q.sign() << ", fdp " << sum << ")\n" << std::endl;
+	}
+
 } // namespace unum
 } // namespace sw
 
@@ -0,0 +1,109 @@
+// reductions.cpp: time and accuracy of naive, Kahan, pairwise, and exact sums of posit and IEEE vectors
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/reductions.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// time per element and relative error against the exact sum of an ill-conditioned vector: values of both signs
+// with magnitudes spread over 2^-20 to 2^20, where the large terms cancel and the sum is much smaller than the terms
+template<typename Scalar>
+void CompareSums(std::ostream& ostr, const std::string& header, size_t n) {
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(-20, 20);
+	std::vector<Scalar> x(n);
+	for (auto& e : x) e = Scalar(std::ldexp(distribution(generator), exponent(generator)));
+	double exact = double(blas::sum(x, 1));
+	Scalar result(0);
+	auto error = [&]() { return std::abs(double(result) - exact) / std::abs(exact); };
+
+	double naive = MeasureSecondsPerCall([&]() {
+		Scalar sum(0);
+		for (size_t i = 0; i < n; ++i) sum += x[i];
+		result = sum;
+	});
+	double naiveError = error();
+	double kahan = MeasureSecondsPerCall([&]() {
+		Scalar sum(0), compensation(0);
+		for (size_t i = 0; i < n; ++i) {
+			Scalar y = x[i] - compensation;
+			Scalar t = sum + y;
+			compensation = (t - sum) - y;
+			sum = t;
+		}
+		result = sum;
+	});
+	double kahanError = error();
+	double pairwise = MeasureSecondsPerCall([&]() {
+		result = blas::internal::pairwise_reduce<Scalar>(n, 1, [&](size_t i) { return x[i]; });
+	});
+	double pairwiseError = error();
+	double exact1 = MeasureSecondsPerCall([&]() { result = blas::sum(x, 1); });
+	double exactN = MeasureSecondsPerCall([&]() { result = blas::sum(x); });
+	double exactError = error();
+
+	double ns = 1.0e9 / double(n);
+	ostr << std::setw(14) << header << std::fixed << std::setprecision(1)
+	     << std::setw(10) << naive * ns << std::setw(10) << kahan * ns << std::setw(10) << pairwise * ns
+	     << std::setw(10) << exact1 * ns << std::setw(10) << exactN * ns
+	     << std::scientific << std::setprecision(2)
+	     << std::setw(12) << naiveError << std::setw(12) << kahanError << std::setw(12) << pairwiseError << std::setw(12) << exactError << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	const size_t n = 100000;
+	cout << "sum of " << n << " ill-conditioned elements: ns per element and relative error against the exact sum\n";
+	cout << "exact: per-thread quires merged exactly, on 1 thread and on all hardware threads\n";
+	cout << setw(14) << "type" << setw(10) << "naive" << setw(10) << "Kahan" << setw(10) << "pairwise" << setw(10) << "exact 1" << setw(10) << "exact N"
+	     << setw(12) << "naive err" << setw(12) << "Kahan err" << setw(12) << "pairw err" << setw(12) << "exact err" << '\n';
+	CompareSums<float>(cout, "float", n);
+	CompareSums<double>(cout, "double", n);
+	CompareSums< posit<32, 2> >(cout, "posit<32,2>", n);
+	CompareSums< posit<16, 1> >(cout, "posit<16,1>", n);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
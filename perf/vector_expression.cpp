@@ -0,0 +1,108 @@
+// vector_expression.cpp: passes, time, and rounding error of y = a*x + b*z with temporaries, loops, and expression templates
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/posit/posit>
+#include <universal/blas/vector.hpp>
+#include "posit_performance.hpp"
+
+namespace sw {
+namespace unum {
+
+// time per element and maximum error in units of the result magnitude of y = a * x + b * z - x * w, computed
+// in separate passes with temporary vectors, in one hand-written loop, and as a rounded and a fused expression
+template<typename Scalar>
+void CompareVectorExpressions(std::ostream& ostr, const std::string& header, size_t n) {
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	blas::vector<Scalar> x(n), z(n), w(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = Scalar(distribution(generator));
+		z[i] = Scalar(distribution(generator));
+		w[i] = Scalar(distribution(generator));
+	}
+	Scalar a(0.7), b(-1.3);
+	std::vector<double> exact(n);
+	for (size_t i = 0; i < n; ++i) exact[i] = double(a) * double(x[i]) + double(b) * double(z[i]) - double(x[i]) * double(w[i]);
+	auto maxError = [&]() {
+		double error = 0.0;
+		for (size_t i = 0; i < n; ++i) error = std::max(error, std::abs(double(y[i]) - exact[i]));
+		return error;
+	};
+
+	std::vector<Scalar> t1(n), t2(n), t3(n);
+	double temporaries = MeasureSecondsPerCall([&]() {
+		for (size_t i = 0; i < n; ++i) t1[i] = a * x[i];
+		for (size_t i = 0; i < n; ++i) t2[i] = b * z[i];
+		for (size_t i = 0; i < n; ++i) t3[i] = x[i] * w[i];
+		for (size_t i = 0; i < n; ++i) t1[i] = t1[i] + t2[i];
+		for (size_t i = 0; i < n; ++i) y[i] = t1[i] - t3[i];
+	});
+	double loop = MeasureSecondsPerCall([&]() {
+		for (size_t i = 0; i < n; ++i) y[i] = a * x[i] + b * z[i] - x[i] * w[i];
+	});
+	double loopError = maxError();
+	double rounded = MeasureSecondsPerCall([&]() { y.assign(a * x + b * z - x * w, blas::accumulation::rounded, 1); });
+	double roundedError = maxError();
+	double fused = MeasureSecondsPerCall([&]() { y.assign(a * x + b * z - x * w, blas::accumulation::fused, 1); });
+	double fusedError = maxError();
+
+	double ns = 1.0e9 / double(n);
+	ostr << std::setw(14) << header << std::fixed << std::setprecision(1)
+	     << std::setw(14) << temporaries * ns << std::setw(10) << loop * ns << std::setw(10) << rounded * ns << std::setw(10) << fused * ns
+	     << std::scientific << std::setprecision(2)
+	     << std::setw(12) << loopError << std::setw(12) << roundedError << std::setw(12) << fusedError << '\n';
+}
+
+} // namespace unum
+} // namespace sw
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	const size_t n = 100000;
+	cout << "y = a*x + b*z - x*w on " << n << " elements: ns per element and maximum absolute error\n";
+	cout << "temporaries: five passes over memory with three temporary vectors, loop: one hand-written pass\n";
+	cout << setw(14) << "type" << setw(14) << "temporaries" << setw(10) << "loop" << setw(10) << "rounded" << setw(10) << "fused"
+	     << setw(12) << "loop err" << setw(12) << "rounded err" << setw(12) << "fused err" << '\n';
+	CompareVectorExpressions<float>(cout, "float", n);
+	CompareVectorExpressions< posit<32, 2> >(cout, "posit<32,2>", n);
+	CompareVectorExpressions< posit<16, 1> >(cout, "posit<16,1>", n);
+	CompareVectorExpressions< posit<16, 2> >(cout, "posit<16,2>", n);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,169 @@
+// rounding.cpp: functional tests for the round to nearest even of a fraction into an arbitrary real
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/native/bit_functions.hpp>
+#include <universal/posit/exceptions.hpp>
+#include <universal/posit/trace_constants.hpp>
+#include <universal/bitblock/bitblock.hpp>
+#include <universal/areal/areal.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// report the areal that convert_ produced against the expected scale and fraction
+template<size_t nbits, size_t es, size_t fbits>
+int CompareRounding(bool sign, int scale, const bitblock<fbits>& fraction, int refScale, const bitblock<nbits - es - 1>& refFraction, bool bReportIndividualTestCases) {
+	areal<nbits, es> r;
+	convert_(sign, scale, fraction, r);
+	if (r.sign() != sign || r.scale() != refScale || r.get_fraction() != refFraction) {
+		if (bReportIndividualTestCases) {
+			std::cout << "FAIL areal<" << nbits << "," << es << "> scale " << scale << " fraction " << fraction
+				<< " : scale " << r.scale() << " fraction " << r.get_fraction()
+				<< " vs reference scale " << refScale << " fraction " << refFraction << std::endl;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+// reference: the value 1.fraction is exact in a double, and nearbyint rounds it to afbits fraction bits,
+// to nearest with ties to even in the default rounding mode
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyRoundingAgainstDouble(bool sign, int scale, const bitblock<fbits>& fraction, bool bReportIndividualTestCases) {
+	constexpr size_t afbits = nbits - es - 1;
+	static_assert(fbits <= 52 && afbits <= 52, "the reference requires the fractions to be exact in a double");
+	double significand = 1.0;
+	for (size_t i = 0; i < fbits; ++i) {
+		if (fraction.test(i)) significand += std::ldexp(1.0, int(i) - int(fbits));
+	}
+	uint64_t rounded = uint64_t(std::nearbyint(std::ldexp(significand, int(afbits))));
+	int refScale = scale;
+	if (rounded == (uint64_t(1) << (afbits + 1))) {
+		++refScale;
+		rounded = uint64_t(1) << afbits;
+	}
+	bitblock<afbits> refFraction;
+	for (size_t i = 0; i < afbits; ++i) refFraction.set(i, (rounded >> i) & 1);
+	return CompareRounding<nbits, es, fbits>(sign, scale, fraction, refScale, refFraction, bReportIndividualTestCases);
+}
+
+// reference for fractions wider than a double: truncate, and increment the bitblock when the rounding bit
+// is set and either a bit after it is set or the last bit kept is odd
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyRoundingAgainstBitblock(bool sign, int scale, const bitblock<fbits>& fraction, bool bReportIndividualTestCases) {
+	constexpr size_t afbits = nbits - es - 1;
+	static_assert(fbits > afbits, "the reference rounds away fraction bits");
+	bitblock<afbits> refFraction;
+	for (size_t i = 0; i < afbits; ++i) refFraction.set(i, fraction.test(fbits - afbits + i));
+	bool round = fraction.test(fbits - afbits - 1);
+	bool sticky = anyAfter(fraction, int(fbits - afbits) - 2);
+	int refScale = scale;
+	if (round && (sticky || refFraction.test(0))) {
+		if (increment_bitset(refFraction)) ++refScale;   // carry out of the fraction: the fraction wraps to zero
+	}
+	return CompareRounding<nbits, es, fbits>(sign, scale, fraction, refScale, refFraction, bReportIndividualTestCases);
+}
+
+// select the reference: a double for fractions that fit, the bitblock reference for wider fractions
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyRounding(bool sign, int scale, const bitblock<fbits>& fraction, bool bReportIndividualTestCases, std::false_type) {
+	return VerifyRoundingAgainstDouble<nbits, es, fbits>(sign, scale, fraction, bReportIndividualTestCases);
+}
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyRounding(bool sign, int scale, const bitblock<fbits>& fraction, bool bReportIndividualTestCases, std::true_type) {
+	return VerifyRoundingAgainstBitblock<nbits, es, fbits>(sign, scale, fraction, bReportIndividualTestCases);
+}
+
+// all fraction patterns of fbits bits
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyRoundingExhaustively(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	bitblock<fbits> fraction;
+	for (uint64_t f = 0; f < (uint64_t(1) << fbits); ++f) {
+		fraction.setblock(0, f);
+		nrOfFailedTests += VerifyRoundingAgainstDouble<nbits, es, fbits>((f & 1) != 0, int(f % 7) - 3, fraction, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// random fraction patterns of fbits bits, a quarter of them with trailing zeros to reach the ties
+template<size_t nbits, size_t es, size_t fbits, bool wide>
+int VerifyRoundingRandomly(size_t nrRandoms, bool bReportIndividualTestCases) {
+	std::mt19937_64 generator(nbits + fbits);
+	int nrOfFailedTests = 0;
+	bitblock<fbits> fraction;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		for (size_t i = 0; i < bitblock<fbits>::nrBlocks; ++i) fraction.setblock(i, generator());
+		if (n % 4 == 0) {
+			size_t zeros = size_t(generator() % fbits);
+			for (size_t i = 0; i < zeros; ++i) fraction.reset(i);
+		}
+		bool sign = (generator() & 1) != 0;
+		int scale = int(generator() % 64) - 32;
+		nrOfFailedTests += VerifyRounding<nbits, es, fbits>(sign, scale, fraction, bReportIndividualTestCases, std::integral_constant<bool, wide>());
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::unum
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<8, 2, 9>(true), "areal<8,2>", "rounding");
+
+#else
+
+	cout << "Arbitrary Real rounding validation" << endl;
+
+	// exhaustive: fractions shorter than, as long as, and longer than the fraction of the areal
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<8, 2, 3>(bReportIndividualTestCases), "areal<8,2>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<8, 2, 5>(bReportIndividualTestCases), "areal<8,2>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<8, 2, 9>(bReportIndividualTestCases), "areal<8,2>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<16, 5, 16>(bReportIndividualTestCases), "areal<16,5>", "rounding");
+
+	// random: the fraction of the areal within one limb, across two limbs, and wider than a double
+	nrOfFailedTestCases += ReportTestResult((VerifyRoundingRandomly<32, 8, 40, false>(100000, bReportIndividualTestCases)), "areal<32,8>", "rounding");
+	nrOfFailedTestCases += ReportTestResult((VerifyRoundingRandomly<64, 11, 52, false>(100000, bReportIndividualTestCases)), "areal<64,11>", "rounding");
+	nrOfFailedTestCases += ReportTestResult((VerifyRoundingRandomly<64, 11, 100, true>(100000, bReportIndividualTestCases)), "areal<64,11>", "rounding");
+	nrOfFailedTestCases += ReportTestResult((VerifyRoundingRandomly<128, 15, 200, true>(100000, bReportIndividualTestCases)), "areal<128,15>", "rounding");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundingExhaustively<32, 8, 26>(bReportIndividualTestCases), "areal<32,8>", "rounding");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -8,6 +8,8 @@
 // test helpers, such as, ReportTestResults
 #include "../utils/test_helpers.hpp"
 #include "bitblock_test_helpers.hpp"
+#include <random>
+#include <algorithm>
 
 int Conversions() {
 	using namespace sw::unum;
@@ -108,6 +110,163 @@ int VerifyCopyInto(bool bReportIndividualTestCases = false) {
 	return nrOfFailedTestCases;
 }
 
+// random operands with long runs of ones and zeros, so carries and borrows ripple across blocks
+template<size_t nbits>
+sw::unum::bitblock<nbits> RandomBits(std::mt19937_64& generator) {
+	sw::unum::bitblock<nbits> bits;
+	bool run = generator() & 1;
+	for (size_t i = 0; i < nbits; ++i) {
+		if (generator() % 16 == 0) run = !run;
+		bits[i] = (generator() % 8 == 0) ? !run : run;
+	}
+	return bits;
+}
+
+// the block operators against bit-serial references
+template<size_t nbits>
+int VerifyMultiBlockArithmetic(bool bReportIndividualTestCases, int nrRandoms) {
+	using namespace sw::unum;
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTestCases = 0;
+	for (int r = 0; r < nrRandoms; ++r) {
+		bitblock<nbits> a = RandomBits<nbits>(generator), b = RandomBits<nbits>(generator);
+
+		bitblock<nbits + 1> sum, dif, refSum, refDif;
+		bool carry = false, borrow = false;
+		for (size_t i = 0; i < nbits; ++i) {
+			refSum[i] = a[i] ^ b[i] ^ carry;
+			carry = (a[i] && b[i]) || (carry && a[i] != b[i]);
+			refDif[i] = a[i] ^ b[i] ^ borrow;
+			borrow = (!a[i] && b[i]) || (a[i] == b[i] && borrow);
+		}
+		refSum[nbits] = carry;
+		refDif[nbits] = borrow;
+		if (add_unsigned(a, b, sum) != carry || sum != refSum) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " + " << b << " = " << sum << " reference " << refSum << std::endl;
+		}
+		if (subtract_unsigned(a, b, dif) != borrow || dif != refDif) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " - " << b << " = " << dif << " reference " << refDif << std::endl;
+		}
+
+		// accumulate leaves the bits above the addend alone
+		bitblock<nbits + 7> accumulator = RandomBits<nbits + 7>(generator), refAccumulator = accumulator;
+		for (size_t i = 0; i < nbits; ++i) refAccumulator[i] = refSum[i];
+		for (size_t i = 0; i < nbits; ++i) accumulator[i] = b[i];
+		if (accumulate(a, accumulator) != bool(refSum[nbits]) || accumulator != refAccumulator) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: accumulate " << a << " into " << b << std::endl;
+		}
+
+		// b + (-b) is zero modulo 2^nbits
+		bitblock<nbits + 1> total;
+		add_unsigned(b, twos_complement(b), total);
+		total.reset(nbits);
+		if (total.any()) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: two's complement of " << b << std::endl;
+		}
+
+		bool less = false;
+		for (size_t i = nbits; i-- > 0; ) {
+			if (a[i] != b[i]) { less = b[i]; break; }
+		}
+		if ((a < b) != less || (a > b) != (!less && a != b) || (a <= b) != (less || a == b)) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: comparison of " << a << " and " << b << std::endl;
+		}
+
+		size_t shift = generator() % (nbits + 2);
+		bitblock<nbits> left = a << shift, right = a >> shift, refLeft, refRight;
+		for (size_t i = 0; i < nbits; ++i) {
+			if (i >= shift) refLeft[i] = a[i - shift];
+			if (i + shift < nbits) refRight[i] = a[i + shift];
+		}
+		if (left != refLeft || right != refRight) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: shifts of " << a << " by " << shift << std::endl;
+		}
+
+		int msb = -1;
+		for (size_t i = 0; i < nbits; ++i) if (right[i]) msb = int(i);
+		std::string digits = right.to_string();
+		if (findMostSignificantBit(right) != msb || right.count() != size_t(std::count(digits.begin(), digits.end(), '1'))) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: most significant bit of " << right << std::endl;
+		}
+	}
+	// increment and decrement ripple through all blocks
+	bitblock<nbits> ones;
+	ones.set();
+	if (!increment_bitset(ones) || ones.any() || !decrement_bitset(ones) || !ones.all()) {
+		++nrOfFailedTestCases;
+		if (bReportIndividualTestCases) std::cout << "FAIL: increment and decrement of all ones" << std::endl;
+	}
+	return nrOfFailedTestCases;
+}
+
+// multiply and divide against a shift-and-add reference product and the defining inequalities of the quotients
+template<size_t nbits>
+int VerifyMultiBlockMultiplyDivide(bool bReportIndividualTestCases, int nrRandoms) {
+	using namespace sw::unum;
+	constexpr size_t result_size = 2 * nbits + 3;
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTestCases = 0;
+	for (int r = 0; r < nrRandoms; ++r) {
+		bitblock<nbits> a = RandomBits<nbits>(generator), b = RandomBits<nbits>(generator);
+		b >>= generator() % nbits;   // divisors of all lengths, down to a single block
+		b.set(0);
+
+		bitblock<2 * nbits> product, refProduct, addend;
+		for (size_t i = 0; i < nbits; ++i) {
+			if (a[i]) {
+				copy_into<nbits, 2 * nbits>(b, i, addend);
+				accumulate(addend, refProduct);
+			}
+		}
+		multiply_unsigned(a, b, product);
+		if (product != refProduct) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " * " << b << " = " << product << " reference " << refProduct << std::endl;
+		}
+
+		// q = floor(a / b) satisfies q * b <= a < q * b + b, and has no more than nbits significant bits
+		bitblock<2 * nbits> quotient;
+		integer_divide_unsigned(a, b, quotient);
+		bitblock<nbits> q;
+		for (size_t i = 0; i < nbits; ++i) q[i] = quotient[i];
+		bitblock<2 * nbits> lower, divisor;
+		bitblock<2 * nbits + 1> lowerBound, upperBound, dividend;
+		multiply_unsigned(q, b, lower);
+		copy_into<nbits, 2 * nbits>(b, 0, divisor);
+		add_unsigned(lower, divisor, upperBound);
+		copy_into<2 * nbits, 2 * nbits + 1>(lower, 0, lowerBound);
+		copy_into<nbits, 2 * nbits + 1>(a, 0, dividend);
+		if (findMostSignificantBit(quotient) >= int(nbits) || lowerBound > dividend || upperBound <= dividend) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " / " << b << " = " << quotient << std::endl;
+		}
+
+		// the fraction quotient q = floor(a * 2^(result_size - nbits) / b) satisfies q * b <= a * 2^(result_size - nbits) < q * b + b
+		bitblock<result_size> fraction, fractionDivisor;
+		divide_with_fraction(a, b, fraction);
+		copy_into<nbits, result_size>(b, 0, fractionDivisor);
+		bitblock<2 * result_size> fractionLower, wideDivisor;
+		bitblock<2 * result_size + 1> fractionLowerBound, fractionUpperBound, scaledDividend;
+		multiply_unsigned(fraction, fractionDivisor, fractionLower);
+		copy_into<nbits, 2 * result_size>(b, 0, wideDivisor);
+		add_unsigned(fractionLower, wideDivisor, fractionUpperBound);
+		copy_into<2 * result_size, 2 * result_size + 1>(fractionLower, 0, fractionLowerBound);
+		copy_into<nbits, 2 * result_size + 1>(a, result_size - nbits, scaledDividend);
+		if (fractionLowerBound > scaledDividend || fractionUpperBound <= scaledDividend) {
+			++nrOfFailedTestCases;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " / " << b << " = " << fraction << " with fraction" << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -189,6 +348,13 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetSubtraction<7>(bReportIndividualTestCases), "bitblock<7>", "-");
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetSubtraction<8>(bReportIndividualTestCases), "bitblock<8>", "-");
 
+	cout << "Arithmetic: multi-block operands" << endl;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockArithmetic<63>(bReportIndividualTestCases, 1000), "bitblock<63>", "block arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockArithmetic<64>(bReportIndividualTestCases, 1000), "bitblock<64>", "block arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockArithmetic<65>(bReportIndividualTestCases, 1000), "bitblock<65>", "block arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockArithmetic<128>(bReportIndividualTestCases, 1000), "bitblock<128>", "block arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockArithmetic<200>(bReportIndividualTestCases, 1000), "bitblock<200>", "block arithmetic");
+
 	cout << "Arithmetic: multiplication" << endl;
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetMultiplication<3>(bReportIndividualTestCases), "bitblock<3>", "*");
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetMultiplication<4>(bReportIndividualTestCases), "bitblock<4>", "*");
@@ -217,6 +383,14 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetDivision<7>(bReportIndividualTestCases), "bitblock<7>", "/");
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetDivision<8>(bReportIndividualTestCases), "bitblock<8>", "/");
 
+	cout << "Arithmetic: multi-block multiplication and division" << endl;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<63>(bReportIndividualTestCases, 500), "bitblock<63>", "* /");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<64>(bReportIndividualTestCases, 500), "bitblock<64>", "* /");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<65>(bReportIndividualTestCases, 500), "bitblock<65>", "* /");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<128>(bReportIndividualTestCases, 500), "bitblock<128>", "* /");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<200>(bReportIndividualTestCases, 500), "bitblock<200>", "* /");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiBlockMultiplyDivide<2100>(bReportIndividualTestCases, 20), "bitblock<2100>", "* /");
+
 #if STRESS_TESTING
 
 	nrOfFailedTestCases += ReportTestResult(VerifyBitsetAddition<16>(bReportIndividualTestCases), "bitblock<8>", "+");
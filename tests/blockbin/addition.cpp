@@ -67,6 +67,44 @@ int VerifyAddition(const std::string& tag, bool bReportIndividualTestCases) {
 	return nrOfFailedTests;
 }
 
+// multi-limb uint64_t blocks against the same operands in uint32_t blocks, including full-length carry and borrow chains
+template<size_t nbits>
+int VerifyWideAddition(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << endl;
+	cout << "blockbinary<" << nbits << ",uint64_t> vs blockbinary<" << nbits << ",uint32_t>" << endl;
+
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTests = 0;
+	blockbinary<nbits, uint64_t> a, b, sum, difference;
+	blockbinary<nbits, uint32_t> aref, bref, sumref, differenceref;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		if (n == 0) { // carry across every limb: -1 + 1 and 0 - 1
+			a = -1; aref = -1;
+			b = 1; bref = 1;
+		}
+		else if (n == 1) {
+			a = 0; aref = 0;
+			b = 1; bref = 1;
+		}
+		else {
+			RandomBlockBinaryPair(generator, a, aref);
+			RandomBlockBinaryPair(generator, b, bref);
+		}
+		sum = a + b;
+		sumref = aref + bref;
+		difference = a - b;
+		differenceref = aref - bref;
+		if (to_binary(sum) != to_binary(sumref) || to_binary(difference) != to_binary(differenceref)) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) cout << "FAIL " << to_hex(a) << " +/- " << to_hex(b) << " = " << to_hex(sum) << " / " << to_hex(difference) << " vs " << to_hex(sumref) << " / " << to_hex(differenceref) << endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
 // generate specific test case that you can trace with the trace conditions in blockbinary
 // for most bugs they are traceable with _trace_conversion and _trace_add
 template<size_t nbits, typename StorageBlockType = uint8_t>
@@ -157,6 +195,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<4, uint8_t>(tag, bReportIndividualTestCases), "blockbinary<4,uint8_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<4, uint16_t>(tag, bReportIndividualTestCases), "blockbinary<4,uint16_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<4, uint32_t>(tag, bReportIndividualTestCases), "blockbinary<4,uint32_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition<4, uint64_t>(tag, bReportIndividualTestCases), "blockbinary<4,uint64_t>", "addition");
 
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<8, uint8_t>(tag, bReportIndividualTestCases), "blockbinary<8,uint8_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<8, uint16_t>(tag, bReportIndividualTestCases), "blockbinary<8,uint16_t>", "addition");
@@ -177,6 +216,12 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint8_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint8_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint16_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint16_t>", "addition");
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint32_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint32_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition<12, uint64_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint64_t>", "addition");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAddition<64>(tag, 1000, bReportIndividualTestCases), "blockbinary<64,uint64_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAddition<65>(tag, 1000, bReportIndividualTestCases), "blockbinary<65,uint64_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAddition<128>(tag, 1000, bReportIndividualTestCases), "blockbinary<128,uint64_t>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideAddition<200>(tag, 1000, bReportIndividualTestCases), "blockbinary<200,uint64_t>", "addition");
 
 #if STRESS_TESTING
 
@@ -12,6 +12,7 @@
 // test helpers, such as, ReportTestResults
 #include "../utils/test_helpers.hpp"
 #include "../utils/blockbinary_helpers.hpp"
+#include "../utils/performance_runner.hpp"
 
 // enumerate all multiplication cases for an blockbinary<nbits,BlockType> configuration
 template<size_t nbits, typename BlockType = uint8_t>
@@ -80,6 +81,110 @@ void TestMostSignificantBit() {
 	}
 }
 
+// restoring division reference: one quotient bit per shift-subtract step on the magnitudes
+template<size_t nbits, typename BlockType>
+void RestoringDivide(const sw::unum::blockbinary<nbits, BlockType>& a, const sw::unum::blockbinary<nbits, BlockType>& b, sw::unum::blockbinary<nbits, BlockType>& quotient, sw::unum::blockbinary<nbits, BlockType>& remainder) {
+	sw::unum::blockbinary<nbits + 1, BlockType> accumulator(a), subtractand(b);
+	if (a.sign()) accumulator.twoscomplement();
+	if (b.sign()) subtractand.twoscomplement();
+	quotient.clear();
+	int shift = accumulator.msb() - subtractand.msb();
+	if (shift > 0) subtractand <<= shift;
+	for (int i = shift; i >= 0; --i) {
+		if (subtractand <= accumulator) {
+			accumulator -= subtractand;
+			quotient.set(i);
+		}
+		subtractand >>= 1;
+	}
+	if (a.sign() ^ b.sign()) quotient.twoscomplement();
+	if (a.sign()) accumulator.twoscomplement();
+	remainder = accumulator;
+}
+
+// multi-limb uint64_t blocks against restoring division of the same operands in uint32_t blocks:
+// the shifted divisors cover both the single-limb and the Algorithm D paths of the limb division
+template<size_t nbits>
+int VerifyWideDivision(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << endl;
+	cout << "blockbinary<" << nbits << ",uint64_t> vs blockbinary<" << nbits << ",uint32_t>" << endl;
+
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTests = 0;
+	blockbinary<nbits, uint64_t> a, b, quotient, remainder;
+	blockbinary<nbits, uint32_t> aref, bref, quotientref, remainderref;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		RandomBlockBinaryPair(generator, a, aref);
+		RandomBlockBinaryPair(generator, b, bref);
+		// vary the divisor length so the quotients are not all 0 or -1
+		long shift = long(generator() % nbits);
+		b >>= shift;
+		bref >>= shift;
+		if (b.iszero()) continue;
+		quotient = a / b;
+		remainder = a % b;
+		RestoringDivide(aref, bref, quotientref, remainderref);
+		if (to_binary(quotient) != to_binary(quotientref) || to_binary(remainder) != to_binary(remainderref)) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) cout << "FAIL " << to_hex(a) << " / " << to_hex(b) << " = " << to_hex(quotient) << " rem " << to_hex(remainder) << " vs " << to_hex(quotientref) << " rem " << to_hex(remainderref) << endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// divide a full-width dividend by a divisor of divisorBits significant bits
+template<size_t nbits, size_t divisorBits>
+void LongDivisionWorkload(size_t NR_OPS) {
+	using namespace sw::unum;
+	std::mt19937_64 generator(nbits);
+	blockbinary<nbits, uint64_t> a, b, c;
+	for (size_t i = 0; i < a.nrBlocks; ++i) a.setblock(i, generator());
+	a.reset(nbits - 1);
+	b = a;
+	b >>= long(nbits - divisorBits);
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		c = a / b;
+		a.setblock(0, a.block(0) ^ c.block(0));
+	}
+}
+
+// the same operands through the restoring division reference
+template<size_t nbits, size_t divisorBits>
+void RestoringDivisionWorkload(size_t NR_OPS) {
+	using namespace sw::unum;
+	std::mt19937_64 generator(nbits);
+	blockbinary<nbits, uint64_t> a, b, c, r;
+	for (size_t i = 0; i < a.nrBlocks; ++i) a.setblock(i, generator());
+	a.reset(nbits - 1);
+	b = a;
+	b >>= long(nbits - divisorBits);
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		RestoringDivide(a, b, c, r);
+		a.setblock(0, a.block(0) ^ c.block(0));
+	}
+}
+
+void TestDivisionPerformance() {
+	using namespace std;
+	cout << endl << "blockbinary division performance: Algorithm D against restoring division" << endl;
+
+	constexpr size_t NR_OPS = 1024 * 32;
+	PerformanceRunner("blockbinary<64>   / 32-bit divisor   ", LongDivisionWorkload<64, 32>, NR_OPS);
+	PerformanceRunner("blockbinary<64>   restoring          ", RestoringDivisionWorkload<64, 32>, NR_OPS / 16);
+	PerformanceRunner("blockbinary<128>  / 64-bit divisor   ", LongDivisionWorkload<128, 64>, NR_OPS);
+	PerformanceRunner("blockbinary<128>  / 96-bit divisor   ", LongDivisionWorkload<128, 96>, NR_OPS);
+	PerformanceRunner("blockbinary<128>  restoring          ", RestoringDivisionWorkload<128, 96>, NR_OPS / 32);
+	PerformanceRunner("blockbinary<512>  / 64-bit divisor   ", LongDivisionWorkload<512, 64>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<512>  / 256-bit divisor  ", LongDivisionWorkload<512, 256>, NR_OPS / 4);
+	PerformanceRunner("blockbinary<512>  restoring          ", RestoringDivisionWorkload<512, 256>, NR_OPS / 256);
+	PerformanceRunner("blockbinary<2048> / 64-bit divisor   ", LongDivisionWorkload<2048, 64>, NR_OPS / 16);
+	PerformanceRunner("blockbinary<2048> / 1024-bit divisor ", LongDivisionWorkload<2048, 1024>, NR_OPS / 16);
+	PerformanceRunner("blockbinary<2048> restoring          ", RestoringDivisionWorkload<2048, 1024>, NR_OPS / 1024);
+}
+
 // generate specific test case that you can trace with the trace conditions in blockbinary
 // for most bugs they are traceable with _trace_conversion and _trace_add
 template<size_t nbits, typename BlockType = uint8_t>
@@ -155,6 +260,15 @@ try {
 
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<12, uint32_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint32_t>", "division");
 
+	nrOfFailedTestCases += ReportTestResult(VerifyDivision<12, uint64_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint64_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<64>(tag, 200, bReportIndividualTestCases), "blockbinary<64,uint64_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<128>(tag, 200, bReportIndividualTestCases), "blockbinary<128,uint64_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<200>(tag, 200, bReportIndividualTestCases), "blockbinary<200,uint64_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<512>(tag, 100, bReportIndividualTestCases), "blockbinary<512,uint64_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<2048>(tag, 20, bReportIndividualTestCases), "blockbinary<2048,uint64_t>", "division");
+
+	TestDivisionPerformance();
+
 #if STRESS_TESTING
 
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<16, uint8_t>(tag, bReportIndividualTestCases), "blockbinary<16,uint8_t>", "division");
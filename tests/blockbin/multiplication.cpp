@@ -67,6 +67,44 @@ int VerifyMultiplication(const std::string& tag, bool bReportIndividualTestCases
 	return nrOfFailedTests;
 }
 
+// shift-and-add reference for the modular product
+template<size_t nbits, typename BlockType>
+sw::unum::blockbinary<nbits, BlockType> ShiftAndAddMultiply(const sw::unum::blockbinary<nbits, BlockType>& a, sw::unum::blockbinary<nbits, BlockType> multiplicant) {
+	sw::unum::blockbinary<nbits, BlockType> product;
+	for (size_t i = 0; i < nbits; ++i) {
+		if (a.at(i)) product += multiplicant;
+		multiplicant <<= 1;
+	}
+	return product;
+}
+
+// multi-limb uint64_t blocks against shift-and-add of the same operands in uint32_t blocks:
+// the sizes cover the schoolbook, Karatsuba, and Toom-3 paths of the limb multiplication
+template<size_t nbits>
+int VerifyWideMultiplication(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	cout << endl;
+	cout << "blockbinary<" << nbits << ",uint64_t> vs blockbinary<" << nbits << ",uint32_t>" << endl;
+
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTests = 0;
+	blockbinary<nbits, uint64_t> a, b, result;
+	blockbinary<nbits, uint32_t> aref, bref, refResult;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		RandomBlockBinaryPair(generator, a, aref);
+		RandomBlockBinaryPair(generator, b, bref);
+		result = a * b;
+		refResult = ShiftAndAddMultiply(aref, bref);
+		if (to_binary(result) != to_binary(refResult)) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) cout << "FAIL " << to_hex(a) << " * " << to_hex(b) << " = " << to_hex(result) << " vs " << to_hex(refResult) << endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
 // generate specific test case that you can trace with the trace conditions blockbinary
 // for most bugs they are traceable with _trace_conversion and _trace_add
 template<size_t nbits, typename StorageBlockType = uint8_t>
@@ -206,6 +244,13 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint8_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint8>", "multiplication");
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint16_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint16>", "multiplication");
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint32_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint32>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint64_t>(tag, bReportIndividualTestCases), "blockbinary<12,uint64>", "multiplication");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<64>(tag, 200, bReportIndividualTestCases), "blockbinary<64,uint64>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<128>(tag, 200, bReportIndividualTestCases), "blockbinary<128,uint64>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<200>(tag, 200, bReportIndividualTestCases), "blockbinary<200,uint64>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<2048>(tag, 10, bReportIndividualTestCases), "blockbinary<2048,uint64>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<65536>(tag, 1, bReportIndividualTestCases), "blockbinary<65536,uint64>", "multiplication");
 
 
 
@@ -58,22 +58,27 @@ void TestBlockPerformanceOnShift() {
 	PerformanceRunner("blockbinary<64,uint8>    shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<64, uint8_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint16>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<64, uint16_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint32>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<64, uint64_t> >, NR_OPS);
 
 	PerformanceRunner("blockbinary<128,uint8>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<128, uint8_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint16>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<128, uint16_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint32>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<128, uint64_t> >, NR_OPS / 2);
 
 	PerformanceRunner("blockbinary<256,uint8>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<256, uint8_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint16>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<256, uint16_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint32>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<256, uint64_t> >, NR_OPS / 4);
 
-	PerformanceRunner("blockbinary<512,uint8>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 8);
-	PerformanceRunner("blockbinary<512,uint16>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS / 8);
-	PerformanceRunner("blockbinary<512,uint32>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint8>   shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<512, uint8_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint16>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<512, uint16_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint32>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<512, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint64>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<512, uint64_t> >, NR_OPS / 8);
 
 	PerformanceRunner("blockbinary<1024,uint8>  shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint16> shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS /16);
 	PerformanceRunner("blockbinary<1024,uint32> shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("blockbinary<1024,uint64> shifts  ", ShiftPerformanceWorkload< sw::unum::blockbinary<1024, uint64_t> >, NR_OPS / 16);
 }
 
 template<typename IntegerType>
@@ -176,18 +181,23 @@ void TestBlockPerformanceOnAdd() {
 	PerformanceRunner("blockbinary<64,uint8>     add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<64, uint8_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint16>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<64, uint16_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint32>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<64, uint64_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<128,uint8>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<128, uint8_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint16>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<128, uint16_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint32>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<128, uint64_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<256,uint8>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<256, uint8_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint16>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<256, uint16_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint32>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<256, uint64_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<512,uint8>    add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<512, uint8_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint16>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<512, uint16_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint32>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<512, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint64>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<512, uint64_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<1024,uint8>   add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint16>  add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint32>  add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("blockbinary<1024,uint64>  add   ", AdditionSubtractionWorkload< sw::unum::blockbinary<1024, uint64_t> >, NR_OPS / 16);
 }
 
 void TestBlockPerformanceOnDiv() {
@@ -205,18 +215,23 @@ void TestBlockPerformanceOnDiv() {
 	PerformanceRunner("blockbinary<64,uint8>     div   ", DivisionWorkload< sw::unum::blockbinary<64, uint8_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint16>    div   ", DivisionWorkload< sw::unum::blockbinary<64, uint16_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint32>    div   ", DivisionWorkload< sw::unum::blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>    div   ", DivisionWorkload< sw::unum::blockbinary<64, uint64_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<128,uint8>    div   ", DivisionWorkload< sw::unum::blockbinary<128, uint8_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint16>   div   ", DivisionWorkload< sw::unum::blockbinary<128, uint16_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint32>   div   ", DivisionWorkload< sw::unum::blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>   div   ", DivisionWorkload< sw::unum::blockbinary<128, uint64_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<256,uint8>    div   ", DivisionWorkload< sw::unum::blockbinary<256, uint8_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint16>   div   ", DivisionWorkload< sw::unum::blockbinary<256, uint16_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint32>   div   ", DivisionWorkload< sw::unum::blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>   div   ", DivisionWorkload< sw::unum::blockbinary<256, uint64_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<512,uint8>    div   ", DivisionWorkload< sw::unum::blockbinary<512, uint8_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint16>   div   ", DivisionWorkload< sw::unum::blockbinary<512, uint16_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint32>   div   ", DivisionWorkload< sw::unum::blockbinary<512, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint64>   div   ", DivisionWorkload< sw::unum::blockbinary<512, uint64_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<1024,uint8>   div   ", DivisionWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint16>  div   ", DivisionWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint32>  div   ", DivisionWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("blockbinary<1024,uint64>  div   ", DivisionWorkload< sw::unum::blockbinary<1024, uint64_t> >, NR_OPS / 16);
 }
 
 void TestBlockPerformanceOnRem() {
@@ -234,18 +249,23 @@ void TestBlockPerformanceOnRem() {
 	PerformanceRunner("blockbinary<64,uint8>     rem   ", RemainderWorkload< sw::unum::blockbinary<64, uint8_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint16>    rem   ", RemainderWorkload< sw::unum::blockbinary<64, uint16_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint32>    rem   ", RemainderWorkload< sw::unum::blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>    rem   ", RemainderWorkload< sw::unum::blockbinary<64, uint64_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<128,uint8>    rem   ", RemainderWorkload< sw::unum::blockbinary<128, uint8_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint16>   rem   ", RemainderWorkload< sw::unum::blockbinary<128, uint16_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint32>   rem   ", RemainderWorkload< sw::unum::blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>   rem   ", RemainderWorkload< sw::unum::blockbinary<128, uint64_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<256,uint8>    rem   ", RemainderWorkload< sw::unum::blockbinary<256, uint8_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint16>   rem   ", RemainderWorkload< sw::unum::blockbinary<256, uint16_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint32>   rem   ", RemainderWorkload< sw::unum::blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>   rem   ", RemainderWorkload< sw::unum::blockbinary<256, uint64_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<512,uint8>    rem   ", RemainderWorkload< sw::unum::blockbinary<512, uint8_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint16>   rem   ", RemainderWorkload< sw::unum::blockbinary<512, uint16_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<512,uint32>   rem   ", RemainderWorkload< sw::unum::blockbinary<512, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint64>   rem   ", RemainderWorkload< sw::unum::blockbinary<512, uint64_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<1024,uint8>   rem   ", RemainderWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint16>  rem   ", RemainderWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS / 16);
 	PerformanceRunner("blockbinary<1024,uint32>  rem   ", RemainderWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("blockbinary<1024,uint64>  rem   ", RemainderWorkload< sw::unum::blockbinary<1024, uint64_t> >, NR_OPS / 16);
 }
 
 void TestBlockPerformanceOnMul() {
@@ -263,18 +283,23 @@ void TestBlockPerformanceOnMul() {
 	PerformanceRunner("blockbinary<64,uint8>     mul   ", MultiplicationWorkload< sw::unum::blockbinary<64, uint8_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint16>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<64, uint16_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<64,uint32>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<64, uint64_t> >, NR_OPS);
 	PerformanceRunner("blockbinary<128,uint8>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<128, uint8_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint16>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<128, uint16_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<128,uint32>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<128, uint64_t> >, NR_OPS / 2);
 	PerformanceRunner("blockbinary<256,uint8>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<256, uint8_t> >, NR_OPS / 4 / 2);
 	PerformanceRunner("blockbinary<256,uint16>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<256, uint16_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<256,uint32>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<256, uint64_t> >, NR_OPS / 4);
 	PerformanceRunner("blockbinary<512,uint8>    mul   ", MultiplicationWorkload< sw::unum::blockbinary<512, uint8_t> >, NR_OPS / 8 / 4);
 	PerformanceRunner("blockbinary<512,uint16>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<512, uint16_t> >, NR_OPS / 8 / 2);
 	PerformanceRunner("blockbinary<512,uint32>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<512, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<512,uint64>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<512, uint64_t> >, NR_OPS / 8);
 	PerformanceRunner("blockbinary<1024,uint8>   mul   ", MultiplicationWorkload< sw::unum::blockbinary<1024, uint8_t> >, NR_OPS / 16 / 4);
 	PerformanceRunner("blockbinary<1024,uint16>  mul   ", MultiplicationWorkload< sw::unum::blockbinary<1024, uint16_t> >, NR_OPS / 16 / 2);
 	PerformanceRunner("blockbinary<1024,uint32>  mul   ", MultiplicationWorkload< sw::unum::blockbinary<1024, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("blockbinary<1024,uint64>  mul   ", MultiplicationWorkload< sw::unum::blockbinary<1024, uint64_t> >, NR_OPS / 16);
 
 }
 
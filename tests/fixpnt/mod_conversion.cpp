@@ -260,6 +260,16 @@ try {
 	nrOfFailedTestCases = ReportTestResult(ValidateConversion<16, 12, Modulo, uint8_t>(tag, bReportIndividualTestCases), tag, "fixpnt<16,12,Modulo,uint8_t>");
 	nrOfFailedTestCases = ReportTestResult(ValidateConversion<16, 16, Modulo, uint8_t>(tag, bReportIndividualTestCases), tag, "fixpnt<16,16,Modulo,uint8_t>");
 
+	// conversions of values below half the smallest fixpnt value, across the rounding shifts of float and double
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<4, 0, Modulo, uint8_t, float>(tag, bReportIndividualTestCases), tag, "fixpnt<4,0,Modulo,uint8_t> float underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<4, 0, Modulo, uint8_t, double>(tag, bReportIndividualTestCases), tag, "fixpnt<4,0,Modulo,uint8_t> double underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<8, 4, Modulo, uint8_t, float>(tag, bReportIndividualTestCases), tag, "fixpnt<8,4,Modulo,uint8_t> float underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<8, 4, Modulo, uint8_t, double>(tag, bReportIndividualTestCases), tag, "fixpnt<8,4,Modulo,uint8_t> double underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<12, 8, Modulo, uint8_t, float>(tag, bReportIndividualTestCases), tag, "fixpnt<12,8,Modulo,uint8_t> float underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<12, 8, Modulo, uint8_t, double>(tag, bReportIndividualTestCases), tag, "fixpnt<12,8,Modulo,uint8_t> double underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<16, 16, Modulo, uint8_t, float>(tag, bReportIndividualTestCases), tag, "fixpnt<16,16,Modulo,uint8_t> float underflow");
+	nrOfFailedTestCases += ReportTestResult(ValidateUnderflowConversion<16, 16, Modulo, uint8_t, double>(tag, bReportIndividualTestCases), tag, "fixpnt<16,16,Modulo,uint8_t> double underflow");
+
 #if STRESS_TESTING
 
 #endif  // STRESS_TESTING
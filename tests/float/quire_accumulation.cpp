@@ -9,6 +9,108 @@
 #include "universal/bitblock/bitblock.hpp"
 #include "universal/posit/value.hpp"
 #include "universal/float/quire.hpp"
+#include <random>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+namespace ieee {
+
+// the value of a quire, which is exact in a double for the dyadic test values below
+template<size_t nbits, size_t es, size_t capacity>
+double quire_to_double(const quire<nbits, es, capacity>& q) {
+	return q.iszero() ? 0.0 : q.to_value().to_double();
+}
+
+// report a quire that differs from the exact reference
+template<size_t nbits, size_t es, size_t capacity>
+int CompareQuire(const std::string& op, const quire<nbits, es, capacity>& q, double reference, bool bReportIndividualTestCases) {
+	double result = quire_to_double(q);
+	if (result != reference || (q.iszero() ? false : q.get_sign() != (reference < 0.0))) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: " << op << " quire " << result << (q.get_sign() ? " (negative)" : " (positive)") << " reference " << reference << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// values of either sign added to a quire of either sign: the magnitudes subtract when the signs differ,
+// and the quire changes sign when the value has the larger magnitude
+template<size_t nbits, size_t es>
+int VerifyMixedSignAccumulation(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	{
+		quire<nbits, es> q;
+		q += sw::unum::value<52>(1.5);
+		q += sw::unum::value<52>(-2.0);
+		nrOfFailedTests += CompareQuire("1.5 + -2", q, -0.5, bReportIndividualTestCases);
+		q += sw::unum::value<52>(0.25);
+		nrOfFailedTests += CompareQuire("-0.5 + 0.25", q, -0.25, bReportIndividualTestCases);
+		q += sw::unum::value<52>(1.0);
+		nrOfFailedTests += CompareQuire("-0.25 + 1", q, 0.75, bReportIndividualTestCases);
+		q -= sw::unum::value<52>(0.75);
+		nrOfFailedTests += CompareQuire("0.75 - 0.75", q, 0.0, bReportIndividualTestCases);
+		q += sw::unum::value<52>(-1024.0);
+		q += sw::unum::value<52>(0.0078125);
+		nrOfFailedTests += CompareQuire("-1024 + 2^-7", q, -1024.0 + 0.0078125, bReportIndividualTestCases);
+	}
+	// random dyadic values whose sums are exact in a double, with a sign change every few steps
+	std::mt19937_64 generator(nbits + es);
+	std::uniform_int_distribution<int> numerator(-(1 << 20), (1 << 20));
+	std::uniform_int_distribution<int> exponent(-12, 12);
+	quire<nbits, es> q;
+	double reference = 0.0;
+	for (int i = 0; i < 1000; ++i) {
+		double v = std::ldexp(double(numerator(generator)), exponent(generator) - 8);
+		if (i % 7 == 0) v = -2.0 * reference + v / 1024.0;   // push the sum across zero
+		if (v == 0.0) continue;
+		if (i % 3 == 0) {
+			q -= sw::unum::value<52>(-v);
+		}
+		else {
+			q += sw::unum::value<52>(v);
+		}
+		reference += v;
+		nrOfFailedTests += CompareQuire("random accumulation", q, reference, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// quires added to and subtracted from quires of either sign, including themselves
+template<size_t nbits, size_t es>
+int VerifyQuireAddition(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nbits * es);
+	std::uniform_int_distribution<int> numerator(-(1 << 20), (1 << 20));
+	std::uniform_int_distribution<int> exponent(-12, 12);
+	for (int i = 0; i < 200; ++i) {
+		quire<nbits, es> a, b;
+		double ra = 0.0, rb = 0.0;
+		for (int j = 0; j < 4; ++j) {
+			double va = std::ldexp(double(numerator(generator)), exponent(generator) - 8);
+			double vb = std::ldexp(double(numerator(generator)), exponent(generator) - 8);
+			a += sw::unum::value<52>(va);
+			b += sw::unum::value<52>(vb);
+			ra += va;
+			rb += vb;
+		}
+		quire<nbits, es> sum(a), difference(a);
+		sum += b;
+		difference -= b;
+		nrOfFailedTests += CompareQuire("quire + quire", sum, ra + rb, bReportIndividualTestCases);
+		nrOfFailedTests += CompareQuire("quire - quire", difference, ra - rb, bReportIndividualTestCases);
+		// the merge of the positive and negative partial sums of the same terms
+		sum -= b;
+		nrOfFailedTests += CompareQuire("(a + b) - b", sum, ra, bReportIndividualTestCases);
+		quire<nbits, es> twice(a);
+		twice += twice;
+		nrOfFailedTests += CompareQuire("a + a", twice, 2.0 * ra, bReportIndividualTestCases);
+		twice -= twice;
+		nrOfFailedTests += CompareQuire("2a - 2a", twice, 0.0, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::ieee
 
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -18,7 +120,7 @@ try {
 	using namespace std;
 	using namespace sw::ieee;
 
-	//bool bReportIndividualTestCases = false;
+	bool bReportIndividualTestCases = false;
 	int nrOfFailedTestCases = 0;
 
 	std::string tag = "Quire Accumulation";
@@ -28,8 +130,11 @@ try {
 #else
 
 	cout << "IEEE Floating Point Quire experiments" << endl;
-	
-	cout << "\nTBD\n";
+
+	nrOfFailedTestCases += ReportTestResult(VerifyMixedSignAccumulation<32, 8>(bReportIndividualTestCases), "quire<32,8>", "mixed sign accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyMixedSignAccumulation<64, 11>(bReportIndividualTestCases), "quire<64,11>", "mixed sign accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAddition<32, 8>(bReportIndividualTestCases), "quire<32,8>", "quire addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAddition<64, 11>(bReportIndividualTestCases), "quire<64,11>", "quire addition");
 
 #ifdef STRESS_TESTING
 
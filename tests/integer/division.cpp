@@ -5,6 +5,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
 #include <string>
+#include <random>
 // configure the integer arithmetic class
 // we need to enable exceptions to validate divide by zero and overflow conditions
 // however, we also need to make this work with exceptions turned off: TODO
@@ -207,6 +208,40 @@ void ExamplePattern() {
 	GenerateDivTest<sw::unum::integer<16> >(2, 16, z);
 }
 
+// multi-word quotients and remainders on random operands checked against a = q * b + r with 0 <= r < b,
+// and the signs of the negated operands: quotient truncates toward zero and remainder takes the sign of a
+// the operands are positive so the checks stay clear of the overflow exception of integer addition,
+// and the shifted divisors cover both the single-limb and the Algorithm D paths of the limb division
+template<size_t nbits>
+int VerifyWideDivision(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTests = 0;
+	integer<nbits> a, b, q, r;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		for (unsigned i = 0; i < integer<nbits>::nrBytes; ++i) {
+			a.setbyte(i, uint8_t(generator()));
+			b.setbyte(i, uint8_t(generator()));
+		}
+		a.reset(nbits - 1);
+		b.reset(nbits - 1);
+		b >>= int(generator() % nbits);
+		if (a == 0 || b == 0) continue;
+		q = a / b;
+		r = a % b;
+		bool fail = (q * b + r != a) || r.sign() || !(r < b);
+		if (q != 0) fail |= ((-a) / b != -q) || (a / (-b) != -q) || ((-a) / (-b) != q);
+		if (r != 0) fail |= ((-a) % b != -r) || (a % (-b) != r) || ((-a) % (-b) != -r);
+		if (fail) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) cout << "FAIL " << a << " / " << b << " = " << q << " rem " << r << endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -244,6 +279,9 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<10, uint8_t>(tag, bReportIndividualTestCases), "integer<10, uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<12, uint8_t>(tag, bReportIndividualTestCases), "integer<12, uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyDivision<12, uint16_t>(tag, bReportIndividualTestCases), "integer<12, uint16_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<128>(tag, 1000, bReportIndividualTestCases), "integer<128>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<512>(tag, 1000, bReportIndividualTestCases), "integer<512>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<2048>(tag, 100, bReportIndividualTestCases), "integer<2048>", "division");
 
 #if STRESS_TESTING
 
@@ -5,6 +5,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
 #include <string>
+#include <random>
 // configure the integer arithmetic class
 #define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/integer/integer.hpp>
@@ -37,6 +38,36 @@ void ExamplePattern() {
 	GenerateMulTest<sw::unum::integer<16> >(2, 16, z);
 }
 
+// multi-word products against a shift-and-add reference on random operands:
+// the sizes cover the schoolbook and Karatsuba paths of the limb multiplication
+template<size_t nbits>
+int VerifyWideMultiplication(const std::string& tag, size_t nrRandoms, bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	std::mt19937_64 generator(nbits);
+	int nrOfFailedTests = 0;
+	integer<nbits> a, b, result, reference, multiplicant;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		for (unsigned i = 0; i < integer<nbits>::nrBytes; ++i) {
+			a.setbyte(i, uint8_t(generator()));
+			b.setbyte(i, uint8_t(generator()));
+		}
+		result = a * b;
+		reference.clear();
+		multiplicant = b;
+		for (size_t i = 0; i < nbits; ++i) {
+			if (a.at(i)) reference += multiplicant;
+			multiplicant <<= 1;
+		}
+		if (result != reference) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) cout << "FAIL " << a << " * " << b << " = " << result << " vs " << reference << endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -75,6 +106,10 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint8_t>(tag, bReportIndividualTestCases), "integer<12, uint8_t>", "multiplication");
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<12, uint16_t>(tag, bReportIndividualTestCases), "integer<12, uint16_t>", "multiplication");
 
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<128>(tag, 100, bReportIndividualTestCases), "integer<128>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<2048>(tag, 10, bReportIndividualTestCases), "integer<2048>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<4096>(tag, 5, bReportIndividualTestCases), "integer<4096>", "multiplication");
+
 #if STRESS_TESTING
 
 	nrOfFailedTestCases += ReportTestResult(VerifyMultiplication<14, uint8_t>(tag, bReportIndividualTestCases), "integer<14, uint8_t>", "multiplication");
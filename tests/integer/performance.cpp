@@ -6,6 +6,7 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <random>
 // configure the integer arithmetic class
 #define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
 #include <universal/integer/integer.hpp>
@@ -132,6 +133,58 @@ void TestArithmeticOperatorPerformance() {
 	PerformanceRunner("integer<1024> multiplication", MultiplicationWorkload< sw::unum::integer<1024> >, NR_OPS / 32);
 }
 
+// divide a full-width dividend by a divisor of divisorBits significant bits
+template<size_t nbits, size_t divisorBits>
+void LongDivisionWorkload(size_t NR_OPS) {
+	using IntegerType = sw::unum::integer<nbits>;
+	std::mt19937_64 generator(nbits);
+	IntegerType a, b, c;
+	for (unsigned i = 0; i < IntegerType::nrBytes; ++i) a.setbyte(i, uint8_t(generator()));
+	a.reset(nbits - 1);
+	b = a;
+	b >>= int(nbits - divisorBits);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		c = a / b;
+		a.setbyte(0, a.byte(0) ^ c.byte(0));
+	}
+}
+
+// remainder of the same operands, as used by gcd and decimal conversion
+template<size_t nbits, size_t divisorBits>
+void LongRemainderWorkload(size_t NR_OPS) {
+	using IntegerType = sw::unum::integer<nbits>;
+	std::mt19937_64 generator(nbits);
+	IntegerType a, b, c;
+	for (unsigned i = 0; i < IntegerType::nrBytes; ++i) a.setbyte(i, uint8_t(generator()));
+	a.reset(nbits - 1);
+	b = a;
+	b >>= int(nbits - divisorBits);
+	for (uint64_t i = 0; i < NR_OPS; ++i) {
+		c = a % b;
+		a.setbyte(0, a.byte(0) ^ c.byte(0));
+	}
+}
+
+// test performance of long division with single-limb and multi-limb divisors
+void TestLongDivisionPerformance() {
+	using namespace std;
+	cout << endl << "Long division performance" << endl;
+
+	constexpr uint64_t NR_OPS = 1024 * 32;
+
+	PerformanceRunner("integer<64>   / 32-bit divisor   ", LongDivisionWorkload<64, 32>, NR_OPS);
+	PerformanceRunner("integer<128>  / 64-bit divisor   ", LongDivisionWorkload<128, 64>, NR_OPS);
+	PerformanceRunner("integer<128>  / 96-bit divisor   ", LongDivisionWorkload<128, 96>, NR_OPS);
+	PerformanceRunner("integer<512>  / 64-bit divisor   ", LongDivisionWorkload<512, 64>, NR_OPS / 4);
+	PerformanceRunner("integer<512>  / 256-bit divisor  ", LongDivisionWorkload<512, 256>, NR_OPS / 4);
+	PerformanceRunner("integer<2048> / 64-bit divisor   ", LongDivisionWorkload<2048, 64>, NR_OPS / 16);
+	PerformanceRunner("integer<2048> / 1024-bit divisor ", LongDivisionWorkload<2048, 1024>, NR_OPS / 16);
+	PerformanceRunner("integer<64>   % 32-bit divisor   ", LongRemainderWorkload<64, 32>, NR_OPS);
+	PerformanceRunner("integer<128>  % 96-bit divisor   ", LongRemainderWorkload<128, 96>, NR_OPS);
+	PerformanceRunner("integer<512>  % 256-bit divisor  ", LongRemainderWorkload<512, 256>, NR_OPS / 4);
+	PerformanceRunner("integer<2048> % 1024-bit divisor ", LongRemainderWorkload<2048, 1024>, NR_OPS / 16);
+}
+
 // conditional compilation
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
@@ -147,6 +200,7 @@ try {
 
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestLongDivisionPerformance();
 
 	cout << "done" << endl;
 
@@ -158,6 +212,7 @@ try {
 	   
 	TestShiftOperatorPerformance();
 	TestArithmeticOperatorPerformance();
+	TestLongDivisionPerformance();
 
 #if STRESS_TESTING
 
@@ -0,0 +1,213 @@
+// array_arithmetic.cpp: functional tests comparing the vectorized posit array operators to the scalar posit operators
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations that have vectorized kernels
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: compile the vectorized kernels independent of the USE_AVX2 build option, the host decides at run time
+#if !defined(POSIT_ARRAY_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define POSIT_ARRAY_SIMD 1
+#endif
+
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// random encodings, with the special values and the extremes of the dynamic range sprinkled in,
+// and half the b operands biased towards the magnitude of a to exercise cancellation and carries
+template<size_t nbits, size_t es>
+void GenerateOperands(std::vector< posit<nbits, es> >& a, std::vector< posit<nbits, es> >& b, size_t n) {
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_int_distribution<uint64_t> distribution;
+	const uint64_t nar = uint64_t(1) << (nbits - 1);
+	const uint64_t specials[] = { 0, nar, nar - 1, nar + 1, 1, (uint64_t(1) << nbits) - 1, nar >> 1 };
+	a.resize(n);
+	b.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t x = distribution(generator);
+		uint64_t y = distribution(generator);
+		if (i & 1) y = x + (distribution(generator) & 0xFF) - 0x80;
+		if ((i % 13) == 0) x = specials[(i / 13) % 7];
+		if ((i % 17) == 0) y = specials[(i / 17) % 7];
+		a[i].set_raw_bits(x);
+		b[i].set_raw_bits(y);
+	}
+}
+
+template<size_t nbits, size_t es>
+int CompareSpans(const std::string& op, simd_isa isa, const std::vector< posit<nbits, es> >& a, const std::vector< posit<nbits, es> >& b,
+	             const std::vector< posit<nbits, es> >& pref, const std::vector< posit<nbits, es> >& presult, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < pref.size(); ++i) {
+		if (presult[i] != pref[i]) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportBinaryArithmeticError(std::string("FAIL ") + to_string(isa), op, a[i], b[i], pref[i], presult[i]);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// run each array operator with each instruction set the host supports and compare to the scalar operators
+template<size_t nbits, size_t es>
+int VerifyArrayOperators(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::vector<Posit> a, b, pref(n), presult(n);
+	GenerateOperands(a, b, n);
+	Posit alpha = b[1];
+
+	for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) {
+		simd_isa isa = simd_isa(level);
+		for (size_t i = 0; i < n; ++i) pref[i] = a[i] + b[i];
+		array_add(a.data(), b.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("+", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		for (size_t i = 0; i < n; ++i) pref[i] = a[i] - b[i];
+		array_sub(a.data(), b.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("-", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		for (size_t i = 0; i < n; ++i) pref[i] = a[i] * b[i];
+		array_mul(a.data(), b.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("*", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		for (size_t i = 0; i < n; ++i) pref[i] = a[i] / b[i];
+		array_div(a.data(), b.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("/", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		for (size_t i = 0; i < n; ++i) pref[i] = alpha * a[i];
+		array_scale(alpha, a.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("scale", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		for (size_t i = 0; i < n; ++i) pref[i] = -a[i];
+		array_negate(a.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("negate", isa, a, b, pref, presult, bReportIndividualTestCases);
+
+		// in place
+		presult = a;
+		for (size_t i = 0; i < n; ++i) pref[i] = a[i] * b[i];
+		array_mul(presult.data(), b.data(), presult.data(), n, isa);
+		nrOfFailedTests += CompareSpans("*=", isa, a, b, pref, presult, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+// for posits with at most 8 bits, a*b+c is exact in double precision, so the double rounded to the posit is the fused result
+template<size_t nbits, size_t es>
+int VerifyArrayFma(bool bReportIndividualTestCases) {
+	static_assert(nbits <= 8, "exact double reference requires small posits");
+	using Posit = posit<nbits, es>;
+	const size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	std::vector<Posit> a, b, c, pref, presult;
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		for (size_t j = 0; j < NR_POSITS; ++j) {
+			Posit pa, pb, pc;
+			pa.set_raw_bits(i);
+			pb.set_raw_bits(j);
+			pc.set_raw_bits(i ^ (j << 1) ^ 0x5A);
+			a.push_back(pa);
+			b.push_back(pb);
+			c.push_back(pc);
+			Posit p;
+			if (pa.isnar() || pb.isnar() || pc.isnar()) {
+				p.setnar();
+			}
+			else {
+				p = double(pa) * double(pb) + double(pc);
+			}
+			pref.push_back(p);
+		}
+	}
+	array_fma(a, b, c, presult);
+	for (size_t i = 0; i < pref.size(); ++i) {
+		if (presult[i] != pref[i]) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) std::cout << "FAIL fma(" << a[i] << ", " << b[i] << ", " << c[i] << ") = " << presult[i] << " reference " << pref[i] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Posit array arithmetic validation" << endl;
+	cout << "host SIMD instruction set: " << to_string(host_simd_isa()) << ", posit array kernels use: " << to_string(posit_array_isa()) << endl;
+
+#if MANUAL_TESTING
+	posit<16, 1> a[16], b[16], c[16];
+	for (int i = 0; i < 16; ++i) {
+		a[i] = 1.0 + i / 16.0;
+		b[i] = -0.5;
+	}
+	array_add(a, b, c, 16);
+	for (int i = 0; i < 16; ++i) cout << a[i] << " + " << b[i] << " = " << c[i] << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<16, 1>(true, 100), "posit<16,1>", "array operators");
+
+#else
+
+	// odd lengths leave a remainder for the scalar loop
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<16, 1>(bReportIndividualTestCases, 100003), "posit<16,1>", "array operators");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<32, 2>(bReportIndividualTestCases, 100003), "posit<32,2>", "array operators");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<8, 0>(bReportIndividualTestCases, 1001), "posit<8,0>", "array operators");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<24, 1>(bReportIndividualTestCases, 1001), "posit<24,1>", "array operators");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayFma<6, 1>(bReportIndividualTestCases), "posit<6,1>", "array fma");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayFma<8, 0>(bReportIndividualTestCases), "posit<8,0>", "array fma");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<16, 1>(bReportIndividualTestCases, 10000019), "posit<16,1>", "array operators");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayOperators<32, 2>(bReportIndividualTestCases, 10000019), "posit<32,2>", "array operators");
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayFma<8, 1>(bReportIndividualTestCases), "posit<8,1>", "array fma");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
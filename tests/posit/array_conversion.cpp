@@ -0,0 +1,191 @@
+// array_conversion.cpp: functional tests comparing the bulk IEEE-754 to posit conversions to the scalar conversions
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations that have vectorized kernels
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: compile the vectorized kernels independent of the USE_AVX2 build option, the host decides at run time
+#if !defined(POSIT_ARRAY_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define POSIT_ARRAY_SIMD 1
+#endif
+
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace sw {
+namespace unum {
+
+// bit patterns of IEEE-754 values: random encodings cover NaNs, infinities, and subnormals,
+// and the values with an exponent around the posit dynamic range exercise the regime rounding
+template<typename Real, typename Bits>
+std::vector<Real> GenerateIeeeValues(size_t n, int max_exponent) {
+	std::mt19937_64 generator(sizeof(Real));
+	std::uniform_int_distribution<uint64_t> bits;
+	std::uniform_int_distribution<int> exponent(-max_exponent - 4, max_exponent + 4);
+	const Real specials[] = { Real(0), -Real(0), Real(1), -Real(1), Real(INFINITY), -Real(INFINITY), Real(NAN), std::numeric_limits<Real>::denorm_min() };
+	std::vector<Real> v(n);
+	for (size_t i = 0; i < n; ++i) {
+		if ((i % 3) == 0) {
+			Bits b = Bits(bits(generator));
+			std::memcpy(&v[i], &b, sizeof(Real));
+		}
+		else {
+			Real mantissa = Real(double(bits(generator) >> 11) / double(uint64_t(1) << 53));   // [0,1)
+			v[i] = std::ldexp(Real(1) + mantissa, exponent(generator)) * ((i & 4) ? -1 : 1);
+		}
+		if ((i % 101) == 0) v[i] = specials[(i / 101) % 8];
+	}
+	return v;
+}
+
+// compare the bulk conversion of IEEE-754 values to the scalar conversion, with each instruction set the host supports
+template<size_t nbits, size_t es, typename Real>
+int VerifyToPosit(const std::string& tag, bool bReportIndividualTestCases, const std::vector<Real>& v) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	size_t n = v.size();
+	std::vector<Posit> pref(n), presult(n);
+	for (size_t i = 0; i < n; ++i) pref[i] = v[i];
+	for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) {
+		simd_isa isa = simd_isa(level);
+		to_posit(v.data(), presult.data(), n, isa);
+		for (size_t i = 0; i < n; ++i) {
+			if (presult[i] != pref[i]) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << "FAIL " << to_string(isa) << " " << tag << " " << std::setprecision(17) << v[i] << " -> " << presult[i] << " reference " << pref[i] << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// compare the bulk conversion of posits to IEEE-754 values to the scalar conversion
+template<size_t nbits, size_t es, typename Real>
+int VerifyToIeee(const std::string& tag, bool bReportIndividualTestCases, const std::vector< posit<nbits, es> >& p) {
+	int nrOfFailedTests = 0;
+	size_t n = p.size();
+	std::vector<Real> vref(n), vresult(n);
+	for (size_t i = 0; i < n; ++i) vref[i] = Real(p[i]);
+	for (int level = int(simd_isa::scalar); level <= int(posit_array_isa()); ++level) {
+		simd_isa isa = simd_isa(level);
+		if (sizeof(Real) == sizeof(float)) {
+			to_float(p.data(), reinterpret_cast<float*>(vresult.data()), n, isa);
+		}
+		else {
+			to_double(p.data(), reinterpret_cast<double*>(vresult.data()), n, isa);
+		}
+		for (size_t i = 0; i < n; ++i) {
+			bool match = (std::isnan(vref[i]) ? std::isnan(vresult[i]) : std::memcmp(&vref[i], &vresult[i], sizeof(Real)) == 0);
+			if (!match) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) std::cout << "FAIL " << to_string(isa) << " " << tag << " " << p[i] << " -> " << std::setprecision(17) << vresult[i] << " reference " << vref[i] << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// all encodings for small posits, random encodings with the special values sprinkled in for the others
+template<size_t nbits, size_t es>
+std::vector< posit<nbits, es> > GeneratePositValues(size_t n) {
+	std::mt19937_64 generator(nbits);
+	std::uniform_int_distribution<uint64_t> distribution;
+	std::vector< posit<nbits, es> > p(n);
+	for (size_t i = 0; i < n; ++i) {
+		p[i].set_raw_bits(nbits <= 16 ? uint64_t(i) : distribution(generator));
+		if ((i % 101) == 0) p[i].set_raw_bits((i & 1) ? (uint64_t(1) << (nbits - 1)) : 0);
+	}
+	return p;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Posit array conversion validation" << endl;
+	cout << "host SIMD instruction set: " << to_string(host_simd_isa()) << ", posit array kernels use: " << to_string(posit_array_isa()) << endl;
+
+#if MANUAL_TESTING
+	float f[16];
+	posit<16, 1> p[16];
+	for (int i = 0; i < 16; ++i) f[i] = 1.0f + i / 16.0f;
+	to_posit(f, p, 16);
+	for (int i = 0; i < 16; ++i) cout << f[i] << " -> " << p[i] << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<16, 1>("float", true, GenerateIeeeValues<float, uint32_t>(100, 28)), "posit<16,1>", "to_posit(float)");
+
+#else
+
+	// odd lengths leave a remainder for the scalar loop
+	const size_t N = 100003;
+	std::vector<float>  fv = GenerateIeeeValues<float, uint32_t>(N, 30);
+	std::vector<float>  fw = GenerateIeeeValues<float, uint32_t>(N, 122);
+	std::vector<double> dv = GenerateIeeeValues<double, uint64_t>(N, 122);
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<16, 1>("float", bReportIndividualTestCases, fv), "posit<16,1>", "to_posit(float)");
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<16, 1>("double", bReportIndividualTestCases, dv), "posit<16,1>", "to_posit(double)");
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<32, 2>("float", bReportIndividualTestCases, fw), "posit<32,2>", "to_posit(float)");
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<32, 2>("double", bReportIndividualTestCases, dv), "posit<32,2>", "to_posit(double)");
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<8, 0>("float", bReportIndividualTestCases, fv), "posit<8,0>", "to_posit(float)");
+
+	std::vector< posit<16, 1> > p16 = GeneratePositValues<16, 1>(65536 + 7);
+	std::vector< posit<32, 2> > p32 = GeneratePositValues<32, 2>(N);
+	nrOfFailedTestCases += ReportTestResult(VerifyToIeee<16, 1, float>("float", bReportIndividualTestCases, p16), "posit<16,1>", "to_float");
+	nrOfFailedTestCases += ReportTestResult(VerifyToIeee<16, 1, double>("double", bReportIndividualTestCases, p16), "posit<16,1>", "to_double");
+	nrOfFailedTestCases += ReportTestResult(VerifyToIeee<32, 2, float>("float", bReportIndividualTestCases, p32), "posit<32,2>", "to_float");
+	nrOfFailedTestCases += ReportTestResult(VerifyToIeee<32, 2, double>("double", bReportIndividualTestCases, p32), "posit<32,2>", "to_double");
+	nrOfFailedTestCases += ReportTestResult(VerifyToIeee<8, 0, float>("float", bReportIndividualTestCases, GeneratePositValues<8, 0>(256)), "posit<8,0>", "to_float");
+
+#if STRESS_TESTING
+	std::vector<float> fs = GenerateIeeeValues<float, uint32_t>(10000019, 122);
+	nrOfFailedTestCases += ReportTestResult(VerifyToPosit<32, 2>("float", bReportIndividualTestCases, fs), "posit<32,2>", "to_posit(float)");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
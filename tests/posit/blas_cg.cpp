@@ -0,0 +1,177 @@
+// blas_cg.cpp: functional tests of the preconditioned conjugate gradient solver
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/blas/cg.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// the 5-point Laplacian of a grid x grid mesh, shifted by shift on the diagonal
+template<typename Scalar>
+blas::sparse_matrix<Scalar> Laplacian2D(size_t grid, double shift = 0.0) {
+	std::vector< blas::triplet<Scalar> > elements;
+	size_t n = grid * grid;
+	for (size_t i = 0; i < n; ++i) {
+		size_t r = i / grid, c = i % grid;
+		elements.push_back({ i, i, Scalar(4.0 + shift) });
+		if (r > 0)        elements.push_back({ i, i - grid, Scalar(-1) });
+		if (r + 1 < grid) elements.push_back({ i, i + grid, Scalar(-1) });
+		if (c > 0)        elements.push_back({ i, i - 1, Scalar(-1) });
+		if (c + 1 < grid) elements.push_back({ i, i + 1, Scalar(-1) });
+	}
+	return blas::sparse_matrix<Scalar>(n, n, std::move(elements));
+}
+
+template<typename Scalar>
+int CheckSolution(bool bReportIndividualTestCases, const blas::cg_result& result, const std::vector<Scalar>& x, const std::vector<double>& reference, double tolerance) {
+	int nrOfFailedTests = 0;
+	if (!result.converged) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: no convergence in " << result.iterations << " iterations, residual " << result.residual << std::endl;
+	}
+	for (size_t i = 0; i < x.size(); ++i) {
+		if (std::abs(double(x[i]) - reference[i]) > tolerance * std::abs(reference[i])) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: x[" << i << "] = " << double(x[i]) << " reference " << reference[i] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// sparse Laplacian with solution x = 1 + i / n
+template<typename Scalar>
+int VerifySparseCG(bool bReportIndividualTestCases, size_t grid, blas::preconditioner precond, double tolerance) {
+	blas::sparse_matrix<Scalar> A = Laplacian2D<Scalar>(grid, 0.5);
+	size_t n = A.rows();
+	std::vector<Scalar> solution(n), b, x;
+	std::vector<double> reference(n);
+	for (size_t i = 0; i < n; ++i) {
+		reference[i] = 1.0 + double(i) / double(n);
+		solution[i] = Scalar(reference[i]);
+		reference[i] = double(solution[i]);
+	}
+	blas::spmv(A, solution, b);
+	blas::cg_options options;
+	options.precond = precond;
+	options.tolerance = tolerance;
+	blas::cg_result result = blas::cg(A, b, x, options);
+	return CheckSolution(bReportIndividualTestCases, result, x, reference, 100 * tolerance);
+}
+
+// dense, symmetric, diagonally dominant matrix with solution x = 1, -1, 1, ...
+template<typename Scalar>
+int VerifyDenseCG(bool bReportIndividualTestCases, size_t n, double tolerance) {
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<Scalar> A(n * n), solution(n), b, x;
+	std::vector<double> reference(n);
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t j = 0; j < i; ++j) A[i * n + j] = A[j * n + i] = Scalar(distribution(generator));
+		A[i * n + i] = Scalar(double(n) * (1.0 + 0.5 * distribution(generator)));
+		reference[i] = (i % 2) ? -1.0 : 1.0;
+		solution[i] = Scalar(reference[i]);
+	}
+	blas::gemv(blas::matrix_layout::row_major, n, n, A, solution, b);
+	blas::cg_options options;
+	options.tolerance = tolerance;
+	options.threads = 2;
+	blas::cg_result result = blas::cg(n, A, b, x, options);
+	return CheckSolution(bReportIndividualTestCases, result, x, reference, 100 * tolerance);
+}
+
+// the fused inner product of posit vectors is the fused dot product of fdp.hpp
+template<size_t nbits, size_t es>
+int VerifyDot(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-1.0e3, 1.0e3);
+	std::vector<Posit> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distribution(generator);
+		y[i] = distribution(generator);
+	}
+	Posit reference = fdp<std::vector<Posit>, blas::default_quire_capacity>(x, y);
+	if (blas::dot(x, y) != reference || blas::dot(x, y, blas::accumulation::fused, 3) != reference) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: dot " << blas::dot(x, y) << " fdp " << reference << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using blas::preconditioner;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS conjugate gradient validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG< posit<32, 2> >(true, 4, preconditioner::jacobi, 1.0e-6), "posit<32,2>", "cg 4x4 grid");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<32, 2>(bReportIndividualTestCases, 50000), "posit<32,2>", "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot<16, 1>(bReportIndividualTestCases, 1000), "posit<16,1>", "dot");
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG< posit<32, 2> >(bReportIndividualTestCases, 20, preconditioner::jacobi, 1.0e-6), "posit<32,2>", "pcg 20x20 grid");
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG< posit<32, 2> >(bReportIndividualTestCases, 20, preconditioner::none, 1.0e-6), "posit<32,2>", "cg 20x20 grid");
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG< posit<16, 1> >(bReportIndividualTestCases, 10, preconditioner::jacobi, 1.0e-2), "posit<16,1>", "pcg 10x10 grid");
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG<double>(bReportIndividualTestCases, 20, preconditioner::jacobi, 1.0e-10), "double", "pcg 20x20 grid");
+	nrOfFailedTestCases += ReportTestResult(VerifyDenseCG< posit<32, 2> >(bReportIndividualTestCases, 60, 1.0e-6), "posit<32,2>", "pcg dense 60x60");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifySparseCG< posit<32, 2> >(bReportIndividualTestCases, 200, preconditioner::jacobi, 1.0e-6), "posit<32,2>", "pcg 200x200 grid");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
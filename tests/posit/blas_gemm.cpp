@@ -0,0 +1,119 @@
+// blas_gemm.cpp: functional tests of the cache-blocked posit matrix-matrix multiplication
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/blas/gemm.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// every element of C must be the fused dot product of a row of A and a column of B, rounded once
+template<size_t nbits, size_t es>
+int VerifyGemm(bool bReportIndividualTestCases, size_t m, size_t n, size_t k, unsigned nrThreads, bool sprinkleNaR = false) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(m * 31 + n * 7 + k);
+	std::uniform_real_distribution<double> distribution(-64.0, 64.0);
+	std::vector<Posit> A(m * k), B(k * n), C;
+	for (Posit& a : A) a = distribution(generator);
+	for (Posit& b : B) b = distribution(generator);
+	if (sprinkleNaR && m > 1 && n > 2) {
+		A[k + k / 2].setnar();         // row 1
+		B[(k - 1) * n + 2].setnar();   // column 2
+	}
+	blas::gemm(m, n, k, A, B, C, nrThreads);
+	for (size_t i = 0; i < m; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			quire<nbits, es, 30> q;
+			bool nar = false;
+			for (size_t p = 0; p < k; ++p) {
+				if (A[i * k + p].isnar() || B[p * n + j].isnar()) nar = true; else q += quire_mul(A[i * k + p], B[p * n + j]);
+			}
+			Posit reference;
+			if (nar) reference.setnar(); else convert(q.to_value(), reference);
+			if (C[i * n + j] != reference) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << "FAIL: C(" << i << ", " << j << ") = " << C[i * n + j] << " reference " << reference << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS gemm validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<16, 1>(true, 4, 4, 4, 1), "posit<16,1>", "gemm 4x4x4");
+
+#else
+
+	// sizes that leave partial tiles and panels
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<32, 2>(bReportIndividualTestCases, 37, 29, 300, 1), "posit<32,2>", "gemm 37x29x300");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<32, 2>(bReportIndividualTestCases, 50, 19, 17, 3), "posit<32,2>", "gemm 50x19x17 3 threads");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<16, 1>(bReportIndividualTestCases, 64, 64, 64, 4), "posit<16,1>", "gemm 64x64x64 4 threads");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<16, 1>(bReportIndividualTestCases, 40, 300, 270, 2), "posit<16,1>", "gemm 40x300x270 2 column blocks");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<16, 1>(bReportIndividualTestCases, 20, 20, 520, 2, true), "posit<16,1>", "gemm NaR");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<8, 0>(bReportIndividualTestCases, 17, 33, 9, 2), "posit<8,0>", "gemm 17x33x9");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<64, 3>(bReportIndividualTestCases, 18, 18, 18, 2), "posit<64,3>", "gemm 18x18x18");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<72, 3>(bReportIndividualTestCases, 5, 6, 7, 2), "posit<72,3>", "gemm 5x6x7");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<16, 1>(bReportIndividualTestCases, 3, 5, 0, 1), "posit<16,1>", "gemm empty inner dimension");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyGemm<32, 2>(bReportIndividualTestCases, 256, 256, 256, 0), "posit<32,2>", "gemm 256x256x256");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
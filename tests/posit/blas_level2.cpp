@@ -0,0 +1,202 @@
+// blas_level2.cpp: functional tests of the posit matrix-vector kernels gemv, ger, and trsv
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/blas/gemv.hpp>
+#include <universal/blas/trsv.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+template<typename Scalar>
+void RandomFill(std::vector<Scalar>& v, size_t seed, double range = 16.0) {
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<double> distribution(-range, range);
+	for (Scalar& e : v) e = distribution(generator);
+}
+
+template<typename Scalar>
+int Compare(bool bReportIndividualTestCases, const char* kernel, const std::vector<Scalar>& result, const std::vector<Scalar>& reference) {
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < result.size(); ++i) {
+		if (result[i] != reference[i]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << kernel << " element " << i << " = " << result[i] << " reference " << reference[i] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// both layouts of gemv must produce the fused dot product of each row, and the rounded axpy sequence
+template<size_t nbits, size_t es>
+int VerifyGemv(bool bReportIndividualTestCases, size_t m, size_t n, unsigned nrThreads, bool sprinkleNaR = false) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::vector<Posit> A(m * n), At(m * n), x(n), y;
+	RandomFill(A, m * 13 + n);
+	RandomFill(x, n);
+	if (sprinkleNaR && m > 2) A[2 * n + n / 2].setnar();
+	for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) At[i + j * m] = A[i * n + j];
+
+	std::vector<Posit> fused(m), rounded(m);
+	for (size_t i = 0; i < m; ++i) {
+		quire<nbits, es, 30> q;
+		Posit sum(0);
+		bool nar = false;
+		for (size_t j = 0; j < n; ++j) {
+			if (A[i * n + j].isnar()) nar = true; else q += quire_mul(A[i * n + j], x[j]);
+			sum += A[i * n + j] * x[j];
+		}
+		if (nar) fused[i].setnar(); else convert(q.to_value(), fused[i]);
+		rounded[i] = sum;
+	}
+	blas::gemv(blas::matrix_layout::row_major, m, n, A, x, y, blas::accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "gemv row-major fused", y, fused);
+	blas::gemv(blas::matrix_layout::column_major, m, n, At, x, y, blas::accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "gemv column-major fused", y, fused);
+	blas::gemv(blas::matrix_layout::row_major, m, n, A, x, y, blas::accumulation::rounded, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "gemv row-major rounded", y, rounded);
+	blas::gemv(blas::matrix_layout::column_major, m, n, At, x, y, blas::accumulation::rounded, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "gemv column-major rounded", y, rounded);
+	return nrOfFailedTests;
+}
+
+// every element of the rank-1 update must be the fused multiply-add a + x * y
+template<size_t nbits, size_t es>
+int VerifyGer(bool bReportIndividualTestCases, size_t m, size_t n, unsigned nrThreads) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::vector<Posit> A(m * n), At(m * n), x(m), y(n), reference(m * n);
+	RandomFill(A, m + n);
+	RandomFill(x, m * 3);
+	RandomFill(y, n * 5);
+	for (size_t i = 0; i < m; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			At[i + j * m] = A[i * n + j];
+			quire<nbits, es, 30> q;
+			q += A[i * n + j];
+			q += quire_mul(x[i], y[j]);
+			convert(q.to_value(), reference[i * n + j]);
+		}
+	}
+	blas::ger(blas::matrix_layout::row_major, m, n, x, y, A, blas::accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "ger row-major", A, reference);
+	blas::ger(blas::matrix_layout::column_major, m, n, x, y, At, blas::accumulation::fused, nrThreads);
+	for (size_t i = 0; i < m; ++i) for (size_t j = 0; j < n; ++j) A[i * n + j] = At[i + j * m];
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "ger column-major", A, reference);
+	return nrOfFailedTests;
+}
+
+// the blocked solve must match forward or backward substitution with one accumulator per row
+template<typename Scalar>
+int VerifyTrsv(bool bReportIndividualTestCases, size_t n, blas::triangle uplo, blas::diagonal diag, unsigned nrThreads) {
+	int nrOfFailedTests = 0;
+	std::vector<Scalar> A(n * n), At(n * n), b(n), reference(n);
+	RandomFill(A, n * 7, 1.0);
+	RandomFill(b, n * 11);
+	for (size_t i = 0; i < n; ++i) A[i * n + i] = Scalar(double(n));   // diagonally dominant
+	for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < n; ++j) At[i + j * n] = A[i * n + j];
+	bool lower = (uplo == blas::triangle::lower);
+	for (size_t s = 0; s < n; ++s) {
+		size_t i = lower ? s : n - 1 - s;
+		blas::dot_accumulator<Scalar> r;
+		r.load(b[i]);
+		size_t first = lower ? 0 : i + 1;
+		size_t last = lower ? i : n;
+		for (size_t j = first; j < last; ++j) r.msc(A[i * n + j], reference[j]);
+		reference[i] = r.value();
+		if (diag == blas::diagonal::non_unit) reference[i] /= A[i * n + i];
+	}
+	std::vector<Scalar> x = b;
+	blas::trsv(blas::matrix_layout::row_major, uplo, diag, n, A, x, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "trsv row-major", x, reference);
+	x = b;
+	blas::trsv(blas::matrix_layout::column_major, uplo, diag, n, At, x, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "trsv column-major", x, reference);
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using blas::triangle;
+	using blas::diagonal;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS level 2 validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<16, 1>(true, 4, 4, 1), "posit<16,1>", "gemv 4x4");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<32, 2>(bReportIndividualTestCases, 37, 53, 1), "posit<32,2>", "gemv 37x53");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<32, 2>(bReportIndividualTestCases, 300, 200, 4), "posit<32,2>", "gemv 300x200 4 threads");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<16, 1>(bReportIndividualTestCases, 65, 40, 2, true), "posit<16,1>", "gemv NaR");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<8, 0>(bReportIndividualTestCases, 17, 9, 2), "posit<8,0>", "gemv 17x9");
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<72, 3>(bReportIndividualTestCases, 6, 7, 2), "posit<72,3>", "gemv 6x7");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyGer<32, 2>(bReportIndividualTestCases, 300, 100, 3), "posit<32,2>", "ger 300x100 3 threads");
+	nrOfFailedTestCases += ReportTestResult(VerifyGer<16, 1>(bReportIndividualTestCases, 13, 29, 1), "posit<16,1>", "ger 13x29");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv< posit<32, 2> >(bReportIndividualTestCases, 300, triangle::lower, diagonal::non_unit, 3), "posit<32,2>", "trsv lower");
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv< posit<32, 2> >(bReportIndividualTestCases, 300, triangle::upper, diagonal::non_unit, 3), "posit<32,2>", "trsv upper");
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv< posit<16, 1> >(bReportIndividualTestCases, 130, triangle::lower, diagonal::unit, 2), "posit<16,1>", "trsv lower unit");
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv< posit<16, 1> >(bReportIndividualTestCases, 5, triangle::upper, diagonal::unit, 1), "posit<16,1>", "trsv upper unit");
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv<float>(bReportIndividualTestCases, 257, triangle::lower, diagonal::non_unit, 2), "float", "trsv lower");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyGemv<32, 2>(bReportIndividualTestCases, 2048, 2048, 0), "posit<32,2>", "gemv 2048x2048");
+	nrOfFailedTestCases += ReportTestResult(VerifyTrsv< posit<32, 2> >(bReportIndividualTestCases, 2048, triangle::lower, diagonal::non_unit, 0), "posit<32,2>", "trsv 2048");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+// blas_lu.cpp: functional tests of the LU factorization and the mixed-precision refined solve
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/blas/lu.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// random matrix with a dominant, but not the largest, element in each column, and b = A * x for x = 1, 2, ..., n
+template<typename Scalar>
+void GenerateSystem(size_t n, std::vector<Scalar>& A, std::vector<Scalar>& b, size_t seed) {
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<double> a(n * n);
+	for (double& e : a) e = distribution(generator);
+	for (size_t i = 0; i < n; ++i) a[((i + 1) % n) * n + i] += double(n);   // forces row exchanges
+	A.resize(n * n);
+	b.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		double sum = 0.0;
+		for (size_t j = 0; j < n; ++j) {
+			A[i * n + j] = Scalar(a[i * n + j]);
+			sum += double(A[i * n + j]) * double(j + 1);
+		}
+		b[i] = Scalar(sum);
+	}
+}
+
+// P * A must equal L * U to within the rounding of the factors, and every row must be used once as pivot
+template<typename Scalar>
+int VerifyFactorization(bool bReportIndividualTestCases, size_t n, unsigned nrThreads, double tolerance) {
+	int nrOfFailedTests = 0;
+	std::vector<Scalar> A, b;
+	GenerateSystem(n, A, b, n);
+	std::vector<Scalar> LU = A;
+	std::vector<size_t> piv;
+	if (!blas::lu(n, LU, piv, nrThreads)) return 1;
+	std::vector<size_t> row(n);
+	for (size_t i = 0; i < n; ++i) row[i] = i;
+	for (size_t j = 0; j < n; ++j) std::swap(row[j], row[piv[j]]);
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			double sum = 0.0;
+			for (size_t p = 0; p <= std::min(i, j); ++p) sum += (p == i ? 1.0 : double(LU[i * n + p])) * double(LU[p * n + j]);
+			double a = double(A[row[i] * n + j]);
+			if (std::abs(sum - a) > tolerance * double(n)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << "FAIL: (L*U)(" << i << ", " << j << ") = " << sum << " (P*A) = " << a << std::endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// refinement must recover x = 1, 2, ..., n to the precision of High
+template<typename Low, typename High>
+int VerifyRefinedSolve(bool bReportIndividualTestCases, size_t n, unsigned nrThreads, double tolerance) {
+	int nrOfFailedTests = 0;
+	std::vector<High> A, b, x;
+	GenerateSystem(n, A, b, n + 1);
+	blas::refinement_result result = blas::refined_solve<Low>(n, A, b, x, tolerance, 30, nrThreads);
+	if (!result.converged) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: no convergence in " << result.iterations << " iterations" << std::endl;
+	}
+	for (size_t i = 0; i < n; ++i) {
+		double error = std::abs(double(x[i]) - double(i + 1)) / double(i + 1);
+		if (error > tolerance * 100) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: x[" << i << "] = " << x[i] << " relative error " << error << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS LU factorization and refined solve validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFactorization< posit<32, 2> >(true, 5, 1, 1.0e-6), "posit<32,2>", "lu 5x5");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFactorization< posit<32, 2> >(bReportIndividualTestCases, 77, 2, 1.0e-7), "posit<32,2>", "lu 77x77");
+	nrOfFailedTestCases += ReportTestResult(VerifyFactorization< posit<16, 1> >(bReportIndividualTestCases, 40, 1, 1.0e-3), "posit<16,1>", "lu 40x40");
+	nrOfFailedTestCases += ReportTestResult(VerifyFactorization<double>(bReportIndividualTestCases, 70, 3, 1.0e-14), "double", "lu 70x70");
+
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinedSolve< posit<16, 1>, posit<32, 2> >(bReportIndividualTestCases, 50, 2, 1.0e-7)), "posit<16,1>", "refined in posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinedSolve< posit<32, 2>, posit<64, 3> >(bReportIndividualTestCases, 100, 2, 1.0e-15)), "posit<32,2>", "refined in posit<64,3>");
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinedSolve< posit<16, 1>, posit<64, 3> >(bReportIndividualTestCases, 40, 1, 1.0e-15)), "posit<16,1>", "refined in posit<64,3>");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinedSolve< posit<32, 2>, posit<64, 3> >(bReportIndividualTestCases, 1000, 0, 1.0e-15)), "posit<32,2>", "refined in posit<64,3> 1000x1000");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,205 @@
+// blas_reductions.cpp: functional tests of the exact and pairwise reductions of posit and IEEE vectors
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/blas/reductions.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// pairs of large values of opposite sign around small values whose sum is exact in double: a naive sum loses the small values
+template<typename Real>
+std::vector<Real> CancellingSignal(size_t n, double& exactSum) {
+	std::mt19937_64 generator(n);
+	std::uniform_int_distribution<int> small(-1000, 1000), exponent(10, 60);
+	std::vector<Real> x;
+	exactSum = 0.0;
+	while (x.size() + 3 <= n) {
+		Real big = Real(std::ldexp(1.0 + double(small(generator) & 0xff) / 256.0, exponent(generator)));
+		Real s = Real(std::ldexp(double(small(generator)), -10));
+		x.push_back(big);
+		x.push_back(s);
+		x.push_back(-big);
+		exactSum += double(s);
+	}
+	std::shuffle(x.begin(), x.end(), generator);
+	return x;
+}
+
+// the exact sum of a cancelling signal
+template<typename Real>
+int VerifyExactSum(bool bReportIndividualTestCases, size_t n) {
+	double exactSum;
+	std::vector<Real> x = CancellingSignal<Real>(n, exactSum);
+	Real sum = blas::sum(x, 1);
+	if (sum != Real(exactSum)) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: sum " << sum << " != " << exactSum << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// round to nearest, ties to even, of sums that are not representable, and norms below the smallest normal
+int VerifyIeeeRounding(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	double ulp = std::ldexp(1.0, -52), half = std::ldexp(1.0, -53), tiny = std::ldexp(1.0, -90);
+	struct { std::vector<double> x; double sum; } cases[] = {
+		{ { 1.0, half }, 1.0 },                             // tie rounds to the even 1
+		{ { 1.0 + ulp, half }, 1.0 + 2 * ulp },             // tie rounds to the even 1 + 2 ulp
+		{ { 1.0, half, tiny }, 1.0 + ulp },                 // above the tie
+		{ { 1.0, half, -tiny }, 1.0 },                      // below the tie
+		{ { -1.0, -half, -tiny }, -1.0 - ulp },
+		{ { std::numeric_limits<double>::min(), -std::numeric_limits<double>::denorm_min() }, std::numeric_limits<double>::min() - std::numeric_limits<double>::denorm_min() },
+	};
+	for (auto& c : cases) {
+		double sum = blas::sum(c.x);
+		if (sum != c.sum) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: sum " << sum << " != " << c.sum << std::endl;
+		}
+	}
+	double m = std::numeric_limits<double>::denorm_min();
+	std::vector<double> subnormals = { 3 * m, 4 * m }, huge = { 3e300, 4e300 };
+	if (blas::nrm2(subnormals) != 5 * m || blas::nrm2(huge) != 5e300) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: nrm2 " << blas::nrm2(subnormals) << " " << blas::nrm2(huge) << std::endl;
+	}
+	std::vector<float> f = { 1.0f, std::numeric_limits<float>::infinity() }, g = { std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+	if (!std::isinf(blas::sum(f)) || !std::isnan(blas::sum(g))) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: sums with infinities " << blas::sum(f) << " " << blas::sum(g) << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// sum, mean, variance, and nrm2 are identical for any number of threads
+template<typename Scalar>
+int VerifyReproducibility(bool bReportIndividualTestCases, size_t n) {
+	std::mt19937_64 generator(n);
+	std::normal_distribution<double> distribution(1.0, 3.0);
+	std::vector<Scalar> x(n);
+	for (auto& e : x) e = Scalar(distribution(generator));
+	Scalar sum = blas::sum(x, 1), mean = blas::mean(x, 1), variance = blas::variance(x, 1), norm = blas::nrm2(x, 1);
+	int nrOfFailedTests = 0;
+	for (unsigned nrThreads : { 2u, 3u, 5u }) {
+		if (blas::sum(x, nrThreads) != sum || blas::mean(x, nrThreads) != mean || blas::variance(x, nrThreads) != variance || blas::nrm2(x, nrThreads) != norm) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: results on " << nrThreads << " threads differ" << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// mean and variance of posits against the double precision statistics of the same values
+template<size_t nbits, size_t es>
+int VerifyStatistics(bool bReportIndividualTestCases, size_t n, double tolerance) {
+	using Posit = posit<nbits, es>;
+	std::mt19937_64 generator(n);
+	std::normal_distribution<double> distribution(100.0, 0.5);     // large mean, small spread
+	std::vector<Posit> x(n);
+	for (auto& e : x) e = Posit(distribution(generator));
+	long double s = 0.0;
+	for (auto& e : x) s += (long double)(double(e));
+	long double m = s / n, v = 0.0;
+	for (auto& e : x) v += ((long double)(double(e)) - m) * ((long double)(double(e)) - m);
+	v /= (n - 1);
+	double meanError = std::abs(double(blas::mean(x)) - double(m)) / double(m);
+	double varianceError = std::abs(double(blas::variance(x)) - double(v)) / double(v);
+	if (meanError > tolerance || varianceError > tolerance) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: relative errors of mean " << meanError << " and variance " << varianceError << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int VerifyInvalidArguments(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	try {
+		blas::mean(std::vector<double>{});
+		++nrOfFailedTests;
+	}
+	catch (const std::invalid_argument&) {}
+	try {
+		blas::variance(std::vector<double>{ 1.0 });
+		++nrOfFailedTests;
+	}
+	catch (const std::invalid_argument&) {}
+	if (nrOfFailedTests > 0 && bReportIndividualTestCases) std::cout << "FAIL: statistics of too few elements accepted" << std::endl;
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS reductions validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeRounding(true), "double", "rounding");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyExactSum<double>(bReportIndividualTestCases, 3000), "double", "exact sum");
+	nrOfFailedTestCases += ReportTestResult(VerifyExactSum<float>(bReportIndividualTestCases, 3000), "float", "exact sum");
+	nrOfFailedTestCases += ReportTestResult(VerifyIeeeRounding(bReportIndividualTestCases), "double", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<double>(bReportIndividualTestCases, 50000), "double", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility< posit<32, 2> >(bReportIndividualTestCases, 50000), "posit<32,2>", "reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<long double>(bReportIndividualTestCases, 50000), "long double", "pairwise reproducibility");
+	nrOfFailedTestCases += ReportTestResult(VerifyStatistics<32, 2>(bReportIndividualTestCases, 10000, 1e-7), "posit<32,2>", "mean and variance");
+	nrOfFailedTestCases += ReportTestResult(VerifyStatistics<16, 1>(bReportIndividualTestCases, 10000, 1e-2), "posit<16,1>", "mean and variance");
+	nrOfFailedTestCases += ReportTestResult(VerifyInvalidArguments(bReportIndividualTestCases), "double", "invalid arguments");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility<float>(bReportIndividualTestCases, 1000000), "float", "reproducibility");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
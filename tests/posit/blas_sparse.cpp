@@ -0,0 +1,237 @@
+// blas_sparse.cpp: functional tests of the sparse matrix-vector products and the Matrix Market reader
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/blas/sparse.hpp>
+#include <universal/blas/matrix_market.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// random sparse matrix with duplicate coordinates, and its dense row-major equivalent
+template<typename Scalar>
+blas::sparse_matrix<Scalar> GenerateSparse(size_t rows, size_t cols, size_t perRow, std::vector<Scalar>& dense, blas::sparse_format format) {
+	std::mt19937_64 generator(rows * 3 + cols);
+	std::uniform_real_distribution<double> distribution(-8.0, 8.0);
+	std::uniform_int_distribution<size_t> column(0, cols - 1);
+	std::vector< blas::triplet<Scalar> > elements;
+	for (size_t i = 0; i < rows; ++i) {
+		size_t nnz = (i % 7 == 0) ? 4 * perRow : perRow;   // unbalanced rows
+		for (size_t e = 0; e < nnz; ++e) elements.push_back({ i, column(generator), Scalar(distribution(generator)) });
+	}
+	blas::sparse_matrix<Scalar> A(rows, cols, elements, format);
+	blas::sparse_matrix<Scalar> csr = A.convert(blas::sparse_format::csr);
+	dense.assign(rows * cols, Scalar(0));
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t e = csr.ptr()[i]; e < csr.ptr()[i + 1]; ++e) dense[i * cols + csr.index()[e]] = csr.value()[e];
+	}
+	return A;
+}
+
+template<typename Scalar>
+int Compare(bool bReportIndividualTestCases, const char* kernel, const std::vector<Scalar>& result, const std::vector<Scalar>& reference) {
+	int nrOfFailedTests = 0;
+	if (result.size() != reference.size()) return 1;
+	for (size_t i = 0; i < result.size(); ++i) {
+		if (result[i] != reference[i]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << kernel << " element " << i << " = " << double(result[i]) << " reference " << double(reference[i]) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the fused products of both formats, and of their transposes, must equal the fused dense products
+template<typename Scalar>
+int VerifySpmv(bool bReportIndividualTestCases, size_t rows, size_t cols, size_t perRow, unsigned nrThreads) {
+	using namespace blas;
+	int nrOfFailedTests = 0;
+	std::vector<Scalar> dense, x(cols), xt(rows), y, reference;
+	sparse_matrix<Scalar> csr = GenerateSparse(rows, cols, perRow, dense, sparse_format::csr);
+	sparse_matrix<Scalar> csc = csr.convert(sparse_format::csc);
+	std::mt19937_64 generator(rows);
+	std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+	for (Scalar& e : x) e = Scalar(distribution(generator));
+	for (Scalar& e : xt) e = Scalar(distribution(generator));
+
+	gemv(matrix_layout::row_major, rows, cols, dense, x, reference, accumulation::fused, 1);
+	spmv(csr, x, y, accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "spmv csr", y, reference);
+	spmv(csc, x, y, accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "spmv csc", y, reference);
+
+	// A in row-major order is A^T in column-major order
+	gemv(matrix_layout::column_major, cols, rows, dense, xt, reference, accumulation::fused, 1);
+	spmv_transpose(csr, xt, y, accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "spmv_transpose csr", y, reference);
+	spmv_transpose(csc, xt, y, accumulation::fused, nrThreads);
+	nrOfFailedTests += Compare(bReportIndividualTestCases, "spmv_transpose csc", y, reference);
+
+	// rounded accumulation of csr rows follows the order of the columns, like the rounded dense product
+	gemv(matrix_layout::row_major, rows, cols, dense, x, reference, accumulation::rounded, 1);
+	spmv(csr, x, y, accumulation::rounded, nrThreads);
+	for (size_t i = 0; i < rows; ++i) {
+		// the dense product adds the zeros as well, which does not change a rounded sum
+		if (y[i] != reference[i]) ++nrOfFailedTests;
+	}
+	return nrOfFailedTests;
+}
+
+// the fixed-point accumulator must round the exact sum of products once, and saturate when asked to
+template<bool arithmetic>
+int VerifyFixpntAccumulation(bool bReportIndividualTestCases, size_t n) {
+	using Fixpnt = fixpnt<32, 16, arithmetic>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+	blas::dot_accumulator<Fixpnt> sum;
+	double exact = 0.0;   // products of 16-bit fractions and their sums are exact in double for these magnitudes
+	for (size_t i = 0; i < n; ++i) {
+		Fixpnt a(distribution(generator)), b(distribution(generator));
+		sum.mac(a, b);
+		exact += double(a) * double(b);
+	}
+	double error = std::abs(double(sum.value()) - exact);
+	if (error > std::ldexp(1.0, -17)) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: fixpnt sum " << double(sum.value()) << " exact " << exact << std::endl;
+	}
+	if (arithmetic == Saturating) {
+		Fixpnt big(30000.0);
+		sum.mac(big, big);
+		if (sum.value() != maxpos_fixpnt<32, 16, arithmetic, uint8_t>()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: fixpnt sum did not saturate " << double(sum.value()) << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+int VerifyMatrixMarket(bool bReportIndividualTestCases) {
+	using namespace blas;
+	int nrOfFailedTests = 0;
+	std::istringstream symmetric(
+		"%%MatrixMarket matrix coordinate real symmetric\n"
+		"% a 3 x 3 symmetric matrix\n"
+		"3 3 4\n"
+		"1 1 2.0\n"
+		"2 1 -1.0\n"
+		"3 2 0.5\n"
+		"3 3 4.0\n");
+	sparse_matrix< posit<32, 2> > A = read_matrix_market< posit<32, 2> >(symmetric);
+	std::vector< posit<32, 2> > x = { 1.0, 2.0, 3.0 }, y;
+	spmv(A, x, y);
+	// [2 -1 0; -1 0 0.5; 0 0.5 4] * [1 2 3] = [0 0.5 13]
+	if (A.nonzeros() != 6 || double(y[0]) != 0.0 || double(y[1]) != 0.5 || double(y[2]) != 13.0) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: symmetric matrix market input " << y[0] << ' ' << y[1] << ' ' << y[2] << std::endl;
+	}
+	std::istringstream pattern("%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+	sparse_matrix< posit<16, 1> > P = read_matrix_market< posit<16, 1> >(pattern, sparse_format::csc);
+	if (P.rows() != 2 || P.cols() != 3 || P.nonzeros() != 2 || P.ptr()[1] != 1 || P.index()[0] != 1) ++nrOfFailedTests;
+	std::istringstream truncated("%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1.0\n");
+	try {
+		read_matrix_market<double>(truncated);
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: truncated input was accepted" << std::endl;
+	}
+	catch (const std::runtime_error&) {
+		// correctly rejected
+	}
+	return nrOfFailedTests;
+}
+
+int VerifyPartition(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	// one heavy line followed by many light ones
+	std::vector<size_t> ptr(1, 0);
+	ptr.push_back(1000);
+	for (size_t k = 0; k < 1000; ++k) ptr.push_back(ptr.back() + 1);
+	std::vector<size_t> boundary = blas::partition_by_nonzeros(ptr, 4);
+	if (boundary.front() != 0 || boundary.back() != 1001) ++nrOfFailedTests;
+	for (size_t t = 1; t < boundary.size(); ++t) {
+		size_t nnz = ptr[boundary[t]] - ptr[boundary[t - 1]];
+		if (boundary[t] < boundary[t - 1] || nnz > 1000) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: part " << t - 1 << " has " << nnz << " nonzeros" << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS sparse matrix-vector product validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<16, 1> >(true, 5, 4, 2, 1), "posit<16,1>", "spmv 5x4");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<32, 2> >(bReportIndividualTestCases, 200, 150, 5, 1), "posit<32,2>", "spmv 200x150");
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<32, 2> >(bReportIndividualTestCases, 1500, 1200, 20, 3), "posit<32,2>", "spmv 1500x1200 3 threads");
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<16, 1> >(bReportIndividualTestCases, 120, 300, 8, 2), "posit<16,1>", "spmv 120x300");
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< fixpnt<32, 16> >(bReportIndividualTestCases, 60, 50, 4, 2), "fixpnt<32,16>", "spmv 60x50");
+	nrOfFailedTestCases += ReportTestResult(VerifyFixpntAccumulation<Modulo>(bReportIndividualTestCases, 1000), "fixpnt<32,16>", "modulo accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyFixpntAccumulation<Saturating>(bReportIndividualTestCases, 1000), "fixpnt<32,16>", "saturating accumulation");
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarket(bReportIndividualTestCases), "matrix market", "reader");
+	nrOfFailedTestCases += ReportTestResult(VerifyPartition(bReportIndividualTestCases), "partition", "by nonzeros");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<32, 2> >(bReportIndividualTestCases, 5000, 5000, 30, 0), "posit<32,2>", "spmv 5000x5000");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
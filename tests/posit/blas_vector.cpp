@@ -0,0 +1,211 @@
+// blas_vector.cpp: functional tests of the vector expression templates with rounded and fused evaluation
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/blas/vector.hpp>
+#include <universal/blas/dot.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+template<typename Scalar>
+blas::vector<Scalar> RandomVector(size_t n, double amplitude, uint64_t seed) {
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<double> distribution(-amplitude, amplitude);
+	blas::vector<Scalar> x(n);
+	for (size_t i = 0; i < n; ++i) x[i] = Scalar(distribution(generator));
+	return x;
+}
+
+// rounded evaluation is the hand-written loop: one rounding per operator, in the order of the expression
+template<typename Scalar>
+int VerifyRoundedEvaluation(bool bReportIndividualTestCases, size_t n) {
+	blas::vector<Scalar> x = RandomVector<Scalar>(n, 4.0, 1), z = RandomVector<Scalar>(n, 4.0, 2), w = RandomVector<Scalar>(n, 4.0, 3);
+	Scalar a(0.75), b(-1.5);
+	blas::vector<Scalar> y = a * x + b * z - x * w;
+	blas::vector<Scalar> v = -(x + z) * 3.0;
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < n; ++i) {
+		Scalar ax = a * x[i], bz = b * z[i], xw = x[i] * w[i];
+		Scalar reference = (ax + bz) - xw;
+		Scalar negated = -(x[i] + z[i]);
+		if (y[i] != reference || v[i] != negated * Scalar(3.0)) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: element " << i << " : " << y[i] << " != " << reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// fused evaluation rounds the exact value of each element once: the products of posit<16,1> have at most
+// 24 significant bits, so the exact sums are computed in double and rounded once for the reference
+template<size_t nbits, size_t es>
+int VerifyFusedEvaluation(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	blas::vector<Posit> x = RandomVector<Posit>(n, 4.0, 4), z = RandomVector<Posit>(n, 4.0, 5), w = RandomVector<Posit>(n, 4.0, 6);
+	Posit a(0.75), b(-1.5);
+	blas::vector<Posit> y;
+	y.assign(a * x + b * z - x * w + w, blas::accumulation::fused);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < n; ++i) {
+		double exact = double(a) * double(x[i]) + double(b) * double(z[i]) - double(x[i]) * double(w[i]) + double(w[i]);
+		Posit reference(exact);
+		if (y[i] != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: element " << i << " : " << y[i] << " != " << reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a * x + b * z with b * z close to -a * x: rounded evaluation loses the difference, fused evaluation keeps it
+template<size_t nbits, size_t es>
+int VerifyCancellation(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	blas::vector<Posit> x = RandomVector<Posit>(n, 1000.0, 7), z(n);
+	Posit a(3.0), b(-1.0);
+	for (size_t i = 0; i < n; ++i) z[i] = Posit(3.0 * double(x[i]) + 0.001 * double(i % 7 + 1));
+	blas::vector<Posit> rounded = a * x + b * z, fused;
+	fused.assign(a * x + b * z, blas::accumulation::fused);
+	double roundedError = 0.0, fusedError = 0.0;
+	for (size_t i = 0; i < n; ++i) {
+		double exact = double(a) * double(x[i]) + double(b) * double(z[i]);
+		roundedError += std::abs(double(rounded[i]) - exact);
+		fusedError += std::abs(double(fused[i]) - exact);
+		if (fused[i] != Posit(exact)) {
+			if (bReportIndividualTestCases) std::cout << "FAIL: element " << i << " : " << fused[i] << " != " << exact << std::endl;
+			return 1;
+		}
+	}
+	if (!(fusedError < roundedError)) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: fused error " << fusedError << " is not below rounded error " << roundedError << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// the assigned vector may appear in the expression, and the evaluation is independent of the number of threads
+template<typename Scalar>
+int VerifyAliasingAndThreads(bool bReportIndividualTestCases, size_t n) {
+	blas::vector<Scalar> x = RandomVector<Scalar>(n, 4.0, 8), z = RandomVector<Scalar>(n, 4.0, 9);
+	Scalar a(0.75), b(-1.5);
+	blas::vector<Scalar> reference, y(x);
+	reference.assign(a * x + b * z * x, blas::accumulation::fused, 1);
+	y.assign(a * y + b * z * y, blas::accumulation::fused, 4);
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (y[i] != reference[i]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: element " << i << " : " << y[i] << " != " << reference[i] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the fused sum of an elementwise product is the fused dot product, and the fused sum of a difference is exact
+template<typename Scalar>
+int VerifyReduction(bool bReportIndividualTestCases, size_t n) {
+	blas::vector<Scalar> x = RandomVector<Scalar>(n, 4.0, 10), z = RandomVector<Scalar>(n, 4.0, 11);
+	Scalar s = blas::sum(x * z), d = blas::dot(x.elements(), z.elements());
+	Scalar t = blas::sum(x - z);
+	blas::dot_accumulator<Scalar> difference;
+	for (size_t i = 0; i < n; ++i) {
+		difference.mac(x[i], Scalar(1));
+		difference.msc(z[i], Scalar(1));
+	}
+	if (s != d || t != difference.value()) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: sum " << s << " != " << d << " or " << t << " != " << difference.value() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int VerifySizeMismatch(bool bReportIndividualTestCases) {
+	blas::vector<float> x(3), z(4);
+	try {
+		blas::vector<float> y = x + z;
+	}
+	catch (const std::invalid_argument&) {
+		return 0;
+	}
+	if (bReportIndividualTestCases) std::cout << "FAIL: vectors of different size added" << std::endl;
+	return 1;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "BLAS vector expression validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedEvaluation<16, 1>(true, 10), "posit<16,1>", "fused evaluation");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundedEvaluation<float>(bReportIndividualTestCases, 1000), "float", "rounded evaluation");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundedEvaluation< posit<16, 1> >(bReportIndividualTestCases, 1000), "posit<16,1>", "rounded evaluation");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundedEvaluation< posit<32, 2> >(bReportIndividualTestCases, 1000), "posit<32,2>", "rounded evaluation");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedEvaluation<16, 1>(bReportIndividualTestCases, 1000), "posit<16,1>", "fused evaluation");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedEvaluation<12, 1>(bReportIndividualTestCases, 1000), "posit<12,1>", "fused evaluation");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation<16, 1>(bReportIndividualTestCases, 1000), "posit<16,1>", "cancellation");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation<12, 1>(bReportIndividualTestCases, 1000), "posit<12,1>", "cancellation");
+	nrOfFailedTestCases += ReportTestResult(VerifyAliasingAndThreads< posit<32, 2> >(bReportIndividualTestCases, 40000), "posit<32,2>", "aliasing and threads");
+	nrOfFailedTestCases += ReportTestResult(VerifyReduction< posit<32, 2> >(bReportIndividualTestCases, 1000), "posit<32,2>", "reduction");
+	nrOfFailedTestCases += ReportTestResult(VerifySizeMismatch(bReportIndividualTestCases), "float", "size mismatch");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedEvaluation<16, 1>(bReportIndividualTestCases, 1000000), "posit<16,1>", "fused evaluation");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+// dsp_fft.cpp: functional tests of the Stockham fast Fourier transform in posit, fixed-point, and IEEE arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/dsp/fft.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// the discrete Fourier transform by definition, in double
+std::vector< std::complex<double> > ReferenceDFT(const std::vector< std::complex<double> >& x, dsp::fft_direction direction) {
+	const double pi = 3.14159265358979323846;
+	size_t n = x.size();
+	double sign = (direction == dsp::fft_direction::forward) ? -1.0 : 1.0;
+	std::vector< std::complex<double> > X(n);
+	for (size_t k = 0; k < n; ++k) {
+		std::complex<double> sum(0.0, 0.0);
+		for (size_t j = 0; j < n; ++j) {
+			double theta = sign * 2.0 * pi * double((j * k) % n) / double(n);
+			sum += x[j] * std::complex<double>(std::cos(theta), std::sin(theta));
+		}
+		X[k] = sum;
+	}
+	return X;
+}
+
+// signal-to-noise ratio in dB of a transform against the reference
+template<typename Scalar>
+double SNR(const std::vector< std::complex<Scalar> >& X, const std::vector< std::complex<double> >& reference) {
+	double signal = 0.0, noise = 0.0;
+	for (size_t k = 0; k < X.size(); ++k) {
+		std::complex<double> e = std::complex<double>(double(X[k].real()), double(X[k].imag())) - reference[k];
+		signal += std::norm(reference[k]);
+		noise += std::norm(e);
+	}
+	return (noise == 0.0) ? 400.0 : 10.0 * std::log10(signal / noise);
+}
+
+// random complex samples of magnitude below one half
+std::vector< std::complex<double> > RandomSignal(size_t n) {
+	std::mt19937_64 generator(n);
+	std::uniform_real_distribution<double> distribution(-0.35, 0.35);
+	std::vector< std::complex<double> > x(n);
+	for (auto& e : x) e = std::complex<double>(distribution(generator), distribution(generator));
+	return x;
+}
+
+// the transform of the signal rounded to Scalar has at least the given SNR against the DFT of the rounded signal
+template<typename Scalar>
+int VerifyTransform(bool bReportIndividualTestCases, size_t n, dsp::fft_direction direction, dsp::fft_scaling scaling, dsp::accumulation acc, double minSNR) {
+	std::vector< std::complex<double> > x = RandomSignal(n);
+	std::vector< std::complex<Scalar> > data(n);
+	for (size_t i = 0; i < n; ++i) {
+		data[i] = std::complex<Scalar>(Scalar(x[i].real()), Scalar(x[i].imag()));
+		x[i] = std::complex<double>(double(data[i].real()), double(data[i].imag()));
+	}
+	std::vector< std::complex<double> > reference = ReferenceDFT(x, direction);
+	if (scaling == dsp::fft_scaling::per_stage) for (auto& e : reference) e /= double(n);
+	dsp::fft_plan<Scalar> plan(n, direction, scaling, acc);
+	plan.transform(data);
+	double snr = SNR(data, reference);
+	if (snr < minSNR) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: n = " << n << " SNR " << snr << " dB is below " << minSNR << " dB" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// the forward transform followed by the scaled inverse reproduces the signal
+template<typename Scalar>
+int VerifyRoundTrip(bool bReportIndividualTestCases, size_t n, dsp::accumulation acc, double minSNR) {
+	std::vector< std::complex<double> > x = RandomSignal(n);
+	std::vector< std::complex<Scalar> > data(n);
+	for (size_t i = 0; i < n; ++i) {
+		data[i] = std::complex<Scalar>(Scalar(x[i].real()), Scalar(x[i].imag()));
+		x[i] = std::complex<double>(double(data[i].real()), double(data[i].imag()));
+	}
+	dsp::fft(data, dsp::fft_scaling::none, acc);
+	dsp::ifft(data, dsp::fft_scaling::per_stage, acc);
+	double snr = SNR(data, x);
+	if (snr < minSNR) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: round trip of n = " << n << " SNR " << snr << " dB is below " << minSNR << " dB" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// a batch of transforms spread over threads is identical to the transforms one at a time
+template<typename Scalar>
+int VerifyBatch(bool bReportIndividualTestCases, size_t n, size_t count, unsigned nrThreads) {
+	std::vector< std::complex<double> > x = RandomSignal(n * count);
+	std::vector< std::complex<Scalar> > batch(n * count), single;
+	for (size_t i = 0; i < n * count; ++i) batch[i] = std::complex<Scalar>(Scalar(x[i].real()), Scalar(x[i].imag()));
+	single = batch;
+	dsp::fft_plan<Scalar> plan(n, dsp::fft_direction::forward, dsp::fft_scaling::per_stage, dsp::accumulation::fused);
+	plan.transform_batch(batch.data(), count, n, nrThreads);
+	for (size_t b = 0; b < count; ++b) plan.transform(single.data() + b * n);
+	for (size_t i = 0; i < n * count; ++i) {
+		if (batch[i] != single[i]) {
+			if (bReportIndividualTestCases) std::cout << "FAIL: batch element " << i << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int VerifyInvalidLength(bool bReportIndividualTestCases) {
+	try {
+		dsp::fft_plan<float> plan(96);
+	}
+	catch (const std::invalid_argument&) {
+		return 0;
+	}
+	if (bReportIndividualTestCases) std::cout << "FAIL: length 96 accepted" << std::endl;
+	return 1;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using dsp::fft_direction;
+	using dsp::fft_scaling;
+	using dsp::accumulation;
+	using Fixed = fixpnt<16, 14, Modulo, uint16_t>;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "DSP fast Fourier transform validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform<double>(true, 8, fft_direction::forward, fft_scaling::none, accumulation::rounded, 250.0), "double", "fft 8");
+
+#else
+
+	// radix-4 only, and radix-4 with a radix-2 stage
+	for (size_t n : { 1, 2, 4, 16, 32, 256, 512 }) {
+		string test = "fft " + to_string(n);
+		nrOfFailedTestCases += ReportTestResult(VerifyTransform<double>(bReportIndividualTestCases, n, fft_direction::forward, fft_scaling::none, accumulation::rounded, 250.0), "double", test);
+		nrOfFailedTestCases += ReportTestResult(VerifyTransform<double>(bReportIndividualTestCases, n, fft_direction::inverse, fft_scaling::none, accumulation::fused, 250.0), "double", "inverse " + test);
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform< posit<32, 2> >(bReportIndividualTestCases, 256, fft_direction::forward, fft_scaling::none, accumulation::rounded, 140.0), "posit<32,2>", "fft 256");
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform< posit<32, 2> >(bReportIndividualTestCases, 512, fft_direction::forward, fft_scaling::none, accumulation::fused, 145.0), "posit<32,2>", "fused fft 512");
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform< posit<16, 1> >(bReportIndividualTestCases, 256, fft_direction::forward, fft_scaling::per_stage, accumulation::rounded, 55.0), "posit<16,1>", "scaled fft 256");
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform< posit<16, 1> >(bReportIndividualTestCases, 512, fft_direction::forward, fft_scaling::per_stage, accumulation::fused, 60.0), "posit<16,1>", "scaled fused fft 512");
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform<Fixed>(bReportIndividualTestCases, 256, fft_direction::forward, fft_scaling::per_stage, accumulation::rounded, 45.0), "fixpnt<16,14>", "scaled fft 256");
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform<Fixed>(bReportIndividualTestCases, 512, fft_direction::forward, fft_scaling::per_stage, accumulation::fused, 45.0), "fixpnt<16,14>", "scaled fused fft 512");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip< posit<32, 2> >(bReportIndividualTestCases, 1024, accumulation::fused, 140.0), "posit<32,2>", "round trip 1024");
+	nrOfFailedTestCases += ReportTestResult(VerifyRoundTrip<float>(bReportIndividualTestCases, 1024, accumulation::rounded, 120.0), "float", "round trip 1024");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBatch< posit<16, 1> >(bReportIndividualTestCases, 64, 600, 4), "posit<16,1>", "batch");
+	nrOfFailedTestCases += ReportTestResult(VerifyInvalidLength(bReportIndividualTestCases), "float", "invalid length");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyTransform< posit<32, 2> >(bReportIndividualTestCases, 8192, fft_direction::forward, fft_scaling::none, accumulation::fused, 140.0), "posit<32,2>", "fused fft 8192");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
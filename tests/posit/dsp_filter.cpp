@@ -0,0 +1,260 @@
+// dsp_filter.cpp: functional tests of the streaming FIR, IIR, and polyphase filters in posit, fixed-point, and IEEE arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+#include <universal/fixpnt/fixed_point.hpp>
+#include <universal/dsp/filter.hpp>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+
+namespace sw {
+namespace unum {
+
+// random samples in [-0.35, 0.35] rounded to Scalar
+template<typename Scalar>
+std::vector<Scalar> RandomSamples(size_t n, uint64_t seed) {
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<double> distribution(-0.35, 0.35);
+	std::vector<Scalar> x(n);
+	for (auto& e : x) e = Scalar(distribution(generator));
+	return x;
+}
+
+// y[n] = sum h[k] x[n - k] in double
+template<typename Scalar>
+std::vector<double> ReferenceConvolution(const std::vector<Scalar>& h, const std::vector<Scalar>& x) {
+	std::vector<double> y(x.size(), 0.0);
+	for (size_t n = 0; n < x.size(); ++n) {
+		for (size_t k = 0; k < h.size() && k <= n; ++k) y[n] += double(h[k]) * double(x[n - k]);
+	}
+	return y;
+}
+
+// the fused filter rounds the exact sum of products once: for short products the double reference is exact,
+// so the outputs match it bit for bit; otherwise they are within maxError of it
+template<typename Scalar>
+int VerifyFIR(bool bReportIndividualTestCases, size_t taps, dsp::accumulation acc, double maxError, bool exact) {
+	std::vector<Scalar> h = RandomSamples<Scalar>(taps, taps), x = RandomSamples<Scalar>(4 * taps + 17, taps + 1);
+	std::vector<double> reference = ReferenceConvolution(h, x);
+	dsp::fir_filter<Scalar> filter(h, acc);
+	int nrOfFailedTests = 0;
+	for (size_t n = 0; n < x.size(); ++n) {
+		Scalar y = filter.process(x[n]);
+		bool fail = exact ? (y != Scalar(reference[n])) : (std::abs(double(y) - reference[n]) > maxError);
+		if (fail) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: output " << n << " : " << y << " != " << reference[n] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// processing a stream in blocks of any size is identical to processing it one sample at a time, and reset
+// returns the filter to its initial state
+template<typename Scalar>
+int VerifyBlockProcessing(bool bReportIndividualTestCases, size_t taps) {
+	std::vector<Scalar> h = RandomSamples<Scalar>(taps, 3), x = RandomSamples<Scalar>(1000, 4);
+	dsp::fir_filter<Scalar> filter(h);
+	std::vector<Scalar> single(x.size()), blocked(x.size());
+	for (size_t n = 0; n < x.size(); ++n) single[n] = filter.process(x[n]);
+	filter.reset();
+	size_t blockSizes[] = { 1, 7, 64, 3, 250 };
+	for (size_t n = 0, b = 0; n < x.size(); ++b) {
+		size_t count = std::min(blockSizes[b % 5], x.size() - n);
+		filter.process(x.data() + n, blocked.data() + n, count);
+		n += count;
+	}
+	int nrOfFailedTests = 0;
+	for (size_t n = 0; n < x.size(); ++n) {
+		if (single[n] != blocked[n]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: block output " << n << " : " << blocked[n] << " != " << single[n] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// cascade of two low-pass biquads against the same recursion in double
+template<typename Scalar>
+int VerifyIIR(bool bReportIndividualTestCases, dsp::accumulation acc, double maxError) {
+	const double c[2][5] = {
+		{ 0.0200833655642112, 0.0401667311284225, 0.0200833655642112, -1.5610180758007182, 0.6413515380575631 },
+		{ 0.0461318020933977, 0.0922636041867953, 0.0461318020933977, -1.3072850288493345, 0.4918122372229252 },
+	};
+	std::vector< dsp::biquad<Scalar> > sections;
+	for (auto& s : c) sections.push_back(dsp::biquad<Scalar>{ Scalar(s[0]), Scalar(s[1]), Scalar(s[2]), Scalar(s[3]), Scalar(s[4]) });
+	std::vector<Scalar> x = RandomSamples<Scalar>(2000, 5);
+	std::vector<Scalar> y(x.size());
+	dsp::iir_filter<Scalar> filter(sections, acc);
+	filter.process(x.data(), y.data(), x.size());
+
+	std::vector<double> reference(x.size());
+	double z[2][4] = { { 0 } };
+	for (size_t n = 0; n < x.size(); ++n) {
+		double v = double(x[n]);
+		for (size_t s = 0; s < 2; ++s) {
+			const dsp::biquad<Scalar>& b = sections[s];
+			double w = double(b.b0) * v + double(b.b1) * z[s][0] + double(b.b2) * z[s][1] - double(b.a1) * z[s][2] - double(b.a2) * z[s][3];
+			z[s][1] = z[s][0]; z[s][0] = v;
+			z[s][3] = z[s][2]; z[s][2] = w;
+			v = w;
+		}
+		reference[n] = v;
+	}
+	double error = 0.0;
+	for (size_t n = 0; n < x.size(); ++n) error = std::max(error, std::abs(double(y[n]) - reference[n]));
+	if (error > maxError) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: maximum error " << error << " is above " << maxError << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// the decimator produces every factor-th output of the full-rate filter
+template<typename Scalar>
+int VerifyDecimation(bool bReportIndividualTestCases, size_t taps, size_t factor) {
+	std::vector<Scalar> h = RandomSamples<Scalar>(taps, 6), x = RandomSamples<Scalar>(1001, 7);
+	dsp::fir_filter<Scalar> full(h);
+	dsp::fir_decimator<Scalar> decimator(h, factor);
+	std::vector<Scalar> y(x.size()), decimated(x.size());
+	full.process(x.data(), y.data(), x.size());
+	size_t produced = decimator.process(x.data(), decimated.data(), 500);
+	produced += decimator.process(x.data() + 500, decimated.data() + produced, x.size() - 500);
+	int nrOfFailedTests = 0;
+	if (produced != (x.size() + factor - 1) / factor) {
+		if (bReportIndividualTestCases) std::cout << "FAIL: " << produced << " outputs" << std::endl;
+		return 1;
+	}
+	for (size_t m = 0; m < produced; ++m) {
+		if (decimated[m] != y[m * factor]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: decimated output " << m << " : " << decimated[m] << " != " << y[m * factor] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the interpolator is the full-rate filter applied to the input with factor - 1 zeros after every sample
+template<typename Scalar>
+int VerifyInterpolation(bool bReportIndividualTestCases, size_t taps, size_t factor) {
+	std::vector<Scalar> h = RandomSamples<Scalar>(taps, 8), x = RandomSamples<Scalar>(300, 9);
+	std::vector<Scalar> upsampled(x.size() * factor, Scalar(0));
+	for (size_t n = 0; n < x.size(); ++n) upsampled[n * factor] = x[n];
+	dsp::fir_filter<Scalar> full(h);
+	dsp::fir_interpolator<Scalar> interpolator(h, factor);
+	std::vector<Scalar> y(upsampled.size()), interpolated(upsampled.size());
+	full.process(upsampled.data(), y.data(), upsampled.size());
+	interpolator.process(x.data(), interpolated.data(), x.size());
+	int nrOfFailedTests = 0;
+	for (size_t n = 0; n < y.size(); ++n) {
+		if (interpolated[n] != y[n]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: interpolated output " << n << " : " << interpolated[n] << " != " << y[n] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+int VerifyInvalidArguments(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	try {
+		dsp::fir_filter<float> filter(std::vector<float>{});
+		++nrOfFailedTests;
+	}
+	catch (const std::invalid_argument&) {}
+	try {
+		dsp::fir_decimator<float> decimator(std::vector<float>{ 1.0f }, 0);
+		++nrOfFailedTests;
+	}
+	catch (const std::invalid_argument&) {}
+	if (nrOfFailedTests > 0 && bReportIndividualTestCases) std::cout << "FAIL: invalid filter accepted" << std::endl;
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+	using dsp::accumulation;
+	using Fixed = fixpnt<16, 14, Modulo, uint16_t>;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "DSP streaming filter validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR< posit<16, 1> >(true, 8, accumulation::fused, 0.0, true), "posit<16,1>", "fused fir 8");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR<double>(bReportIndividualTestCases, 32, accumulation::rounded, 1e-15, false), "double", "fir 32");
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR< posit<16, 1> >(bReportIndividualTestCases, 32, accumulation::fused, 0.0, true), "posit<16,1>", "fused fir 32");
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR< posit<16, 1> >(bReportIndividualTestCases, 32, accumulation::rounded, 1e-2, false), "posit<16,1>", "fir 32");
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR< posit<32, 2> >(bReportIndividualTestCases, 128, accumulation::fused, 1e-8, false), "posit<32,2>", "fused fir 128");
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR<Fixed>(bReportIndividualTestCases, 16, accumulation::fused, 0.0, true), "fixpnt<16,14>", "fused fir 16");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockProcessing< posit<16, 1> >(bReportIndividualTestCases, 33), "posit<16,1>", "block processing");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockProcessing<Fixed>(bReportIndividualTestCases, 8), "fixpnt<16,14>", "block processing");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIIR<double>(bReportIndividualTestCases, accumulation::rounded, 1e-14), "double", "biquad cascade");
+	nrOfFailedTestCases += ReportTestResult(VerifyIIR< posit<32, 2> >(bReportIndividualTestCases, accumulation::fused, 1e-7), "posit<32,2>", "fused biquad cascade");
+	nrOfFailedTestCases += ReportTestResult(VerifyIIR< posit<16, 1> >(bReportIndividualTestCases, accumulation::fused, 1e-2), "posit<16,1>", "fused biquad cascade");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimation< posit<16, 1> >(bReportIndividualTestCases, 48, 4), "posit<16,1>", "decimation by 4");
+	nrOfFailedTestCases += ReportTestResult(VerifyDecimation<Fixed>(bReportIndividualTestCases, 17, 3), "fixpnt<16,14>", "decimation by 3");
+	nrOfFailedTestCases += ReportTestResult(VerifyInterpolation< posit<16, 1> >(bReportIndividualTestCases, 48, 4), "posit<16,1>", "interpolation by 4");
+	nrOfFailedTestCases += ReportTestResult(VerifyInterpolation<Fixed>(bReportIndividualTestCases, 17, 3), "fixpnt<16,14>", "interpolation by 3");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyInvalidArguments(bReportIndividualTestCases), "float", "invalid arguments");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyFIR< posit<32, 2> >(bReportIndividualTestCases, 512, accumulation::fused, 1e-8, false), "posit<32,2>", "fused fir 512");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
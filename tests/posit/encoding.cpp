@@ -0,0 +1,214 @@
+// encoding.cpp: functional tests comparing the integer posit encoders to the bitblock reference encoder
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+// minimum set of include files to reflect source code dependencies
+#include <random>
+#include "universal/posit/posit.hpp"
+#include "universal/posit/numeric_limits.hpp"
+#include "universal/posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// the bitblock encoder that convert_ and convert_to_bb used before the integer encoders of the word and limb engines:
+// it builds regime, exponent, and fraction bitblocks of nbits + 3 + es bits, ors them together with a sticky bit,
+// and rounds to nearest even with a bitblock increment. Kept here as the reference for the integer encoders.
+template<size_t nbits, size_t es, size_t fbits>
+bitblock<nbits> ReferenceEncode(bool _sign, int _scale, const bitblock<fbits>& fraction_in) {
+	bitblock<nbits> ptt;
+	if (check_inward_projection_range<nbits, es>(_scale)) {    // regime dominated
+		// we are projecting to minpos/maxpos
+		int k = calculate_unconstrained_k<nbits, es>(_scale);
+		ptt = k < 0 ? minpos_pattern<nbits, es>(_sign) : maxpos_pattern<nbits, es>(_sign);
+	}
+	else {
+		const size_t pt_len = nbits + 3 + es;
+		bitblock<pt_len> pt_bits;
+		bitblock<pt_len> regime;
+		bitblock<pt_len> exponent;
+		bitblock<pt_len> fraction;
+		bitblock<pt_len> sticky_bit;
+
+		bool s = _sign;
+		int e = _scale;
+		bool r = (e >= 0);
+
+		unsigned run = (r ? 1 + (e >> es) : -(e >> es));
+		regime.set(0, 1 ^ r);
+		for (unsigned i = 1; i <= run; i++) regime.set(i, r);
+
+		unsigned esval = e % (uint32_t(1) << es);
+		exponent = convert_to_bitblock<pt_len>(esval);
+		unsigned nf = (unsigned)std::max<int>(0, (nbits + 1) - (2 + run + es));
+		// copy the most significant nf fraction bits into fraction
+		unsigned lsb = nf <= fbits ? 0 : nf - fbits;
+		for (unsigned i = lsb; i < nf; i++) fraction[i] = fraction_in[fbits - nf + i];
+
+		bool sb = anyAfter(fraction_in, int(fbits) - 1 - int(nf));
+
+		// construct the untruncated posit
+		// pt    = BitOr[BitShiftLeft[reg, es + nf + 1], BitShiftLeft[esval, nf + 1], BitShiftLeft[fv, 1], sb];
+		regime <<= es + nf + 1;
+		exponent <<= nf + 1;
+		fraction <<= 1;
+		sticky_bit.set(0, sb);
+
+		pt_bits |= regime;
+		pt_bits |= exponent;
+		pt_bits |= fraction;
+		pt_bits |= sticky_bit;
+
+		unsigned len = 1 + std::max<unsigned>((nbits + 1), (2 + run + es));
+		bool blast = pt_bits.test(len - nbits);
+		bool bafter = pt_bits.test(len - nbits - 1);
+		bool bsticky = anyAfter(pt_bits, int(len - nbits - 1) - 1);
+
+		bool rb = (blast & bafter) | (bafter & bsticky);
+
+		pt_bits <<= pt_len - len;
+		truncate(pt_bits, ptt);
+		if (rb) increment_bitset(ptt);
+		if (s) ptt = twos_complement(ptt);
+	}
+	return ptt;
+}
+
+// compare the encoder of posit<nbits,es> to the reference on a sign, scale, and fraction
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyEncoding(bool sign, int scale, const bitblock<fbits>& fraction, bool bReportIndividualTestCases) {
+	posit<nbits, es> p;
+	convert_(sign, scale, fraction, p);
+	bitblock<nbits> reference = ReferenceEncode<nbits, es, fbits>(sign, scale, fraction);
+	if (p.get() != reference) {
+		if (bReportIndividualTestCases) {
+			std::cout << "FAIL posit<" << nbits << "," << es << "> sign " << sign << " scale " << std::setw(5) << scale
+				<< " fraction " << fraction << " : " << p.get() << " vs reference " << reference << std::endl;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+// the scales that reach past the inward projection of maxpos and minpos
+template<size_t nbits, size_t es>
+int MaxEncodingScale() {
+	return int(nbits - 2) * (1 << es) + 3;
+}
+
+// enumerate both signs, all scales around the dynamic range, and all fraction patterns of fbits bits
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyEncoderExhaustively(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	int maxScale = MaxEncodingScale<nbits, es>();
+	bitblock<fbits> fraction;
+	for (int sign = 0; sign < 2; ++sign) {
+		for (int scale = -maxScale; scale <= maxScale; ++scale) {
+			for (uint64_t f = 0; f < (uint64_t(1) << fbits); ++f) {
+				fraction.setblock(0, f);
+				nrOfFailedTests += VerifyEncoding<nbits, es, fbits>(sign == 1, scale, fraction, bReportIndividualTestCases);
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// random signs, scales around the dynamic range, and fractions of fbits bits
+template<size_t nbits, size_t es, size_t fbits>
+int VerifyEncoderRandomly(size_t nrRandoms, bool bReportIndividualTestCases) {
+	std::mt19937_64 generator(nbits * 16 + es);
+	int maxScale = MaxEncodingScale<nbits, es>();
+	std::uniform_int_distribution<int> scales(-maxScale, maxScale);
+	int nrOfFailedTests = 0;
+	bitblock<fbits> fraction;
+	for (size_t n = 0; n < nrRandoms; ++n) {
+		for (size_t i = 0; i < bitblock<fbits>::nrBlocks; ++i) fraction.setblock(i, generator());
+		// zero trailing bits hit the ties of round to nearest even
+		if (n % 4 == 0) {
+			size_t zeros = size_t(generator() % fbits);
+			for (size_t i = 0; i < zeros; ++i) fraction.reset(i);
+		}
+		bool sign = (generator() & 1) != 0;
+		nrOfFailedTests += VerifyEncoding<nbits, es, fbits>(sign, scales(generator), fraction, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
+}} // namespace sw::unum
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	std::string tag = "posit encoding: ";
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<5, 1, 4>(true), "posit<5,1>", "encoding");
+
+#else
+
+	cout << "Integer posit encoders against the bitblock reference encoder" << endl;
+
+	// exhaustive: fractions shorter than, as long as, and longer than the fraction field
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<3, 0, 4>(bReportIndividualTestCases), "posit<3,0>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<4, 0, 5>(bReportIndividualTestCases), "posit<4,0>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<4, 1, 5>(bReportIndividualTestCases), "posit<4,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<5, 1, 3>(bReportIndividualTestCases), "posit<5,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<6, 1, 8>(bReportIndividualTestCases), "posit<6,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<8, 0, 10>(bReportIndividualTestCases), "posit<8,0>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<8, 1, 10>(bReportIndividualTestCases), "posit<8,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<8, 2, 6>(bReportIndividualTestCases), "posit<8,2>", "encoding");
+
+	// random: the word encoder up to 64 bits, the limb encoder beyond, with fractions that spill past a 64-bit limb
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<12, 1, 16>(10000, bReportIndividualTestCases), "posit<12,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<16, 1, 20>(10000, bReportIndividualTestCases), "posit<16,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<24, 1, 30>(10000, bReportIndividualTestCases), "posit<24,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<32, 2, 40>(10000, bReportIndividualTestCases), "posit<32,2>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<48, 2, 52>(10000, bReportIndividualTestCases), "posit<48,2>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<64, 3, 100>(10000, bReportIndividualTestCases), "posit<64,3>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<80, 3, 90>(5000, bReportIndividualTestCases), "posit<80,3>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<100, 2, 120>(5000, bReportIndividualTestCases), "posit<100,2>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<128, 4, 140>(5000, bReportIndividualTestCases), "posit<128,4>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<256, 5, 300>(2000, bReportIndividualTestCases), "posit<256,5>", "encoding");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderExhaustively<10, 1, 12>(bReportIndividualTestCases), "posit<10,1>", "encoding");
+	nrOfFailedTestCases += ReportTestResult(VerifyEncoderRandomly<32, 2, 40>(1000000, bReportIndividualTestCases), "posit<32,2>", "encoding");
+#endif // STRESS_TESTING
+
+#endif // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
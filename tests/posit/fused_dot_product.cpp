@@ -0,0 +1,176 @@
+// fused_dot_product.cpp: functional tests of the sequential and parallel fused dot products
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+#define POSIT_FAST_POSIT_32_2 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// the parallel fused dot product must round the same exact sum as the sequential one, for any number of threads
+template<size_t nbits, size_t es>
+int VerifyParallelFdp(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nbits);
+	std::uniform_real_distribution<double> distribution(-1024.0, 1024.0);
+	std::vector<Posit> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = distribution(generator);
+		y[i] = distribution(generator);
+	}
+	Posit reference = fdp(x, y);
+	Posit stride_reference = fdp_stride(n, x, 3, y, 2);
+	for (unsigned nrThreads = 1; nrThreads <= 8; ++nrThreads) {
+		Posit result = fdp_parallel(x, y, nrThreads);
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: fdp_parallel with " << nrThreads << " threads " << result << " != " << reference << std::endl;
+		}
+		result = fdp_stride_parallel(n, x, 3, y, 2, nrThreads);
+		if (result != stride_reference) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: fdp_stride_parallel with " << nrThreads << " threads " << result << " != " << stride_reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// partial sums that grow into the capacity bits of their quires cancel in the merge
+int VerifyCapacityMerge(bool bReportIndividualTestCases) {
+	using Posit = posit<8, 0>;
+	constexpr size_t n = 4 * internal::fdp_elements_per_thread;
+	int nrOfFailedTests = 0;
+	Posit mp = maxpos<8, 0>();
+	std::vector<Posit> x(n, mp), y(n, mp);
+	// the first half of the elements adds maxpos^2, the second half subtracts it, except for the last element
+	for (size_t i = n / 2; i < n - 1; ++i) y[i] = -mp;
+	y[n - 1] = Posit(1);
+	// 8192 accumulations of maxpos^2 per block need 13 capacity bits
+	Posit result = fdp_parallel<std::vector<Posit>, 16>(x, y, 4);
+	if (result != mp) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: capacity merge " << result << " != " << mp << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// a NaR element makes every fused dot product NaR: the sequential, strided, quire continuation, and parallel forms
+template<size_t nbits, size_t es>
+int VerifyNaRPropagation(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	std::vector<Posit> x(n, Posit(1.5)), y(n, Posit(2));
+	Posit nar;
+	nar.setnar();
+	// an element of the last block that the strided forms visit as well: x[3i] and y[2i]
+	size_t i = (n - 1) / 3;
+	std::vector<Posit> xnar(x), ynar(y);
+	xnar[3 * i] = nar;
+	ynar[2 * i] = nar;
+
+	std::vector<Posit> results;
+	results.push_back(fdp(xnar, y));
+	results.push_back(fdp(x, ynar));
+	results.push_back(fdp_stride(n, xnar, 3, y, 2));
+	results.push_back(fdp_stride(n, x, 3, ynar, 2));
+	for (unsigned nrThreads = 1; nrThreads <= 4; ++nrThreads) {
+		results.push_back(fdp_parallel(xnar, y, nrThreads));
+		results.push_back(fdp_stride_parallel(n, x, 3, ynar, 2, nrThreads));
+	}
+	quire<nbits, es, 10> q;
+	fdp_qc(q, n, xnar, 1, y, 1);
+	Posit sum;
+	convert(q.to_value(), sum);
+	results.push_back(sum);
+	// the quire stays NaR through the fused multiply-accumulates that follow
+	q.reset();
+	q.msc(x[0], nar);
+	q.mac(x[0], y[0]);
+	convert(q.to_value(), sum);
+	results.push_back(sum);
+
+	for (size_t r = 0; r < results.size(); ++r) {
+		if (!results[r].isnar()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: fused dot product " << r << " with a NaR element yields " << results[r] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Fused dot product validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<16, 1>(true, 100000), "posit<16,1>", "fdp_parallel");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<16, 1>(bReportIndividualTestCases, 100003), "posit<16,1>", "fdp_parallel");
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<32, 2>(bReportIndividualTestCases, 100003), "posit<32,2>", "fdp_parallel");
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<8, 0>(bReportIndividualTestCases, 50001), "posit<8,0>", "fdp_parallel");
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<16, 1>(bReportIndividualTestCases, 17), "posit<16,1>", "fdp_parallel short");
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<16, 1>(bReportIndividualTestCases, 0), "posit<16,1>", "fdp_parallel empty");
+	nrOfFailedTestCases += ReportTestResult(VerifyCapacityMerge(bReportIndividualTestCases), "posit<8,0>", "fdp_parallel capacity merge");
+	nrOfFailedTestCases += ReportTestResult(VerifyNaRPropagation<16, 1>(bReportIndividualTestCases, 4 * internal::fdp_elements_per_thread), "posit<16,1>", "fdp NaR");
+	nrOfFailedTestCases += ReportTestResult(VerifyNaRPropagation<32, 2>(bReportIndividualTestCases, 4 * internal::fdp_elements_per_thread), "posit<32,2>", "fdp NaR");
+	nrOfFailedTestCases += ReportTestResult(VerifyNaRPropagation<80, 3>(bReportIndividualTestCases, 64), "posit<80,3>", "fdp NaR");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyParallelFdp<32, 2>(bReportIndividualTestCases, 10000019), "posit<32,2>", "fdp_parallel");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
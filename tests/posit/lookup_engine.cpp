@@ -0,0 +1,200 @@
+// lookup_engine.cpp: functional tests comparing the table-driven posit<8,es> engine to the bitblock reference arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: use the lookup engine for the posit<8,es> operators and functions
+#define POSIT_LOOKUP_POSIT_8 1
+
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/numeric_limits.hpp"
+#include "universal/posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math_functions.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_randoms.hpp"
+
+namespace sw {
+namespace unum {
+
+const char* OperatorSymbol(int opcode) {
+	switch (opcode) {
+	case OPCODE_ADD: return "+";
+	case OPCODE_SUB: return "-";
+	case OPCODE_MUL: return "*";
+	case OPCODE_DIV: return "/";
+	default:         return "?";
+	}
+}
+
+// enumerate all operand pairs and compare the lookup tables to the reference arithmetic
+template<size_t es>
+int VerifyLookupBinaryOperators(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	posit<8, es> pa, pb, pref, presult;
+	for (int opcode = OPCODE_ADD; opcode <= OPCODE_DIV; ++opcode) {
+		for (unsigned i = 0; i < 256; i++) {
+			pa.set_raw_bits(i);
+			for (unsigned j = 0; j < 256; j++) {
+				pb.set_raw_bits(j);
+				executeReferenceBinary(opcode, pa, pb, pref);
+				presult = executeOperator(opcode, pa, pb);
+				if (presult != pref) {
+					nrOfFailedTests++;
+					if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", OperatorSymbol(opcode), pa, pb, pref, presult);
+				}
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// reciprocals must match the reference division, roots the correctly rounded root of the long double,
+// and exp/log the double precision shims of the math library
+template<size_t es>
+int VerifyLookupUnaryFunctions(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	posit<8, es> one(1), pa, pref, presult;
+	for (unsigned i = 0; i < 256; i++) {
+		pa.set_raw_bits(i);
+		executeReferenceBinary(OPCODE_DIV, one, pa, pref);
+		presult = pa.reciprocate();
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "reciprocate", pa, pref, presult);
+		}
+		if (pa.isneg() || pa.isnar()) {
+			pref.setnar();
+		}
+		else {
+			pref = std::sqrt((long double)pa);
+		}
+		presult = sqrt(pa);
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", pa, pref, presult);
+		}
+		if (pa.isnar()) {
+			pref.setnar();
+		}
+		else {
+			double d = std::exp(double(pa));
+			if (d == 0.0) pref = minpos<8, es>(); else pref = d;
+		}
+		presult = exp(pa);
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "exp", pa, pref, presult);
+		}
+		pref = std::log(double(pa));
+		presult = log(pa);
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "log", pa, pref, presult);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t es>
+int VerifyLookupEngine(bool bReportIndividualTestCases) {
+	return VerifyLookupBinaryOperators<es>(bReportIndividualTestCases) + VerifyLookupUnaryFunctions<es>(bReportIndividualTestCases);
+}
+
+// posit<8,es> arithmetic in the dynamic initialization of global objects must see generated tables
+const posit<8, 1> globalSum        = posit<8, 1>(1.5) + posit<8, 1>(0.25);
+const posit<8, 1> globalDifference = posit<8, 1>(1.5) - posit<8, 1>(0.25);
+const posit<8, 1> globalProduct    = posit<8, 1>(1.5) * posit<8, 1>(0.25);
+const posit<8, 1> globalQuotient   = posit<8, 1>(1.5) / posit<8, 1>(0.25);
+const posit<8, 1> globalRoot       = sqrt(posit<8, 1>(0.25));
+
+int VerifyLookupInGlobalInitializers(bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	const posit<8, 1> results[] = { globalSum, globalDifference, globalProduct, globalQuotient, globalRoot };
+	const double references[] = { 1.75, 1.25, 0.375, 6.0, 0.5 };
+	for (size_t i = 0; i < sizeof(references) / sizeof(references[0]); ++i) {
+		if (double(results[i]) != references[i]) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) std::cout << "FAIL: global initializer " << i << " : " << results[i] << " != " << references[i] << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Posit<8,es> lookup engine validation" << endl;
+
+#if MANUAL_TESTING
+	posit<8, 2> a, b;
+	a.set_raw_bits(0x41);
+	b.set_raw_bits(0xC3);
+	cout << components_to_string(a + b) << endl;
+	posit<8, 2> c;
+	executeReferenceBinary(OPCODE_ADD, a, b, c);
+	cout << components_to_string(c) << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<2>(true), "posit<8,2>", "lookup engine");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<0>(bReportIndividualTestCases), "posit<8,0>", "lookup engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<1>(bReportIndividualTestCases), "posit<8,1>", "lookup engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<2>(bReportIndividualTestCases), "posit<8,2>", "lookup engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<3>(bReportIndividualTestCases), "posit<8,3>", "lookup engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupInGlobalInitializers(bReportIndividualTestCases), "posit<8,1>", "lookup in global initializers");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<4>(bReportIndividualTestCases), "posit<8,4>", "lookup engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupEngine<5>(bReportIndividualTestCases), "posit<8,5>", "lookup engine");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,243 @@
+// packed_posit_array.cpp: functional tests of the bit-packed posit arrays
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable the fast specializations
+#define POSIT_FAST_POSIT_16_1 1
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+
+#include <numeric>
+#include <universal/posit/posit>
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_helpers.hpp"
+
+namespace sw {
+namespace unum {
+
+// element access and assignment through the proxy must not disturb the neighboring elements
+template<size_t nbits, size_t es>
+int VerifyElementAccess(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	constexpr uint64_t mask = (nbits == 64 ? ~0ull : ((1ull << nbits) - 1));
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(nbits);
+	std::vector<uint64_t> reference(n);
+	packed_posit_array<nbits, es> a(n);
+	for (size_t i = 0; i < n; ++i) {
+		reference[i] = generator() & mask;
+		Posit p;
+		p.set_raw_bits(reference[i]);
+		a[i] = p;
+	}
+	// overwrite every third element with its negation
+	for (size_t i = 0; i < n; i += 3) {
+		Posit p;
+		p.set_raw_bits(reference[i]);
+		a[i] = -p;
+		reference[i] = (-p).encoding();
+	}
+	for (size_t i = 0; i < n; ++i) {
+		if (a.raw(i) != reference[i] || Posit(a[i]).encoding() != reference[i]) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: element " << i << " " << std::hex << a.raw(i) << " reference " << reference[i] << std::dec << std::endl;
+		}
+	}
+	if (a.bytes() != ((n * nbits + 63) / 64) * 8) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: footprint of " << n << " elements is " << a.bytes() << " bytes" << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+// bulk unpack and pack of spans at all alignments against element access
+template<size_t nbits, size_t es>
+int VerifyBulkTransfer(bool bReportIndividualTestCases, size_t n) {
+	using Posit = posit<nbits, es>;
+	using Lane = typename packed_posit_array<nbits, es>::lane_type;
+	constexpr uint64_t mask = (nbits == 64 ? ~0ull : ((1ull << nbits) - 1));
+	int nrOfFailedTests = 0;
+	std::mt19937_64 generator(n);
+	packed_posit_array<nbits, es> a(n), b(n);
+	for (size_t i = 0; i < n; ++i) a.set_raw(i, generator() & mask);
+	for (size_t first = 0; first < 70 && first < n; first += 7) {
+		size_t count = n - first - (first % 5);
+		std::vector<Lane> lanes(count);
+		std::vector<Posit> posits(count);
+		a.unpack(first, count, lanes.data());
+		a.unpack(first, count, posits.data());
+		for (size_t i = 0; i < count; ++i) {
+			if (lanes[i] != a.raw(first + i) || posits[i].encoding() != a.raw(first + i)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << "FAIL: unpack element " << first + i << std::endl;
+				break;
+			}
+		}
+		// pack the span into a clean array and a copy that is filled with ones: the elements outside the span must survive
+		packed_posit_array<nbits, es> c(n);
+		for (size_t i = 0; i < n; ++i) c.set_raw(i, mask);
+		b = packed_posit_array<nbits, es>(n);
+		b.pack(first, count, lanes.data());
+		c.pack(first, count, posits.data());
+		for (size_t i = 0; i < n; ++i) {
+			bool inside = (i >= first && i < first + count);
+			if (b.raw(i) != (inside ? a.raw(i) : 0) || c.raw(i) != (inside ? a.raw(i) : mask)) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cout << "FAIL: pack element " << i << " of span [" << first << ", " << first + count << ")" << std::endl;
+				break;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// widening all encodings to IEEE values and narrowing them back must agree with the posit conversions
+template<size_t nbits, size_t es>
+int VerifyConversion(bool bReportIndividualTestCases) {
+	using Posit = posit<nbits, es>;
+	int nrOfFailedTests = 0;
+	const size_t NR_POSITS = (size_t(1) << nbits);
+	packed_posit_array<nbits, es> a(NR_POSITS), b(NR_POSITS);
+	for (size_t i = 0; i < NR_POSITS; ++i) a.set_raw(i, i);
+	std::vector<double> values(NR_POSITS);
+	std::vector<float> floats(NR_POSITS);
+	a.unpack(0, NR_POSITS, values.data());
+	a.unpack(0, NR_POSITS, floats.data());
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		Posit p;
+		p.set_raw_bits(i);
+		double reference = double(p);
+		if ((values[i] != reference && !(p.isnar() && std::isnan(values[i]))) || (floats[i] != float(reference) && !(p.isnar() && std::isnan(floats[i])))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: widen " << p << " to " << values[i] << std::endl;
+		}
+	}
+	// round trip, and rounding of the midpoints between neighboring posits and of values beyond the dynamic range
+	b.pack(0, NR_POSITS, values.data());
+	for (size_t i = 0; i < NR_POSITS; ++i) {
+		if (b.raw(i) != i) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: narrow " << values[i] << std::endl;
+		}
+	}
+	std::mt19937_64 generator(nbits);
+	std::uniform_real_distribution<double> distribution(-64.0, 64.0);
+	std::vector<double> samples;
+	for (size_t i = 0; i < 1000; ++i) {
+		samples.push_back(std::ldexp(distribution(generator), int(generator() % 160) - 80));
+	}
+	for (size_t i = 1; i + 1 < NR_POSITS / 2; ++i) samples.push_back((values[i] + values[i + 1]) / 2.0);
+	samples.push_back(std::numeric_limits<double>::infinity());
+	samples.push_back(std::numeric_limits<double>::quiet_NaN());
+	samples.push_back(std::numeric_limits<double>::denorm_min());
+	packed_posit_array<nbits, es> c(samples.size());
+	c.pack(0, samples.size(), samples.data());
+	for (size_t i = 0; i < samples.size(); ++i) {
+		Posit reference(samples[i]);
+		if (c.raw(i) != reference.encoding()) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: narrow " << samples[i] << " to " << Posit(c[i]) << " reference " << reference << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the iterators work with the standard algorithms
+int VerifyIterators(bool bReportIndividualTestCases) {
+	using Posit = posit<12, 1>;
+	int nrOfFailedTests = 0;
+	packed_posit_array<12, 1> a = { Posit(1), Posit(2), Posit(3), Posit(4.5) };
+	a.push_back(Posit(-0.5));
+	std::vector<Posit> v(a.begin(), a.end());
+	double sum = std::accumulate(a.cbegin(), a.cend(), 0.0, [](double s, const Posit& p) { return s + double(p); });
+	std::fill(a.begin() + 1, a.begin() + 3, Posit(0.25));
+	*(a.end() - 1) += Posit(1);
+	if (v.size() != 5 || double(v[3]) != 4.5 || sum != 10.0 || a.end() - a.begin() != 5
+	    || double(Posit(a[1])) != 0.25 || double(Posit(a[2])) != 0.25 || double(a.back()) != 0.5 || double(a.front()) != 1.0) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: iterators" << std::endl;
+	}
+	a.resize(2);
+	a.resize(4);
+	if (a.size() != 4 || !a[2].operator Posit().iszero() || !a.at(3).iszero()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: resize" << std::endl;
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "packed posit array validation" << endl;
+
+#if MANUAL_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer<10, 0>(true, 100), "posit<10,0>", "bulk transfer");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyElementAccess<10, 0>(bReportIndividualTestCases, 1000), "posit<10,0>", "element access");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementAccess<12, 1>(bReportIndividualTestCases, 1000), "posit<12,1>", "element access");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementAccess<16, 1>(bReportIndividualTestCases, 1000), "posit<16,1>", "element access");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementAccess<48, 2>(bReportIndividualTestCases, 1000), "posit<48,2>", "element access");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer< 5, 0>(bReportIndividualTestCases, 1000), "posit<5,0>", "bulk transfer");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer< 8, 0>(bReportIndividualTestCases, 1000), "posit<8,0>", "bulk transfer");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer<10, 0>(bReportIndividualTestCases, 1000), "posit<10,0>", "bulk transfer");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer<12, 1>(bReportIndividualTestCases, 1000), "posit<12,1>", "bulk transfer");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer<16, 1>(bReportIndividualTestCases, 1000), "posit<16,1>", "bulk transfer");
+	nrOfFailedTestCases += ReportTestResult(VerifyBulkTransfer<48, 2>(bReportIndividualTestCases, 1000), "posit<48,2>", "bulk transfer");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyConversion< 8, 0>(bReportIndividualTestCases), "posit<8,0>", "conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyConversion<10, 0>(bReportIndividualTestCases), "posit<10,0>", "conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyConversion<12, 1>(bReportIndividualTestCases), "posit<12,1>", "conversion");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIterators(bReportIndividualTestCases), "posit<12,1>", "iterators");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyConversion<16, 1>(bReportIndividualTestCases), "posit<16,1>", "conversion");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
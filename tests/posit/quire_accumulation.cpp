@@ -251,10 +251,112 @@ int ValidateBorrowPropagation(bool bReportIndividualTestCases) {
 	return nrOfFailedTests;
 }
 
+// accumulate random products of small posits, which a double holds exactly, with sign changes,
+// carries, and borrows across many carry propagations, and merge quires along the way
 template<size_t nbits, size_t es, size_t capacity = 2>
 int ValidateQuireAccumulation(bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	static_assert(2 * quire<nbits, es, capacity>::half_range + capacity < 53, "exact double reference requires small posits");
+	constexpr size_t NR_ACCUMULATIONS = 1000;
+	int nrOfFailedTests = 0;
+
+	std::mt19937_64 generator(nbits + es);
+	quire<nbits, es, capacity> q, partial;
+	double reference = 0.0, partial_reference = 0.0;
+	for (size_t i = 0; i < NR_ACCUMULATIONS; ++i) {
+		posit<nbits, es> a, b;
+		a.set_raw_bits(generator());
+		b.set_raw_bits(generator());
+		if (a.isnar() || b.isnar()) continue;
+		if (i % 3 == 0) {
+			partial -= quire_mul(a, b);
+			partial_reference -= double(a) * double(b);
+		}
+		else {
+			q += quire_mul(a, b);
+			reference += double(a) * double(b);
+		}
+		if (i % 100 == 99) {
+			q += partial;
+			reference += partial_reference;
+		}
+		if (!(q == value<52>(reference))) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: accumulation " << i << " quire " << q.to_value() << " reference " << reference << std::endl;
+		}
+	}
+	posit<nbits, es> sum;
+	convert(q.to_value(), sum);
+	if (sum != posit<nbits, es>(reference)) ++nrOfFailedTests;
+	return nrOfFailedTests;
+}
+
+// the fused multiply-accumulate must leave the quire in the same state as accumulating quire_mul
+template<size_t nbits, size_t es, size_t capacity = 30>
+int ValidateFusedMultiplyAccumulate(bool bReportIndividualTestCases, size_t nrOfAccumulations) {
+	using namespace sw::unum;
 	int nrOfFailedTests = 0;
 
+	std::mt19937_64 generator(nbits * 16 + es);
+	quire<nbits, es, capacity> q, qref;
+	for (size_t i = 0; i < nrOfAccumulations; ++i) {
+		posit<nbits, es> a, b;
+		a.set_raw_bits(generator());
+		b.set_raw_bits(generator());
+		if (a.isnar() || b.isnar()) continue;
+		if (i % 11 == 0) a.setzero();
+		if (generator() & 1) {
+			q.mac(a, b);
+			qref += quire_mul(a, b);
+		}
+		else {
+			q.msc(a, b);
+			qref -= quire_mul(a, b);
+		}
+		if (q != qref) {
+			++nrOfFailedTests;
+			if (bReportIndividualTestCases) std::cout << "FAIL: " << a << " * " << b << "\n" << q << "\n" << qref << std::endl;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a NaR value makes the quire NaR: further accumulations, and the sum of quires, keep it NaR until a reset
+template<size_t nbits, size_t es, size_t capacity = 30>
+int ValidateNaRAccumulation(bool bReportIndividualTestCases) {
+	using namespace sw::unum;
+	int nrOfFailedTests = 0;
+
+	posit<nbits, es> nar, x(1.5), y(2);
+	nar.setnar();
+	quire<nbits, es, capacity> q;
+	q += quire_mul(x, y);
+	q += nar.to_value();
+	q += quire_mul(x, y);
+	q -= quire_mul(x, y);
+	posit<nbits, es> sum;
+	convert(q.to_value(), sum);
+	if (!q.isnar() || !sum.isnar()) {
+		++nrOfFailedTests;
+		if (bReportIndividualTestCases) std::cout << "FAIL: quire += NaR yields " << sum << std::endl;
+	}
+	// a NaR subtracted, or a NaR product, is NaR as well
+	quire<nbits, es, capacity> qsub, qmul;
+	qsub -= nar.to_value();
+	qmul += quire_mul(nar, y);
+	if (!qsub.isnar() || !qmul.isnar()) ++nrOfFailedTests;
+	// the sum of quires carries the NaR
+	quire<nbits, es, capacity> finite;
+	finite += quire_mul(x, y);
+	finite += q;
+	if (!finite.isnar()) ++nrOfFailedTests;
+	// a reset, or an assignment, clears the NaR
+	q.reset();
+	q += quire_mul(x, y);
+	convert(q.to_value(), sum);
+	if (q.isnar() || sum != posit<nbits, es>(3)) ++nrOfFailedTests;
+	finite = 1;
+	if (finite.isnar()) ++nrOfFailedTests;
 	return nrOfFailedTests;
 }
 
@@ -330,6 +432,17 @@ try {
 	nrOfFailedTestCases += ReportTestResult(ValidateCarryPropagation<4, 1>(bReportIndividualTestCases), "carry propagation", "increment");
 	cout << "Borrow Propagation\n";
 	nrOfFailedTestCases += ReportTestResult(ValidateBorrowPropagation<4, 1>(bReportIndividualTestCases), "borrow propagation", "increment");
+	cout << "Accumulation\n";
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulation<8, 0, 12>(bReportIndividualTestCases), "quire<8,0,12>", "accumulation");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireAccumulation<6, 1, 12>(bReportIndividualTestCases), "quire<6,1,12>", "accumulation");
+	cout << "Fused multiply-accumulate\n";
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedMultiplyAccumulate<8, 0>(bReportIndividualTestCases, 1000), "quire<8,0,30>", "mac/msc");
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedMultiplyAccumulate<16, 1>(bReportIndividualTestCases, 1000), "quire<16,1,30>", "mac/msc");
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedMultiplyAccumulate<32, 2>(bReportIndividualTestCases, 1000), "quire<32,2,30>", "mac/msc");
+	nrOfFailedTestCases += ReportTestResult(ValidateFusedMultiplyAccumulate<64, 3>(bReportIndividualTestCases, 200), "quire<64,3,30>", "mac/msc");
+	cout << "NaR accumulation\n";
+	nrOfFailedTestCases += ReportTestResult(ValidateNaRAccumulation<16, 1>(bReportIndividualTestCases), "quire<16,1,30>", "NaR");
+	nrOfFailedTestCases += ReportTestResult(ValidateNaRAccumulation<32, 2>(bReportIndividualTestCases), "quire<32,2,30>", "NaR");
 
 #ifdef ISSUE_45_DEBUG
 	{	
@@ -7,9 +7,9 @@
 // Configure the posit template environment
 // first: enable fast specialized posit<256,5>
 //#define POSIT_FAST_SPECIALIZATION   // turns on all fast specializations
-#define POSIT_FAST_POSIT_256_5 0
+#define POSIT_FAST_POSIT_256_5 1
 // second: enable posit arithmetic exceptions
-#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/posit/posit>
 // test helpers, such as, ReportTestResults
 #include "../../utils/test_helpers.hpp"
@@ -19,17 +19,70 @@
 Standard posits with nbits = 256 have 5 exponent bits.
 */
 
-#define STRESS_TESTING 1
+// doubles of moderate scale are exact in posit<256,5> and must survive the round trip
+template<size_t nbits, size_t es>
+int ValidateDoubleRoundTrip(const std::string& tag, bool bReportIndividualTestCases, uint32_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	std::random_device rd;
+	std::mt19937_64 eng(rd());
+	std::uniform_real_distribution<double> distribution(-1.0e6, 1.0e6);
+	posit<nbits, es> p;
+	for (uint32_t i = 0; i < nrOfRandoms; ++i) {
+		double v = distribution(eng);
+		p = v;
+		if (double(p) != v) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL " << v << " != " << double(p) << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// reciprocals must match the reference division, roots must square back to the radicand within rounding
+template<size_t nbits, size_t es>
+int ValidateReciprocalAndRoot(const std::string& tag, bool bReportIndividualTestCases, uint32_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	std::random_device rd;
+	std::mt19937_64 eng(rd());
+	posit<nbits, es> one(1), p, presult, preference;
+	for (uint32_t i = 0; i < nrOfRandoms; ++i) {
+		randomEncoding(p, eng);
+		if (p.isnar() || p.iszero()) continue;
+		executeReferenceBinary(OPCODE_DIV, one, p, preference);
+		presult = p.reciprocate();
+		if (presult != preference) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "reciprocate", p, preference, presult);
+		}
+		if (p.isneg()) p = -p;
+		presult = sqrt(p);
+		// the square of the root brackets the radicand between the squares of its neighbors
+		posit<nbits, es> below(presult), above(presult), square, lower, upper;
+		--below; ++above;
+		executeReferenceBinary(OPCODE_MUL, presult, presult, square);
+		executeReferenceBinary(OPCODE_MUL, below, below, lower);
+		executeReferenceBinary(OPCODE_MUL, above, above, upper);
+		if (lower > p || upper < p) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", p, square, presult);
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+#define STRESS_TESTING 0
 
 int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
-	const size_t RND_TEST_CASES = 10000;
+	constexpr size_t RND_TEST_CASES = 1000;
 
-	const size_t nbits = 256;
-	const size_t es = 5;
+	constexpr size_t nbits = 256;
+	constexpr size_t es = 5;
 
 	int nrOfFailedTestCases = 0;
 	bool bReportIndividualTestCases = false;
@@ -44,22 +97,52 @@ try {
 	posit<nbits, es> p;
 	cout << dynamic_range(p) << endl << endl;
 
-	// TODO: as we don't have a reference floating point implementation to validate
-	// the arithmetic operations we are going to ignore the failures
-#if STRESS_TESTING
+	// special cases
+	p = 0;
+	if (!p.iszero()) ++nrOfFailedTestCases;
+	p = NAN;
+	if (!p.isnar()) ++nrOfFailedTestCases;
+	p = INFINITY;
+	if (!p.isnar()) ++nrOfFailedTestCases;
+	p = minpos<nbits, es>();
+	if (p.ispos() == false || p <= 0) ++nrOfFailedTestCases;
+	p = maxpos<nbits, es>();
+	if (p.isneg() || p.isnar()) ++nrOfFailedTestCases;
+
+	// integer and native floating-point conversions
+	cout << "Conversion tests" << endl;
+	int nrOfConversionFailures = 0;
+	for (long long i = -1024; i <= 1024; ++i) {
+		p = i;
+		if ((long long)p != i) ++nrOfConversionFailures;
+		p = double(i) / 1024.0;
+		if (double(p) != double(i) / 1024.0) ++nrOfConversionFailures;
+	}
+	p = 0x7FFFFFFFFFFFFFFFll;  // exact: the significand has more than 64 bits
+	if ((long double)(p - posit<nbits, es>(0x7FFFFFFFFFFFFF00ll)) != 255.0l) ++nrOfConversionFailures;
+	nrOfFailedTestCases += ReportTestResult(nrOfConversionFailures, tag, "integer/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateDoubleRoundTrip<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "double        ");
+
+	// the arithmetic is validated against the bitblock reference arithmetic of the generic posit
 	cout << "Arithmetic tests " << RND_TEST_CASES << " randoms each" << endl;
-	cout << "Without an arithmetic reference, test failures can be ignored" << endl;
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition      ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction   ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateReciprocalAndRoot<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "reciprocate/sqrt");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, 100 * RND_TEST_CASES), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, 100 * RND_TEST_CASES), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, 100 * RND_TEST_CASES), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, 100 * RND_TEST_CASES), tag, "division      ");
 #endif
-	nrOfFailedTestCases = 0;
+
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
 	std::cerr << msg << std::endl;
-	return EXIT_SUCCESS; //as we manually throwing the not supported yet it should not fall through the cracks     EXIT_FAILURE;
+	return EXIT_FAILURE;
 }
 catch (const posit_arithmetic_exception& err) {
 	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
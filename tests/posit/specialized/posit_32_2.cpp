@@ -53,6 +53,40 @@ void CheckAddition() {
 	}
 }
 
+// the exhaustive logic tests only reach the small positive encodings: compare negative posits
+// to zero, to each other, and to positive posits, with NaR less than any other posit
+template<size_t nbits, size_t es>
+int VerifySignedComparisons(bool bReportIndividualTestCases) {
+	using namespace std;
+	using namespace sw::unum;
+
+	vector< posit<nbits, es> > v;
+	posit<nbits, es> nar;
+	nar.setnar();
+	v.push_back(nar);
+	v.push_back(-maxpos<nbits, es>());
+	for (double d : { -1.0e6, -3.0, -2.0, -1.0, -0.75, -0.5, -1.0e-6, 0.0, 1.0e-6, 0.5, 1.0, 2.0, 1.0e6 }) {
+		v.push_back(posit<nbits, es>(d));
+	}
+	v.push_back(-minpos<nbits, es>());
+	v.push_back(minpos<nbits, es>());
+	v.push_back(maxpos<nbits, es>());
+
+	int nrOfFailedTests = 0;
+	for (const posit<nbits, es>& a : v) {
+		for (const posit<nbits, es>& b : v) {
+			// NaR sorts below all other posits
+			bool lt = a.isnar() ? !b.isnar() : (b.isnar() ? false : double(a) < double(b));
+			bool eq = a.isnar() ? b.isnar() : (b.isnar() ? false : double(a) == double(b));
+			if ((a < b) != lt || (a > b) != (!lt && !eq) || (a <= b) != (lt || eq) || (a >= b) != !lt) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) cout << "FAIL: " << a << " vs " << b << " : < " << (a < b) << " > " << (a > b) << " <= " << (a <= b) << " >= " << (a >= b) << endl;
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
 int main(int argc, char** argv)
 try {
 	using namespace std;
@@ -96,6 +130,7 @@ try {
 	nrOfFailedTestCases += ReportTestResult( ValidatePositLogicLessOrEqualThan   <nbits, es>(), tag, "    <=          (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidatePositLogicGreaterThan       <nbits, es>(), tag, "    >           (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidatePositLogicGreaterOrEqualThan<nbits, es>(), tag, "    >=          (native)  ");
+	nrOfFailedTestCases += ReportTestResult( VerifySignedComparisons             <nbits, es>(bReportIndividualTestCases), tag, "    < > <= >=   (signed)  ");
 
 	// conversion tests
 	// internally this generators are clamped as the state space 2^33 is too big
@@ -111,6 +146,8 @@ try {
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES),  tag, "subtraction     (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES),  tag, "multiplication  (native)  ");
 	nrOfFailedTestCases += ReportTestResult( ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES),  tag, "division        (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateCompoundAssignmentThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "+=              (native)  ");
+	nrOfFailedTestCases += ReportTestResult( ValidateCompoundAssignmentThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "-=              (native)  ");
 
 	// elementary function tests
 	cout << "Elementary function tests " << endl;
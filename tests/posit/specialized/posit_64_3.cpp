@@ -6,7 +6,7 @@
 
 // Configure the posit template environment
 // first: enable fast specialized posit<64,3>
-#define POSIT_FAST_POSIT_64_3 0
+#define POSIT_FAST_POSIT_64_3 1
 // second: enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/posit/posit>
@@ -18,14 +18,71 @@
 Standard posit with nbits = 64 have es = 3 exponent bits.
 */
 
-#define STRESS_TESTING 1
+// the encodings of posit<64,3> have at most 59 significant bits, so they are exact in an 80-bit long double
+template<size_t nbits, size_t es>
+int ValidateLongDoubleRoundTrip(const std::string& tag, bool bReportIndividualTestCases, uint32_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	if (std::numeric_limits<long double>::digits < 64) {
+		std::cout << tag << " long double does not have a 64-bit significand: round trip test skipped" << std::endl;
+		return 0;
+	}
+	std::random_device rd;
+	std::mt19937_64 eng(rd());
+	posit<nbits, es> p, presult;
+	for (uint32_t i = 0; i < nrOfRandoms; ++i) {
+		randomEncoding(p, eng);
+		if (p.isnar()) continue;
+		presult = (long double)p;
+		if (presult != p) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) std::cout << tag << " FAIL " << p.get() << " != " << presult.get() << std::endl;
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// reciprocals must match the reference division, roots must square back to the radicand within rounding
+template<size_t nbits, size_t es>
+int ValidateReciprocalAndRoot(const std::string& tag, bool bReportIndividualTestCases, uint32_t nrOfRandoms) {
+	using namespace sw::unum;
+	int nrOfFailedTestCases = 0;
+	std::random_device rd;
+	std::mt19937_64 eng(rd());
+	posit<nbits, es> one(1), p, presult, preference;
+	for (uint32_t i = 0; i < nrOfRandoms; ++i) {
+		randomEncoding(p, eng);
+		if (p.isnar() || p.iszero()) continue;
+		executeReferenceBinary(OPCODE_DIV, one, p, preference);
+		presult = p.reciprocate();
+		if (presult != preference) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "reciprocate", p, preference, presult);
+		}
+		if (p.isneg()) p = -p;
+		presult = sqrt(p);
+		// the square of the root brackets the radicand between the squares of its neighbors
+		posit<nbits, es> below(presult), above(presult), square, lower, upper;
+		--below; ++above;
+		executeReferenceBinary(OPCODE_MUL, presult, presult, square);
+		executeReferenceBinary(OPCODE_MUL, below, below, lower);
+		executeReferenceBinary(OPCODE_MUL, above, above, upper);
+		if (lower > p || upper < p) {
+			nrOfFailedTestCases++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", p, square, presult);
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+#define STRESS_TESTING 0
 
 int main(int argc, char** argv)
 try {
 	using namespace std;
 	using namespace sw::unum;
 
-	constexpr size_t RND_TEST_CASES = 100000;
+	constexpr size_t RND_TEST_CASES = 10000;
 
 	constexpr size_t nbits = 64;
 	constexpr size_t es = 3;
@@ -51,17 +108,35 @@ try {
 	p = INFINITY;
 	if (!p.isnar()) ++nrOfFailedTestCases;
 
-	// TODO: as we don't have a reference floating point implementation to validate
-	// the arithmetic operations we are going to ignore the failures
-#if STRESS_TESTING
+	// integer and native floating-point conversions
+	cout << "Conversion tests" << endl;
+	int nrOfConversionFailures = 0;
+	for (long long i = -1024; i <= 1024; ++i) {
+		p = i;
+		if ((long long)p != i) ++nrOfConversionFailures;
+		p = double(i) / 1024.0;
+		if (double(p) != double(i) / 1024.0) ++nrOfConversionFailures;
+	}
+	p = 0x7FFFFFFFFFFFFFFFll;  // rounds to 2^63
+	if ((long double)p != 9223372036854775808.0l) ++nrOfConversionFailures;
+	nrOfFailedTestCases += ReportTestResult(nrOfConversionFailures, tag, "integer/double");
+	nrOfFailedTestCases += ReportTestResult(ValidateLongDoubleRoundTrip<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "long double   ");
+
+	// the arithmetic is validated against the bitblock reference arithmetic
 	cout << "Arithmetic tests " << RND_TEST_CASES << " randoms each" << endl;
-	cout << "Without an arithmetic reference, test failures can be ignored" << endl;
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition      ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction   ");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
-	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorThroughRandoms<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, RND_TEST_CASES), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, RND_TEST_CASES), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, RND_TEST_CASES), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, RND_TEST_CASES), tag, "division      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateReciprocalAndRoot<nbits, es>(tag, bReportIndividualTestCases, RND_TEST_CASES), tag, "reciprocate/sqrt");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_ADD, 100 * RND_TEST_CASES), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_SUB, 100 * RND_TEST_CASES), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_MUL, 100 * RND_TEST_CASES), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(ValidateBinaryOperatorAgainstReference<nbits, es>(tag, bReportIndividualTestCases, OPCODE_DIV, 100 * RND_TEST_CASES), tag, "division      ");
 #endif
-	nrOfFailedTestCases = 0;
+
 	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 catch (char const* msg) {
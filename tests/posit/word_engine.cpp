@@ -0,0 +1,212 @@
+// word_engine.cpp: functional tests comparing the word-native posit arithmetic engine to the bitblock reference arithmetic
+//
+// Copyright (C) 2017-2020 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// Configure the posit template environment
+// first: enable general or specialized specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// third: use the word-native engine for the posit arithmetic operators
+#define POSIT_WORD_ENGINE 1
+
+// minimum set of include files to reflect source code dependencies
+#include "universal/posit/posit.hpp"
+#include "universal/posit/numeric_limits.hpp"
+#include "universal/posit/specializations.hpp"
+// posit type manipulators such as pretty printers
+#include "universal/posit/posit_manipulators.hpp"
+#include "universal/posit/math_functions.hpp"
+// test helpers, such as, ReportTestResults
+#include "../utils/test_helpers.hpp"
+#include "../utils/posit_test_randoms.hpp"
+
+namespace sw {
+namespace unum {
+
+const char* OperatorSymbol(int opcode) {
+	switch (opcode) {
+	case OPCODE_ADD: return "+";
+	case OPCODE_SUB: return "-";
+	case OPCODE_MUL: return "*";
+	case OPCODE_DIV: return "/";
+	default:         return "?";
+	}
+}
+
+// enumerate all operand pairs of a posit configuration and compare the word engine to the reference arithmetic
+template<size_t nbits, size_t es>
+int VerifyWordEngineExhaustively(int opcode, bool bReportIndividualTestCases) {
+	const size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> pa, pb, pref, presult;
+	for (size_t i = 0; i < NR_POSITS; i++) {
+		pa.set_raw_bits(i);
+		for (size_t j = 0; j < NR_POSITS; j++) {
+			pb.set_raw_bits(j);
+			executeReferenceBinary(opcode, pa, pb, pref);
+			presult = executeOperator(opcode, pa, pb);
+			if (presult != pref) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", OperatorSymbol(opcode), pa, pb, pref, presult);
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// compare the word engine to the reference arithmetic on random encodings
+template<size_t nbits, size_t es>
+int VerifyWordEngineThroughRandoms(int opcode, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	std::mt19937_64 generator(nbits * 8 + es);
+	std::uniform_int_distribution<uint64_t> distribution;
+	int nrOfFailedTests = 0;
+	posit<nbits, es> pa, pb, pref, presult;
+	for (size_t i = 0; i < nrOfRandoms; i++) {
+		pa.set_raw_bits(distribution(generator));
+		pb.set_raw_bits(distribution(generator));
+		// bias half the cases towards operands of similar magnitude to exercise cancellation and carries
+		if (i & 1) pb.set_raw_bits(pa.encoding() + (distribution(generator) & 0xFF) - 0x80);
+		executeReferenceBinary(opcode, pa, pb, pref);
+		presult = executeOperator(opcode, pa, pb);
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", OperatorSymbol(opcode), pa, pb, pref, presult);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// reciprocate and sqrt: reciprocals must match the reference division, roots the correctly rounded root of the long double
+template<size_t nbits, size_t es>
+int VerifyWordEngineUnaryOperators(bool bReportIndividualTestCases) {
+	const size_t NR_POSITS = (size_t(1) << nbits);
+	int nrOfFailedTests = 0;
+	posit<nbits, es> one(1), pa, pref, presult;
+	for (size_t i = 0; i < NR_POSITS; i++) {
+		pa.set_raw_bits(i);
+		executeReferenceBinary(OPCODE_DIV, one, pa, pref);
+		presult = pa.reciprocate();
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "reciprocate", pa, pref, presult);
+		}
+		if (pa.isneg() || pa.isnar()) {
+			pref.setnar();
+		}
+		else {
+			pref = std::sqrt((long double)pa);
+		}
+		presult = sqrt(pa);
+		if (presult != pref) {
+			nrOfFailedTests++;
+			if (bReportIndividualTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", pa, pref, presult);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyWordEngine(const std::string& tag, bool bReportIndividualTestCases) {
+	int nrOfFailedTests = 0;
+	for (int opcode = OPCODE_ADD; opcode <= OPCODE_DIV; ++opcode) {
+		nrOfFailedTests += VerifyWordEngineExhaustively<nbits, es>(opcode, bReportIndividualTestCases);
+	}
+	nrOfFailedTests += VerifyWordEngineUnaryOperators<nbits, es>(bReportIndividualTestCases);
+	return nrOfFailedTests;
+}
+
+template<size_t nbits, size_t es>
+int VerifyWordEngineThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, size_t nrOfRandoms) {
+	int nrOfFailedTests = 0;
+	for (int opcode = OPCODE_ADD; opcode <= OPCODE_DIV; ++opcode) {
+		nrOfFailedTests += VerifyWordEngineThroughRandoms<nbits, es>(opcode, bReportIndividualTestCases, nrOfRandoms);
+	}
+	return nrOfFailedTests;
+}
+
+} // namespace unum
+} // namespace sw
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main(int argc, char** argv)
+try {
+	using namespace std;
+	using namespace sw::unum;
+
+	bool bReportIndividualTestCases = false;
+	int nrOfFailedTestCases = 0;
+
+	cout << "Posit word-native arithmetic engine validation" << endl;
+
+	std::string tag = "Word engine failed: ";
+
+#if MANUAL_TESTING
+	posit<64, 3> a, b;
+	a.set_raw_bits(0x4000000000000001ull);
+	b.set_raw_bits(0xC000000000000000ull);
+	cout << components_to_string(a + b) << endl;
+	posit<64, 3> c;
+	executeReferenceBinary(OPCODE_ADD, a, b, c);
+	cout << components_to_string(c) << endl;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<5, 1>(tag, true), "posit<5,1>", "word engine");
+
+#else
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<2, 0>(tag, bReportIndividualTestCases), "posit<2,0>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<4, 1>(tag, bReportIndividualTestCases), "posit<4,1>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<5, 3>(tag, bReportIndividualTestCases), "posit<5,3>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<8, 0>(tag, bReportIndividualTestCases), "posit<8,0>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<8, 1>(tag, bReportIndividualTestCases), "posit<8,1>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<8, 2>(tag, bReportIndividualTestCases), "posit<8,2>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<8, 3>(tag, bReportIndividualTestCases), "posit<8,3>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<10, 1>(tag, bReportIndividualTestCases), "posit<10,1>", "word engine");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<16, 1>(tag, bReportIndividualTestCases, 10000), "posit<16,1>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<24, 1>(tag, bReportIndividualTestCases, 10000), "posit<24,1>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<32, 2>(tag, bReportIndividualTestCases, 10000), "posit<32,2>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<40, 2>(tag, bReportIndividualTestCases, 10000), "posit<40,2>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<48, 3>(tag, bReportIndividualTestCases, 10000), "posit<48,3>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<63, 4>(tag, bReportIndividualTestCases, 10000), "posit<63,4>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 10000), "posit<64,3>", "word engine");
+
+#if STRESS_TESTING
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<12, 1>(tag, bReportIndividualTestCases), "posit<12,1>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngine<12, 2>(tag, bReportIndividualTestCases), "posit<12,2>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<64, 0>(tag, bReportIndividualTestCases, 1000000), "posit<64,0>", "word engine");
+	nrOfFailedTestCases += ReportTestResult(VerifyWordEngineThroughRandoms<64, 3>(tag, bReportIndividualTestCases, 1000000), "posit<64,3>", "word engine");
+#endif  // STRESS_TESTING
+
+#endif  // MANUAL_TESTING
+
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -5,6 +5,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <iostream>
 #include <iomanip>
+#include <random>
 #include <universal/native/integers.hpp> // for to_binary(int)
 #include <universal/blockbin/blockbinary.hpp>
 
@@ -80,3 +81,15 @@ void ReportArithmeticShiftSuccess(const std::string& test_case, const std::strin
 		<< std::setprecision(old_precision)
 		<< std::endl;
 }
+
+// fill two blockbinary numbers of different block types with the same random bit pattern
+template<size_t nbits, typename BlockType, typename ReferenceBlockType>
+void RandomBlockBinaryPair(std::mt19937_64& generator, sw::unum::blockbinary<nbits, BlockType>& a, sw::unum::blockbinary<nbits, ReferenceBlockType>& ref) {
+	uint64_t bits = 0;
+	for (size_t i = 0; i < nbits; ++i) {
+		if (i % 64 == 0) bits = generator();
+		bool bit = (bits >> (i % 64)) & 0x1;
+		a.set(i, bit);
+		ref.set(i, bit);
+	}
+}
@@ -295,6 +295,32 @@ int ValidateConversion(const std::string& tag, bool bReportIndividualTestCases)
 	return nrOfFailedTests;
 }
 
+// values below half the smallest fixpnt value convert to zero, including the ones whose rounding shift reaches past
+// the fraction of the float or double; half of it is a tie that rounds to zero, and values just above it round up
+template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType, typename Real>
+int ValidateUnderflowConversion(const std::string& tag, bool bReportIndividualTestCases) {
+	constexpr int fbits = std::numeric_limits<Real>::digits - 1;
+	const Real half = Real(std::ldexp(1.0, -int(rbits) - 1));
+	const double minpos = std::ldexp(1.0, -int(rbits));
+	int nrOfFailedTests = 0;
+	fixpnt<nbits, rbits, arithmetic, BlockType> nut;
+	for (int sign = 1; sign >= -1; sign -= 2) {
+		std::vector<Real> below;
+		for (int shift = 0; shift <= fbits + 4; ++shift) below.push_back(Real(sign) * std::ldexp(half, -shift));
+		below.push_back(Real(sign) * std::nextafter(half, Real(0)));
+		below.push_back(Real(sign) * std::numeric_limits<Real>::min());
+		below.push_back(Real(sign) * std::numeric_limits<Real>::denorm_min());
+		for (Real input : below) {
+			nut = input;
+			nrOfFailedTests += Compare(double(input), nut, 0.0, bReportIndividualTestCases);
+		}
+		Real above = Real(sign) * std::nextafter(half, Real(1));
+		nut = above;
+		nrOfFailedTests += Compare(double(above), nut, sign * minpos, bReportIndividualTestCases);
+	}
+	return nrOfFailedTests;
+}
+
 // enumerate all addition cases for an fixpnt<nbits,rbits> configuration
 template<size_t nbits, size_t rbits, bool arithmetic, typename BlockType>
 int VerifyAddition(const std::string& tag, bool bReportIndividualTestCases) {
@@ -264,6 +264,230 @@ namespace unum {
 		return nrOfFailedTests;
 	}
 
+	// generate random operands to test the compound assignment operators += and -=, which do their own sign
+	// dispatch: every other pair of operands has opposite signs, so that += subtracts and -= adds magnitudes
+	template<size_t nbits, size_t es>
+	int ValidateCompoundAssignmentThroughRandoms(const std::string& tag, bool bReportIndividualTestCases, int opcode, uint32_t nrOfRandoms) {
+		int nrOfFailedTests = 0;
+		posit<nbits, es> pa, pb, presult, preference;
+
+		std::string operation_string;
+		switch (opcode) {
+		case OPCODE_ADD:
+			operation_string = "+=";
+			break;
+		case OPCODE_SUB:
+			operation_string = "-=";
+			break;
+		default:
+			std::cerr << "Unsupported compound assignment operator, test cancelled\n";
+			return 1;
+		}
+		std::random_device rd;
+		std::mt19937_64 eng(rd());
+		std::uniform_int_distribution<unsigned long long> distr;
+		for (unsigned i = 0; i < nrOfRandoms; i++) {
+			pa.set_raw_bits(distr(eng));
+			pb.set_raw_bits(distr(eng));
+			if (pa.isnar() || pb.isnar()) continue;
+			if ((i & 1) && (pa.isneg() == pb.isneg())) pb = -pb;
+			double da = double(pa);
+			double db = double(pb);
+			presult = pa;
+			if (opcode == OPCODE_ADD) {
+				presult += pb;
+				preference = da + db;
+			}
+			else {
+				presult -= pb;
+				preference = da - db;
+			}
+			if (presult != preference) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", operation_string, pa, pb, preference, presult);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// Decode a posit into a (sign, scale, fraction) triple through the bitblock reference decoder.
+	// Only uses get(), so it applies to the generic posit as well as to the fast specializations.
+	template<size_t nbits, size_t es, size_t fbits>
+	void referenceNormalize(const posit<nbits, es>& p, value<fbits>& v) {
+		bool s;
+		regime<nbits, es> r;
+		exponent<nbits, es> e;
+		fraction<fbits> f;
+		decode(p.get(), s, r, e, f);
+		v.set(s, r.scale() + e.scale(), f.get(), p.iszero(), p.isnar());
+	}
+
+	// Execute a binary operator with the reference arithmetic: the bitblock (sign, scale, fraction) modules
+	// followed by the rounding of convert_to_bb. The reference does not depend on a native floating-point
+	// type, so it is exact for posits of any size, and does not use the arithmetic of the posit under test.
+	template<size_t nbits, size_t es>
+	void executeReferenceBinary(int opcode, const posit<nbits, es>& pa, const posit<nbits, es>& pb, posit<nbits, es>& preference) {
+		constexpr size_t fbits   = (es + 2 >= nbits ? 0 : nbits - 3 - es);
+		constexpr size_t fhbits  = fbits + 1;
+		constexpr size_t abits   = fhbits + 3;
+		constexpr size_t mbits   = 2 * fhbits;
+		constexpr size_t divbits = 3 * fhbits + 4;
+		bitblock<nbits> ptt;
+		if (pa.isnar() || pb.isnar() || (opcode == OPCODE_DIV && pb.iszero())) {
+			preference.setnar();
+			return;
+		}
+		value<fbits> a, b;
+		referenceNormalize(pa, a);
+		referenceNormalize(pb, b);
+		switch (opcode) {
+		case OPCODE_ADD:
+		case OPCODE_SUB:
+			{
+				if (opcode == OPCODE_SUB) b.set(!b.sign(), b.scale(), b.fraction(), b.iszero(), false);
+				value<abits + 1> sum;
+				if (pa.iszero() && pb.iszero()) {
+					preference.setzero();
+					return;
+				}
+				if (pa.iszero()) {
+					convert_to_bb<nbits, es, fbits>(b.sign(), b.scale(), b.fraction(), ptt);
+					break;
+				}
+				if (pb.iszero()) {
+					preference = pa;
+					return;
+				}
+				module_add<fbits, abits>(a, b, sum);
+				if (sum.iszero()) {
+					preference.setzero();
+					return;
+				}
+				convert_to_bb<nbits, es, abits + 1>(sum.sign(), sum.scale(), sum.fraction(), ptt);
+			}
+			break;
+		case OPCODE_MUL:
+			{
+				if (pa.iszero() || pb.iszero()) {
+					preference.setzero();
+					return;
+				}
+				value<mbits> product;
+				module_multiply(a, b, product);
+				convert_to_bb<nbits, es, mbits>(product.sign(), product.scale(), product.fraction(), ptt);
+			}
+			break;
+		case OPCODE_DIV:
+			{
+				if (pa.iszero()) {
+					preference.setzero();
+					return;
+				}
+				value<divbits> ratio;
+				module_divide(a, b, ratio);
+				convert_to_bb<nbits, es, divbits>(ratio.sign(), ratio.scale(), ratio.fraction(), ptt);
+			}
+			break;
+		default:
+			std::cerr << "Unsupported binary operator: operation ignored\n";
+			break;
+		}
+		preference.set(ptt);
+	}
+
+	// Execute a binary operator of the posit under test
+	template<size_t nbits, size_t es>
+	posit<nbits, es> executeOperator(int opcode, const posit<nbits, es>& pa, const posit<nbits, es>& pb) {
+		switch (opcode) {
+		case OPCODE_ADD:
+			return pa + pb;
+		case OPCODE_SUB:
+			return pa - pb;
+		case OPCODE_MUL:
+			return pa * pb;
+		case OPCODE_DIV:
+			return pa / pb;
+		default:
+			break;
+		}
+		return posit<nbits, es>();
+	}
+
+	// assign a random encoding to a posit of any size
+	template<size_t nbits, size_t es, typename RandomEngine>
+	void randomEncoding(posit<nbits, es>& p, RandomEngine& eng) {
+		std::uniform_int_distribution<unsigned long long> distr;
+		bitblock<nbits> raw;
+		for (size_t i = 0; i < nbits; i += 64) {
+			unsigned long long word = distr(eng);
+			for (size_t j = 0; j < 64 && i + j < nbits; ++j) {
+				raw.set(i + j, (word >> j) & 0x1);
+			}
+		}
+		p.set(raw);
+	}
+
+	// Validate a binary operator against the reference arithmetic with random operands.
+	// Unlike ValidateBinaryOperatorThroughRandoms, which uses double as reference, this is
+	// bit-accurate for any posit size, and is the validation of record for the fast specializations.
+	// A quarter of the test cases pairs operands of nearly equal magnitude to exercise cancellation.
+	template<size_t nbits, size_t es>
+	int ValidateBinaryOperatorAgainstReference(const std::string& tag, bool bReportIndividualTestCases, int opcode, uint32_t nrOfRandoms) {
+		int nrOfFailedTests = 0;
+		posit<nbits, es> pa, pb, presult, preference;
+
+		std::string operation_string;
+		switch (opcode) {
+		case OPCODE_ADD:
+			operation_string = "+";
+			break;
+		case OPCODE_SUB:
+			operation_string = "-";
+			break;
+		case OPCODE_MUL:
+			operation_string = "*";
+			break;
+		case OPCODE_DIV:
+			operation_string = "/";
+			break;
+		default:
+			std::cerr << "Unsupported binary operator, test cancelled\n";
+			return 1;
+		}
+		std::random_device rd;
+		std::mt19937_64 eng(rd());
+		for (unsigned i = 0; i < nrOfRandoms; i++) {
+			randomEncoding(pa, eng);
+			randomEncoding(pb, eng);
+			if ((i & 0x3) == 1 && (opcode == OPCODE_ADD || opcode == OPCODE_SUB)) {
+				pb = (opcode == OPCODE_ADD ? -pa : pa);
+				unsigned steps = unsigned(eng() & 0x7);
+				for (unsigned k = 0; k < steps; ++k) ++pb;
+			}
+			executeReferenceBinary(opcode, pa, pb, preference);
+#if POSIT_THROW_ARITHMETIC_EXCEPTION
+			try {
+				presult = executeOperator(opcode, pa, pb);
+			}
+			catch (const posit_arithmetic_exception& err) {
+				if (pa.isnar() || pb.isnar() || (opcode == OPCODE_DIV && pb.iszero())) {
+					presult.setnar();
+				}
+				else {
+					throw err;
+				}
+			}
+#else
+			presult = executeOperator(opcode, pa, pb);
+#endif
+			if (presult != preference) {
+				nrOfFailedTests++;
+				if (bReportIndividualTestCases) ReportBinaryArithmeticError("FAIL", operation_string, pa, pb, preference, presult);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
 	// generate a random set of operands to test the binary operators for a posit configuration
 	// Basic design is that we generate nrOfRandom posit values and store them in an operand array.
 	// We will then execute the binary operator nrOfRandom combinations.
@@ -122,6 +122,34 @@ void GenerateLookupTable(UNARY_ARITHMETIC_OPERATOR op) {
 	}
 }
 
+// print one lookup table of the posit<8,es> lookup engine as a C array
+void PrintLookupTable(std::ostream& ostr, const std::string& name, const uint8_t* table, size_t size) {
+	ostr << "constexpr uint8_t " << name << "[" << size << "] = {\n";
+	for (size_t i = 0; i < size; i += 16) {
+		ostr << '\t';
+		for (size_t j = 0; j < 16; ++j) {
+			ostr << unsigned(table[i + j]) << ',';
+		}
+		ostr << '\n';
+	}
+	ostr << "};\n\n";
+}
+
+// print the tables of the posit<8,es> lookup engine, for example, to place them in ROM on embedded targets
+template<size_t es>
+void GeneratePosit8LookupTables(std::ostream& ostr) {
+	const sw::unum::posit8_lookup_tables<es>& tables = sw::unum::posit8_lookup_tables<es>::instance();
+	std::string prefix = std::string("posit_8_") + std::to_string(es) + "_";
+	PrintLookupTable(ostr, prefix + "addition_lookup", tables.add, 65536);
+	PrintLookupTable(ostr, prefix + "subtraction_lookup", tables.sub, 65536);
+	PrintLookupTable(ostr, prefix + "multiplication_lookup", tables.mul, 65536);
+	PrintLookupTable(ostr, prefix + "division_lookup", tables.div, 65536);
+	PrintLookupTable(ostr, prefix + "reciprocal_lookup", tables.reciprocal, 256);
+	PrintLookupTable(ostr, prefix + "sqrt_lookup", tables.sqrt, 256);
+	PrintLookupTable(ostr, prefix + "exp_lookup", tables.exp, 256);
+	PrintLookupTable(ostr, prefix + "log_lookup", tables.log, 256);
+}
+
 namespace sw {
 	namespace spec {
 
@@ -303,6 +331,20 @@ try {
 	duration<double> time_span;
 	double elapsed;
 
+	// lookup_arithmetic es: print the tables of the posit<8,es> lookup engine
+	if (argc == 2) {
+		switch (atoi(argv[1])) {
+		case 0: GeneratePosit8LookupTables<0>(cout); break;
+		case 1: GeneratePosit8LookupTables<1>(cout); break;
+		case 2: GeneratePosit8LookupTables<2>(cout); break;
+		case 3: GeneratePosit8LookupTables<3>(cout); break;
+		default:
+			cerr << "usage: lookup_arithmetic [es], with es in [0, 3]" << endl;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
 #ifdef NOW
 	//Validate5_0_Lookup();
 	cout << "constexpr uint8_t posit_3_0_addition_lookup[64] = {\n";